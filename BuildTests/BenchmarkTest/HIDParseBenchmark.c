@@ -0,0 +1,236 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2018.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2018  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Benchmark of HID report descriptor parsing, giving the time taken to parse each report descriptor via both
+ *  \ref USB_ProcessHIDReport() and \ref USB_StreamHIDReport(), along with the peak usage of each of the parser's fixed
+ *  size tables: the stored report items, collection paths and report IDs, and the usage and state table stacks. The
+ *  table usage shows how close each descriptor comes to the \c HID_MAX_* and \c HID_*_STACK_DEPTH limits the parser
+ *  was built with, and so how far those limits can be reduced to save memory.
+ *
+ *  The parse time is given in TSC cycles per parse on x86 hosts, or nanoseconds per parse otherwise.
+ *
+ *  Usage: HIDParseBenchmark ITERATIONS DESCRIPTOR...
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+	#include <x86intrin.h>
+#endif
+
+#include <LUFA/Drivers/USB/USB.h>
+
+/** Maximum size in bytes of a benchmarked report descriptor. */
+#define MAX_DESCRIPTOR_SIZE    1024
+
+/** Peak usage of the parser's stacks by a report descriptor, found by walking its items. */
+typedef struct
+{
+	uint8_t Collections; /**< Number of COLLECTION items, each of which takes a collection path entry. */
+	uint8_t UsageDepth; /**< Largest number of USAGE items given for a single main item. */
+	uint8_t StateDepth; /**< Largest number of state tables in use at once, including the current state table. */
+} DescriptorStacks_t;
+
+static HID_ReportInfo_t   ParserData;
+static HID_ReportLayout_t Layout;
+
+bool CALLBACK_HIDParser_FilterHIDReportItem(HID_ReportItem_t* const CurrentItem)
+{
+	/* Keep every report item, so that the peak report item usage covers the whole descriptor */
+	return true;
+}
+
+static void StreamItemCallback(const HID_ReportItem_t* const ReportItem)
+{
+
+}
+
+static uint64_t GetTimestamp(void)
+{
+	#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+	#else
+	struct timespec Time;
+	clock_gettime(CLOCK_MONOTONIC, &Time);
+
+	return (((uint64_t)Time.tv_sec * 1000000000) + Time.tv_nsec);
+	#endif
+}
+
+/** Walks the items of a report descriptor to find its peak usage of the parser's collection paths, usage stack and
+ *  state table stack, mirroring the way in which the parser allocates them.
+ */
+static DescriptorStacks_t GetDescriptorStacks(const uint8_t* Descriptor,
+                                              const uint16_t Size)
+{
+	DescriptorStacks_t Stacks     = {.StateDepth = 1};
+	uint8_t            Usages     = 0;
+	uint8_t            StateDepth = 1;
+	uint16_t           Offset     = 0;
+
+	while (Offset < Size)
+	{
+		uint8_t  Prefix   = Descriptor[Offset];
+		uint16_t ItemSize = (Prefix & 0x03);
+
+		if (ItemSize == 3)
+		  ItemSize = 4;
+
+		if (Prefix == 0xFE)
+		{
+			Offset += (3 + ((Offset + 1 < Size) ? Descriptor[Offset + 1] : 0));
+			continue;
+		}
+
+		switch (Prefix & 0xFC)
+		{
+			case HID_RI_PUSH(0):
+				StateDepth++;
+				Stacks.StateDepth = MAX(Stacks.StateDepth, StateDepth);
+				break;
+			case HID_RI_POP(0):
+				StateDepth--;
+				break;
+			case HID_RI_USAGE(0):
+				Usages++;
+				Stacks.UsageDepth = MAX(Stacks.UsageDepth, Usages);
+				break;
+			case HID_RI_COLLECTION(0):
+				Stacks.Collections++;
+				Usages = 0;
+				break;
+			case HID_RI_INPUT(0):
+			case HID_RI_OUTPUT(0):
+			case HID_RI_FEATURE(0):
+			case HID_RI_END_COLLECTION(0):
+				Usages = 0;
+				break;
+		}
+
+		Offset += (1 + ItemSize);
+	}
+
+	return Stacks;
+}
+
+static double BenchmarkFullParse(const uint8_t* Descriptor,
+                                 const uint16_t Size,
+                                 const uint32_t Iterations)
+{
+	uint64_t StartTime = GetTimestamp();
+
+	for (uint32_t i = 0; i < Iterations; i++)
+	  USB_ProcessHIDReport(Descriptor, Size, &ParserData);
+
+	return ((double)(GetTimestamp() - StartTime) / Iterations);
+}
+
+static double BenchmarkStreamParse(const uint8_t* Descriptor,
+                                   const uint16_t Size,
+                                   const uint32_t Iterations)
+{
+	uint64_t StartTime = GetTimestamp();
+
+	for (uint32_t i = 0; i < Iterations; i++)
+	  USB_StreamHIDReport(Descriptor, Size, &Layout, StreamItemCallback);
+
+	return ((double)(GetTimestamp() - StartTime) / Iterations);
+}
+
+int main(int argc,
+         char* argv[])
+{
+	static uint8_t Descriptor[MAX_DESCRIPTOR_SIZE];
+
+	if (argc < 3)
+	{
+		printf("Usage: %s ITERATIONS DESCRIPTOR...\n", argv[0]);
+		return 1;
+	}
+
+	uint32_t Iterations = strtoul(argv[1], NULL, 0);
+
+	#if defined(__x86_64__) || defined(__i386__)
+	const char* Unit = "cycles";
+	#else
+	const char* Unit = "ns";
+	#endif
+
+	printf("HID report descriptor parse, %lu iterations, parse time in %s/parse:\n", (unsigned long)Iterations, Unit);
+	printf("  %-16s %5s %8s %8s %8s %8s %8s %8s %8s\n", "Descriptor", "Bytes", "Full", "Stream",
+	       "Items", "Paths", "IDs", "Usages", "States");
+
+	for (int Arg = 2; Arg < argc; Arg++)
+	{
+		const char* Name = strrchr(argv[Arg], '/') ? (strrchr(argv[Arg], '/') + 1) : argv[Arg];
+		FILE*       File = fopen(argv[Arg], "rb");
+
+		if (File == NULL)
+		{
+			printf("Failed to open report descriptor \"%s\".\n", argv[Arg]);
+			return 1;
+		}
+
+		uint16_t Size = fread(Descriptor, 1, sizeof(Descriptor), File);
+		fclose(File);
+
+		uint8_t ErrorCode = USB_ProcessHIDReport(Descriptor, Size, &ParserData);
+
+		if (ErrorCode != HID_PARSE_Successful)
+		{
+			printf("Failed to parse report descriptor \"%s\", error %d.\n", Name, ErrorCode);
+			return 1;
+		}
+
+		DescriptorStacks_t Stacks = GetDescriptorStacks(Descriptor, Size);
+		char               Usage[5][8];
+
+		snprintf(Usage[0], sizeof(Usage[0]), "%d/%d", ParserData.TotalReportItems, HID_MAX_REPORTITEMS);
+		snprintf(Usage[1], sizeof(Usage[1]), "%d/%d", Stacks.Collections, HID_MAX_COLLECTIONS);
+		snprintf(Usage[2], sizeof(Usage[2]), "%d/%d", ParserData.TotalDeviceReports, HID_MAX_REPORT_IDS);
+		snprintf(Usage[3], sizeof(Usage[3]), "%d/%d", Stacks.UsageDepth, HID_USAGE_STACK_DEPTH);
+		snprintf(Usage[4], sizeof(Usage[4]), "%d/%d", Stacks.StateDepth, HID_STATETABLE_STACK_DEPTH);
+
+		printf("  %-16s %5u %8.0f %8.0f %8s %8s %8s %8s %8s\n", Name, Size,
+		       BenchmarkFullParse(Descriptor, Size, Iterations), BenchmarkStreamParse(Descriptor, Size, Iterations),
+		       Usage[0], Usage[1], Usage[2], Usage[3], Usage[4]);
+	}
+
+	printf("Parser tables: %u bytes of HID_ReportInfo_t, %u bytes of state table stack\n",
+	       (unsigned)sizeof(HID_ReportInfo_t), (unsigned)(sizeof(HID_StateTable_t) * HID_STATETABLE_STACK_DEPTH));
+
+	return 0;
+}
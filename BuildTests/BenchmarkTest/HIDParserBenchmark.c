@@ -0,0 +1,276 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2018.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2018  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Benchmark of HID report decoding, comparing a call to \ref USB_GetHIDReportItemInfo() for each report item against
+ *  a single call to the extraction plan based \ref USB_GetHIDReportItemValues(). The decoded report is a 64 byte
+ *  gamepad report with 78 items: 32 buttons, 8 signed 16-bit axes, 12 12-bit axes, 2 hat switches, 16 8-bit triggers
+ *  and 8 signed 5-bit items. Before timing, both methods are run over a set of random reports and their values are
+ *  compared, after sign extending the per-item values of the signed items.
+ *
+ *  The decode time of each method is given in TSC cycles per report on x86 hosts, or nanoseconds per report otherwise.
+ *
+ *  Usage: HIDParserBenchmark [ITERATIONS]
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+	#include <x86intrin.h>
+#endif
+
+#include <LUFA/Drivers/USB/USB.h>
+
+/** Size in bytes of the benchmarked report. */
+#define REPORT_SIZE        64
+
+/** Number of random reports on which both decoding methods are compared before timing. */
+#define CHECKED_REPORTS    1000
+
+/** HID report descriptor of the benchmarked gamepad, with a single 64 byte IN report. */
+static const uint8_t GamepadReport[] =
+{
+	0x05, 0x01,        /* Usage Page (Generic Desktop) */
+	0x09, 0x05,        /* Usage (Gamepad) */
+	0xA1, 0x01,        /* Collection (Application) */
+	0x05, 0x09,        /*   Usage Page (Button) */
+	0x19, 0x01,        /*   Usage Minimum (1) */
+	0x29, 0x20,        /*   Usage Maximum (32) */
+	0x15, 0x00,        /*   Logical Minimum (0) */
+	0x25, 0x01,        /*   Logical Maximum (1) */
+	0x75, 0x01,        /*   Report Size (1) */
+	0x95, 0x20,        /*   Report Count (32) */
+	0x81, 0x02,        /*   Input (Data, Variable, Absolute) */
+	0x05, 0x01,        /*   Usage Page (Generic Desktop) */
+	0x19, 0x30,        /*   Usage Minimum (X) */
+	0x29, 0x37,        /*   Usage Maximum (Dial) */
+	0x16, 0x00, 0x80,  /*   Logical Minimum (-32768) */
+	0x26, 0xFF, 0x7F,  /*   Logical Maximum (32767) */
+	0x75, 0x10,        /*   Report Size (16) */
+	0x95, 0x08,        /*   Report Count (8) */
+	0x81, 0x02,        /*   Input (Data, Variable, Absolute) */
+	0x19, 0x40,        /*   Usage Minimum (Vx) */
+	0x29, 0x4B,        /*   Usage Maximum (12 usages) */
+	0x15, 0x00,        /*   Logical Minimum (0) */
+	0x26, 0xFF, 0x0F,  /*   Logical Maximum (4095) */
+	0x75, 0x0C,        /*   Report Size (12) */
+	0x95, 0x0C,        /*   Report Count (12) */
+	0x81, 0x02,        /*   Input (Data, Variable, Absolute) */
+	0x09, 0x39,        /*   Usage (Hat Switch) */
+	0x09, 0x39,        /*   Usage (Hat Switch) */
+	0x15, 0x00,        /*   Logical Minimum (0) */
+	0x25, 0x07,        /*   Logical Maximum (7) */
+	0x75, 0x04,        /*   Report Size (4) */
+	0x95, 0x02,        /*   Report Count (2) */
+	0x81, 0x42,        /*   Input (Data, Variable, Absolute, Null State) */
+	0x05, 0x02,        /*   Usage Page (Simulation Controls) */
+	0x19, 0xC0,        /*   Usage Minimum (0xC0) */
+	0x29, 0xCF,        /*   Usage Maximum (0xCF) */
+	0x15, 0x00,        /*   Logical Minimum (0) */
+	0x26, 0xFF, 0x00,  /*   Logical Maximum (255) */
+	0x75, 0x08,        /*   Report Size (8) */
+	0x95, 0x10,        /*   Report Count (16) */
+	0x81, 0x02,        /*   Input (Data, Variable, Absolute) */
+	0x05, 0x01,        /*   Usage Page (Generic Desktop) */
+	0x19, 0x40,        /*   Usage Minimum (Vx) */
+	0x29, 0x47,        /*   Usage Maximum (8 usages) */
+	0x15, 0xF0,        /*   Logical Minimum (-16) */
+	0x25, 0x0F,        /*   Logical Maximum (15) */
+	0x75, 0x05,        /*   Report Size (5) */
+	0x95, 0x08,        /*   Report Count (8) */
+	0x81, 0x02,        /*   Input (Data, Variable, Absolute) */
+	0x75, 0x20,        /*   Report Size (32) */
+	0x95, 0x01,        /*   Report Count (1) */
+	0x81, 0x03,        /*   Input (Constant, Variable, Absolute) */
+	0xC0,              /* End Collection */
+};
+
+static HID_ReportInfo_t ParserData;
+static uint8_t          Report[REPORT_SIZE];
+static int32_t          Values[HID_MAX_REPORTITEMS];
+
+/** State of the xorshift generator used for the random reports. */
+static uint32_t RandomState = 0x2545F491;
+
+bool CALLBACK_HIDParser_FilterHIDReportItem(HID_ReportItem_t* const CurrentItem)
+{
+	return !(CurrentItem->ItemFlags & HID_IOF_CONSTANT);
+}
+
+static uint32_t Random(void)
+{
+	RandomState ^= (RandomState << 13);
+	RandomState ^= (RandomState >> 17);
+	RandomState ^= (RandomState << 5);
+
+	return RandomState;
+}
+
+static uint64_t GetTimestamp(void)
+{
+	#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+	#else
+	struct timespec Time;
+	clock_gettime(CLOCK_MONOTONIC, &Time);
+
+	return (((uint64_t)Time.tv_sec * 1000000000) + Time.tv_nsec);
+	#endif
+}
+
+/** Decodes the current report with a call to \ref USB_GetHIDReportItemInfo() for each report item.
+ *
+ *  \return Sum of the decoded raw item values.
+ */
+static uint32_t DecodeItemByItem(void)
+{
+	uint32_t Sum = 0;
+
+	for (uint8_t ItemIndex = 0; ItemIndex < ParserData.TotalReportItems; ItemIndex++)
+	{
+		HID_ReportItem_t* ReportItem = &ParserData.ReportItems[ItemIndex];
+
+		USB_GetHIDReportItemInfo(Report, ReportItem);
+		Sum += ReportItem->Value;
+	}
+
+	return Sum;
+}
+
+/** Decodes the current report with a single call to \ref USB_GetHIDReportItemValues().
+ *
+ *  \return Sum of the decoded item values.
+ */
+static uint32_t DecodeBatched(void)
+{
+	uint32_t Sum = 0;
+
+	USB_GetHIDReportItemValues(&ParserData, Report, sizeof(Report), HID_REPORT_ITEM_In, Values);
+
+	for (uint8_t ItemIndex = 0; ItemIndex < ParserData.TotalReportItems; ItemIndex++)
+	  Sum += Values[ItemIndex];
+
+	return Sum;
+}
+
+/** Checks that both decoding methods give the same values for the current report. The descriptor's signed items
+ *  are its 16-bit axes and 5-bit items, whose per-item values are sign extended before comparison.
+ *
+ *  \return Boolean \c true if the values of every report item match, \c false otherwise.
+ */
+static bool CheckReport(void)
+{
+	DecodeItemByItem();
+
+	if (USB_GetHIDReportItemValues(&ParserData, Report, sizeof(Report), HID_REPORT_ITEM_In, Values) !=
+	    ParserData.TotalReportItems)
+	{
+		return false;
+	}
+
+	for (uint8_t ItemIndex = 0; ItemIndex < ParserData.TotalReportItems; ItemIndex++)
+	{
+		HID_ReportItem_t* ReportItem = &ParserData.ReportItems[ItemIndex];
+		uint8_t           BitSize    = ReportItem->Attributes.BitSize;
+		int32_t           Expected   = ReportItem->Value;
+
+		if ((BitSize == 16) || (BitSize == 5))
+		  Expected = (int32_t)(ReportItem->Value << (32 - BitSize)) >> (32 - BitSize);
+
+		if (Values[ItemIndex] != Expected)
+		  return false;
+	}
+
+	return true;
+}
+
+static double Benchmark(uint32_t (*const Decode)(void),
+                        const uint32_t Iterations)
+{
+	volatile uint32_t Sum = 0;
+
+	uint64_t StartTime = GetTimestamp();
+
+	for (uint32_t i = 0; i < Iterations; i++)
+	{
+		Report[i % sizeof(Report)] = (uint8_t)i;
+		Sum += Decode();
+	}
+
+	return ((double)(GetTimestamp() - StartTime) / Iterations);
+}
+
+int main(int argc,
+         char* argv[])
+{
+	uint32_t Iterations = (argc > 1) ? strtoul(argv[1], NULL, 0) : 200000;
+
+	if (USB_ProcessHIDReport(GamepadReport, sizeof(GamepadReport), &ParserData) != HID_PARSE_Successful)
+	{
+		printf("Failed to parse the benchmark report descriptor.\n");
+		return 1;
+	}
+
+	if ((ParserData.TotalReportItems != 78) || (USB_GetHIDReportSize(&ParserData, 0, HID_REPORT_ITEM_In) != REPORT_SIZE))
+	{
+		printf("Unexpected benchmark report layout.\n");
+		return 1;
+	}
+
+	for (uint16_t i = 0; i < CHECKED_REPORTS; i++)
+	{
+		for (uint8_t b = 0; b < sizeof(Report); b++)
+		  Report[b] = (uint8_t)Random();
+
+		if (!(CheckReport()))
+		{
+			printf("Batched report item values differ from the per-item values.\n");
+			return 1;
+		}
+	}
+
+	#if defined(__x86_64__) || defined(__i386__)
+	const char* Unit = "cycles";
+	#else
+	const char* Unit = "ns";
+	#endif
+
+	printf("HID report decode, %d byte report with %d items, %lu iterations:\n", REPORT_SIZE,
+	       ParserData.TotalReportItems, (unsigned long)Iterations);
+	printf("  %-32s %8.0f %s/report\n", "USB_GetHIDReportItemInfo() each", Benchmark(DecodeItemByItem, Iterations), Unit);
+	printf("  %-32s %8.0f %s/report\n", "USB_GetHIDReportItemValues()", Benchmark(DecodeBatched, Iterations), Unit);
+
+	return 0;
+}
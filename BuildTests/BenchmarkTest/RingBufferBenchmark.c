@@ -0,0 +1,266 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2018.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2018  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Throughput benchmark of the interrupt masking \c RingBuffer.h buffer against the lock-free \c SPSCRingBuffer.h
+ *  buffer. Data is passed through a 128 byte buffer of each kind in 64 byte bursts, a byte at a time through both
+ *  buffers and then via the contiguous spans of the lock-free buffer. Before timing, the lock-free buffer is checked
+ *  against a random producer and consumer schedule which mixes all of its insertion and removal functions.
+ *
+ *  On the POSIX architecture the interrupt mask functions are empty, so the byte at a time figures do not include
+ *  the cost of masking interrupts that the \c RingBuffer.h functions incur on the embedded architectures.
+ *
+ *  Usage: RingBufferBenchmark [MEGABYTES]
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <LUFA/Drivers/Misc/RingBuffer.h>
+#include <LUFA/Drivers/Misc/SPSCRingBuffer.h>
+
+/** Size in bytes of the storage array of each benchmarked buffer. */
+#define BUFFER_SIZE        128
+
+/** Number of bytes inserted and then removed in each burst. */
+#define BURST_SIZE         64
+
+/** Number of steps of the random producer and consumer schedule. */
+#define SCHEDULE_STEPS     2000000
+
+static uint8_t         BufferData[BUFFER_SIZE];
+static RingBuffer_t    Buffer;
+static SPSCRingBuffer_t SPSCBuffer;
+
+/** State of the xorshift generator used for the random schedule. */
+static uint32_t RandomState = 0x2545F491;
+
+static uint32_t Random(void)
+{
+	RandomState ^= (RandomState << 13);
+	RandomState ^= (RandomState >> 17);
+	RandomState ^= (RandomState << 5);
+
+	return RandomState;
+}
+
+static double GetTimeSeconds(void)
+{
+	struct timespec Time;
+	clock_gettime(CLOCK_MONOTONIC, &Time);
+
+	return (Time.tv_sec + (Time.tv_nsec / 1e9));
+}
+
+/** Checks that the lock-free buffer passes through an incrementing byte sequence unchanged, when it is filled
+ *  and drained in random amounts by each of its insertion and removal functions.
+ *
+ *  \return Boolean \c true if every byte was removed in sequence, \c false otherwise.
+ */
+static bool CheckSPSCSchedule(void)
+{
+	uint8_t NextInsert = 0;
+	uint8_t NextRemove = 0;
+	uint8_t Burst[BUFFER_SIZE];
+
+	SPSCRingBuffer_InitBuffer(&SPSCBuffer, BufferData, sizeof(BufferData));
+
+	for (uint32_t Step = 0; Step < SCHEDULE_STEPS; Step++)
+	{
+		uint32_t Choice = Random();
+		uint16_t Length = ((Choice >> 8) % (BUFFER_SIZE + 1));
+		uint8_t* Span;
+
+		switch (Choice & 0x07)
+		{
+			case 0:
+				if (!(SPSCRingBuffer_IsFull(&SPSCBuffer)))
+				  SPSCRingBuffer_Insert(&SPSCBuffer, NextInsert++);
+				break;
+			case 1:
+				for (uint16_t i = 0; i < Length; i++)
+				  Burst[i] = (uint8_t)(NextInsert + i);
+
+				NextInsert += SPSCRingBuffer_Write(&SPSCBuffer, Burst, Length);
+				break;
+			case 2:
+				Length = MIN(Length, SPSCRingBuffer_GetWriteSpan(&SPSCBuffer, &Span));
+
+				for (uint16_t i = 0; i < Length; i++)
+				  Span[i] = NextInsert++;
+
+				SPSCRingBuffer_CommitWrite(&SPSCBuffer, Length);
+				break;
+			case 3:
+			case 4:
+				if (SPSCRingBuffer_IsEmpty(&SPSCBuffer))
+				  break;
+
+				if (SPSCRingBuffer_Peek(&SPSCBuffer) != NextRemove)
+				  return false;
+
+				if (SPSCRingBuffer_Remove(&SPSCBuffer) != NextRemove++)
+				  return false;
+				break;
+			case 5:
+			case 6:
+				Length = SPSCRingBuffer_Read(&SPSCBuffer, Burst, Length);
+
+				for (uint16_t i = 0; i < Length; i++)
+				{
+					if (Burst[i] != NextRemove++)
+					  return false;
+				}
+				break;
+			case 7:
+				Length = MIN(Length, SPSCRingBuffer_GetReadSpan(&SPSCBuffer, &Span));
+
+				for (uint16_t i = 0; i < Length; i++)
+				{
+					if (Span[i] != NextRemove++)
+					  return false;
+				}
+
+				SPSCRingBuffer_CommitRead(&SPSCBuffer, Length);
+				break;
+		}
+
+		if (SPSCRingBuffer_GetCount(&SPSCBuffer) != (uint8_t)(NextInsert - NextRemove))
+		  return false;
+	}
+
+	return true;
+}
+
+static uint32_t RunRingBuffer(const uint32_t Bursts)
+{
+	uint32_t Checksum = 0;
+
+	RingBuffer_InitBuffer(&Buffer, BufferData, sizeof(BufferData));
+
+	for (uint32_t b = 0; b < Bursts; b++)
+	{
+		for (uint8_t i = 0; i < BURST_SIZE; i++)
+		  RingBuffer_Insert(&Buffer, i);
+
+		for (uint8_t i = 0; i < BURST_SIZE; i++)
+		  Checksum += RingBuffer_Remove(&Buffer);
+	}
+
+	return Checksum;
+}
+
+static uint32_t RunSPSCBytes(const uint32_t Bursts)
+{
+	uint32_t Checksum = 0;
+
+	SPSCRingBuffer_InitBuffer(&SPSCBuffer, BufferData, sizeof(BufferData));
+
+	for (uint32_t b = 0; b < Bursts; b++)
+	{
+		for (uint8_t i = 0; i < BURST_SIZE; i++)
+		  SPSCRingBuffer_Insert(&SPSCBuffer, i);
+
+		for (uint8_t i = 0; i < BURST_SIZE; i++)
+		  Checksum += SPSCRingBuffer_Remove(&SPSCBuffer);
+	}
+
+	return Checksum;
+}
+
+static uint32_t RunSPSCSpans(const uint32_t Bursts)
+{
+	uint32_t Checksum = 0;
+	uint8_t  Source[BURST_SIZE];
+	uint8_t  Destination[BURST_SIZE];
+
+	for (uint8_t i = 0; i < BURST_SIZE; i++)
+	  Source[i] = i;
+
+	SPSCRingBuffer_InitBuffer(&SPSCBuffer, BufferData, sizeof(BufferData));
+
+	for (uint32_t b = 0; b < Bursts; b++)
+	{
+		SPSCRingBuffer_Write(&SPSCBuffer, Source, BURST_SIZE);
+		SPSCRingBuffer_Read(&SPSCBuffer, Destination, BURST_SIZE);
+
+		for (uint8_t i = 0; i < BURST_SIZE; i++)
+		  Checksum += Destination[i];
+	}
+
+	return Checksum;
+}
+
+static bool Benchmark(const char* const Name,
+                      uint32_t (*const Run)(uint32_t),
+                      const uint32_t Bursts)
+{
+	uint32_t Expected = (Bursts * ((BURST_SIZE * (BURST_SIZE - 1)) / 2));
+
+	double   StartTime = GetTimeSeconds();
+	uint32_t Checksum  = Run(Bursts);
+	double   Elapsed   = (GetTimeSeconds() - StartTime);
+
+	printf("  %-32s %8.0f MB/s\n", Name, ((double)Bursts * BURST_SIZE / 1e6 / Elapsed));
+
+	if (Checksum != Expected)
+	{
+		printf("  %s returned incorrect data.\n", Name);
+		return false;
+	}
+
+	return true;
+}
+
+int main(int argc,
+         char* argv[])
+{
+	uint32_t Megabytes = (argc > 1) ? strtoul(argv[1], NULL, 0) : 256;
+	uint32_t Bursts    = ((Megabytes * 1000000) / BURST_SIZE);
+	bool     Passed    = true;
+
+	if (!(CheckSPSCSchedule()))
+	{
+		printf("SPSCRingBuffer failed the random producer and consumer schedule.\n");
+		return 1;
+	}
+
+	printf("Ring buffer throughput, %d byte bursts through a %d byte buffer:\n", BURST_SIZE, BUFFER_SIZE);
+
+	Passed &= Benchmark("RingBuffer byte at a time", RunRingBuffer, Bursts);
+	Passed &= Benchmark("SPSCRingBuffer byte at a time", RunSPSCBytes, Bursts);
+	Passed &= Benchmark("SPSCRingBuffer bulk spans", RunSPSCSpans, Bursts);
+
+	return (Passed ? 0 : 1);
+}
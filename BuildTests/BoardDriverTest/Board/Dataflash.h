@@ -123,6 +123,27 @@
 				return 0;
 			}
 
+			/** Starts receiving a byte from the currently selected dataflash IC by sending a dummy byte, without waiting for
+			 *  the transfer to complete. Each call must be followed by a call to \ref Dataflash_EndReceiveByte() before the
+			 *  next transfer with the dataflash is started.
+			 */
+			static inline void Dataflash_BeginReceiveByte(void) ATTR_ALWAYS_INLINE;
+			static inline void Dataflash_BeginReceiveByte(void)
+			{
+
+			}
+
+			/** Completes the reception of a byte started by \ref Dataflash_BeginReceiveByte(), waiting until the transfer is
+			 *  complete.
+			 *
+			 *  \return Last response byte from the dataflash
+			 */
+			static inline uint8_t Dataflash_EndReceiveByte(void) ATTR_ALWAYS_INLINE ATTR_WARN_UNUSED_RESULT;
+			static inline uint8_t Dataflash_EndReceiveByte(void)
+			{
+				return 0;
+			}
+
 			/** Determines the currently selected dataflash chip.
 			 *
 			 *  \return Mask of the currently selected Dataflash chip, either \ref DATAFLASH_NO_CHIP if no chip is selected
@@ -75,6 +75,9 @@ int main(void)
 	Dataflash_SendByte(0);
 	// cppcheck-suppress redundantAssignment
 	Dummy = Dataflash_ReceiveByte();
+	Dataflash_BeginReceiveByte();
+	// cppcheck-suppress redundantAssignment
+	Dummy = Dataflash_EndReceiveByte();
 	// cppcheck-suppress redundantAssignment
 	Dummy = Dataflash_GetSelectedChip();
 	Dataflash_SelectChip(DATAFLASH_CHIP1);
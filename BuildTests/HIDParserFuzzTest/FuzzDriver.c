@@ -0,0 +1,227 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2018.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2018  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+
+/** \file
+ *
+ *  Standalone driver for the HID report parser fuzz target, for use where the libFuzzer runtime is not available.
+ *  Each file given on the command line is run through the fuzz target as-is, after which a simple deterministic
+ *  mutation of the given inputs is run for the requested number of further executions. If a sanitizer detects an
+ *  error, the input which triggered it is saved to the \c crash-input file for reproduction.
+ *
+ *  Usage: FuzzDriver [-runs=N] [-seed=N] FILE...
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <sanitizer/common_interface_defs.h>
+
+/** Maximum size in bytes of a single fuzz input. */
+#define MAX_INPUT_SIZE     4096
+
+/** Maximum number of input files which can be given to the driver. */
+#define MAX_INPUT_FILES    256
+
+int LLVMFuzzerTestOneInput(const uint8_t* Data,
+                           size_t Size);
+
+/** Corpus of inputs read from the files given on the command line. */
+static struct
+{
+	uint8_t* Data;
+	size_t   Size;
+} Corpus[MAX_INPUT_FILES];
+
+/** Number of valid entries in the \ref Corpus array. */
+static unsigned TotalCorpusInputs;
+
+/** State of the pseudo-random number generator used for the input mutations. */
+static uint32_t RandomState = 1;
+
+/** Input currently being executed, saved by \ref SaveCrashInput() if a sanitizer detects an error. */
+static const uint8_t* CurrentInput;
+
+/** Size in bytes of the input currently being executed. */
+static size_t CurrentInputSize;
+
+
+/** Returns the next value of a xorshift pseudo-random number generator, so that mutation runs are repeatable. */
+static uint32_t NextRandom(void)
+{
+	RandomState ^= (RandomState << 13);
+	RandomState ^= (RandomState >> 17);
+	RandomState ^= (RandomState << 5);
+
+	return RandomState;
+}
+
+/** Sanitizer death callback, saving the input which triggered the detected error. */
+static void SaveCrashInput(void)
+{
+	FILE* CrashFile = fopen("crash-input", "wb");
+
+	if (!(CrashFile))
+	  return;
+
+	fwrite(CurrentInput, 1, CurrentInputSize, CrashFile);
+	fclose(CrashFile);
+
+	fprintf(stderr, "Input saved to \"crash-input\".\n");
+}
+
+/** Executes the fuzz target on the given input, noting it as the current input for \ref SaveCrashInput(). */
+static void RunInput(const uint8_t* const Data,
+                     const size_t Size)
+{
+	CurrentInput     = Data;
+	CurrentInputSize = Size;
+
+	LLVMFuzzerTestOneInput(Data, Size);
+}
+
+/** Applies a random number of random mutations to the given input, in place.
+ *
+ *  \param[in,out] Data  Input to mutate, in a buffer of \ref MAX_INPUT_SIZE bytes.
+ *  \param[in]     Size  Current size of the input in bytes.
+ *
+ *  \return New size of the input in bytes.
+ */
+static size_t MutateInput(uint8_t* const Data,
+                          size_t Size)
+{
+	uint8_t TotalMutations = (1 + (NextRandom() % 4));
+
+	for (uint8_t i = 0; i < TotalMutations; i++)
+	{
+		size_t Position = (Size ? (NextRandom() % Size) : 0);
+
+		switch (NextRandom() % 5)
+		{
+			case 0:
+				/* Flip a single bit */
+				if (Size)
+				  Data[Position] ^= (1 << (NextRandom() % 8));
+				break;
+			case 1:
+				/* Replace a byte with a random value */
+				if (Size)
+				  Data[Position] = NextRandom();
+				break;
+			case 2:
+				/* Insert a random byte */
+				if (Size < MAX_INPUT_SIZE)
+				{
+					memmove(&Data[Position + 1], &Data[Position], (Size - Position));
+					Data[Position] = NextRandom();
+					Size++;
+				}
+				break;
+			case 3:
+				/* Remove a byte */
+				if (Size > 1)
+				{
+					memmove(&Data[Position], &Data[Position + 1], (Size - Position - 1));
+					Size--;
+				}
+				break;
+			case 4:
+				/* Truncate the input */
+				if (Size > 1)
+				  Size = (Position + 1);
+				break;
+		}
+	}
+
+	return Size;
+}
+
+int main(int argc,
+         char* argv[])
+{
+	unsigned long TotalRuns = 0;
+
+	__sanitizer_set_death_callback(SaveCrashInput);
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (!(strncmp(argv[i], "-runs=", 6)))
+		{
+			TotalRuns = strtoul(&argv[i][6], NULL, 0);
+			continue;
+		}
+		else if (!(strncmp(argv[i], "-seed=", 6)))
+		{
+			RandomState = (strtoul(&argv[i][6], NULL, 0) | 1);
+			continue;
+		}
+
+		FILE* InputFile = fopen(argv[i], "rb");
+
+		if (!(InputFile) || (TotalCorpusInputs == MAX_INPUT_FILES))
+		{
+			fprintf(stderr, "Unable to load input \"%s\".\n", argv[i]);
+			return EXIT_FAILURE;
+		}
+
+		uint8_t* Data = malloc(MAX_INPUT_SIZE);
+		size_t   Size = fread(Data, 1, MAX_INPUT_SIZE, InputFile);
+		fclose(InputFile);
+
+		Corpus[TotalCorpusInputs].Data = Data;
+		Corpus[TotalCorpusInputs].Size = Size;
+		TotalCorpusInputs++;
+
+		RunInput(Data, Size);
+	}
+
+	printf("Executed %u corpus inputs.\n", TotalCorpusInputs);
+
+	if (!(TotalRuns) || !(TotalCorpusInputs))
+	  return EXIT_SUCCESS;
+
+	uint8_t MutatedInput[MAX_INPUT_SIZE];
+
+	for (unsigned long Run = 0; Run < TotalRuns; Run++)
+	{
+		unsigned InputIndex = (NextRandom() % TotalCorpusInputs);
+		size_t   Size       = Corpus[InputIndex].Size;
+
+		memcpy(MutatedInput, Corpus[InputIndex].Data, Size);
+		Size = MutateInput(MutatedInput, Size);
+
+		RunInput(MutatedInput, Size);
+	}
+
+	printf("Executed %lu mutated inputs.\n", TotalRuns);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,187 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2018.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2018  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+
+/** \file
+ *
+ *  Fuzz target for the HID report parser, using the libFuzzer \c LLVMFuzzerTestOneInput() entry point. Each input
+ *  is parsed as a HID report descriptor by both the full and the streaming parsers, after which every report item
+ *  found is extracted from and written to report buffers allocated at exactly the report size given by the parser,
+ *  so that any out of bounds access is caught by the address sanitizer.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <LUFA/Drivers/USB/USB.h>
+
+/** Maximum number of report items kept by the streaming parser callback for later extraction. */
+#define MAX_STREAMED_ITEMS    64
+
+/** Packed report items gathered by the streaming parser callback. */
+static HID_PackedReportItem_t StreamedItems[MAX_STREAMED_ITEMS];
+
+/** Number of valid entries in the \ref StreamedItems array. */
+static uint8_t TotalStreamedItems;
+
+/** Current fuzz input, used to fill report buffers with input dependent data. */
+static const uint8_t* FuzzData;
+
+/** Size in bytes of the current fuzz input. */
+static size_t FuzzSize;
+
+
+bool CALLBACK_HIDParser_FilterHIDReportItem(HID_ReportItem_t* const CurrentItem)
+{
+	/* Keep every report item, so that all items are exercised by the extraction functions */
+	return true;
+}
+
+/** Allocates a report buffer of exactly the given size, filled with data taken from the fuzz input.
+ *
+ *  \param[in] ReportID    Report ID of the report, or zero if the device does not use report IDs.
+ *  \param[in] ReportSize  Size of the report in bytes, excluding any report ID.
+ *
+ *  \return Pointer to the allocated report buffer, which must be freed by the caller.
+ */
+static uint8_t* AllocateReport(const uint8_t ReportID,
+                               const uint16_t ReportSize)
+{
+	size_t   BufferSize = (ReportSize + (ReportID ? 1 : 0));
+	uint8_t* Report     = malloc(BufferSize ? BufferSize : 1);
+
+	for (size_t i = 0; i < BufferSize; i++)
+	  Report[i] = FuzzData[i % FuzzSize];
+
+	if (ReportID)
+	  Report[0] = ReportID;
+
+	return Report;
+}
+
+/** Streaming parser callback, keeping a packed copy of each report item found. */
+static void StreamItemCallback(const HID_ReportItem_t* const ReportItem)
+{
+	if (TotalStreamedItems == MAX_STREAMED_ITEMS)
+	  return;
+
+	if (USB_PackHIDReportItem(ReportItem, &StreamedItems[TotalStreamedItems]))
+	  TotalStreamedItems++;
+}
+
+/** Extracts every stored report item of a full parse from, and writes it to, exactly sized report buffers. */
+static void FuzzReportInfo(HID_ReportInfo_t* const ParserData)
+{
+	for (uint8_t ItemIndex = 0; ItemIndex < ParserData->TotalReportItems; ItemIndex++)
+	{
+		HID_ReportItem_t* ReportItem = &ParserData->ReportItems[ItemIndex];
+		uint16_t          ReportSize = USB_GetHIDReportSize(ParserData, ReportItem->ReportID, ReportItem->ItemType);
+
+		uint8_t* Report = AllocateReport(ReportItem->ReportID, ReportSize);
+		USB_GetHIDReportItemInfo(Report, ReportItem);
+
+		memset(Report, 0x00, (ReportSize + (ReportItem->ReportID ? 1 : 0)));
+		USB_SetHIDReportItemInfo(Report, ReportItem);
+
+		HID_PackedReportItem_t PackedItem;
+		uint32_t               Value;
+
+		if (USB_PackHIDReportItem(ReportItem, &PackedItem))
+		  USB_GetHIDPackedReportItemValue(Report, &PackedItem, &Value);
+
+		free(Report);
+	}
+
+	#if defined(HID_EXTRACTION_PLANS)
+	int32_t Values[HID_MAX_REPORTITEMS];
+
+	for (uint8_t ReportIndex = 0; ReportIndex < ParserData->TotalDeviceReports; ReportIndex++)
+	{
+		uint8_t ReportID = ParserData->ReportIDSizes[ReportIndex].ReportID;
+
+		for (uint8_t ReportType = HID_REPORT_ITEM_In; ReportType <= HID_REPORT_ITEM_Feature; ReportType++)
+		{
+			uint16_t ReportSize = USB_GetHIDReportSize(ParserData, ReportID, ReportType);
+			uint8_t* Report     = AllocateReport(ReportID, ReportSize);
+
+			USB_GetHIDReportItemValues(ParserData, Report, (ReportSize + (ReportID ? 1 : 0)), ReportType, Values);
+
+			free(Report);
+		}
+	}
+	#endif
+}
+
+/** Extracts every report item gathered by a streaming parse from exactly sized report buffers. */
+static void FuzzReportLayout(const HID_ReportLayout_t* const Layout)
+{
+	for (uint8_t ItemIndex = 0; ItemIndex < TotalStreamedItems; ItemIndex++)
+	{
+		HID_PackedReportItem_t* PackedItem = &StreamedItems[ItemIndex];
+		uint16_t                ReportSize = USB_GetHIDReportLayoutSize(Layout, PackedItem->ReportID, PackedItem->ItemType);
+
+		uint8_t* Report = AllocateReport(PackedItem->ReportID, ReportSize);
+		uint32_t Value;
+
+		USB_GetHIDPackedReportItemValue(Report, PackedItem, &Value);
+
+		free(Report);
+	}
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t* Data,
+                           size_t Size)
+{
+	if (!(Size) || (Size > UINT16_MAX))
+	  return 0;
+
+	/* Parse from an exactly sized copy of the input, so that reads past the end of the descriptor are caught */
+	uint8_t* Descriptor = malloc(Size);
+	memcpy(Descriptor, Data, Size);
+
+	FuzzData = Descriptor;
+	FuzzSize = Size;
+
+	static HID_ReportInfo_t ParserData;
+	memset(&ParserData, 0x00, sizeof(ParserData));
+
+	if (USB_ProcessHIDReport(Descriptor, Size, &ParserData) == HID_PARSE_Successful)
+	  FuzzReportInfo(&ParserData);
+
+	static HID_ReportLayout_t Layout;
+	memset(&Layout, 0x00, sizeof(Layout));
+	TotalStreamedItems = 0;
+
+	if (USB_StreamHIDReport(Descriptor, Size, &Layout, StreamItemCallback) == HID_PARSE_Successful)
+	  FuzzReportLayout(&Layout);
+
+	free(Descriptor);
+	return 0;
+}
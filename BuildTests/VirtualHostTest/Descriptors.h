@@ -0,0 +1,69 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2018.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2018  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Header file for Descriptors.c, shared by the HID test applications of the virtual host test.
+ */
+
+#ifndef _DESCRIPTORS_H_
+#define _DESCRIPTORS_H_
+
+	/* Includes: */
+		#include <LUFA/Drivers/USB/USB.h>
+
+	/* Type Defines: */
+		/** Type define for the device configuration descriptor structure. */
+		typedef struct
+		{
+			USB_Descriptor_Configuration_Header_t Config;
+
+			USB_Descriptor_Interface_t            HID_Interface;
+			USB_HID_Descriptor_HID_t              HID_TestHID;
+			USB_Descriptor_Endpoint_t             HID_ReportINEndpoint;
+		} USB_Descriptor_Configuration_t;
+
+	/* Macros: */
+		/** Endpoint address of the HID reporting IN endpoint. */
+		#define HID_IN_EPADDR             (ENDPOINT_DIR_IN | 1)
+
+		/** Size in bytes of the HID reporting endpoint. */
+		#define HID_EPSIZE                8
+
+		/** Size in bytes of each input and output report, excluding the report ID. */
+		#define HID_REPORT_SIZE           4
+
+	/* Function Prototypes: */
+		uint16_t CALLBACK_USB_GetDescriptor(const uint16_t wValue,
+		                                    const uint16_t wIndex,
+		                                    const void** const DescriptorAddress)
+		                                    ATTR_WARN_UNUSED_RESULT ATTR_NON_NULL_PTR_ARG(3);
+
+#endif
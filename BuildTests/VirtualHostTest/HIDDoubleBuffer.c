@@ -0,0 +1,132 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2018.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2018  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  HID double buffered report test application for the virtual host test. Each output report received from the host
+ *  via a SET_REPORT request sets the state sent back in the input reports created by the HID class driver, which are
+ *  double buffered, so that the host script can check which created reports the driver sends.
+ */
+
+#include "Descriptors.h"
+
+/** Current state sent to the host in each input report, as set by the last output report from the host. */
+static uint8_t ReportState[HID_REPORT_SIZE];
+
+/** Buffer to hold the previously created HID report, for comparison purposes inside the HID class driver. */
+static uint8_t PrevHIDReportBuffer[HID_REPORT_SIZE];
+
+/** Buffer the HID class driver creates the next HID report in, swapped with the previous report buffer on each change. */
+static uint8_t HIDReportBuffer[HID_REPORT_SIZE];
+
+/** LUFA HID Class driver interface configuration and state information. */
+USB_ClassInfo_HID_Device_t DoubleBuffer_HID_Interface =
+	{
+		.Config =
+			{
+				.InterfaceNumber              = 0,
+				.ReportINEndpoint             =
+					{
+						.Address              = HID_IN_EPADDR,
+						.Size                 = HID_EPSIZE,
+						.Banks                = 1,
+					},
+				.PrevReportINBuffer           = PrevHIDReportBuffer,
+				.PrevReportINBufferSize       = sizeof(PrevHIDReportBuffer),
+				.ReportINBuffer               = HIDReportBuffer,
+			},
+	};
+
+
+/** Main program entry point. */
+int main(void)
+{
+	USB_Init();
+
+	GlobalInterruptEnable();
+
+	for (;;)
+	{
+		HID_Device_USBTask(&DoubleBuffer_HID_Interface);
+		USB_USBTask();
+	}
+}
+
+/** Event handler for the library USB Configuration Changed event. */
+void EVENT_USB_Device_ConfigurationChanged(void)
+{
+	HID_Device_ConfigureEndpoints(&DoubleBuffer_HID_Interface);
+
+	USB_Device_EnableSOFEvents();
+}
+
+/** Event handler for the library USB Control Request reception event. */
+void EVENT_USB_Device_ControlRequest(void)
+{
+	HID_Device_ProcessControlRequest(&DoubleBuffer_HID_Interface);
+}
+
+/** Event handler for the USB device Start Of Frame event. */
+void EVENT_USB_Device_StartOfFrame(void)
+{
+	HID_Device_MillisecondElapsed(&DoubleBuffer_HID_Interface);
+}
+
+/** HID class driver callback function for the creation of HID reports to the host, which writes the current state into
+ *  the report as a 16-bit field followed by two 8-bit fields.
+ */
+bool CALLBACK_HID_Device_CreateHIDReport(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo,
+                                         uint8_t* const ReportID,
+                                         const uint8_t ReportType,
+                                         void* ReportData,
+                                         uint16_t* const ReportSize)
+{
+	uint8_t* Data = (uint8_t*)ReportData;
+
+	HID_Device_UpdateReportINField(HIDInterfaceInfo, &Data[0], &ReportState[0], 2);
+	HID_Device_UpdateReportINField(HIDInterfaceInfo, &Data[2], &ReportState[2], 1);
+	HID_Device_UpdateReportINField(HIDInterfaceInfo, &Data[3], &ReportState[3], 1);
+
+	*ReportID   = 1;
+	*ReportSize = HID_REPORT_SIZE;
+	return false;
+}
+
+/** HID class driver callback function for the processing of HID reports from the host, which sets the state sent back
+ *  in the following input reports.
+ */
+void CALLBACK_HID_Device_ProcessHIDReport(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo,
+                                          const uint8_t ReportID,
+                                          const uint8_t ReportType,
+                                          const void* ReportData,
+                                          const uint16_t ReportSize)
+{
+	memcpy(ReportState, ReportData, MIN(ReportSize, sizeof(ReportState)));
+}
@@ -0,0 +1,126 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2018.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2018  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  HID report queue test application for the virtual host test. Each output report received from the host via a
+ *  SET_REPORT request is queued back to the host as an input report of the same report ID, so that the host script
+ *  can check which queued reports the HID class driver sends.
+ */
+
+#include "Descriptors.h"
+
+/** Maximum number of reports which may be waiting in the report queue. */
+#define QUEUE_DEPTH           4
+
+/** Buffer to hold the previously sent HID report, for comparison purposes inside the HID class driver. */
+static uint8_t PrevHIDReportBuffer[HID_REPORT_SIZE];
+
+/** Buffer holding the reports waiting in the HID class driver's report queue. */
+static uint8_t HIDReportQueueBuffer[HID_DEVICE_REPORT_QUEUE_BUFFER_SIZE(QUEUE_DEPTH, HID_REPORT_SIZE)];
+
+/** LUFA HID Class driver interface configuration and state information. */
+USB_ClassInfo_HID_Device_t Queue_HID_Interface =
+	{
+		.Config =
+			{
+				.InterfaceNumber              = 0,
+				.ReportINEndpoint             =
+					{
+						.Address              = HID_IN_EPADDR,
+						.Size                 = HID_EPSIZE,
+						.Banks                = 1,
+					},
+				.PrevReportINBuffer           = PrevHIDReportBuffer,
+				.PrevReportINBufferSize       = sizeof(PrevHIDReportBuffer),
+				.ReportQueueBuffer            = HIDReportQueueBuffer,
+				.ReportQueueDepth             = QUEUE_DEPTH,
+			},
+	};
+
+
+/** Main program entry point. */
+int main(void)
+{
+	USB_Init();
+
+	GlobalInterruptEnable();
+
+	for (;;)
+	{
+		HID_Device_USBTask(&Queue_HID_Interface);
+		USB_USBTask();
+	}
+}
+
+/** Event handler for the library USB Configuration Changed event. */
+void EVENT_USB_Device_ConfigurationChanged(void)
+{
+	HID_Device_ConfigureEndpoints(&Queue_HID_Interface);
+
+	USB_Device_EnableSOFEvents();
+}
+
+/** Event handler for the library USB Control Request reception event. */
+void EVENT_USB_Device_ControlRequest(void)
+{
+	HID_Device_ProcessControlRequest(&Queue_HID_Interface);
+}
+
+/** Event handler for the USB device Start Of Frame event. */
+void EVENT_USB_Device_StartOfFrame(void)
+{
+	HID_Device_MillisecondElapsed(&Queue_HID_Interface);
+}
+
+/** HID class driver callback function for the creation of HID reports to the host. No reports are created, as every
+ *  input report is queued from \ref CALLBACK_HID_Device_ProcessHIDReport().
+ */
+bool CALLBACK_HID_Device_CreateHIDReport(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo,
+                                         uint8_t* const ReportID,
+                                         const uint8_t ReportType,
+                                         void* ReportData,
+                                         uint16_t* const ReportSize)
+{
+	*ReportSize = 0;
+	return false;
+}
+
+/** HID class driver callback function for the processing of HID reports from the host, which queues each received
+ *  report back to the host under the same report ID.
+ */
+void CALLBACK_HID_Device_ProcessHIDReport(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo,
+                                          const uint8_t ReportID,
+                                          const uint8_t ReportType,
+                                          const void* ReportData,
+                                          const uint16_t ReportSize)
+{
+	HID_Device_QueueReport(HIDInterfaceInfo, ReportID, ReportData, ReportSize);
+}
@@ -41,24 +41,30 @@
 
 		#include <LUFA/Drivers/USB/USB.h>
 
-	/* Macros: */
-		/** Endpoint address of the first CDC interface's device-to-host data IN endpoint. */
-		#define CDC1_TX_EPADDR                 (ENDPOINT_DIR_IN  | 1)
-
-		/** Endpoint address of the first CDC interface's host-to-device data OUT endpoint. */
-		#define CDC1_RX_EPADDR                 (ENDPOINT_DIR_OUT | 2)
-
-		/** Endpoint address of the first CDC interface's device-to-host notification IN endpoint. */
-		#define CDC1_NOTIFICATION_EPADDR       (ENDPOINT_DIR_IN  | 3)
-
-		/** Endpoint address of the second CDC interface's device-to-host data IN endpoint. */
-		#define CDC2_TX_EPADDR                 (ENDPOINT_DIR_IN  | 4)
+		#include "Config/AppConfig.h"
 
-		/** Endpoint address of the second CDC interface's host-to-device data OUT endpoint. */
-		#define CDC2_RX_EPADDR                 (ENDPOINT_DIR_OUT | 5)
-
-		/** Endpoint address of the second CDC interface's device-to-host notification IN endpoint. */
-		#define CDC2_NOTIFICATION_EPADDR       (ENDPOINT_DIR_IN  | 6)
+	/* Macros: */
+		#if (ARCH == ARCH_XMEGA) || defined(__DOXYGEN__)
+			/** Endpoint address of the given CDC interface's device-to-host data IN endpoint. On the XMEGA architecture each
+			 *  endpoint number is bidirectional, so each interface's data IN and OUT endpoints share a single endpoint number.
+			 */
+			#define CDC_TX_EPADDR(Port)            (ENDPOINT_DIR_IN  | (((Port) * 2) + 1))
+
+			/** Endpoint address of the given CDC interface's host-to-device data OUT endpoint. */
+			#define CDC_RX_EPADDR(Port)            (ENDPOINT_DIR_OUT | (((Port) * 2) + 1))
+
+			/** Endpoint address of the given CDC interface's device-to-host notification IN endpoint. */
+			#define CDC_NOTIFICATION_EPADDR(Port)  (ENDPOINT_DIR_IN  | (((Port) * 2) + 2))
+		#else
+			#define CDC_TX_EPADDR(Port)            (ENDPOINT_DIR_IN  | (((Port) * 3) + 1))
+			#define CDC_RX_EPADDR(Port)            (ENDPOINT_DIR_OUT | (((Port) * 3) + 2))
+			#define CDC_NOTIFICATION_EPADDR(Port)  (ENDPOINT_DIR_IN  | (((Port) * 3) + 3))
+		#endif
+
+		/** Interface number of the given CDC interface's control interface. Each virtual serial port's data interface
+		 *  immediately follows its control interface.
+		 */
+		#define INTERFACE_ID_CDC_CCI(Port)     ((Port) * 2)
 
 		/** Size in bytes of the CDC device-to-host notification IN endpoints. */
 		#define CDC_NOTIFICATION_EPSIZE        8
@@ -66,6 +72,32 @@
 		/** Size in bytes of the CDC data IN and OUT endpoints. */
 		#define CDC_TXRX_EPSIZE                16
 
+		/** Expands the given initializer macro once for each of the \c CDC_TOTAL_PORTS virtual serial ports, passing it the
+		 *  index of each port, as a comma separated initializer list for an array of per-port elements.
+		 */
+		#define FOR_EACH_VIRTUAL_SERIAL_PORT(Initializer)  CONCAT_EXPANDED(VIRTUAL_SERIAL_PORTS_, CDC_TOTAL_PORTS)(Initializer)
+
+		/** Initializer for the complete set of descriptors of the given virtual serial port, within the configuration descriptor. */
+		#define VIRTUAL_SERIAL_FUNCTION(Port)  CDC_ACM_FUNCTION_DESCRIPTOR(INTERFACE_ID_CDC_CCI(Port),                              \
+		                                                                   CDC_NOTIFICATION_EPADDR(Port), CDC_NOTIFICATION_EPSIZE, \
+		                                                                   CDC_TX_EPADDR(Port), CDC_RX_EPADDR(Port), CDC_TXRX_EPSIZE)
+
+	/* Private Macros: */
+		#define VIRTUAL_SERIAL_PORTS_1(Initializer)        Initializer(0)
+		#define VIRTUAL_SERIAL_PORTS_2(Initializer)        VIRTUAL_SERIAL_PORTS_1(Initializer), Initializer(1)
+		#define VIRTUAL_SERIAL_PORTS_3(Initializer)        VIRTUAL_SERIAL_PORTS_2(Initializer), Initializer(2)
+		#define VIRTUAL_SERIAL_PORTS_4(Initializer)        VIRTUAL_SERIAL_PORTS_3(Initializer), Initializer(3)
+		#define VIRTUAL_SERIAL_PORTS_5(Initializer)        VIRTUAL_SERIAL_PORTS_4(Initializer), Initializer(4)
+		#define VIRTUAL_SERIAL_PORTS_6(Initializer)        VIRTUAL_SERIAL_PORTS_5(Initializer), Initializer(5)
+		#define VIRTUAL_SERIAL_PORTS_7(Initializer)        VIRTUAL_SERIAL_PORTS_6(Initializer), Initializer(6)
+
+	/* Preprocessor Checks: */
+		#if (CDC_TOTAL_PORTS < 1) || (CDC_TOTAL_PORTS > 7)
+			#error CDC_TOTAL_PORTS must be between 1 and 7.
+		#elif ((CDC_NOTIFICATION_EPADDR(CDC_TOTAL_PORTS - 1) & ~ENDPOINT_DIR_IN) >= ENDPOINT_TOTAL_ENDPOINTS)
+			#error The selected number of CDC ports requires more endpoints than are available on the target.
+		#endif
+
 	/* Type Defines: */
 		/** Type define for the device configuration descriptor structure. This must be defined in the
 		 *  application code, as the configuration descriptor contains several sub-descriptors which
@@ -75,45 +107,10 @@
 		{
 			USB_Descriptor_Configuration_Header_t    Config;
 
-			// First CDC Control Interface
-			USB_Descriptor_Interface_Association_t   CDC1_IAD;
-			USB_Descriptor_Interface_t               CDC1_CCI_Interface;
-			USB_CDC_Descriptor_FunctionalHeader_t    CDC1_Functional_Header;
-			USB_CDC_Descriptor_FunctionalACM_t       CDC1_Functional_ACM;
-			USB_CDC_Descriptor_FunctionalUnion_t     CDC1_Functional_Union;
-			USB_Descriptor_Endpoint_t                CDC1_ManagementEndpoint;
-
-			// First CDC Data Interface
-			USB_Descriptor_Interface_t               CDC1_DCI_Interface;
-			USB_Descriptor_Endpoint_t                CDC1_DataOutEndpoint;
-			USB_Descriptor_Endpoint_t                CDC1_DataInEndpoint;
-
-			// Second CDC Control Interface
-			USB_Descriptor_Interface_Association_t   CDC2_IAD;
-			USB_Descriptor_Interface_t               CDC2_CCI_Interface;
-			USB_CDC_Descriptor_FunctionalHeader_t    CDC2_Functional_Header;
-			USB_CDC_Descriptor_FunctionalACM_t       CDC2_Functional_ACM;
-			USB_CDC_Descriptor_FunctionalUnion_t     CDC2_Functional_Union;
-			USB_Descriptor_Endpoint_t                CDC2_ManagementEndpoint;
-
-			// Second CDC Data Interface
-			USB_Descriptor_Interface_t               CDC2_DCI_Interface;
-			USB_Descriptor_Endpoint_t                CDC2_DataOutEndpoint;
-			USB_Descriptor_Endpoint_t                CDC2_DataInEndpoint;
+			// CDC Control and Data Interfaces of each virtual serial port
+			USB_CDC_Descriptor_ACMFunction_t         CDC_Function[CDC_TOTAL_PORTS];
 		} USB_Descriptor_Configuration_t;
 
-		/** Enum for the device interface descriptor IDs within the device. Each interface descriptor
-		 *  should have a unique ID index associated with it, which can be used to refer to the
-		 *  interface from other descriptors.
-		 */
-		enum InterfaceDescriptors_t
-		{
-			INTERFACE_ID_CDC1_CCI = 0, /**< CDC1 CCI interface descriptor ID */
-			INTERFACE_ID_CDC1_DCI = 1, /**< CDC1 DCI interface descriptor ID */
-			INTERFACE_ID_CDC2_CCI = 2, /**< CDC2 CCI interface descriptor ID */
-			INTERFACE_ID_CDC2_DCI = 3, /**< CDC2 DCI interface descriptor ID */
-		};
-
 		/** Enum for the device string descriptor IDs within the device. Each string descriptor should
 		 *  have a unique ID index associated with it, which can be used to refer to the string from
 		 *  other descriptors.
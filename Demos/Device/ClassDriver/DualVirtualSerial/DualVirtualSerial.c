@@ -36,67 +36,14 @@
 
 #include "DualVirtualSerial.h"
 
-/** LUFA CDC Class driver interface configuration and state information. This structure is
- *  passed to all CDC Class driver functions, so that multiple instances of the same class
- *  within a device can be differentiated from one another. This is for the first CDC interface,
- *  which sends strings to the host for each joystick movement.
+/** LUFA CDC Class driver interface configuration and state information for each virtual serial port. These
+ *  structures are passed to all CDC Class driver functions, so that multiple instances of the same class
+ *  within a device can be differentiated from one another. The first CDC interface sends strings to the host
+ *  for each joystick movement, while the remaining interfaces echo back all received data from the host.
  */
-USB_ClassInfo_CDC_Device_t VirtualSerial1_CDC_Interface =
+USB_ClassInfo_CDC_Device_t VirtualSerial_CDC_Ports[CDC_TOTAL_PORTS] =
 	{
-		.Config =
-			{
-				.ControlInterfaceNumber   = INTERFACE_ID_CDC1_CCI,
-				.DataINEndpoint           =
-					{
-						.Address          = CDC1_TX_EPADDR,
-						.Size             = CDC_TXRX_EPSIZE,
-						.Banks            = 1,
-					},
-				.DataOUTEndpoint =
-					{
-						.Address          = CDC1_RX_EPADDR,
-						.Size             = CDC_TXRX_EPSIZE,
-						.Banks            = 1,
-					},
-				.NotificationEndpoint =
-					{
-						.Address          = CDC1_NOTIFICATION_EPADDR,
-						.Size             = CDC_NOTIFICATION_EPSIZE,
-						.Banks            = 1,
-					},
-			},
-	};
-
-/** LUFA CDC Class driver interface configuration and state information. This structure is
- *  passed to all CDC Class driver functions, so that multiple instances of the same class
- *  within a device can be differentiated from one another. This is for the second CDC interface,
- *  which echos back all received data from the host.
- */
-USB_ClassInfo_CDC_Device_t VirtualSerial2_CDC_Interface =
-	{
-		.Config =
-			{
-				.ControlInterfaceNumber   = INTERFACE_ID_CDC2_CCI,
-				.DataINEndpoint           =
-					{
-						.Address          = CDC2_TX_EPADDR,
-						.Size             = CDC_TXRX_EPSIZE,
-						.Banks            = 1,
-					},
-				.DataOUTEndpoint =
-					{
-						.Address          = CDC2_RX_EPADDR,
-						.Size             = CDC_TXRX_EPSIZE,
-						.Banks            = 1,
-					},
-				.NotificationEndpoint =
-					{
-						.Address          = CDC2_NOTIFICATION_EPADDR,
-						.Size             = CDC_NOTIFICATION_EPSIZE,
-						.Banks            = 1,
-					},
-
-			},
+		FOR_EACH_VIRTUAL_SERIAL_PORT(VIRTUAL_SERIAL_PORT)
 	};
 
 
@@ -115,15 +62,17 @@ int main(void)
 		CheckJoystickMovement();
 
 		/* Discard all received data on the first CDC interface */
-		CDC_Device_ReceiveByte(&VirtualSerial1_CDC_Interface);
+		CDC_Device_ReceiveByte(&VirtualSerial_CDC_Ports[0]);
 
-		/* Echo all received data on the second CDC interface */
-		int16_t ReceivedByte = CDC_Device_ReceiveByte(&VirtualSerial2_CDC_Interface);
-		if (!(ReceivedByte < 0))
-		  CDC_Device_SendByte(&VirtualSerial2_CDC_Interface, (uint8_t)ReceivedByte);
+		/* Echo all received data on the remaining CDC interfaces */
+		for (uint8_t PortIndex = 1; PortIndex < CDC_TOTAL_PORTS; PortIndex++)
+		{
+			int16_t ReceivedByte = CDC_Device_ReceiveByte(&VirtualSerial_CDC_Ports[PortIndex]);
+			if (!(ReceivedByte < 0))
+			  CDC_Device_SendByte(&VirtualSerial_CDC_Ports[PortIndex], (uint8_t)ReceivedByte);
+		}
 
-		CDC_Device_USBTask(&VirtualSerial1_CDC_Interface);
-		CDC_Device_USBTask(&VirtualSerial2_CDC_Interface);
+		CDC_Device_MultiPortUSBTask(VirtualSerial_CDC_Ports, CDC_TOTAL_PORTS);
 		USB_USBTask();
 	}
 }
@@ -182,7 +131,7 @@ void CheckJoystickMovement(void)
 	{
 		ActionSent = true;
 
-		CDC_Device_SendString(&VirtualSerial1_CDC_Interface, ReportString);
+		CDC_Device_SendString(&VirtualSerial_CDC_Ports[0], ReportString);
 	}
 }
 
@@ -203,8 +152,9 @@ void EVENT_USB_Device_ConfigurationChanged(void)
 {
 	bool ConfigSuccess = true;
 
-	ConfigSuccess &= CDC_Device_ConfigureEndpoints(&VirtualSerial1_CDC_Interface);
-	ConfigSuccess &= CDC_Device_ConfigureEndpoints(&VirtualSerial2_CDC_Interface);
+	ConfigSuccess &= CDC_Device_ConfigureMultiPortEndpoints(VirtualSerial_CDC_Ports, CDC_TOTAL_PORTS);
+
+	USB_Device_EnableSOFEvents();
 
 	LEDs_SetAllLEDs(ConfigSuccess ? LEDMASK_USB_READY : LEDMASK_USB_ERROR);
 }
@@ -212,8 +162,13 @@ void EVENT_USB_Device_ConfigurationChanged(void)
 /** Event handler for the library USB Control Request reception event. */
 void EVENT_USB_Device_ControlRequest(void)
 {
-	CDC_Device_ProcessControlRequest(&VirtualSerial1_CDC_Interface);
-	CDC_Device_ProcessControlRequest(&VirtualSerial2_CDC_Interface);
+	CDC_Device_ProcessMultiPortControlRequest(VirtualSerial_CDC_Ports, CDC_TOTAL_PORTS);
+}
+
+/** Event handler for the USB device Start Of Frame event. */
+void EVENT_USB_Device_StartOfFrame(void)
+{
+	CDC_Device_MultiPortMillisecondElapsed(VirtualSerial_CDC_Ports, CDC_TOTAL_PORTS);
 }
 
 /** CDC class driver callback function the processing of changes to the virtual
@@ -232,13 +187,4 @@ void EVENT_CDC_Device_ControLineStateChanged(USB_ClassInfo_CDC_Device_t *const C
 	bool HostReady = (CDCInterfaceInfo->State.ControlLineStates.HostToDevice & CDC_CONTROL_LINE_OUT_DTR) != 0;
 
 	(void)HostReady;
-
-	if (CDCInterfaceInfo == &VirtualSerial1_CDC_Interface)
-	{
-		// CDC interface 1's host is ready to send/receive data if HostReady is true
-	}
-	else
-	{
-		// CDC interface 2's host is ready to send/receive data if HostReady is true
-	}
 }
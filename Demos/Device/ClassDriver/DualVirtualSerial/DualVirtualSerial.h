@@ -63,6 +63,35 @@
 		/** LED mask for the library LED driver, to indicate that an error has occurred in the USB interface. */
 		#define LEDMASK_USB_ERROR        (LEDS_LED1 | LEDS_LED3)
 
+		/** Initializer for the CDC Class driver configuration of the given virtual serial port. */
+		#define VIRTUAL_SERIAL_PORT(Port)                                          \
+			{                                                                      \
+				.Config =                                                          \
+					{                                                              \
+						.ControlInterfaceNumber   = INTERFACE_ID_CDC_CCI(Port),    \
+						.DataINEndpoint           =                                \
+							{                                                      \
+								.Address          = CDC_TX_EPADDR(Port),           \
+								.Size             = CDC_TXRX_EPSIZE,               \
+								.Banks            = 1,                             \
+							},                                                     \
+						.DataOUTEndpoint =                                         \
+							{                                                      \
+								.Address          = CDC_RX_EPADDR(Port),           \
+								.Size             = CDC_TXRX_EPSIZE,               \
+								.Banks            = 1,                             \
+							},                                                     \
+						.NotificationEndpoint =                                    \
+							{                                                      \
+								.Address          = CDC_NOTIFICATION_EPADDR(Port), \
+								.Size             = CDC_NOTIFICATION_EPSIZE,       \
+								.Banks            = 1,                             \
+							},                                                     \
+						.FlushHoldFrames          = CDC_FLUSH_HOLD_FRAMES,         \
+						.FlushThreshold           = CDC_FLUSH_THRESHOLD,           \
+					},                                                             \
+			}
+
 	/* Function Prototypes: */
 		void SetupHardware(void);
 		void CheckJoystickMovement(void);
@@ -71,6 +100,7 @@
 		void EVENT_USB_Device_Disconnect(void);
 		void EVENT_USB_Device_ConfigurationChanged(void);
 		void EVENT_USB_Device_ControlRequest(void);
+		void EVENT_USB_Device_StartOfFrame(void);
 
 #endif
 
@@ -160,6 +160,20 @@ const USB_Descriptor_String_t PROGMEM ManufacturerString = USB_STRING_DESCRIPTOR
  */
 const USB_Descriptor_String_t PROGMEM ProductString = USB_STRING_DESCRIPTOR(L"LUFA Generic HID Demo");
 
+/** Table of the device's descriptors, located in FLASH memory, which is searched by the library to find the descriptor
+ *  requested by the host. Entries must be kept in ascending order of descriptor type, then descriptor number.
+ */
+const USB_Descriptor_TableEntry_t PROGMEM DescriptorTable[] =
+{
+	USB_DESCRIPTOR_TABLE_ENTRY(DTYPE_Device, 0, DeviceDescriptor),
+	USB_DESCRIPTOR_TABLE_ENTRY(DTYPE_Configuration, 0, ConfigurationDescriptor),
+	USB_DESCRIPTOR_TABLE_STRING(STRING_ID_Language, LanguageString),
+	USB_DESCRIPTOR_TABLE_STRING(STRING_ID_Manufacturer, ManufacturerString),
+	USB_DESCRIPTOR_TABLE_STRING(STRING_ID_Product, ProductString),
+	USB_DESCRIPTOR_TABLE_ENTRY(HID_DTYPE_HID, 0, ConfigurationDescriptor.HID_GenericHID),
+	USB_DESCRIPTOR_TABLE_ENTRY(HID_DTYPE_Report, 0, GenericReport),
+};
+
 /** This function is called by the library when in device mode, and must be overridden (see library "USB Descriptors"
  *  documentation) by the application code so that the address and size of a requested descriptor can be given
  *  to the USB library. When the device receives a Get Descriptor request on the control endpoint, this function
@@ -170,51 +184,7 @@ uint16_t CALLBACK_USB_GetDescriptor(const uint16_t wValue,
                                     const uint16_t wIndex,
                                     const void** const DescriptorAddress)
 {
-	const uint8_t  DescriptorType   = (wValue >> 8);
-	const uint8_t  DescriptorNumber = (wValue & 0xFF);
-
-	const void* Address = NULL;
-	uint16_t    Size    = NO_DESCRIPTOR;
-
-	switch (DescriptorType)
-	{
-		case DTYPE_Device:
-			Address = &DeviceDescriptor;
-			Size    = sizeof(USB_Descriptor_Device_t);
-			break;
-		case DTYPE_Configuration:
-			Address = &ConfigurationDescriptor;
-			Size    = sizeof(USB_Descriptor_Configuration_t);
-			break;
-		case DTYPE_String:
-			switch (DescriptorNumber)
-			{
-				case STRING_ID_Language:
-					Address = &LanguageString;
-					Size    = pgm_read_byte(&LanguageString.Header.Size);
-					break;
-				case STRING_ID_Manufacturer:
-					Address = &ManufacturerString;
-					Size    = pgm_read_byte(&ManufacturerString.Header.Size);
-					break;
-				case STRING_ID_Product:
-					Address = &ProductString;
-					Size    = pgm_read_byte(&ProductString.Header.Size);
-					break;
-			}
-
-			break;
-		case HID_DTYPE_HID:
-			Address = &ConfigurationDescriptor.HID_GenericHID;
-			Size    = sizeof(USB_HID_Descriptor_HID_t);
-			break;
-		case HID_DTYPE_Report:
-			Address = &GenericReport;
-			Size    = sizeof(GenericReport);
-			break;
-	}
-
-	*DescriptorAddress = Address;
-	return Size;
+	return USB_GetDescriptorFromTable(DescriptorTable, USB_DESCRIPTOR_TABLE_SIZE(DescriptorTable),
+	                                  wValue, wIndex, DescriptorAddress);
 }
 
@@ -39,6 +39,9 @@
 /** Buffer to hold the previously generated HID report, for comparison purposes inside the HID class driver. */
 static uint8_t PrevJoystickHIDReportBuffer[sizeof(USB_JoystickReport_Data_t)];
 
+/** Buffer the HID class driver creates the next HID report in, swapped with the previous report buffer on each change. */
+static uint8_t JoystickHIDReportBuffer[sizeof(USB_JoystickReport_Data_t)];
+
 /** LUFA HID Class driver interface configuration and state information. This structure is
  *  passed to all HID Class driver functions, so that multiple instances of the same class
  *  within a device can be differentiated from one another.
@@ -56,6 +59,7 @@ USB_ClassInfo_HID_Device_t Joystick_HID_Interface =
 					},
 				.PrevReportINBuffer           = PrevJoystickHIDReportBuffer,
 				.PrevReportINBufferSize       = sizeof(PrevJoystickHIDReportBuffer),
+				.ReportINBuffer               = JoystickHIDReportBuffer,
 			},
 	};
 
@@ -163,21 +167,32 @@ bool CALLBACK_HID_Device_CreateHIDReport(USB_ClassInfo_HID_Device_t* const HIDIn
 	uint8_t JoyStatus_LCL    = Joystick_GetStatus();
 	uint8_t ButtonStatus_LCL = Buttons_GetStatus();
 
+	int8_t  X      = 0;
+	int8_t  Y      = 0;
+	int8_t  Z      = 0;
+	uint8_t Button = 0;
+
 	if (JoyStatus_LCL & JOY_UP)
-	  JoystickReport->Y = -100;
+	  Y = -100;
 	else if (JoyStatus_LCL & JOY_DOWN)
-	  JoystickReport->Y =  100;
+	  Y =  100;
 
 	if (JoyStatus_LCL & JOY_LEFT)
-	  JoystickReport->X = -100;
+	  X = -100;
 	else if (JoyStatus_LCL & JOY_RIGHT)
-	  JoystickReport->X =  100;
+	  X =  100;
 
 	if (JoyStatus_LCL & JOY_PRESS)
-	  JoystickReport->Button |= (1 << 1);
+	  Button |= (1 << 1);
 
 	if (ButtonStatus_LCL & BUTTONS_BUTTON1)
-	  JoystickReport->Button |= (1 << 0);
+	  Button |= (1 << 0);
+
+	/* Every field of the double buffered report must be written via the driver, which tracks changes to the previous report */
+	HID_Device_UpdateReportINField(HIDInterfaceInfo, &JoystickReport->X, &X, sizeof(X));
+	HID_Device_UpdateReportINField(HIDInterfaceInfo, &JoystickReport->Y, &Y, sizeof(Y));
+	HID_Device_UpdateReportINField(HIDInterfaceInfo, &JoystickReport->Z, &Z, sizeof(Z));
+	HID_Device_UpdateReportINField(HIDInterfaceInfo, &JoystickReport->Button, &Button, sizeof(Button));
 
 	*ReportSize = sizeof(USB_JoystickReport_Data_t);
 	return false;
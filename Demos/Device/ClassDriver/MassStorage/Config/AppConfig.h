@@ -47,4 +47,25 @@
 
 	#define DISK_READ_ONLY            false
 
+	#if !defined(DISK_BACKEND)
+		#define DISK_BACKEND          DISK_BACKEND_DATAFLASH
+	#endif
+
+	#define SDCARD_CS_DDR             DDRB
+	#define SDCARD_CS_PORT            PORTB
+	#define SDCARD_CS_MASK            (1 << 4)
+
+	#if !defined(DATAFLASH_CACHE_PAGES)
+		#define DATAFLASH_CACHE_PAGES 0
+	#endif
+	#define DATAFLASH_CACHE_FLUSH_MS  500
+
+	#if !defined(DATAFLASH_READ_AHEAD)
+		#define DATAFLASH_READ_AHEAD  false
+	#endif
+
+	#if !defined(DATAFLASH_FTL)
+		#define DATAFLASH_FTL         false
+	#endif
+
 #endif
@@ -0,0 +1,108 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2018.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2018  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Block device interface between the SCSI layer and the storage medium backends. The backend is selected at
+ *  compile time by the \c DISK_BACKEND token in AppConfig.h; each backend provides the functions mapped to the
+ *  \c BlockDevice_* names below, so that further media may be added without changes to the SCSI layer.
+ */
+
+#ifndef _BLOCK_DEVICE_H_
+#define _BLOCK_DEVICE_H_
+
+	/* Macros: */
+		/** Value for the \c DISK_BACKEND token, selecting the board Dataflash IC(s) as the storage medium. */
+		#define DISK_BACKEND_DATAFLASH              0
+
+		/** Value for the \c DISK_BACKEND token, selecting a SD or MMC memory card attached to the SPI bus as the storage medium. */
+		#define DISK_BACKEND_SDCARD                 1
+
+		/** Block size of the device. This is kept at 512 to remain compatible with the OS despite the underlying
+		 *  storage media (such as the Dataflash) using a different native block size. Do not change this value.
+		 */
+		#define VIRTUAL_MEMORY_BLOCK_SIZE           512
+
+	/* Includes: */
+		#include "Config/AppConfig.h"
+
+		#if (DISK_BACKEND == DISK_BACKEND_DATAFLASH)
+			#include "DataflashManager.h"
+		#elif (DISK_BACKEND == DISK_BACKEND_SDCARD)
+			#include "SDCardManager.h"
+		#else
+			#error The selected DISK_BACKEND is not supported.
+		#endif
+
+	/* Macros: */
+		/* Mappings of the block device interface onto the selected backend. BlockDevice_Init() and
+		 * BlockDevice_CheckOperation() return \c false if the medium is not present or not working, while
+		 * BlockDevice_ReadBlocks() and BlockDevice_WriteBlocks() return \c false if the medium failed to complete
+		 * the transfer. The BLOCK_DEVICE_* tokens describe the backend to the SCSI layer.
+		 */
+		#if (DISK_BACKEND == DISK_BACKEND_DATAFLASH)
+			#define BlockDevice_Init()                  DataflashManager_Init()
+			#define BlockDevice_GetTotalBlocks()        VIRTUAL_MEMORY_BLOCKS
+			#define BlockDevice_CheckOperation()        DataflashManager_CheckDataflashOperation()
+			#define BlockDevice_Flush()                 DataflashManager_FlushCache()
+			#define BlockDevice_Task()                  DataflashManager_CacheTask()
+
+			#define BlockDevice_ReadBlocks(MSInterfaceInfo, BlockAddress, TotalBlocks)  \
+			        (DataflashManager_ReadBlocks(MSInterfaceInfo, BlockAddress, TotalBlocks), true)
+			#define BlockDevice_WriteBlocks(MSInterfaceInfo, BlockAddress, TotalBlocks) \
+			        (DataflashManager_WriteBlocks(MSInterfaceInfo, BlockAddress, TotalBlocks), true)
+
+			#define BLOCK_DEVICE_PRODUCT_ID             "Dataflash Disk"
+			#define BLOCK_DEVICE_WRITE_CACHE            (DATAFLASH_CACHE_PAGES > 0)
+			#define BLOCK_DEVICE_READ_AHEAD             DATAFLASH_READ_AHEAD
+			#define BLOCK_DEVICE_WEAR_LEVELLING         DATAFLASH_FTL
+		#elif (DISK_BACKEND == DISK_BACKEND_SDCARD)
+			#define BlockDevice_Init()                  SDCardManager_Init()
+			#define BlockDevice_GetTotalBlocks()        SDCardManager_GetTotalBlocks()
+			#define BlockDevice_CheckOperation()        SDCardManager_CheckCardOperation()
+			#define BlockDevice_Flush()                 do { } while (0)
+			#define BlockDevice_Task()                  do { } while (0)
+
+			#define BlockDevice_ReadBlocks(MSInterfaceInfo, BlockAddress, TotalBlocks)  \
+			        SDCardManager_ReadBlocks(MSInterfaceInfo, BlockAddress, TotalBlocks)
+			#define BlockDevice_WriteBlocks(MSInterfaceInfo, BlockAddress, TotalBlocks) \
+			        SDCardManager_WriteBlocks(MSInterfaceInfo, BlockAddress, TotalBlocks)
+
+			#define BLOCK_DEVICE_PRODUCT_ID             "SD Card Disk"
+			#define BLOCK_DEVICE_WRITE_CACHE            false
+			#define BLOCK_DEVICE_READ_AHEAD             false
+			#define BLOCK_DEVICE_WEAR_LEVELLING         false
+		#endif
+
+		/** Blocks in each LUN, calculated from the total capacity divided by the total number of Logical Units in the device. */
+		#define LUN_MEDIA_BLOCKS                    (BlockDevice_GetTotalBlocks() / TOTAL_LUNS)
+
+#endif
+
@@ -32,13 +32,166 @@
  *
  *  Functions to manage the physical Dataflash media, including reading and writing of
  *  blocks of data. These functions are called by the SCSI layer when data must be stored
- *  or retrieved to/from the physical storage media. If a different media is used (such
- *  as a SD card or EEPROM), functions similar to these will need to be generated.
+ *  or retrieved to/from the physical storage media. Other media (such as a SD card) are
+ *  provided by further backends behind the same block device interface, see BlockDevice.h.
  */
 
 #define  INCLUDE_FROM_DATAFLASHMANAGER_C
 #include "DataflashManager.h"
 
+#if (DISK_BACKEND == DISK_BACKEND_DATAFLASH)
+
+#if (DATAFLASH_CACHE_PAGES > 0)
+/** Write-back cache of recently written Dataflash pages, so that repeated writes to the same pages by the host (such as
+ *  updates to the file system metadata) are merged in SRAM rather than each reprogramming the Dataflash page.
+ */
+static DataflashManager_CachedPage_t CachedPages[DATAFLASH_CACHE_PAGES];
+
+/** Indexes of the cache slots in \ref CachedPages, ordered from the most to the least recently used. */
+static uint8_t CacheUseOrder[DATAFLASH_CACHE_PAGES];
+
+/** Indicates if any page in the cache has been modified since the cache was last flushed. */
+static bool CacheHasDirtyPages;
+
+/** USB frame number of the last host write into the cache, for the idle flush timeout. */
+static uint16_t CacheLastWriteFrame;
+#endif
+
+#if DATAFLASH_READ_AHEAD
+/** Dataflash page read ahead of the next expected sequential READ (10) command. The page's dirty flag is unused. */
+static DataflashManager_CachedPage_t ReadAheadPage;
+
+/** Indicates if the read-ahead page has been read since it was fetched, for the read-ahead statistics. */
+static bool ReadAheadPageUsed;
+
+/** Dataflash page scheduled to be read ahead by \ref DataflashManager_CacheTask(), or \ref DATAFLASH_CACHE_NO_PAGE if none. */
+static uint16_t ReadAheadPendingPage;
+#endif
+
+/** Sequential read-ahead statistics, retrieved via \ref DataflashManager_GetReadAheadStats(). */
+static DataflashManager_ReadAheadStats_t ReadAheadStats;
+
+/** Initializes the board Dataflash IC(s) for use as the storage medium, clearing any sector protections and starting
+ *  with an empty write-back page cache.
+ *
+ *  \return Boolean \c true if all Dataflash ICs are present and working and any translation layer page map was recovered,
+ *          \c false otherwise
+ */
+bool DataflashManager_Init(void)
+{
+	Dataflash_Init();
+
+	/* Check if the Dataflash is working, abort if not */
+	if (!(DataflashManager_CheckDataflashOperation()))
+	  return false;
+
+	/* Clear Dataflash sector protections, if enabled */
+	DataflashManager_ResetDataflashProtections();
+
+#if DATAFLASH_FTL
+	/* Rebuild the Dataflash translation layer's page map from the Dataflash contents, abort if it cannot be recovered */
+	if (!(DataflashFTL_Init()))
+	  return false;
+#endif
+
+	/* Start with an empty Dataflash write-back page cache */
+	DataflashManager_InitCache();
+
+	return true;
+}
+
+#if (DATAFLASH_CACHE_PAGES > 0)
+
+/** Writes blocks (OS blocks, not Dataflash pages) to the storage medium, the board Dataflash IC(s), from
+ *  the pre-selected data OUT endpoint. This routine reads in OS sized blocks from the endpoint and stores
+ *  them into the Dataflash write-back page cache, which later writes the modified pages to the Dataflash
+ *  when they are evicted or the cache is flushed.
+ *
+ *  \param[in] MSInterfaceInfo  Pointer to a structure containing a Mass Storage Class configuration and state
+ *  \param[in] BlockAddress  Data block starting address for the write sequence
+ *  \param[in] TotalBlocks   Number of blocks of data to write
+ */
+void DataflashManager_WriteBlocks(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo,
+                                  const uint32_t BlockAddress,
+                                  uint16_t TotalBlocks)
+{
+	uint16_t CurrDFPage     = ((BlockAddress * VIRTUAL_MEMORY_BLOCK_SIZE) / DATAFLASH_PAGE_SIZE);
+	uint16_t CurrDFPageByte = ((BlockAddress * VIRTUAL_MEMORY_BLOCK_SIZE) % DATAFLASH_PAGE_SIZE);
+	uint32_t BytesRemaining = ((uint32_t)TotalBlocks * VIRTUAL_MEMORY_BLOCK_SIZE);
+
+	/* Drop any read-ahead of the pages about to be written, as it would become stale */
+	DataflashManager_DiscardReadAhead(BlockAddress, TotalBlocks);
+
+	/* Wait until endpoint is ready before continuing */
+	if (Endpoint_WaitUntilReady())
+	  return;
+
+	while (BytesRemaining)
+	{
+		uint16_t BytesInPage = MIN(BytesRemaining, (DATAFLASH_PAGE_SIZE - CurrDFPageByte));
+		bool     IsNewPage   = false;
+
+		DataflashManager_CachedPage_t* CachedPage = DataflashManager_FindCachedPage(CurrDFPage);
+
+		/* On a cache miss, only fetch the existing page contents if they will not be entirely overwritten */
+		if (!(CachedPage))
+		{
+			IsNewPage  = (BytesInPage == DATAFLASH_PAGE_SIZE);
+			CachedPage = DataflashManager_AllocateCachedPage(CurrDFPage, !(IsNewPage));
+		}
+
+		uint8_t* PageDataPtr = &CachedPage->Data[CurrDFPageByte];
+		BytesRemaining -= BytesInPage;
+
+		/* Write the page's portion of the data into the cached page */
+		while (BytesInPage)
+		{
+			/* Check if the endpoint is currently empty */
+			if (!(Endpoint_IsReadWriteAllowed()))
+			{
+				/* Clear the current endpoint bank */
+				Endpoint_ClearOUT();
+
+				/* Wait until the host has sent another packet */
+				if (Endpoint_WaitUntilReady())
+				  break;
+			}
+
+			/* Write one 16-byte chunk of data to the cached page */
+			for (uint8_t ByteInChunk = 0; ByteInChunk < 16; ByteInChunk++)
+			  *(PageDataPtr++) = Endpoint_Read_8();
+
+			BytesInPage -= 16;
+
+			/* Check if the current command is being aborted by the host */
+			if (MSInterfaceInfo->State.IsMassStoreReset)
+			  break;
+		}
+
+		/* Discard a newly allocated page if the transfer was aborted before it was filled, as its contents are undefined */
+		if (BytesInPage && IsNewPage)
+		{
+			CachedPage->PageAddress = DATAFLASH_CACHE_NO_PAGE;
+			return;
+		}
+
+		CachedPage->Dirty   = true;
+		CacheHasDirtyPages  = true;
+		CacheLastWriteFrame = USB_Device_GetFrameNumber();
+
+		/* Stop if the transfer was aborted by the host */
+		if (BytesInPage || MSInterfaceInfo->State.IsMassStoreReset)
+		  return;
+
+		CurrDFPage++;
+		CurrDFPageByte = 0;
+	}
+
+	/* If the endpoint is empty, clear it ready for the next packet from the host */
+	if (!(Endpoint_IsReadWriteAllowed()))
+	  Endpoint_ClearOUT();
+}
+#else
 /** Writes blocks (OS blocks, not Dataflash pages) to the storage medium, the board Dataflash IC(s), from
  *  the pre-selected data OUT endpoint. This routine reads in OS sized blocks from the endpoint and writes
  *  them to the Dataflash in Dataflash page sized blocks.
@@ -56,14 +209,15 @@ void DataflashManager_WriteBlocks(USB_ClassInfo_MS_Device_t* const MSInterfaceIn
 	uint8_t  CurrDFPageByteDiv16 = (CurrDFPageByte >> 4);
 	bool     UsingSecondBuffer   = false;
 
-	/* Select the correct starting Dataflash IC for the block requested */
-	Dataflash_SelectChipFromPage(CurrDFPage);
+	/* Drop any read-ahead of the pages about to be written, as it would become stale */
+	DataflashManager_DiscardReadAhead(BlockAddress, TotalBlocks);
 
 #if (DATAFLASH_PAGE_SIZE > VIRTUAL_MEMORY_BLOCK_SIZE)
-	/* Copy selected dataflash's current page contents to the Dataflash buffer */
-	Dataflash_SendByte(DF_CMD_MAINMEMTOBUFF1);
-	Dataflash_SendAddressBytes(CurrDFPage, 0);
-	Dataflash_WaitWhileBusy();
+	/* Select the correct starting Dataflash IC and copy the page's current contents to the Dataflash buffer */
+	DataflashManager_LoadPageIntoBuffer(CurrDFPage, false);
+#else
+	/* Select the correct starting Dataflash IC for the block requested */
+	Dataflash_SelectChipFromPage(CurrDFPage);
 #endif
 
 	/* Send the Dataflash buffer write command */
@@ -97,8 +251,7 @@ void DataflashManager_WriteBlocks(USB_ClassInfo_MS_Device_t* const MSInterfaceIn
 			{
 				/* Write the Dataflash buffer contents back to the Dataflash page */
 				Dataflash_WaitWhileBusy();
-				Dataflash_SendByte(UsingSecondBuffer ? DF_CMD_BUFF2TOMAINMEMWITHERASE : DF_CMD_BUFF1TOMAINMEMWITHERASE);
-				Dataflash_SendAddressBytes(CurrDFPage, 0);
+				DataflashManager_ProgramBuffer(CurrDFPage, UsingSecondBuffer);
 
 				/* Reset the Dataflash buffer counter, increment the page counter */
 				CurrDFPageByteDiv16 = 0;
@@ -115,11 +268,8 @@ void DataflashManager_WriteBlocks(USB_ClassInfo_MS_Device_t* const MSInterfaceIn
 				/* If less than one Dataflash page remaining, copy over the existing page to preserve trailing data */
 				if ((TotalBlocks * (VIRTUAL_MEMORY_BLOCK_SIZE >> 4)) < (DATAFLASH_PAGE_SIZE >> 4))
 				{
-					/* Copy selected dataflash's current page contents to the Dataflash buffer */
-					Dataflash_WaitWhileBusy();
-					Dataflash_SendByte(UsingSecondBuffer ? DF_CMD_MAINMEMTOBUFF2 : DF_CMD_MAINMEMTOBUFF1);
-					Dataflash_SendAddressBytes(CurrDFPage, 0);
-					Dataflash_WaitWhileBusy();
+					/* Copy the page's current contents to the Dataflash buffer */
+					DataflashManager_LoadPageIntoBuffer(CurrDFPage, UsingSecondBuffer);
 				}
 #endif
 
@@ -163,8 +313,7 @@ void DataflashManager_WriteBlocks(USB_ClassInfo_MS_Device_t* const MSInterfaceIn
 
 	/* Write the Dataflash buffer contents back to the Dataflash page */
 	Dataflash_WaitWhileBusy();
-	Dataflash_SendByte(UsingSecondBuffer ? DF_CMD_BUFF2TOMAINMEMWITHERASE : DF_CMD_BUFF1TOMAINMEMWITHERASE);
-	Dataflash_SendAddressBytes(CurrDFPage, 0x00);
+	DataflashManager_ProgramBuffer(CurrDFPage, UsingSecondBuffer);
 	Dataflash_WaitWhileBusy();
 
 	/* If the endpoint is empty, clear it ready for the next packet from the host */
@@ -174,6 +323,7 @@ void DataflashManager_WriteBlocks(USB_ClassInfo_MS_Device_t* const MSInterfaceIn
 	/* Deselect all Dataflash chips */
 	Dataflash_DeselectChip();
 }
+#endif
 
 /** Reads blocks (OS blocks, not Dataflash pages) from the storage medium, the board Dataflash IC(s), into
  *  the pre-selected data IN endpoint. This routine reads in Dataflash page sized blocks from the Dataflash
@@ -191,16 +341,8 @@ void DataflashManager_ReadBlocks(USB_ClassInfo_MS_Device_t* const MSInterfaceInf
 	uint16_t CurrDFPageByte      = ((BlockAddress * VIRTUAL_MEMORY_BLOCK_SIZE) % DATAFLASH_PAGE_SIZE);
 	uint8_t  CurrDFPageByteDiv16 = (CurrDFPageByte >> 4);
 
-	/* Select the correct starting Dataflash IC for the block requested */
-	Dataflash_SelectChipFromPage(CurrDFPage);
-
-	/* Send the Dataflash main memory page read command */
-	Dataflash_SendByte(DF_CMD_MAINMEMPAGEREAD);
-	Dataflash_SendAddressBytes(CurrDFPage, CurrDFPageByte);
-	Dataflash_SendByte(0x00);
-	Dataflash_SendByte(0x00);
-	Dataflash_SendByte(0x00);
-	Dataflash_SendByte(0x00);
+	/* Start reading the first page, either from the write-back cache or from the Dataflash */
+	const uint8_t* CachedDataPtr = DataflashManager_BeginPageRead(CurrDFPage, CurrDFPageByte);
 
 	/* Wait until endpoint is ready before continuing */
 	if (Endpoint_WaitUntilReady())
@@ -231,35 +373,31 @@ void DataflashManager_ReadBlocks(USB_ClassInfo_MS_Device_t* const MSInterfaceInf
 				CurrDFPageByteDiv16 = 0;
 				CurrDFPage++;
 
-				/* Select the next Dataflash chip based on the new Dataflash page index */
-				Dataflash_SelectChipFromPage(CurrDFPage);
+				/* Start reading the next page, either from the write-back cache or from the Dataflash */
+				CachedDataPtr = DataflashManager_BeginPageRead(CurrDFPage, 0);
+			}
 
-				/* Send the Dataflash main memory page read command */
-				Dataflash_SendByte(DF_CMD_MAINMEMPAGEREAD);
-				Dataflash_SendAddressBytes(CurrDFPage, 0);
-				Dataflash_SendByte(0x00);
-				Dataflash_SendByte(0x00);
-				Dataflash_SendByte(0x00);
-				Dataflash_SendByte(0x00);
+			if (CachedDataPtr)
+			{
+				/* Copy one 16-byte chunk of data from the cached page */
+				for (uint8_t ByteInChunk = 0; ByteInChunk < 16; ByteInChunk++)
+				  Endpoint_Write_8(*(CachedDataPtr++));
 			}
+			else
+			{
+				/* Read one 16-byte chunk of data from the Dataflash, clocking in each byte while the previous one is
+				 * loaded into the endpoint bank so that the SPI transfers overlap the USB controller accesses */
+				Dataflash_BeginReceiveByte();
 
-			/* Read one 16-byte chunk of data from the Dataflash */
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
+				for (uint8_t ByteInChunk = 0; ByteInChunk < 15; ByteInChunk++)
+				{
+					uint8_t DataByte = Dataflash_EndReceiveByte();
+					Dataflash_BeginReceiveByte();
+					Endpoint_Write_8(DataByte);
+				}
+
+				Endpoint_Write_8(Dataflash_EndReceiveByte());
+			}
 
 			/* Increment the Dataflash page 16 byte block counter */
 			CurrDFPageByteDiv16++;
@@ -302,14 +440,16 @@ void DataflashManager_WriteBlocks_RAM(const uint32_t BlockAddress,
 	uint8_t  CurrDFPageByteDiv16 = (CurrDFPageByte >> 4);
 	bool     UsingSecondBuffer   = false;
 
-	/* Select the correct starting Dataflash IC for the block requested */
-	Dataflash_SelectChipFromPage(CurrDFPage);
+	/* Write back and discard the cached and read-ahead pages, so that they do not hold stale copies of the written pages */
+	DataflashManager_FlushCache();
+	DataflashManager_InitCache();
 
 #if (DATAFLASH_PAGE_SIZE > VIRTUAL_MEMORY_BLOCK_SIZE)
-	/* Copy selected dataflash's current page contents to the Dataflash buffer */
-	Dataflash_SendByte(DF_CMD_MAINMEMTOBUFF1);
-	Dataflash_SendAddressBytes(CurrDFPage, 0);
-	Dataflash_WaitWhileBusy();
+	/* Select the correct starting Dataflash IC and copy the page's current contents to the Dataflash buffer */
+	DataflashManager_LoadPageIntoBuffer(CurrDFPage, false);
+#else
+	/* Select the correct starting Dataflash IC for the block requested */
+	Dataflash_SelectChipFromPage(CurrDFPage);
 #endif
 
 	/* Send the Dataflash buffer write command */
@@ -328,8 +468,7 @@ void DataflashManager_WriteBlocks_RAM(const uint32_t BlockAddress,
 			{
 				/* Write the Dataflash buffer contents back to the Dataflash page */
 				Dataflash_WaitWhileBusy();
-				Dataflash_SendByte(UsingSecondBuffer ? DF_CMD_BUFF2TOMAINMEMWITHERASE : DF_CMD_BUFF1TOMAINMEMWITHERASE);
-				Dataflash_SendAddressBytes(CurrDFPage, 0);
+				DataflashManager_ProgramBuffer(CurrDFPage, UsingSecondBuffer);
 
 				/* Reset the Dataflash buffer counter, increment the page counter */
 				CurrDFPageByteDiv16 = 0;
@@ -346,11 +485,8 @@ void DataflashManager_WriteBlocks_RAM(const uint32_t BlockAddress,
 				/* If less than one Dataflash page remaining, copy over the existing page to preserve trailing data */
 				if ((TotalBlocks * (VIRTUAL_MEMORY_BLOCK_SIZE >> 4)) < (DATAFLASH_PAGE_SIZE >> 4))
 				{
-					/* Copy selected dataflash's current page contents to the Dataflash buffer */
-					Dataflash_WaitWhileBusy();
-					Dataflash_SendByte(UsingSecondBuffer ? DF_CMD_MAINMEMTOBUFF2 : DF_CMD_MAINMEMTOBUFF1);
-					Dataflash_SendAddressBytes(CurrDFPage, 0);
-					Dataflash_WaitWhileBusy();
+					/* Copy the page's current contents to the Dataflash buffer */
+					DataflashManager_LoadPageIntoBuffer(CurrDFPage, UsingSecondBuffer);
 				}
 #endif
 
@@ -377,8 +513,7 @@ void DataflashManager_WriteBlocks_RAM(const uint32_t BlockAddress,
 
 	/* Write the Dataflash buffer contents back to the Dataflash page */
 	Dataflash_WaitWhileBusy();
-	Dataflash_SendByte(UsingSecondBuffer ? DF_CMD_BUFF2TOMAINMEMWITHERASE : DF_CMD_BUFF1TOMAINMEMWITHERASE);
-	Dataflash_SendAddressBytes(CurrDFPage, 0x00);
+	DataflashManager_ProgramBuffer(CurrDFPage, UsingSecondBuffer);
 	Dataflash_WaitWhileBusy();
 
 	/* Deselect all Dataflash chips */
@@ -402,16 +537,13 @@ void DataflashManager_ReadBlocks_RAM(const uint32_t BlockAddress,
 	uint16_t CurrDFPageByte      = ((BlockAddress * VIRTUAL_MEMORY_BLOCK_SIZE) % DATAFLASH_PAGE_SIZE);
 	uint8_t  CurrDFPageByteDiv16 = (CurrDFPageByte >> 4);
 
-	/* Select the correct starting Dataflash IC for the block requested */
-	Dataflash_SelectChipFromPage(CurrDFPage);
+#if (DATAFLASH_CACHE_PAGES > 0)
+	/* Write back the cached pages, so that the Dataflash contents are current */
+	DataflashManager_FlushCache();
+#endif
 
-	/* Send the Dataflash main memory page read command */
-	Dataflash_SendByte(DF_CMD_MAINMEMPAGEREAD);
-	Dataflash_SendAddressBytes(CurrDFPage, CurrDFPageByte);
-	Dataflash_SendByte(0x00);
-	Dataflash_SendByte(0x00);
-	Dataflash_SendByte(0x00);
-	Dataflash_SendByte(0x00);
+	/* Select the correct starting Dataflash IC and send the Dataflash main memory page read command */
+	DataflashManager_SendPageReadCommand(CurrDFPage, CurrDFPageByte);
 
 	while (TotalBlocks)
 	{
@@ -427,16 +559,8 @@ void DataflashManager_ReadBlocks_RAM(const uint32_t BlockAddress,
 				CurrDFPageByteDiv16 = 0;
 				CurrDFPage++;
 
-				/* Select the next Dataflash chip based on the new Dataflash page index */
-				Dataflash_SelectChipFromPage(CurrDFPage);
-
-				/* Send the Dataflash main memory page read command */
-				Dataflash_SendByte(DF_CMD_MAINMEMPAGEREAD);
-				Dataflash_SendAddressBytes(CurrDFPage, 0);
-				Dataflash_SendByte(0x00);
-				Dataflash_SendByte(0x00);
-				Dataflash_SendByte(0x00);
-				Dataflash_SendByte(0x00);
+				/* Select the next Dataflash chip and send the Dataflash main memory page read command */
+				DataflashManager_SendPageReadCommand(CurrDFPage, 0);
 			}
 
 			/* Read one 16-byte chunk of data from the Dataflash */
@@ -532,3 +656,400 @@ bool DataflashManager_CheckDataflashOperation(void)
 	return true;
 }
 
+/** Initializes the Dataflash write-back page cache and read-ahead page, marking all cache slots as unused. Any modified
+ *  pages held in the cache are discarded, so \ref DataflashManager_FlushCache() should be called first if the cache may
+ *  hold modified pages.
+ */
+void DataflashManager_InitCache(void)
+{
+#if (DATAFLASH_CACHE_PAGES > 0)
+	for (uint8_t CacheSlot = 0; CacheSlot < DATAFLASH_CACHE_PAGES; CacheSlot++)
+	{
+		CachedPages[CacheSlot].PageAddress = DATAFLASH_CACHE_NO_PAGE;
+		CachedPages[CacheSlot].Dirty       = false;
+		CacheUseOrder[CacheSlot]           = CacheSlot;
+	}
+
+	CacheHasDirtyPages = false;
+#endif
+
+#if DATAFLASH_READ_AHEAD
+	ReadAheadPage.PageAddress = DATAFLASH_CACHE_NO_PAGE;
+	ReadAheadPendingPage      = DATAFLASH_CACHE_NO_PAGE;
+#endif
+}
+
+/** Writes all modified pages held in the Dataflash write-back page cache to the Dataflash, and waits until the Dataflash
+ *  ICs have finished programming them. The pages remain in the cache for subsequent reads and writes.
+ */
+void DataflashManager_FlushCache(void)
+{
+#if (DATAFLASH_CACHE_PAGES > 0)
+	for (uint8_t CacheSlot = 0; CacheSlot < DATAFLASH_CACHE_PAGES; CacheSlot++)
+	{
+		if (CachedPages[CacheSlot].Dirty)
+		  DataflashManager_WriteCachedPage(&CachedPages[CacheSlot]);
+	}
+
+	/* Wait until the Dataflash ICs have finished programming the written back pages */
+	Dataflash_SelectChip(DATAFLASH_CHIP1);
+	Dataflash_WaitWhileBusy();
+
+	#if (DATAFLASH_TOTALCHIPS == 2)
+	Dataflash_SelectChip(DATAFLASH_CHIP2);
+	Dataflash_WaitWhileBusy();
+	#endif
+
+	Dataflash_DeselectChip();
+
+	CacheHasDirtyPages = false;
+#endif
+}
+
+/** Task to manage the Dataflash write-back page cache and read-ahead page, which should be called frequently from the main
+ *  program loop. This flushes the cache once the host has not written to it for \c DATAFLASH_CACHE_FLUSH_MS milliseconds,
+ *  or as soon as the device is no longer in the configured state (for example, when it is suspended or detached from the
+ *  host). Any page scheduled by \ref DataflashManager_ReadAhead() is then read into the read-ahead page, overlapping the
+ *  Dataflash access with the host's handling of the completed command. Finally, the background task of the Dataflash
+ *  translation layer is run, if enabled.
+ */
+void DataflashManager_CacheTask(void)
+{
+#if (DATAFLASH_CACHE_PAGES > 0)
+	if (CacheHasDirtyPages)
+	{
+		/* Frame numbers are 11 bits wide and increment once per millisecond while the bus is active */
+		uint16_t IdleFrames = ((USB_Device_GetFrameNumber() - CacheLastWriteFrame) & 0x07FF);
+
+		if ((USB_DeviceState != DEVICE_STATE_Configured) || (IdleFrames >= DATAFLASH_CACHE_FLUSH_MS))
+		  DataflashManager_FlushCache();
+	}
+#endif
+
+#if DATAFLASH_READ_AHEAD
+	if (ReadAheadPendingPage != DATAFLASH_CACHE_NO_PAGE)
+	{
+		uint8_t* DataPtr = ReadAheadPage.Data;
+
+		if ((ReadAheadPage.PageAddress != DATAFLASH_CACHE_NO_PAGE) && !(ReadAheadPageUsed))
+		  ReadAheadStats.PagesDiscarded++;
+
+		DataflashManager_SendPageReadCommand(ReadAheadPendingPage, 0);
+
+		for (uint16_t ByteNum = 0; ByteNum < DATAFLASH_PAGE_SIZE; ByteNum++)
+		  *(DataPtr++) = Dataflash_ReceiveByte();
+
+		Dataflash_DeselectChip();
+
+		ReadAheadPage.PageAddress = ReadAheadPendingPage;
+		ReadAheadPageUsed         = false;
+		ReadAheadPendingPage      = DATAFLASH_CACHE_NO_PAGE;
+
+		ReadAheadStats.PagesPrefetched++;
+	}
+#endif
+#if DATAFLASH_FTL
+	/* Erase unused Dataflash pages ahead of time and level the Dataflash wear between host commands */
+	DataflashFTL_Task();
+#endif
+}
+
+/** Schedules the Dataflash page holding the given block to be read ahead into SRAM by the next call to
+ *  \ref DataflashManager_CacheTask(). This should be called by the SCSI layer once it detects that the host is reading
+ *  the medium sequentially, with the block address following the last block read.
+ *
+ *  \param[in] BlockAddress  Data block address expected to be read next by the host
+ */
+void DataflashManager_ReadAhead(const uint32_t BlockAddress)
+{
+#if DATAFLASH_READ_AHEAD
+	uint16_t PageAddress = ((BlockAddress * VIRTUAL_MEMORY_BLOCK_SIZE) / DATAFLASH_PAGE_SIZE);
+
+	/* Ignore reads past the end of the medium, or of a page that has already been read ahead */
+	if ((BlockAddress >= VIRTUAL_MEMORY_BLOCKS) || (PageAddress == ReadAheadPage.PageAddress))
+	  return;
+
+	#if (DATAFLASH_CACHE_PAGES > 0)
+	/* Pages held in the write-back cache are already served from SRAM */
+	for (uint8_t CacheSlot = 0; CacheSlot < DATAFLASH_CACHE_PAGES; CacheSlot++)
+	{
+		if (CachedPages[CacheSlot].PageAddress == PageAddress)
+		  return;
+	}
+	#endif
+
+	ReadAheadPendingPage = PageAddress;
+#endif
+}
+
+/** Retrieves the sequential read-ahead statistics. The SCSI layer updates the READ (10) command counts directly.
+ *
+ *  \return Pointer to the read-ahead statistics.
+ */
+DataflashManager_ReadAheadStats_t* DataflashManager_GetReadAheadStats(void)
+{
+	return &ReadAheadStats;
+}
+
+/** Retrieves the physical Dataflash page holding the given page of the storage medium. With the Dataflash translation
+ *  layer enabled the pages are moved on each write, otherwise each page of the medium is held in the Dataflash page of
+ *  the same address.
+ *
+ *  \param[in] PageAddress  Page of the storage medium to locate
+ *
+ *  \return Physical Dataflash page holding the page
+ */
+static inline uint16_t DataflashManager_GetPhysicalPage(const uint16_t PageAddress)
+{
+#if DATAFLASH_FTL
+	return DataflashFTL_GetPhysicalPage(PageAddress);
+#else
+	return PageAddress;
+#endif
+}
+
+/** Selects the Dataflash IC holding the given page and copies the page's current contents into one of its Dataflash
+ *  buffers, so that part of the page can be rewritten. The Dataflash IC remains selected.
+ *
+ *  \param[in] PageAddress      Dataflash page to copy
+ *  \param[in] UseSecondBuffer  Indicates if the page is to be copied into the second Dataflash buffer rather than the first
+ */
+static void DataflashManager_LoadPageIntoBuffer(const uint16_t PageAddress,
+                                                const bool UseSecondBuffer)
+{
+	uint16_t PhysicalPage = DataflashManager_GetPhysicalPage(PageAddress);
+
+	/* Select the correct Dataflash IC for the page requested, wait until it is idle */
+	Dataflash_SelectChipFromPage(PhysicalPage);
+	Dataflash_WaitWhileBusy();
+
+	Dataflash_SendByte(UseSecondBuffer ? DF_CMD_MAINMEMTOBUFF2 : DF_CMD_MAINMEMTOBUFF1);
+	Dataflash_SendAddressBytes(PhysicalPage, 0);
+	Dataflash_WaitWhileBusy();
+}
+
+/** Programs the contents of one of the Dataflash buffers of the selected Dataflash IC into the given page. With the
+ *  Dataflash translation layer enabled the contents are written to a fresh physical page, otherwise the page is erased
+ *  and reprogrammed in place. The programming is started but not waited for, and the Dataflash IC remains selected.
+ *
+ *  \param[in] PageAddress      Dataflash page to write
+ *  \param[in] UseSecondBuffer  Indicates if the contents are held in the second Dataflash buffer rather than the first
+ */
+static void DataflashManager_ProgramBuffer(const uint16_t PageAddress,
+                                           const bool UseSecondBuffer)
+{
+#if DATAFLASH_FTL
+	DataflashFTL_ProgramBuffer(PageAddress, UseSecondBuffer);
+#else
+	Dataflash_ToggleSelectedChipCS();
+	Dataflash_SendByte(UseSecondBuffer ? DF_CMD_BUFF2TOMAINMEMWITHERASE : DF_CMD_BUFF1TOMAINMEMWITHERASE);
+	Dataflash_SendAddressBytes(PageAddress, 0);
+	Dataflash_ToggleSelectedChipCS();
+#endif
+}
+
+/** Selects the Dataflash IC holding the given page and sends the main memory page read command, so that the page contents
+ *  can be read out starting from the given byte within the page.
+ *
+ *  \param[in] PageAddress  Dataflash page to read
+ *  \param[in] PageByte     Byte within the page to start reading from
+ */
+static void DataflashManager_SendPageReadCommand(const uint16_t PageAddress,
+                                                 const uint16_t PageByte)
+{
+	uint16_t PhysicalPage = DataflashManager_GetPhysicalPage(PageAddress);
+
+	/* Select the correct Dataflash IC for the page requested */
+	Dataflash_SelectChipFromPage(PhysicalPage);
+
+#if (DATAFLASH_CACHE_PAGES > 0) || DATAFLASH_FTL
+	/* Pages are programmed and erased in the background, wait until the Dataflash IC is idle */
+	Dataflash_WaitWhileBusy();
+#endif
+
+	/* Send the Dataflash main memory page read command */
+	Dataflash_SendByte(DF_CMD_MAINMEMPAGEREAD);
+	Dataflash_SendAddressBytes(PhysicalPage, PageByte);
+	Dataflash_SendByte(0x00);
+	Dataflash_SendByte(0x00);
+	Dataflash_SendByte(0x00);
+	Dataflash_SendByte(0x00);
+}
+
+/** Starts reading the given Dataflash page from the given byte within the page. If the page is held in the write-back
+ *  page cache the cached copy is returned, otherwise the page read command is sent to the Dataflash IC holding the page
+ *  so that its contents can be received from the Dataflash.
+ *
+ *  \param[in] PageAddress  Dataflash page to read
+ *  \param[in] PageByte     Byte within the page to start reading from
+ *
+ *  \return Pointer to the starting byte within the cached page, or \c NULL if the page must be read from the Dataflash.
+ */
+static const uint8_t* DataflashManager_BeginPageRead(const uint16_t PageAddress,
+                                                     const uint16_t PageByte)
+{
+#if (DATAFLASH_CACHE_PAGES > 0)
+	DataflashManager_CachedPage_t* CachedPage = DataflashManager_FindCachedPage(PageAddress);
+
+	if (CachedPage)
+	{
+		/* End any read in progress from the previous page */
+		Dataflash_DeselectChip();
+
+		return &CachedPage->Data[PageByte];
+	}
+#endif
+
+#if DATAFLASH_READ_AHEAD
+	if (PageAddress == ReadAheadPage.PageAddress)
+	{
+		/* End any read in progress from the previous page */
+		Dataflash_DeselectChip();
+
+		ReadAheadPageUsed = true;
+		ReadAheadStats.PagesHit++;
+
+		return &ReadAheadPage.Data[PageByte];
+	}
+#endif
+
+	DataflashManager_SendPageReadCommand(PageAddress, PageByte);
+	return NULL;
+}
+
+/** Discards the read-ahead page, and cancels any scheduled read-ahead, if it lies within the given range of blocks. This
+ *  must be called before the blocks are written, so that later reads do not return the stale read-ahead page contents.
+ *
+ *  \param[in] BlockAddress  Data block starting address of the write sequence
+ *  \param[in] TotalBlocks   Number of blocks of data to be written
+ */
+static void DataflashManager_DiscardReadAhead(const uint32_t BlockAddress,
+                                              const uint16_t TotalBlocks)
+{
+#if DATAFLASH_READ_AHEAD
+	uint16_t FirstPage = ((BlockAddress * VIRTUAL_MEMORY_BLOCK_SIZE) / DATAFLASH_PAGE_SIZE);
+	uint16_t LastPage  = ((((BlockAddress + TotalBlocks) * VIRTUAL_MEMORY_BLOCK_SIZE) - 1) / DATAFLASH_PAGE_SIZE);
+
+	if (!(TotalBlocks))
+	  return;
+
+	if ((ReadAheadPage.PageAddress >= FirstPage) && (ReadAheadPage.PageAddress <= LastPage))
+	{
+		if (!(ReadAheadPageUsed))
+		  ReadAheadStats.PagesDiscarded++;
+
+		ReadAheadPage.PageAddress = DATAFLASH_CACHE_NO_PAGE;
+	}
+
+	if ((ReadAheadPendingPage >= FirstPage) && (ReadAheadPendingPage <= LastPage))
+	  ReadAheadPendingPage = DATAFLASH_CACHE_NO_PAGE;
+#endif
+}
+
+#if (DATAFLASH_CACHE_PAGES > 0)
+/** Moves the given cache slot to the head of the cache use order, marking it as the most recently used slot.
+ *
+ *  \param[in] CacheSlot  Index of the cache slot that was used
+ */
+static void DataflashManager_MarkCacheSlotUsed(const uint8_t CacheSlot)
+{
+	uint8_t OrderIndex = 0;
+
+	while (CacheUseOrder[OrderIndex] != CacheSlot)
+	  OrderIndex++;
+
+	/* Shift the more recently used slots down by one to make room at the head of the list */
+	while (OrderIndex)
+	{
+		CacheUseOrder[OrderIndex] = CacheUseOrder[OrderIndex - 1];
+		OrderIndex--;
+	}
+
+	CacheUseOrder[0] = CacheSlot;
+}
+
+/** Searches the write-back page cache for the given Dataflash page, marking it as the most recently used page if found.
+ *
+ *  \param[in] PageAddress  Dataflash page to search for
+ *
+ *  \return Pointer to the cache slot holding the page, or \c NULL if the page is not cached.
+ */
+static DataflashManager_CachedPage_t* DataflashManager_FindCachedPage(const uint16_t PageAddress)
+{
+	for (uint8_t CacheSlot = 0; CacheSlot < DATAFLASH_CACHE_PAGES; CacheSlot++)
+	{
+		if (CachedPages[CacheSlot].PageAddress == PageAddress)
+		{
+			DataflashManager_MarkCacheSlotUsed(CacheSlot);
+			return &CachedPages[CacheSlot];
+		}
+	}
+
+	return NULL;
+}
+
+/** Allocates a cache slot for the given Dataflash page, evicting the least recently used page from the cache. If the
+ *  evicted page has been modified it is written back to the Dataflash first.
+ *
+ *  \param[in] PageAddress    Dataflash page to allocate a cache slot for
+ *  \param[in] FetchContents  If \c true the existing page contents are read from the Dataflash into the slot, otherwise
+ *                            the slot contents are left undefined for the caller to overwrite in full
+ *
+ *  \return Pointer to the cache slot allocated to the page.
+ */
+static DataflashManager_CachedPage_t* DataflashManager_AllocateCachedPage(const uint16_t PageAddress,
+                                                                          const bool FetchContents)
+{
+	uint8_t CacheSlot = CacheUseOrder[DATAFLASH_CACHE_PAGES - 1];
+	DataflashManager_CachedPage_t* CachedPage = &CachedPages[CacheSlot];
+
+	if (CachedPage->Dirty)
+	  DataflashManager_WriteCachedPage(CachedPage);
+
+	CachedPage->PageAddress = PageAddress;
+	DataflashManager_MarkCacheSlotUsed(CacheSlot);
+
+	if (FetchContents)
+	{
+		uint8_t* DataPtr = CachedPage->Data;
+
+		DataflashManager_SendPageReadCommand(PageAddress, 0);
+
+		for (uint16_t ByteNum = 0; ByteNum < DATAFLASH_PAGE_SIZE; ByteNum++)
+		  *(DataPtr++) = Dataflash_ReceiveByte();
+
+		Dataflash_DeselectChip();
+	}
+
+	return CachedPage;
+}
+
+/** Writes a modified cached page back to the Dataflash. The page programming is started but not waited for, so that it
+ *  can proceed in the background; the Dataflash IC is waited on before it is next accessed.
+ *
+ *  \param[in,out] CachedPage  Cache slot holding the page to write back
+ */
+static void DataflashManager_WriteCachedPage(DataflashManager_CachedPage_t* const CachedPage)
+{
+	const uint8_t* DataPtr = CachedPage->Data;
+
+	/* Select the Dataflash IC holding the page, wait until any previous page programming has completed */
+	Dataflash_SelectChipFromPage(CachedPage->PageAddress);
+	Dataflash_WaitWhileBusy();
+
+	/* Load the page contents into the Dataflash buffer */
+	Dataflash_SendByte(DF_CMD_BUFF1WRITE);
+	Dataflash_SendAddressBytes(0, 0);
+
+	for (uint16_t ByteNum = 0; ByteNum < DATAFLASH_PAGE_SIZE; ByteNum++)
+	  Dataflash_SendByte(*(DataPtr++));
+
+	/* Program the Dataflash buffer contents into the page, which continues after the chip is deselected */
+	DataflashManager_ProgramBuffer(CachedPage->PageAddress, false);
+	Dataflash_DeselectChip();
+
+	CachedPage->Dirty = false;
+}
+#endif
+
+#endif
@@ -41,35 +41,78 @@
 
 		#include "../MassStorage.h"
 		#include "../Descriptors.h"
+		#include "BlockDevice.h"
 		#include "Config/AppConfig.h"
 
 		#include <LUFA/Common/Common.h>
 		#include <LUFA/Drivers/USB/USB.h>
 		#include <LUFA/Drivers/Board/Dataflash.h>
 
+		#if DATAFLASH_FTL
+			#include <LUFA/Drivers/Misc/DataflashFTL.h>
+		#endif
+
+	/* Private Interface - For use in library only: */
+	#if !defined(__DOXYGEN__)
+		/* Macros: */
+			#define DATAFLASH_PAGE_BUFFER_BYTES     ((DATAFLASH_CACHE_PAGES + (DATAFLASH_READ_AHEAD ? 1 : 0)) * \
+			                                         (DATAFLASH_PAGE_SIZE + 3))
+			#define DATAFLASH_RESERVED_RAM_BYTES    1024
+	#endif
+
 	/* Preprocessor Checks: */
 		#if (DATAFLASH_PAGE_SIZE % 16)
 			#error Dataflash page size must be a multiple of 16 bytes.
 		#endif
 
-	/* Defines: */
-		/** Total number of bytes of the storage medium, comprised of one or more Dataflash ICs. */
-		#define VIRTUAL_MEMORY_BYTES                ((uint32_t)DATAFLASH_PAGES * DATAFLASH_PAGE_SIZE * DATAFLASH_TOTALCHIPS)
+		#if ((DATAFLASH_CACHE_PAGES > 0) && (DATAFLASH_CACHE_FLUSH_MS > 2047))
+			#error The Dataflash cache flush timeout must not exceed 2047 milliseconds.
+		#endif
 
-		/** Block size of the device. This is kept at 512 to remain compatible with the OS despite the underlying
-		 *  storage media (Dataflash) using a different native block size. Do not change this value.
-		 */
-		#define VIRTUAL_MEMORY_BLOCK_SIZE           512
+		#if defined(RAMSTART) && defined(RAMEND)
+			#if (DATAFLASH_PAGE_BUFFER_BYTES > ((RAMEND - RAMSTART + 1) - DATAFLASH_RESERVED_RAM_BYTES))
+				#error The Dataflash page cache and read-ahead buffers exceed the available SRAM of the selected target.
+			#endif
+		#endif
+
+	/* Defines: */
+		#if DATAFLASH_FTL
+			/** Total number of bytes of the storage medium, comprised of the logical pages of the Dataflash translation layer. */
+			#define VIRTUAL_MEMORY_BYTES            ((uint32_t)DATAFLASH_FTL_LOGICAL_PAGES * DATAFLASH_PAGE_SIZE)
+		#else
+			/** Total number of bytes of the storage medium, comprised of one or more Dataflash ICs. */
+			#define VIRTUAL_MEMORY_BYTES            ((uint32_t)DATAFLASH_PAGES * DATAFLASH_PAGE_SIZE * DATAFLASH_TOTALCHIPS)
+		#endif
 
 		/** Total number of blocks of the virtual memory for reporting to the host as the device's total capacity. Do not
 		 *  change this value; change VIRTUAL_MEMORY_BYTES instead to alter the media size.
 		 */
 		#define VIRTUAL_MEMORY_BLOCKS               (VIRTUAL_MEMORY_BYTES / VIRTUAL_MEMORY_BLOCK_SIZE)
 
-		/** Blocks in each LUN, calculated from the total capacity divided by the total number of Logical Units in the device. */
-		#define LUN_MEDIA_BLOCKS                    (VIRTUAL_MEMORY_BLOCKS / TOTAL_LUNS)
+		/** Page address of a Dataflash page cache slot which does not currently hold a page. */
+		#define DATAFLASH_CACHE_NO_PAGE             0xFFFF
+
+	/* Type Defines: */
+		/** Type define for a single slot of the Dataflash write-back page cache. */
+		typedef struct
+		{
+			uint16_t PageAddress; /**< Dataflash page held in the slot, or \ref DATAFLASH_CACHE_NO_PAGE if unused. */
+			bool     Dirty; /**< Indicates if the page has been modified since it was last written to the Dataflash. */
+			uint8_t  Data[DATAFLASH_PAGE_SIZE]; /**< Contents of the cached Dataflash page. */
+		} DataflashManager_CachedPage_t;
+
+		/** Type define for the sequential read-ahead statistics, reported to the host via a vendor specific SCSI command. */
+		typedef struct
+		{
+			uint32_t ReadCommands; /**< Total number of READ (10) commands issued by the host. */
+			uint32_t SequentialReads; /**< Number of READ (10) commands starting at the block following the previous one. */
+			uint32_t PagesPrefetched; /**< Number of Dataflash pages read ahead of an expected sequential READ (10) command. */
+			uint32_t PagesHit; /**< Number of page reads served from the read-ahead page. */
+			uint32_t PagesDiscarded; /**< Number of read-ahead pages replaced or invalidated before being read. */
+		} DataflashManager_ReadAheadStats_t;
 
 	/* Function Prototypes: */
+		bool DataflashManager_Init(void);
 		void DataflashManager_WriteBlocks(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo,
 		                                  const uint32_t BlockAddress,
 		                                  uint16_t TotalBlocks);
@@ -84,6 +127,34 @@
 		                                     uint8_t* BufferPtr) ATTR_NON_NULL_PTR_ARG(3);
 		void DataflashManager_ResetDataflashProtections(void);
 		bool DataflashManager_CheckDataflashOperation(void);
+		void DataflashManager_InitCache(void);
+		void DataflashManager_FlushCache(void);
+		void DataflashManager_CacheTask(void);
+		void DataflashManager_ReadAhead(const uint32_t BlockAddress);
+		DataflashManager_ReadAheadStats_t* DataflashManager_GetReadAheadStats(void) ATTR_WARN_UNUSED_RESULT ATTR_CONST;
+
+		#if defined(INCLUDE_FROM_DATAFLASHMANAGER_C) && (DISK_BACKEND == DISK_BACKEND_DATAFLASH)
+			static inline uint16_t DataflashManager_GetPhysicalPage(const uint16_t PageAddress) ATTR_ALWAYS_INLINE;
+			static void DataflashManager_LoadPageIntoBuffer(const uint16_t PageAddress,
+			                                                const bool UseSecondBuffer);
+			static void DataflashManager_ProgramBuffer(const uint16_t PageAddress,
+			                                           const bool UseSecondBuffer);
+			static void DataflashManager_SendPageReadCommand(const uint16_t PageAddress,
+			                                                 const uint16_t PageByte);
+			static const uint8_t* DataflashManager_BeginPageRead(const uint16_t PageAddress,
+			                                                     const uint16_t PageByte);
+			static void DataflashManager_DiscardReadAhead(const uint32_t BlockAddress,
+			                                              const uint16_t TotalBlocks);
+
+			#if (DATAFLASH_CACHE_PAGES > 0)
+				static void DataflashManager_MarkCacheSlotUsed(const uint8_t CacheSlot);
+				static DataflashManager_CachedPage_t* DataflashManager_FindCachedPage(const uint16_t PageAddress);
+				static DataflashManager_CachedPage_t* DataflashManager_AllocateCachedPage(const uint16_t PageAddress,
+				                                                                          const bool FetchContents);
+				static void DataflashManager_WriteCachedPage(DataflashManager_CachedPage_t* const CachedPage)
+				                                             ATTR_NON_NULL_PTR_ARG(1);
+			#endif
+		#endif
 
 #endif
 
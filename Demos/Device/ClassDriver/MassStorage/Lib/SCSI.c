@@ -66,7 +66,7 @@ static const SCSI_Inquiry_Response_t InquiryData =
 		.RelAddr             = false,
 
 		.VendorID            = "LUFA",
-		.ProductID           = "Dataflash Disk",
+		.ProductID           = BLOCK_DEVICE_PRODUCT_ID,
 		.RevisionID          = {'0','.','0','0'},
 	};
 
@@ -79,6 +79,11 @@ static SCSI_Request_Sense_Response_t SenseData =
 		.AdditionalLength    = 0x0A,
 	};
 
+#if BLOCK_DEVICE_READ_AHEAD
+/** Block address following the last block read by a READ command, used to detect sequential reads by the host. */
+static uint32_t NextSequentialBlock = NO_SEQUENTIAL_BLOCK;
+#endif
+
 
 /** Main routine to process the SCSI command located in the Command Block Wrapper read from the host. This dispatches
  *  to the appropriate SCSI command handling routine if the issued command is supported by the device, else it returns
@@ -104,6 +109,9 @@ bool SCSI_DecodeSCSICommand(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo)
 		case SCSI_CMD_READ_CAPACITY_10:
 			CommandSuccess = SCSI_Command_Read_Capacity_10(MSInterfaceInfo);
 			break;
+		case SCSI_CMD_SERVICE_ACTION_IN_16:
+			CommandSuccess = SCSI_Command_Read_Capacity_16(MSInterfaceInfo);
+			break;
 		case SCSI_CMD_SEND_DIAGNOSTIC:
 			CommandSuccess = SCSI_Command_Send_Diagnostic(MSInterfaceInfo);
 			break;
@@ -113,10 +121,33 @@ bool SCSI_DecodeSCSICommand(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo)
 		case SCSI_CMD_READ_10:
 			CommandSuccess = SCSI_Command_ReadWrite_10(MSInterfaceInfo, DATA_READ);
 			break;
+		case SCSI_CMD_WRITE_16:
+			CommandSuccess = SCSI_Command_ReadWrite_16(MSInterfaceInfo, DATA_WRITE);
+			break;
+		case SCSI_CMD_READ_16:
+			CommandSuccess = SCSI_Command_ReadWrite_16(MSInterfaceInfo, DATA_READ);
+			break;
 		case SCSI_CMD_MODE_SENSE_6:
 			CommandSuccess = SCSI_Command_ModeSense_6(MSInterfaceInfo);
 			break;
+		#if BLOCK_DEVICE_READ_AHEAD
+		case SCSI_CMD_READ_AHEAD_STATS:
+			CommandSuccess = SCSI_Command_ReadAheadStats(MSInterfaceInfo);
+			break;
+		#endif
+		#if BLOCK_DEVICE_WEAR_LEVELLING
+		case SCSI_CMD_WEAR_STATS:
+			CommandSuccess = SCSI_Command_WearStats(MSInterfaceInfo);
+			break;
+		#endif
+		case SCSI_CMD_SYNCHRONIZE_CACHE_10:
 		case SCSI_CMD_START_STOP_UNIT:
+			/* Write back any cached data to the medium, as the host may be about to eject or power down the disk */
+			BlockDevice_Flush();
+
+			CommandSuccess = true;
+			MSInterfaceInfo->State.CommandBlock.DataTransferLength = 0;
+			break;
 		case SCSI_CMD_TEST_UNIT_READY:
 		case SCSI_CMD_PREVENT_ALLOW_MEDIUM_REMOVAL:
 		case SCSI_CMD_VERIFY_10:
@@ -227,8 +258,47 @@ static bool SCSI_Command_Read_Capacity_10(USB_ClassInfo_MS_Device_t* const MSInt
 	return true;
 }
 
-/** Command processing for an issued SCSI SEND DIAGNOSTIC command. This command performs a quick check of the Dataflash ICs on the
- *  board, and indicates if they are present and functioning correctly. Only the Self-Test portion of the diagnostic command is
+/** Command processing for an issued SCSI READ CAPACITY (16) command, issued as a SERVICE ACTION IN (16) command. This command
+ *  returns the device's capacity on the selected Logical Unit (drive) as a 64-bit last block address, for hosts which use the
+ *  16 byte commands to address large media.
+ *
+ *  \param[in] MSInterfaceInfo  Pointer to the Mass Storage class interface structure that the command is associated with
+ *
+ *  \return Boolean \c true if the command completed successfully, \c false otherwise.
+ */
+static bool SCSI_Command_Read_Capacity_16(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo)
+{
+	uint32_t AllocationLength = SwapEndian_32(*(uint32_t*)&MSInterfaceInfo->State.CommandBlock.SCSICommandData[10]);
+	uint32_t LastBlockAddressInLUN = (LUN_MEDIA_BLOCKS - 1);
+	uint8_t  CapacityData[READ_CAPACITY_16_LENGTH] = {0};
+
+	/* READ CAPACITY (16) is the only supported SERVICE ACTION IN (16) command */
+	if ((MSInterfaceInfo->State.CommandBlock.SCSICommandData[1] & SERVICE_ACTION_MASK) != SCSI_SERVICE_ACTION_READ_CAPACITY_16)
+	{
+		SCSI_SET_SENSE(SCSI_SENSE_KEY_ILLEGAL_REQUEST,
+		               SCSI_ASENSE_INVALID_FIELD_IN_CDB,
+		               SCSI_ASENSEQ_NO_QUALIFIER);
+
+		return false;
+	}
+
+	/* 64-bit last block address, of which the upper 32 bits are always zero, followed by the 32-bit block size */
+	*(uint32_t*)&CapacityData[4]  = cpu_to_be32(LastBlockAddressInLUN);
+	*(uint32_t*)&CapacityData[8]  = cpu_to_be32(VIRTUAL_MEMORY_BLOCK_SIZE);
+
+	uint8_t BytesTransferred = MIN(AllocationLength, sizeof(CapacityData));
+
+	Endpoint_Write_Stream_LE(CapacityData, BytesTransferred, NULL);
+	Endpoint_ClearIN();
+
+	/* Succeed the command and update the bytes transferred counter */
+	MSInterfaceInfo->State.CommandBlock.DataTransferLength -= BytesTransferred;
+
+	return true;
+}
+
+/** Command processing for an issued SCSI SEND DIAGNOSTIC command. This command performs a quick check of the storage medium,
+ *  and indicates if it is present and functioning correctly. Only the Self-Test portion of the diagnostic command is
  *  supported.
  *
  *  \param[in] MSInterfaceInfo  Pointer to the Mass Storage class interface structure that the command is associated with
@@ -248,8 +318,11 @@ static bool SCSI_Command_Send_Diagnostic(USB_ClassInfo_MS_Device_t* const MSInte
 		return false;
 	}
 
-	/* Check to see if all attached Dataflash ICs are functional */
-	if (!(DataflashManager_CheckDataflashOperation()))
+	/* Write back any cached data, so that the medium is idle for the test */
+	BlockDevice_Flush();
+
+	/* Check to see if the storage medium is functional */
+	if (!(BlockDevice_CheckOperation()))
 	{
 		/* Update SENSE key with a hardware error condition and return command fail */
 		SCSI_SET_SENSE(SCSI_SENSE_KEY_HARDWARE_ERROR,
@@ -266,8 +339,7 @@ static bool SCSI_Command_Send_Diagnostic(USB_ClassInfo_MS_Device_t* const MSInte
 }
 
 /** Command processing for an issued SCSI READ (10) or WRITE (10) command. This command reads in the block start address
- *  and total number of blocks to process, then calls the appropriate low-level Dataflash routine to handle the actual
- *  reading and writing of the data.
+ *  and total number of blocks to process, then calls \ref SCSI_ReadWriteBlocks() to transfer the data.
  *
  *  \param[in] MSInterfaceInfo  Pointer to the Mass Storage class interface structure that the command is associated with
  *  \param[in] IsDataRead  Indicates if the command is a READ (10) command or WRITE (10) command (DATA_READ or DATA_WRITE)
@@ -280,6 +352,68 @@ static bool SCSI_Command_ReadWrite_10(USB_ClassInfo_MS_Device_t* const MSInterfa
 	uint32_t BlockAddress;
 	uint16_t TotalBlocks;
 
+	/* Load in the 32-bit block address (SCSI uses big-endian, so have to reverse the byte order) */
+	BlockAddress = SwapEndian_32(*(uint32_t*)&MSInterfaceInfo->State.CommandBlock.SCSICommandData[2]);
+
+	/* Load in the 16-bit total blocks (SCSI uses big-endian, so have to reverse the byte order) */
+	TotalBlocks  = SwapEndian_16(*(uint16_t*)&MSInterfaceInfo->State.CommandBlock.SCSICommandData[7]);
+
+	return SCSI_ReadWriteBlocks(MSInterfaceInfo, BlockAddress, TotalBlocks, IsDataRead);
+}
+
+/** Command processing for an issued SCSI READ (16) or WRITE (16) command. This command reads in the 64-bit block start address
+ *  and 32-bit total number of blocks to process, then calls \ref SCSI_ReadWriteBlocks() to transfer the data.
+ *
+ *  \param[in] MSInterfaceInfo  Pointer to the Mass Storage class interface structure that the command is associated with
+ *  \param[in] IsDataRead  Indicates if the command is a READ (16) command or WRITE (16) command (DATA_READ or DATA_WRITE)
+ *
+ *  \return Boolean \c true if the command completed successfully, \c false otherwise.
+ */
+static bool SCSI_Command_ReadWrite_16(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo,
+                                      const bool IsDataRead)
+{
+	uint32_t BlockAddressHigh;
+	uint32_t BlockAddress;
+	uint32_t TotalBlocks;
+
+	/* Load in the upper and lower halves of the 64-bit block address (SCSI uses big-endian, so have to reverse the byte order) */
+	BlockAddressHigh = SwapEndian_32(*(uint32_t*)&MSInterfaceInfo->State.CommandBlock.SCSICommandData[2]);
+	BlockAddress     = SwapEndian_32(*(uint32_t*)&MSInterfaceInfo->State.CommandBlock.SCSICommandData[6]);
+
+	/* Load in the 32-bit total blocks (SCSI uses big-endian, so have to reverse the byte order) */
+	TotalBlocks      = SwapEndian_32(*(uint32_t*)&MSInterfaceInfo->State.CommandBlock.SCSICommandData[10]);
+
+	/* The medium is addressed with 32-bit block addresses, so any address with the upper half set is out of range */
+	if (BlockAddressHigh)
+	{
+		SCSI_SET_SENSE(SCSI_SENSE_KEY_ILLEGAL_REQUEST,
+		               SCSI_ASENSE_LOGICAL_BLOCK_ADDRESS_OUT_OF_RANGE,
+		               SCSI_ASENSEQ_NO_QUALIFIER);
+
+		return false;
+	}
+
+	return SCSI_ReadWriteBlocks(MSInterfaceInfo, BlockAddress, TotalBlocks, IsDataRead);
+}
+
+/** Transfers blocks of data between the host and the storage medium for a SCSI READ or WRITE command, after checking that
+ *  the blocks lie within the selected Logical Unit. Transfers are passed to the storage medium in sections of up to 65535
+ *  blocks.
+ *
+ *  \param[in] MSInterfaceInfo  Pointer to the Mass Storage class interface structure that the command is associated with
+ *  \param[in] BlockAddress     Block address of the first block to transfer, within the selected Logical Unit
+ *  \param[in] TotalBlocks      Total number of blocks to transfer
+ *  \param[in] IsDataRead       Indicates if the data is to be read from or written to the medium (DATA_READ or DATA_WRITE)
+ *
+ *  \return Boolean \c true if the command completed successfully, \c false otherwise.
+ */
+static bool SCSI_ReadWriteBlocks(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo,
+                                 uint32_t BlockAddress,
+                                 uint32_t TotalBlocks,
+                                 const bool IsDataRead)
+{
+	uint32_t MediaBlocks = LUN_MEDIA_BLOCKS;
+
 	/* Check if the disk is write protected or not */
 	if ((IsDataRead == DATA_WRITE) && DISK_READ_ONLY)
 	{
@@ -291,14 +425,8 @@ static bool SCSI_Command_ReadWrite_10(USB_ClassInfo_MS_Device_t* const MSInterfa
 		return false;
 	}
 
-	/* Load in the 32-bit block address (SCSI uses big-endian, so have to reverse the byte order) */
-	BlockAddress = SwapEndian_32(*(uint32_t*)&MSInterfaceInfo->State.CommandBlock.SCSICommandData[2]);
-
-	/* Load in the 16-bit total blocks (SCSI uses big-endian, so have to reverse the byte order) */
-	TotalBlocks  = SwapEndian_16(*(uint16_t*)&MSInterfaceInfo->State.CommandBlock.SCSICommandData[7]);
-
-	/* Check if the block address is outside the maximum allowable value for the LUN */
-	if (BlockAddress >= LUN_MEDIA_BLOCKS)
+	/* Check if the block range extends outside the maximum allowable value for the LUN */
+	if ((BlockAddress >= MediaBlocks) || (TotalBlocks > (MediaBlocks - BlockAddress)))
 	{
 		/* Block address is invalid, update SENSE key and return command fail */
 		SCSI_SET_SENSE(SCSI_SENSE_KEY_ILLEGAL_REQUEST,
@@ -310,23 +438,71 @@ static bool SCSI_Command_ReadWrite_10(USB_ClassInfo_MS_Device_t* const MSInterfa
 
 	#if (TOTAL_LUNS > 1)
 	/* Adjust the given block address to the real media address based on the selected LUN */
-	BlockAddress += ((uint32_t)MSInterfaceInfo->State.CommandBlock.LUN * LUN_MEDIA_BLOCKS);
+	BlockAddress += ((uint32_t)MSInterfaceInfo->State.CommandBlock.LUN * MediaBlocks);
 	#endif
 
-	/* Determine if the packet is a READ (10) or WRITE (10) command, call appropriate function */
+	#if BLOCK_DEVICE_READ_AHEAD
+	uint32_t FirstBlockAddress = BlockAddress;
+	#endif
+
+	while (TotalBlocks)
+	{
+		uint16_t SectionBlocks = MIN(TotalBlocks, UINT16_MAX);
+		bool     MediaSuccess;
+
+		/* Determine if the packet is a READ or WRITE command, call appropriate function */
+		if (IsDataRead == DATA_READ)
+		  MediaSuccess = BlockDevice_ReadBlocks(MSInterfaceInfo, BlockAddress, SectionBlocks);
+		else
+		  MediaSuccess = BlockDevice_WriteBlocks(MSInterfaceInfo, BlockAddress, SectionBlocks);
+
+		/* Check if the storage medium failed to complete the transfer */
+		if (!(MediaSuccess))
+		{
+			/* Update the SENSE key with a medium error and return command fail */
+			SCSI_SET_SENSE(SCSI_SENSE_KEY_MEDIUM_ERROR,
+			               ((IsDataRead == DATA_READ) ? SCSI_ASENSE_UNRECOVERED_READ_ERROR : SCSI_ASENSE_WRITE_ERROR),
+			               SCSI_ASENSEQ_NO_QUALIFIER);
+
+			return false;
+		}
+
+		/* Update the bytes transferred counter */
+		MSInterfaceInfo->State.CommandBlock.DataTransferLength -= ((uint32_t)SectionBlocks * VIRTUAL_MEMORY_BLOCK_SIZE);
+
+		BlockAddress += SectionBlocks;
+		TotalBlocks  -= SectionBlocks;
+
+		/* Stop if the current command is being aborted by the host */
+		if (MSInterfaceInfo->State.IsMassStoreReset)
+		  return true;
+	}
+
+	#if BLOCK_DEVICE_READ_AHEAD
 	if (IsDataRead == DATA_READ)
-	  DataflashManager_ReadBlocks(MSInterfaceInfo, BlockAddress, TotalBlocks);
-	else
-	  DataflashManager_WriteBlocks(MSInterfaceInfo, BlockAddress, TotalBlocks);
+	{
+		DataflashManager_ReadAheadStats_t* ReadAheadStats = DataflashManager_GetReadAheadStats();
 
-	/* Update the bytes transferred counter and succeed the command */
-	MSInterfaceInfo->State.CommandBlock.DataTransferLength -= ((uint32_t)TotalBlocks * VIRTUAL_MEMORY_BLOCK_SIZE);
+		ReadAheadStats->ReadCommands++;
+
+		/* If this read continued on from the previous one the host is likely reading sequentially, so read ahead the
+		 * following block while the host processes the command status and issues its next command */
+		if (FirstBlockAddress == NextSequentialBlock)
+		{
+			ReadAheadStats->SequentialReads++;
+			DataflashManager_ReadAhead(BlockAddress);
+		}
+
+		NextSequentialBlock = BlockAddress;
+	}
+	#endif
 
 	return true;
 }
 
 /** Command processing for an issued SCSI MODE SENSE (6) command. This command returns various informational pages about
- *  the SCSI device, as well as the device's Write Protect status.
+ *  the SCSI device, as well as the device's Write Protect status. When the write-back cache of the medium is enabled, the
+ *  Caching mode page is returned to indicate to the host that the write cache is enabled.
  *
  *  \param[in] MSInterfaceInfo  Pointer to the Mass Storage class interface structure that the command is associated with
  *
@@ -334,16 +510,141 @@ static bool SCSI_Command_ReadWrite_10(USB_ClassInfo_MS_Device_t* const MSInterfa
  */
 static bool SCSI_Command_ModeSense_6(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo)
 {
-	/* Send an empty header response with the Write Protect flag status */
-	Endpoint_Write_8(0x00);
-	Endpoint_Write_8(0x00);
-	Endpoint_Write_8(DISK_READ_ONLY ? 0x80 : 0x00);
-	Endpoint_Write_8(0x00);
+	uint8_t AllocationLength = MSInterfaceInfo->State.CommandBlock.SCSICommandData[4];
+	uint8_t ModeData[MODE_SENSE_HEADER_LENGTH + MODE_PAGE_CACHING_LENGTH] = {0};
+	uint8_t ModeDataLength   = MODE_SENSE_HEADER_LENGTH;
+
+	/* Mode parameter header, with the Write Protect flag status and no block descriptors */
+	ModeData[2] = (DISK_READ_ONLY ? 0x80 : 0x00);
+
+	#if BLOCK_DEVICE_WRITE_CACHE
+	uint8_t PageControl = (MSInterfaceInfo->State.CommandBlock.SCSICommandData[2] >> 6);
+	uint8_t PageCode    = (MSInterfaceInfo->State.CommandBlock.SCSICommandData[2] & 0x3F);
+
+	/* Append the Caching mode page if requested, advertising the write-back cache of the medium */
+	if ((PageCode == MODE_PAGE_CACHING) || (PageCode == MODE_PAGE_ALL))
+	{
+		uint8_t* CachingPage = &ModeData[ModeDataLength];
+
+		CachingPage[0] = MODE_PAGE_CACHING;
+		CachingPage[1] = (MODE_PAGE_CACHING_LENGTH - 2);
+
+		/* Report the Write Cache Enable bit, except when the changeable values are requested as it is fixed */
+		if (PageControl != MODE_PAGE_CONTROL_CHANGEABLE)
+		  CachingPage[2] = MODE_PAGE_CACHING_WCE;
+
+		ModeDataLength += MODE_PAGE_CACHING_LENGTH;
+	}
+	#endif
+
+	/* The mode data length field excludes itself */
+	ModeData[0] = (ModeDataLength - 1);
+
+	uint8_t BytesTransferred = MIN(AllocationLength, ModeDataLength);
+
+	Endpoint_Write_Stream_LE(ModeData, BytesTransferred, NULL);
 	Endpoint_ClearIN();
 
 	/* Update the bytes transferred counter and succeed the command */
-	MSInterfaceInfo->State.CommandBlock.DataTransferLength -= 4;
+	MSInterfaceInfo->State.CommandBlock.DataTransferLength -= BytesTransferred;
+
+	return true;
+}
+
+#if BLOCK_DEVICE_READ_AHEAD
+/** Command processing for an issued vendor specific SCSI READ AHEAD STATS command. This command returns the sequential
+ *  read-ahead statistics as five big-endian 32-bit counters, in the order of the \ref DataflashManager_ReadAheadStats_t
+ *  structure, truncated to the transfer length requested by the host. If the \ref READ_AHEAD_STATS_RESET flag is set in
+ *  the command, the statistics are reset after they have been returned. A command block which does not request a
+ *  transfer from the device to the host, but has a non-zero transfer length, is rejected.
+ *
+ *  \param[in] MSInterfaceInfo  Pointer to the Mass Storage class interface structure that the command is associated with
+ *
+ *  \return Boolean \c true if the command completed successfully, \c false otherwise.
+ */
+static bool SCSI_Command_ReadAheadStats(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo)
+{
+	/* The statistics can only be returned to the host, so reject a command block that would send data to the device */
+	if (MSInterfaceInfo->State.CommandBlock.DataTransferLength &&
+	    !(MSInterfaceInfo->State.CommandBlock.Flags & MS_COMMAND_DIR_DATA_IN))
+	{
+		SCSI_SET_SENSE(SCSI_SENSE_KEY_ILLEGAL_REQUEST,
+		               SCSI_ASENSE_INVALID_FIELD_IN_CDB,
+		               SCSI_ASENSEQ_NO_QUALIFIER);
+
+		return false;
+	}
+
+	DataflashManager_ReadAheadStats_t* ReadAheadStats = DataflashManager_GetReadAheadStats();
+
+	uint32_t StatsData[] =
+		{
+			cpu_to_be32(ReadAheadStats->ReadCommands),
+			cpu_to_be32(ReadAheadStats->SequentialReads),
+			cpu_to_be32(ReadAheadStats->PagesPrefetched),
+			cpu_to_be32(ReadAheadStats->PagesHit),
+			cpu_to_be32(ReadAheadStats->PagesDiscarded),
+		};
+
+	uint8_t BytesTransferred = MIN(MSInterfaceInfo->State.CommandBlock.DataTransferLength, sizeof(StatsData));
+
+	Endpoint_Write_Stream_LE(StatsData, BytesTransferred, NULL);
+	Endpoint_ClearIN();
+
+	if (MSInterfaceInfo->State.CommandBlock.SCSICommandData[1] & READ_AHEAD_STATS_RESET)
+	  memset(ReadAheadStats, 0x00, sizeof(DataflashManager_ReadAheadStats_t));
+
+	/* Update the bytes transferred counter and succeed the command */
+	MSInterfaceInfo->State.CommandBlock.DataTransferLength -= BytesTransferred;
+
+	return true;
+}
+#endif
+
+#if BLOCK_DEVICE_WEAR_LEVELLING
+/** Command processing for an issued vendor specific SCSI WEAR STATS command. This command returns the Dataflash translation
+ *  layer wear statistics as six big-endian 32-bit counters, in the order of the \ref DataflashFTL_Stats_t structure,
+ *  truncated to the transfer length requested by the host. A command block which does not request a transfer from the
+ *  device to the host, but has a non-zero transfer length, is rejected.
+ *
+ *  \param[in] MSInterfaceInfo  Pointer to the Mass Storage class interface structure that the command is associated with
+ *
+ *  \return Boolean \c true if the command completed successfully, \c false otherwise.
+ */
+static bool SCSI_Command_WearStats(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo)
+{
+	/* The statistics can only be returned to the host, so reject a command block that would send data to the device */
+	if (MSInterfaceInfo->State.CommandBlock.DataTransferLength &&
+	    !(MSInterfaceInfo->State.CommandBlock.Flags & MS_COMMAND_DIR_DATA_IN))
+	{
+		SCSI_SET_SENSE(SCSI_SENSE_KEY_ILLEGAL_REQUEST,
+		               SCSI_ASENSE_INVALID_FIELD_IN_CDB,
+		               SCSI_ASENSEQ_NO_QUALIFIER);
+
+		return false;
+	}
+
+	DataflashFTL_Stats_t* WearStats = DataflashFTL_GetStats();
+
+	uint32_t StatsData[] =
+		{
+			cpu_to_be32(WearStats->PagesWritten),
+			cpu_to_be32(WearStats->MapPagesWritten),
+			cpu_to_be32(WearStats->PagesErased),
+			cpu_to_be32(WearStats->PagesRelocated),
+			cpu_to_be32(WearStats->MinEraseCount),
+			cpu_to_be32(WearStats->MaxEraseCount),
+		};
+
+	uint8_t BytesTransferred = MIN(MSInterfaceInfo->State.CommandBlock.DataTransferLength, sizeof(StatsData));
+
+	Endpoint_Write_Stream_LE(StatsData, BytesTransferred, NULL);
+	Endpoint_ClearIN();
+
+	/* Update the bytes transferred counter and succeed the command */
+	MSInterfaceInfo->State.CommandBlock.DataTransferLength -= BytesTransferred;
 
 	return true;
 }
+#endif
 
@@ -44,7 +44,7 @@
 
 		#include "../MassStorage.h"
 		#include "../Descriptors.h"
-		#include "DataflashManager.h"
+		#include "BlockDevice.h"
 		#include "Config/AppConfig.h"
 
 	/* Macros: */
@@ -60,10 +60,10 @@
 		                                                SenseData.AdditionalSenseCode      = (Acode); \
 		                                                SenseData.AdditionalSenseQualifier = (Aqual); } while (0)
 
-		/** Macro for the \ref SCSI_Command_ReadWrite_10() function, to indicate that data is to be read from the storage medium. */
+		/** Macro for the \ref SCSI_ReadWriteBlocks() function, to indicate that data is to be read from the storage medium. */
 		#define DATA_READ           true
 
-		/** Macro for the \ref SCSI_Command_ReadWrite_10() function, to indicate that data is to be written to the storage medium. */
+		/** Macro for the \ref SCSI_ReadWriteBlocks() function, to indicate that data is to be written to the storage medium. */
 		#define DATA_WRITE          false
 
 		/** Value for the DeviceType entry in the SCSI_Inquiry_Response_t enum, indicating a Block Media device. */
@@ -72,6 +72,44 @@
 		/** Value for the DeviceType entry in the SCSI_Inquiry_Response_t enum, indicating a CD-ROM device. */
 		#define DEVICE_TYPE_CDROM   0x05
 
+		/** Length in bytes of the MODE SENSE (6) mode parameter header, without any block descriptors. */
+		#define MODE_SENSE_HEADER_LENGTH      4
+
+		/** Page Control value of a MODE SENSE command, requesting the changeable mode page values. */
+		#define MODE_PAGE_CONTROL_CHANGEABLE  0x01
+
+		/** Page code of the Caching mode page. */
+		#define MODE_PAGE_CACHING             0x08
+
+		/** Page code requesting all supported mode pages. */
+		#define MODE_PAGE_ALL                 0x3F
+
+		/** Total length in bytes of the Caching mode page, including its two byte page header. */
+		#define MODE_PAGE_CACHING_LENGTH      20
+
+		/** Write Cache Enable flag of the Caching mode page, indicating that writes may be cached before being committed to the medium. */
+		#define MODE_PAGE_CACHING_WCE         (1 << 2)
+
+		/** Length in bytes of the READ CAPACITY (16) parameter data. */
+		#define READ_CAPACITY_16_LENGTH       32
+
+		/** Mask for the service action field in the second byte of a SERVICE ACTION IN (16) command. */
+		#define SERVICE_ACTION_MASK           0x1F
+
+		/** Vendor specific SCSI command code for the command returning the sequential read-ahead statistics. */
+		#define SCSI_CMD_READ_AHEAD_STATS     0xC0
+
+		/** Flag in the second byte of the \ref SCSI_CMD_READ_AHEAD_STATS command, requesting that the statistics be reset
+		 *  once they have been returned.
+		 */
+		#define READ_AHEAD_STATS_RESET        (1 << 0)
+
+		/** Block address used to indicate that no READ command has yet completed, so that no read is sequential. */
+		#define NO_SEQUENTIAL_BLOCK           0xFFFFFFFF
+
+		/** Vendor specific SCSI command code for the command returning the Dataflash translation layer wear statistics. */
+		#define SCSI_CMD_WEAR_STATS           0xC1
+
 	/* Function Prototypes: */
 		bool SCSI_DecodeSCSICommand(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo);
 
@@ -79,10 +117,25 @@
 			static bool SCSI_Command_Inquiry(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo);
 			static bool SCSI_Command_Request_Sense(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo);
 			static bool SCSI_Command_Read_Capacity_10(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo);
+			static bool SCSI_Command_Read_Capacity_16(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo);
 			static bool SCSI_Command_Send_Diagnostic(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo);
 			static bool SCSI_Command_ReadWrite_10(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo,
 			                                      const bool IsDataRead);
+			static bool SCSI_Command_ReadWrite_16(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo,
+			                                      const bool IsDataRead);
+			static bool SCSI_ReadWriteBlocks(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo,
+			                                 uint32_t BlockAddress,
+			                                 uint32_t TotalBlocks,
+			                                 const bool IsDataRead);
 			static bool SCSI_Command_ModeSense_6(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo);
+
+			#if BLOCK_DEVICE_READ_AHEAD
+				static bool SCSI_Command_ReadAheadStats(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo);
+			#endif
+
+			#if BLOCK_DEVICE_WEAR_LEVELLING
+				static bool SCSI_Command_WearStats(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo);
+			#endif
 		#endif
 
 #endif
@@ -0,0 +1,566 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2018.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2018  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Functions to manage a SD or MMC memory card attached to the SPI bus as the storage medium, including
+ *  reading and writing of blocks of data. Transfers of more than one block use the card's multiple block
+ *  read and write commands, so that consecutive blocks are streamed directly between the card and the Mass
+ *  Storage endpoints without a new command, and the card's access time, for each block.
+ */
+
+#define  INCLUDE_FROM_SDCARDMANAGER_C
+#include "SDCardManager.h"
+
+#if (DISK_BACKEND == DISK_BACKEND_SDCARD)
+
+#include <LUFA/Drivers/Peripheral/SPI.h>
+
+#if ((ARCH != ARCH_AVR8) && (ARCH != ARCH_POSIX))
+	#error The SD card backend is only available for the AVR8 and POSIX architectures.
+#endif
+
+/** Indicates if the card is a high capacity card which is addressed in blocks, rather than in bytes. */
+static bool CardUsesBlockAddressing;
+
+/** Indicates if the card is a MMC card, which does not support the SD application specific commands. */
+static bool CardIsMMC;
+
+/** Total number of blocks of the card, read from its CSD register. */
+static uint32_t CardTotalBlocks;
+
+/** Initializes the SPI bus and the attached memory card for use as the storage medium, and reads the card's capacity.
+ *
+ *  \return Boolean \c true if a card is present and was initialized successfully, \c false otherwise
+ */
+bool SDCardManager_Init(void)
+{
+	bool CardReady;
+
+	#if (ARCH == ARCH_AVR8)
+	SDCARD_CS_DDR |= SDCARD_CS_MASK;
+	#endif
+
+	SDCardManager_DeselectCard();
+
+	/* Cards must be initialized with a SPI clock of no more than 400KHz */
+	SPI_Init(SPI_SPEED_FCPU_DIV_128 | SPI_ORDER_MSB_FIRST | SPI_SCK_LEAD_RISING | SPI_SAMPLE_LEADING | SPI_MODE_MASTER);
+
+	/* Send at least 74 clocks with the card deselected, so that it is ready to receive commands */
+	for (uint8_t i = 0; i < 10; i++)
+	  SPI_SendByte(0xFF);
+
+	SDCardManager_SelectCard();
+	CardReady = SDCardManager_InitCard();
+	SDCardManager_DeselectCard();
+
+	/* Switch to the fastest SPI clock for data transfers once the card is ready */
+	if (CardReady)
+	  SPI_Init(SPI_SPEED_FCPU_DIV_2 | SPI_ORDER_MSB_FIRST | SPI_SCK_LEAD_RISING | SPI_SAMPLE_LEADING | SPI_MODE_MASTER);
+
+	return CardReady;
+}
+
+/** Retrieves the total capacity of the card, read when it was initialized.
+ *
+ *  \return Total number of blocks of the card
+ */
+uint32_t SDCardManager_GetTotalBlocks(void)
+{
+	return CardTotalBlocks;
+}
+
+/** Writes blocks to the storage medium, the memory card, from the pre-selected data OUT endpoint. Each block
+ *  is clocked out to the card as it is read from the endpoint, using a multiple block write for transfers of
+ *  more than one block.
+ *
+ *  \param[in] MSInterfaceInfo  Pointer to a structure containing a Mass Storage Class configuration and state
+ *  \param[in] BlockAddress  Data block starting address for the write sequence
+ *  \param[in] TotalBlocks   Number of blocks of data to write
+ *
+ *  \return Boolean \c false if the card failed to store the data, \c true otherwise
+ */
+bool SDCardManager_WriteBlocks(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo,
+                               const uint32_t BlockAddress,
+                               uint16_t TotalBlocks)
+{
+	bool    IsMultiBlock = (TotalBlocks > 1);
+	uint8_t ErrorCode    = SDCARD_TRANSFER_Complete;
+
+	/* Wait until endpoint is ready before continuing */
+	if (Endpoint_WaitUntilReady())
+	  return true;
+
+	SDCardManager_SelectCard();
+
+	/* Tell SD cards how many blocks are about to be written, so that they can be erased ahead of the data */
+	if (IsMultiBlock && !(CardIsMMC))
+	  SDCardManager_SendAppCommand(SD_ACMD_SET_WR_BLK_ERASE_COUNT, TotalBlocks);
+
+	if (SDCardManager_SendCommand((IsMultiBlock ? SD_CMD_WRITE_MULTIPLE_BLOCK : SD_CMD_WRITE_BLOCK),
+	                              (CardUsesBlockAddressing ? BlockAddress : (BlockAddress * VIRTUAL_MEMORY_BLOCK_SIZE))))
+	{
+		SDCardManager_DeselectCard();
+		return false;
+	}
+
+	while (TotalBlocks && (ErrorCode == SDCARD_TRANSFER_Complete))
+	{
+		ErrorCode = SDCardManager_WriteBlockFromEndpoint(MSInterfaceInfo,
+		                                                 (IsMultiBlock ? SD_TOKEN_START_MULTI_BLOCK : SD_TOKEN_START_BLOCK));
+		TotalBlocks--;
+	}
+
+	/* End the multiple block write, and wait until the card has finished programming the last block */
+	if (IsMultiBlock)
+	{
+		SPI_SendByte(SD_TOKEN_STOP_TRAN);
+		SPI_SendByte(0xFF);
+
+		if (!(SDCardManager_WaitWhileBusy()))
+		  ErrorCode = SDCARD_TRANSFER_Error;
+	}
+
+	SDCardManager_DeselectCard();
+
+	/* If the endpoint is empty, clear it ready for the next packet from the host */
+	if ((ErrorCode == SDCARD_TRANSFER_Complete) && !(Endpoint_IsReadWriteAllowed()))
+	  Endpoint_ClearOUT();
+
+	return (ErrorCode != SDCARD_TRANSFER_Error);
+}
+
+/** Reads blocks from the storage medium, the memory card, into the pre-selected data IN endpoint. Each block
+ *  is written to the endpoint as it is clocked in from the card, using a multiple block read for transfers of
+ *  more than one block.
+ *
+ *  \param[in] MSInterfaceInfo  Pointer to a structure containing a Mass Storage Class configuration and state
+ *  \param[in] BlockAddress  Data block starting address for the read sequence
+ *  \param[in] TotalBlocks   Number of blocks of data to read
+ *
+ *  \return Boolean \c false if the card failed to send the data, \c true otherwise
+ */
+bool SDCardManager_ReadBlocks(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo,
+                              const uint32_t BlockAddress,
+                              uint16_t TotalBlocks)
+{
+	bool    IsMultiBlock = (TotalBlocks > 1);
+	uint8_t ErrorCode    = SDCARD_TRANSFER_Complete;
+
+	/* Wait until endpoint is ready before continuing */
+	if (Endpoint_WaitUntilReady())
+	  return true;
+
+	SDCardManager_SelectCard();
+
+	if (SDCardManager_SendCommand((IsMultiBlock ? SD_CMD_READ_MULTIPLE_BLOCK : SD_CMD_READ_SINGLE_BLOCK),
+	                              (CardUsesBlockAddressing ? BlockAddress : (BlockAddress * VIRTUAL_MEMORY_BLOCK_SIZE))))
+	{
+		SDCardManager_DeselectCard();
+		return false;
+	}
+
+	while (TotalBlocks && (ErrorCode == SDCARD_TRANSFER_Complete))
+	{
+		ErrorCode = SDCardManager_ReadBlockToEndpoint(MSInterfaceInfo);
+		TotalBlocks--;
+	}
+
+	/* If the endpoint is full, send its contents to the host */
+	if ((ErrorCode == SDCARD_TRANSFER_Complete) && !(Endpoint_IsReadWriteAllowed()))
+	  Endpoint_ClearIN();
+
+	/* Stop the multiple block read, as the card would otherwise continue sending the following blocks */
+	if (IsMultiBlock)
+	{
+		SDCardManager_SendCommand(SD_CMD_STOP_TRANSMISSION, 0);
+		SDCardManager_WaitWhileBusy();
+	}
+
+	SDCardManager_DeselectCard();
+
+	return (ErrorCode != SDCARD_TRANSFER_Error);
+}
+
+/** Performs a simple test on the attached memory card to ensure that it is present and working.
+ *
+ *  \return Boolean \c true if the card is working, \c false otherwise
+ */
+bool SDCardManager_CheckCardOperation(void)
+{
+	uint8_t Status[2];
+
+	SDCardManager_SelectCard();
+	Status[0] = SDCardManager_SendCommand(SD_CMD_SEND_STATUS, 0);
+	Status[1] = SPI_TransferByte(0xFF);
+	SDCardManager_DeselectCard();
+
+	/* The R2 response is all zeros for a card that is ready and has no error conditions */
+	return !(Status[0] || Status[1]);
+}
+
+/** Asserts the chip select line of the memory card. */
+static inline void SDCardManager_SelectCard(void)
+{
+	#if (ARCH == ARCH_POSIX)
+	VirtualBoard_SDCard_SelectCard(true);
+	#else
+	SDCARD_CS_PORT &= ~SDCARD_CS_MASK;
+	#endif
+}
+
+/** Releases the chip select line of the memory card, and clocks a byte so that the card releases the SPI bus. */
+static inline void SDCardManager_DeselectCard(void)
+{
+	#if (ARCH == ARCH_POSIX)
+	VirtualBoard_SDCard_SelectCard(false);
+	#else
+	SDCARD_CS_PORT |= SDCARD_CS_MASK;
+	#endif
+
+	SPI_SendByte(0xFF);
+}
+
+/** Runs the SPI mode initialization sequence of the selected card, identifying its type and reading its capacity.
+ *
+ *  \return Boolean \c true if the card was initialized successfully, \c false otherwise
+ */
+static bool SDCardManager_InitCard(void)
+{
+	uint8_t  Response[4];
+	uint8_t  CSD[16];
+	uint32_t OpCondArgument = 0;
+	uint8_t  R1;
+
+	/* Reset the card into the idle state, selecting SPI mode */
+	for (uint8_t Attempt = 0; (R1 = SDCardManager_SendCommand(SD_CMD_GO_IDLE_STATE, 0)) != SD_R1_IDLE_STATE; Attempt++)
+	{
+		if (Attempt == 10)
+		  return false;
+	}
+
+	/* Cards implementing version 2.00 or later of the specification echo back the check pattern, and may be high capacity */
+	if (!(SDCardManager_SendCommand(SD_CMD_SEND_IF_COND, SD_IF_COND_ARGUMENT) & SD_R1_ILLEGAL_COMMAND))
+	{
+		for (uint8_t i = 0; i < sizeof(Response); i++)
+		  Response[i] = SPI_TransferByte(0xFF);
+
+		if (((Response[2] & 0x0F) != (SD_IF_COND_ARGUMENT >> 8)) || (Response[3] != (uint8_t)SD_IF_COND_ARGUMENT))
+		  return false;
+
+		OpCondArgument = SD_OP_COND_HCS;
+	}
+
+	/* Wait until the card has completed its initialization process, falling back to the MMC command if not a SD card */
+	CardIsMMC = (SDCardManager_SendAppCommand(SD_ACMD_SD_SEND_OP_COND, OpCondArgument) & SD_R1_ILLEGAL_COMMAND);
+
+	for (uint16_t TimeoutMS = SDCARD_INIT_TIMEOUT_MS; TimeoutMS; TimeoutMS--)
+	{
+		if (CardIsMMC)
+		  R1 = SDCardManager_SendCommand(SD_CMD_SEND_OP_COND, 0);
+		else
+		  R1 = SDCardManager_SendAppCommand(SD_ACMD_SD_SEND_OP_COND, OpCondArgument);
+
+		if (!(R1))
+		  break;
+
+		Delay_MS(1);
+	}
+
+	if (R1)
+	  return false;
+
+	/* High capacity cards indicate that they are addressed in blocks through the OCR register */
+	CardUsesBlockAddressing = false;
+
+	if (OpCondArgument)
+	{
+		if (SDCardManager_SendCommand(SD_CMD_READ_OCR, 0))
+		  return false;
+
+		for (uint8_t i = 0; i < sizeof(Response); i++)
+		  Response[i] = SPI_TransferByte(0xFF);
+
+		CardUsesBlockAddressing = (Response[0] & SD_OCR_CCS);
+	}
+
+	/* Byte addressed cards must use the same block size as the host */
+	if (!(CardUsesBlockAddressing) && SDCardManager_SendCommand(SD_CMD_SET_BLOCKLEN, VIRTUAL_MEMORY_BLOCK_SIZE))
+	  return false;
+
+	if (SDCardManager_SendCommand(SD_CMD_SEND_CSD, 0) || !(SDCardManager_WaitForDataToken()))
+	  return false;
+
+	for (uint8_t i = 0; i < sizeof(CSD); i++)
+	  CSD[i] = SPI_TransferByte(0xFF);
+
+	/* Discard the register's CRC16 */
+	SPI_SendByte(0xFF);
+	SPI_SendByte(0xFF);
+
+	if ((CSD[0] >> 6) == 1)
+	{
+		/* Version 2.0 CSD, with the capacity given in 512KB units */
+		uint32_t CSize = ((((uint32_t)CSD[7] & 0x3F) << 16) | ((uint16_t)CSD[8] << 8) | CSD[9]);
+
+		/* Block addresses are 32 bits wide, so the last block of a full 2TB card cannot be addressed */
+		CardTotalBlocks = ((CSize < 0x3FFFFF) ? ((CSize + 1) << 10) : UINT32_MAX);
+	}
+	else
+	{
+		/* Version 1.0 CSD, with the capacity given as a block count, count multiplier and block length */
+		uint16_t CSize     = ((((uint16_t)CSD[6] & 0x03) << 10) | ((uint16_t)CSD[7] << 2) | (CSD[8] >> 6));
+		uint8_t  CSizeMult = (((CSD[9] & 0x03) << 1) | (CSD[10] >> 7));
+		uint8_t  ReadBlLen = (CSD[5] & 0x0F);
+
+		CardTotalBlocks = ((uint32_t)(CSize + 1) << (CSizeMult + 2 + ReadBlLen - 9));
+	}
+
+	return true;
+}
+
+/** Sends a command to the selected card, and waits for its R1 response. Any further response bytes are left to be
+ *  read by the caller.
+ *
+ *  \param[in] Command   Command index to send, a \c SD_CMD_* value
+ *  \param[in] Argument  32-bit argument of the command
+ *
+ *  \return R1 response of the card, zero if the command was accepted and the card is ready, or 0xFF on timeout
+ */
+static uint8_t SDCardManager_SendCommand(const uint8_t Command,
+                                         const uint32_t Argument)
+{
+	uint8_t R1;
+
+	SPI_SendByte(0x40 | Command);
+	SPI_SendByte(Argument >> 24);
+	SPI_SendByte(Argument >> 16);
+	SPI_SendByte(Argument >> 8);
+	SPI_SendByte(Argument);
+
+	/* Only the commands sent before SPI mode is entered require a valid CRC */
+	if (Command == SD_CMD_GO_IDLE_STATE)
+	  SPI_SendByte(0x95);
+	else if (Command == SD_CMD_SEND_IF_COND)
+	  SPI_SendByte(0x87);
+	else
+	  SPI_SendByte(0x01);
+
+	/* The byte following a stop command is undefined, as the card may still have been sending data */
+	if (Command == SD_CMD_STOP_TRANSMISSION)
+	  SPI_SendByte(0xFF);
+
+	for (uint8_t i = 0; i < SDCARD_RESPONSE_TIMEOUT_BYTES; i++)
+	{
+		if (!((R1 = SPI_TransferByte(0xFF)) & 0x80))
+		  break;
+	}
+
+	return R1;
+}
+
+/** Sends an application specific command to the selected card, preceded by the \ref SD_CMD_APP_CMD command.
+ *
+ *  \param[in] Command   Application specific command index to send, a \c SD_ACMD_* value
+ *  \param[in] Argument  32-bit argument of the command
+ *
+ *  \return R1 response of the card to the application specific command
+ */
+static uint8_t SDCardManager_SendAppCommand(const uint8_t Command,
+                                            const uint32_t Argument)
+{
+	uint8_t R1 = SDCardManager_SendCommand(SD_CMD_APP_CMD, 0);
+
+	if (R1 & ~SD_R1_IDLE_STATE)
+	  return R1;
+
+	return SDCardManager_SendCommand(Command, Argument);
+}
+
+/** Waits for the start token of a data block sent by the selected card.
+ *
+ *  \return Boolean \c true if the card is about to send the block, \c false if it reported an error or timed out
+ */
+static bool SDCardManager_WaitForDataToken(void)
+{
+	for (uint32_t i = 0; i < SDCARD_READ_TIMEOUT_BYTES; i++)
+	{
+		uint8_t Token = SPI_TransferByte(0xFF);
+
+		if (Token != 0xFF)
+		  return (Token == SD_TOKEN_START_BLOCK);
+	}
+
+	return false;
+}
+
+/** Waits while the selected card holds its data output low, indicating that it is busy programming written data.
+ *
+ *  \return Boolean \c true if the card is ready, \c false if it timed out
+ */
+static bool SDCardManager_WaitWhileBusy(void)
+{
+	for (uint32_t i = 0; i < SDCARD_BUSY_TIMEOUT_BYTES; i++)
+	{
+		if (SPI_TransferByte(0xFF) == 0xFF)
+		  return true;
+	}
+
+	return false;
+}
+
+/** Reads a single data block sent by the selected card into the pre-selected data IN endpoint. If the host aborts the
+ *  command part way through the block, the remainder of the block is clocked out of the card and discarded so that the
+ *  card is ready for its next command.
+ *
+ *  \param[in] MSInterfaceInfo  Pointer to a structure containing a Mass Storage Class configuration and state
+ *
+ *  \return A value from the \ref SDCardManager_TransferStatus_t enum
+ */
+static uint8_t SDCardManager_ReadBlockToEndpoint(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo)
+{
+	bool IsAborted = false;
+
+	if (!(SDCardManager_WaitForDataToken()))
+	  return SDCARD_TRANSFER_Error;
+
+	for (uint8_t BytesInBlockDiv16 = 0; BytesInBlockDiv16 < (VIRTUAL_MEMORY_BLOCK_SIZE >> 4); BytesInBlockDiv16++)
+	{
+		/* Check if the endpoint is currently full */
+		if (!(IsAborted) && !(Endpoint_IsReadWriteAllowed()))
+		{
+			/* Clear the endpoint bank to send its contents to the host */
+			Endpoint_ClearIN();
+
+			/* Wait until the endpoint is ready for more data */
+			IsAborted = (Endpoint_WaitUntilReady() != ENDPOINT_READYWAIT_NoError);
+		}
+
+		if (IsAborted)
+		{
+			for (uint8_t ByteInChunk = 0; ByteInChunk < 16; ByteInChunk++)
+			  SPI_SendByte(0xFF);
+
+			continue;
+		}
+
+		/* Read one 16-byte chunk of data from the card, clocking in each byte while the previous one is loaded into
+		 * the endpoint bank so that the SPI transfers overlap the USB controller accesses */
+		SPI_BeginTransferByte(0xFF);
+
+		for (uint8_t ByteInChunk = 0; ByteInChunk < 15; ByteInChunk++)
+		{
+			uint8_t DataByte = SPI_EndTransferByte();
+			SPI_BeginTransferByte(0xFF);
+			Endpoint_Write_8(DataByte);
+		}
+
+		Endpoint_Write_8(SPI_EndTransferByte());
+
+		/* Check if the current command is being aborted by the host */
+		if (MSInterfaceInfo->State.IsMassStoreReset)
+		  IsAborted = true;
+	}
+
+	/* Discard the block's CRC16, which is not checked */
+	SPI_SendByte(0xFF);
+	SPI_SendByte(0xFF);
+
+	return (IsAborted ? SDCARD_TRANSFER_Aborted : SDCARD_TRANSFER_Complete);
+}
+
+/** Writes a single data block from the pre-selected data OUT endpoint to the selected card, and waits until the card
+ *  has stored it. If the host aborts the command part way through the block, the remainder of the block is padded so
+ *  that the card is ready for its next command; as with an interrupted write to any disk, the contents of the blocks
+ *  being written are then undefined.
+ *
+ *  \param[in] MSInterfaceInfo  Pointer to a structure containing a Mass Storage Class configuration and state
+ *  \param[in] StartToken       Token to send before the block, \ref SD_TOKEN_START_BLOCK or \ref SD_TOKEN_START_MULTI_BLOCK
+ *
+ *  \return A value from the \ref SDCardManager_TransferStatus_t enum
+ */
+static uint8_t SDCardManager_WriteBlockFromEndpoint(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo,
+                                                    const uint8_t StartToken)
+{
+	bool IsAborted = false;
+
+	SPI_SendByte(0xFF);
+	SPI_SendByte(StartToken);
+
+	for (uint8_t BytesInBlockDiv16 = 0; BytesInBlockDiv16 < (VIRTUAL_MEMORY_BLOCK_SIZE >> 4); BytesInBlockDiv16++)
+	{
+		/* Check if the endpoint is currently empty */
+		if (!(IsAborted) && !(Endpoint_IsReadWriteAllowed()))
+		{
+			/* Clear the current endpoint bank */
+			Endpoint_ClearOUT();
+
+			/* Wait until the host has sent another packet */
+			IsAborted = (Endpoint_WaitUntilReady() != ENDPOINT_READYWAIT_NoError);
+		}
+
+		if (IsAborted)
+		{
+			for (uint8_t ByteInChunk = 0; ByteInChunk < 16; ByteInChunk++)
+			  SPI_SendByte(0x00);
+
+			continue;
+		}
+
+		/* Write one 16-byte chunk of data to the card, reading each byte from the endpoint bank while the previous one
+		 * is clocked out so that the USB controller accesses overlap the SPI transfers */
+		SPI_BeginTransferByte(Endpoint_Read_8());
+
+		for (uint8_t ByteInChunk = 0; ByteInChunk < 15; ByteInChunk++)
+		{
+			uint8_t DataByte = Endpoint_Read_8();
+			SPI_EndTransferByte();
+			SPI_BeginTransferByte(DataByte);
+		}
+
+		SPI_EndTransferByte();
+
+		/* Check if the current command is being aborted by the host */
+		if (MSInterfaceInfo->State.IsMassStoreReset)
+		  IsAborted = true;
+	}
+
+	/* Send a dummy CRC16, as CRC checking is disabled in SPI mode */
+	SPI_SendByte(0xFF);
+	SPI_SendByte(0xFF);
+
+	/* Check that the card accepted the block, and wait until it has been programmed */
+	if (((SPI_TransferByte(0xFF) & SD_DATA_RESPONSE_MASK) != SD_DATA_RESPONSE_ACCEPTED) || !(SDCardManager_WaitWhileBusy()))
+	  return SDCARD_TRANSFER_Error;
+
+	return (IsAborted ? SDCARD_TRANSFER_Aborted : SDCARD_TRANSFER_Complete);
+}
+
+#endif
@@ -0,0 +1,174 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2018.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2018  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Header file for SDCardManager.c.
+ */
+
+#ifndef _SDCARD_MANAGER_H_
+#define _SDCARD_MANAGER_H_
+
+	/* Includes: */
+		#include <avr/io.h>
+
+		#include "../MassStorage.h"
+		#include "../Descriptors.h"
+		#include "BlockDevice.h"
+		#include "Config/AppConfig.h"
+
+		#include <LUFA/Common/Common.h>
+		#include <LUFA/Drivers/USB/USB.h>
+
+	/* Defines: */
+		/** SD card command to reset the card into the idle state, and select SPI mode. */
+		#define SD_CMD_GO_IDLE_STATE                0
+
+		/** MMC command to start the card's initialization process. */
+		#define SD_CMD_SEND_OP_COND                 1
+
+		/** SD card command to send the host supply voltage, and check if the card supports version 2.00 of the specification. */
+		#define SD_CMD_SEND_IF_COND                 8
+
+		/** SD card command to read the Card Specific Data (CSD) register. */
+		#define SD_CMD_SEND_CSD                     9
+
+		/** SD card command to stop a multiple block read. */
+		#define SD_CMD_STOP_TRANSMISSION            12
+
+		/** SD card command to read the card status register. */
+		#define SD_CMD_SEND_STATUS                  13
+
+		/** SD card command to set the block length of byte addressed cards. */
+		#define SD_CMD_SET_BLOCKLEN                 16
+
+		/** SD card command to read a single block. */
+		#define SD_CMD_READ_SINGLE_BLOCK            17
+
+		/** SD card command to read consecutive blocks until stopped by \ref SD_CMD_STOP_TRANSMISSION. */
+		#define SD_CMD_READ_MULTIPLE_BLOCK          18
+
+		/** SD card command to write a single block. */
+		#define SD_CMD_WRITE_BLOCK                  24
+
+		/** SD card command to write consecutive blocks until stopped by \ref SD_TOKEN_STOP_TRAN. */
+		#define SD_CMD_WRITE_MULTIPLE_BLOCK         25
+
+		/** SD card command indicating that the next command is an application specific command. */
+		#define SD_CMD_APP_CMD                      55
+
+		/** SD card command to read the Operating Conditions Register (OCR). */
+		#define SD_CMD_READ_OCR                     58
+
+		/** SD card application specific command to set the number of blocks to pre-erase before a multiple block write. */
+		#define SD_ACMD_SET_WR_BLK_ERASE_COUNT      23
+
+		/** SD card application specific command to start the card's initialization process. */
+		#define SD_ACMD_SD_SEND_OP_COND             41
+
+		/** Flag in the R1 response of a command, indicating that the card is in the idle state. */
+		#define SD_R1_IDLE_STATE                    (1 << 0)
+
+		/** Flag in the R1 response of a command, indicating that the command is not supported by the card. */
+		#define SD_R1_ILLEGAL_COMMAND               (1 << 2)
+
+		/** Argument of \ref SD_CMD_SEND_IF_COND, with the 2.7-3.6V supply voltage range and check pattern. */
+		#define SD_IF_COND_ARGUMENT                 0x000001AAUL
+
+		/** Flag in the argument of \ref SD_ACMD_SD_SEND_OP_COND, indicating that the host supports high capacity cards. */
+		#define SD_OP_COND_HCS                      (1UL << 30)
+
+		/** Flag in the first byte of the OCR register, indicating that the card uses block rather than byte addressing. */
+		#define SD_OCR_CCS                          (1 << 6)
+
+		/** Token sent by the card before each data block it sends, and by the host before a single block write. */
+		#define SD_TOKEN_START_BLOCK                0xFE
+
+		/** Token sent by the host before each data block of a multiple block write. */
+		#define SD_TOKEN_START_MULTI_BLOCK          0xFC
+
+		/** Token sent by the host to end a multiple block write. */
+		#define SD_TOKEN_STOP_TRAN                  0xFD
+
+		/** Mask for the status bits of the data response token sent by the card after each written data block. */
+		#define SD_DATA_RESPONSE_MASK               0x1F
+
+		/** Data response token value indicating that the card has accepted a written data block. */
+		#define SD_DATA_RESPONSE_ACCEPTED           0x05
+
+		/** Maximum number of bytes to poll for a command response from the card. */
+		#define SDCARD_RESPONSE_TIMEOUT_BYTES       10
+
+		/** Maximum number of bytes to poll for a data block from the card, at least 100ms at the fastest SPI clock. */
+		#define SDCARD_READ_TIMEOUT_BYTES           ((F_CPU / 2 / 8) / 10)
+
+		/** Maximum number of bytes to poll while the card is busy, at least 500ms at the fastest SPI clock. */
+		#define SDCARD_BUSY_TIMEOUT_BYTES           ((F_CPU / 2 / 8) / 2)
+
+		/** Maximum time in milliseconds for the card to complete its initialization process. */
+		#define SDCARD_INIT_TIMEOUT_MS              1000
+
+	/* Enums: */
+		/** Enum for the possible outcomes of a single block transfer between the card and the Mass Storage endpoints. */
+		enum SDCardManager_TransferStatus_t
+		{
+			SDCARD_TRANSFER_Complete = 0, /**< Block was transferred successfully. */
+			SDCARD_TRANSFER_Aborted  = 1, /**< Host aborted the command, the remainder of the block was discarded or padded. */
+			SDCARD_TRANSFER_Error    = 2, /**< Card failed to send or store the block. */
+		};
+
+	/* Function Prototypes: */
+		bool SDCardManager_Init(void);
+		uint32_t SDCardManager_GetTotalBlocks(void) ATTR_WARN_UNUSED_RESULT ATTR_PURE;
+		bool SDCardManager_WriteBlocks(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo,
+		                               const uint32_t BlockAddress,
+		                               uint16_t TotalBlocks);
+		bool SDCardManager_ReadBlocks(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo,
+		                              const uint32_t BlockAddress,
+		                              uint16_t TotalBlocks);
+		bool SDCardManager_CheckCardOperation(void);
+
+		#if defined(INCLUDE_FROM_SDCARDMANAGER_C) && (DISK_BACKEND == DISK_BACKEND_SDCARD)
+			static inline void SDCardManager_SelectCard(void);
+			static inline void SDCardManager_DeselectCard(void);
+			static bool SDCardManager_InitCard(void);
+			static uint8_t SDCardManager_SendCommand(const uint8_t Command,
+			                                         const uint32_t Argument);
+			static uint8_t SDCardManager_SendAppCommand(const uint8_t Command,
+			                                            const uint32_t Argument);
+			static bool SDCardManager_WaitForDataToken(void);
+			static bool SDCardManager_WaitWhileBusy(void);
+			static uint8_t SDCardManager_ReadBlockToEndpoint(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo);
+			static uint8_t SDCardManager_WriteBlockFromEndpoint(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo,
+			                                                    const uint8_t StartToken);
+		#endif
+
+#endif
+
@@ -75,6 +75,7 @@ int main(void)
 	for (;;)
 	{
 		MS_Device_USBTask(&Disk_MS_Interface);
+		BlockDevice_Task();
 		USB_USBTask();
 	}
 }
@@ -103,18 +104,15 @@ void SetupHardware(void)
 
 	/* Hardware Initialization */
 	LEDs_Init();
-	Dataflash_Init();
-	USB_Init();
 
-	/* Check if the Dataflash is working, abort if not */
-	if (!(DataflashManager_CheckDataflashOperation()))
+	/* Initialize the storage medium, abort if it is not present or not working */
+	if (!(BlockDevice_Init()))
 	{
 		LEDs_SetAllLEDs(LEDMASK_USB_ERROR);
 		for(;;);
 	}
 
-	/* Clear Dataflash sector protections, if enabled */
-	DataflashManager_ResetDataflashProtections();
+	USB_Init();
 }
 
 /** Event handler for the library USB Connection event. */
@@ -243,23 +243,18 @@ void DataflashManager_ReadBlocks(USB_ClassInfo_MS_Device_t* const MSInterfaceInf
 				Dataflash_SendByte(0x00);
 			}
 
-			/* Read one 16-byte chunk of data from the Dataflash */
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
+			/* Read one 16-byte chunk of data from the Dataflash, clocking in each byte while the previous one is
+			 * loaded into the endpoint bank so that the SPI transfers overlap the USB controller accesses */
+			Dataflash_BeginReceiveByte();
+
+			for (uint8_t ByteInChunk = 0; ByteInChunk < 15; ByteInChunk++)
+			{
+				uint8_t DataByte = Dataflash_EndReceiveByte();
+				Dataflash_BeginReceiveByte();
+				Endpoint_Write_8(DataByte);
+			}
+
+			Endpoint_Write_8(Dataflash_EndReceiveByte());
 
 			/* Increment the Dataflash page 16 byte block counter */
 			CurrDFPageByteDiv16++;
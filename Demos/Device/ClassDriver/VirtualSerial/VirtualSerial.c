@@ -66,10 +66,12 @@ USB_ClassInfo_CDC_Device_t VirtualSerial_CDC_Interface =
 			},
 	};
 
+#if defined(FDEV_SETUP_STREAM)
 /** Standard file stream for the CDC interface when set up, so that the virtual CDC COM port can be
  *  used like any regular character stream in the C APIs.
  */
 static FILE USBSerialStream;
+#endif
 
 
 /** Main program entry point. This routine contains the overall program flow, including initial
@@ -79,8 +81,10 @@ int main(void)
 {
 	SetupHardware();
 
+	#if defined(FDEV_SETUP_STREAM)
 	/* Create a regular character stream for the interface so that it can be used with the stdio.h functions */
 	CDC_Device_CreateStream(&VirtualSerial_CDC_Interface, &USBSerialStream);
+	#endif
 
 	LEDs_SetAllLEDs(LEDMASK_USB_NOTREADY);
 	GlobalInterruptEnable();
@@ -149,11 +153,16 @@ void CheckJoystickMovement(void)
 	{
 		ActionSent = true;
 
+		#if defined(FDEV_SETUP_STREAM)
 		/* Write the string to the virtual COM port via the created character stream */
 		fputs(ReportString, &USBSerialStream);
 
 		/* Alternatively, without the stream: */
 		// CDC_Device_SendString(&VirtualSerial_CDC_Interface, ReportString);
+		#else
+		/* Character streams require AVR-LibC, so write the string directly when they are unavailable */
+		CDC_Device_SendString(&VirtualSerial_CDC_Interface, ReportString);
+		#endif
 	}
 }
 
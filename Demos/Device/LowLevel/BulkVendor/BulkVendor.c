@@ -37,6 +37,11 @@
 #define  INCLUDE_FROM_BULKVENDOR_C
 #include "BulkVendor.h"
 
+#if defined(ASYNC_ENDPOINT_TRANSFERS)
+/** Buffer to hold the data echoed between the vendor OUT and IN endpoints by the asynchronous transfer callbacks. */
+static uint8_t VendorBuffer[VENDOR_IO_EPSIZE];
+#endif
+
 
 /** Main program entry point. This routine configures the hardware required by the application, then
  *  enters a loop to run the application tasks in sequence.
@@ -52,6 +57,7 @@ int main(void)
 	{
 		USB_USBTask();
 
+		#if !defined(ASYNC_ENDPOINT_TRANSFERS)
 		uint8_t ReceivedData[VENDOR_IO_EPSIZE];
 		memset(ReceivedData, 0x00, sizeof(ReceivedData));
 
@@ -65,6 +71,7 @@ int main(void)
 			Endpoint_Write_Stream_LE(ReceivedData, VENDOR_IO_EPSIZE, NULL);
 			Endpoint_ClearIN();
 		}
+		#endif
 	}
 }
 
@@ -124,6 +131,12 @@ void EVENT_USB_Device_ConfigurationChanged(void)
 
 	/* Indicate endpoint configuration success or failure */
 	LEDs_SetAllLEDs(ConfigSuccess ? LEDMASK_USB_READY : LEDMASK_USB_ERROR);
+
+	#if defined(ASYNC_ENDPOINT_TRANSFERS)
+	/* Start listening for the first packet from the host */
+	if (ConfigSuccess)
+	  Endpoint_SubmitTransfer(VENDOR_OUT_EPADDR, VendorBuffer, sizeof(VendorBuffer), VendorOUTTransferComplete);
+	#endif
 }
 
 /** Event handler for the USB_ControlRequest event. This is used to catch and process control requests sent to
@@ -134,3 +147,39 @@ void EVENT_USB_Device_ControlRequest(void)
 {
 	// Process vendor specific control requests here
 }
+
+#if defined(ASYNC_ENDPOINT_TRANSFERS)
+/** Completion callback for the asynchronous vendor OUT endpoint transfer. This is executed from the USB controller's
+ *  endpoint interrupt once a packet has been received from the host, and queues it for echoing back to the host.
+ *
+ *  \param[in] Address           Address of the endpoint whose transfer has completed.
+ *  \param[in] BytesTransferred  Number of bytes received from the host.
+ *  \param[in] ErrorCode         A value from the \ref Endpoint_Stream_RW_ErrorCodes_t enum.
+ */
+static void VendorOUTTransferComplete(const uint8_t Address,
+                                      const uint16_t BytesTransferred,
+                                      const uint8_t ErrorCode)
+{
+	if (ErrorCode != ENDPOINT_RWSTREAM_NoError)
+	  return;
+
+	Endpoint_SubmitTransfer(VENDOR_IN_EPADDR, VendorBuffer, BytesTransferred, VendorINTransferComplete);
+}
+
+/** Completion callback for the asynchronous vendor IN endpoint transfer. This is executed from the USB controller's
+ *  endpoint interrupt once the echoed packet has been queued for the host, and starts listening for the next packet.
+ *
+ *  \param[in] Address           Address of the endpoint whose transfer has completed.
+ *  \param[in] BytesTransferred  Number of bytes sent to the host.
+ *  \param[in] ErrorCode         A value from the \ref Endpoint_Stream_RW_ErrorCodes_t enum.
+ */
+static void VendorINTransferComplete(const uint8_t Address,
+                                     const uint16_t BytesTransferred,
+                                     const uint8_t ErrorCode)
+{
+	if (ErrorCode != ENDPOINT_RWSTREAM_NoError)
+	  return;
+
+	Endpoint_SubmitTransfer(VENDOR_OUT_EPADDR, VendorBuffer, sizeof(VendorBuffer), VendorOUTTransferComplete);
+}
+#endif
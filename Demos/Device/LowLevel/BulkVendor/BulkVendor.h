@@ -72,5 +72,14 @@
 		void EVENT_USB_Device_ConfigurationChanged(void);
 		void EVENT_USB_Device_ControlRequest(void);
 
+		#if defined(INCLUDE_FROM_BULKVENDOR_C) && defined(ASYNC_ENDPOINT_TRANSFERS)
+			static void VendorOUTTransferComplete(const uint8_t Address,
+			                                      const uint16_t BytesTransferred,
+			                                      const uint8_t ErrorCode);
+			static void VendorINTransferComplete(const uint8_t Address,
+			                                     const uint16_t BytesTransferred,
+			                                     const uint8_t ErrorCode);
+		#endif
+
 #endif
 
@@ -9,13 +9,17 @@
 """
     LUFA Bulk Vendor device demo host test script. This script will send and
     receive a continuous stream of packets to/from to the device, to show
-    bidirectional communications.
+    bidirectional communications. When run with the "throughput" argument,
+    the script instead echoes full size packets through the device for a few
+    seconds and reports the achieved echo throughput, so that the blocking
+    and asynchronous (ASYNC_ENDPOINT_TRANSFERS) builds of the demo may be
+    compared.
 
     Requires PyUSB >= 1.0.0 (https://github.com/pyusb/pyusb).
 """
 
 import sys
-from time import sleep
+from time import sleep, time
 import usb.core
 import usb.util
 
@@ -42,6 +46,19 @@ def read(device):
     return packet
 
 
+def throughput(device, duration=5, packet_size=64):
+    packet = bytearray(x % 256 for x in range(packet_size))
+    total_bytes = 0
+
+    start_time = time()
+    while (time() - start_time) < duration:
+        device.write(usb.util.ENDPOINT_OUT | device_out_ep, packet, 0, 1000)
+        total_bytes += len(device.read(usb.util.ENDPOINT_IN | device_in_ep, packet_size, 0, 1000))
+    elapsed = time() - start_time
+
+    print("Echoed {0} bytes in {1:.2f}s - {2:.1f} KB/s".format(total_bytes, elapsed, total_bytes / elapsed / 1024))
+
+
 def main():
     vendor_device = get_vendor_device_handle()
 
@@ -56,6 +73,10 @@ def main():
            usb.util.get_string(vendor_device, vendor_device.iProduct),
            usb.util.get_string(vendor_device, vendor_device.iManufacturer)))
 
+    if len(sys.argv) > 1 and sys.argv[1] == "throughput":
+        throughput(vendor_device)
+        return
+
     x = 0
     while 1:
     	x = x + 1 % 255
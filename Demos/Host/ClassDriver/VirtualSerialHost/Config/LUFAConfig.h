@@ -84,6 +84,9 @@
 //		#define HOST_DEVICE_SETTLE_DELAY_MS	     {Insert Value Here}
 //		#define NO_AUTO_VBUS_MANAGEMENT
 //		#define INVERTED_VBUS_ENABLE_LINE
+		#define HOST_ENUM_CACHE
+//		#define HOST_ENUM_CACHE_SLOTS            {Insert Value Here}
+//		#define HOST_ENUM_CACHE_DATA_SIZE        {Insert Value Here}
 
 	#else
 
@@ -62,6 +62,13 @@ USB_ClassInfo_CDC_Host_t VirtualSerial_CDC_Interface =
 			},
 	};
 
+#if defined(HOST_ENUM_CACHE)
+/** Non-volatile storage for the library's host enumeration cache, used to skip the retrieval and parsing of the
+ *  configuration descriptor of previously seen devices.
+ */
+static uint8_t EEMEM EnumCacheStorage[HOST_ENUM_CACHE_STORAGE_SIZE];
+#endif
+
 
 /** Main program entry point. This routine configures the hardware required by the application, then
  *  enters a loop to run the application tasks in sequence.
@@ -147,23 +154,45 @@ void EVENT_USB_Host_DeviceEnumerationComplete(void)
 {
 	LEDs_SetAllLEDs(LEDMASK_USB_ENUMERATING);
 
-	uint16_t ConfigDescriptorSize;
-	uint8_t  ConfigDescriptorData[512];
+#if defined(HOST_ENUM_CACHE)
+	USB_Host_EnumCacheKey_t CacheKey;
 
-	if (USB_Host_GetDeviceConfigDescriptor(1, &ConfigDescriptorSize, ConfigDescriptorData,
-	                                       sizeof(ConfigDescriptorData)) != HOST_GETCONFIG_Successful)
+	if (USB_Host_GetEnumCacheKey(1, &CacheKey) != HOST_GETCONFIG_Successful)
 	{
-		puts_P(PSTR("Error Retrieving Configuration Descriptor.\r\n"));
+		puts_P(PSTR("Error Retrieving Device Descriptors.\r\n"));
 		LEDs_SetAllLEDs(LEDMASK_USB_ERROR);
 		return;
 	}
 
-	if (CDC_Host_ConfigurePipes(&VirtualSerial_CDC_Interface,
-	                            ConfigDescriptorSize, ConfigDescriptorData) != CDC_ENUMERROR_NoError)
+	if (CDCHost_RestoreCachedInterface(&CacheKey))
 	{
-		puts_P(PSTR("Attached Device Not a Valid CDC Class Device.\r\n"));
-		LEDs_SetAllLEDs(LEDMASK_USB_ERROR);
-		return;
+		puts_P(PSTR("Restored Cached Configuration.\r\n"));
+	}
+	else
+#endif
+	{
+		uint16_t ConfigDescriptorSize;
+		uint8_t  ConfigDescriptorData[512];
+
+		if (USB_Host_GetDeviceConfigDescriptor(1, &ConfigDescriptorSize, ConfigDescriptorData,
+		                                       sizeof(ConfigDescriptorData)) != HOST_GETCONFIG_Successful)
+		{
+			puts_P(PSTR("Error Retrieving Configuration Descriptor.\r\n"));
+			LEDs_SetAllLEDs(LEDMASK_USB_ERROR);
+			return;
+		}
+
+		if (CDC_Host_ConfigurePipes(&VirtualSerial_CDC_Interface,
+		                            ConfigDescriptorSize, ConfigDescriptorData) != CDC_ENUMERROR_NoError)
+		{
+			puts_P(PSTR("Attached Device Not a Valid CDC Class Device.\r\n"));
+			LEDs_SetAllLEDs(LEDMASK_USB_ERROR);
+			return;
+		}
+
+		#if defined(HOST_ENUM_CACHE)
+		USB_Host_SaveEnumCache(&CacheKey, &VirtualSerial_CDC_Interface, sizeof(VirtualSerial_CDC_Interface));
+		#endif
 	}
 
 	if (USB_Host_SetDeviceConfiguration(1) != HOST_SENDCONTROL_Successful)
@@ -215,3 +244,47 @@ void EVENT_USB_Host_DeviceEnumerationFailed(const uint8_t ErrorCode,
 	LEDs_SetAllLEDs(LEDMASK_USB_ERROR);
 }
 
+
+#if defined(HOST_ENUM_CACHE)
+/** Restores the CDC interface configuration and state of a previously seen device from the host enumeration cache,
+ *  and configures the pipes required to communicate with it.
+ *
+ *  \param[in] CacheKey  Pointer to the enumeration cache key of the attached device.
+ *
+ *  \return Boolean \c true if the interface was restored from the cache, \c false if a full enumeration is required.
+ */
+bool CDCHost_RestoreCachedInterface(const USB_Host_EnumCacheKey_t* const CacheKey)
+{
+	if (!(USB_Host_LoadEnumCache(CacheKey, &VirtualSerial_CDC_Interface, sizeof(VirtualSerial_CDC_Interface))))
+	  return false;
+
+	if (!(Pipe_ConfigurePipeTable(&VirtualSerial_CDC_Interface.Config.DataINPipe, 1)) ||
+	    !(Pipe_ConfigurePipeTable(&VirtualSerial_CDC_Interface.Config.DataOUTPipe, 1)) ||
+	    !(Pipe_ConfigurePipeTable(&VirtualSerial_CDC_Interface.Config.NotificationPipe, 1)))
+	{
+		USB_Host_InvalidateEnumCache(CacheKey);
+		return false;
+	}
+
+	return true;
+}
+
+/** Enumeration cache storage read callback, reading the requested cache data from the AVR's EEPROM. */
+void CALLBACK_USB_Host_ReadEnumCache(const uint16_t Offset,
+                                     void* const Buffer,
+                                     const uint16_t Length)
+{
+	eeprom_read_block(Buffer, &EnumCacheStorage[Offset], Length);
+}
+
+/** Enumeration cache storage write callback, writing the given cache data to the AVR's EEPROM. Only bytes which differ
+ *  from the existing EEPROM contents are written, to reduce wear.
+ */
+void CALLBACK_USB_Host_WriteEnumCache(const uint16_t Offset,
+                                      const void* const Buffer,
+                                      const uint16_t Length)
+{
+	eeprom_update_block(Buffer, &EnumCacheStorage[Offset], Length);
+}
+#endif
+
@@ -42,6 +42,7 @@
 		#include <avr/pgmspace.h>
 		#include <avr/power.h>
 		#include <avr/interrupt.h>
+		#include <avr/eeprom.h>
 		#include <stdio.h>
 
 		#include <LUFA/Drivers/Misc/TerminalCodes.h>
@@ -74,5 +75,9 @@
 		                                            const uint8_t SubErrorCode);
 		void EVENT_USB_Host_DeviceEnumerationComplete(void);
 
+		#if defined(HOST_ENUM_CACHE)
+		bool CDCHost_RestoreCachedInterface(const USB_Host_EnumCacheKey_t* const CacheKey);
+		#endif
+
 #endif
 
@@ -48,6 +48,9 @@ else ifeq ($(ARCH), XMEGA)
 else ifeq ($(ARCH), UC3)
    ATPROGRAM_FLASH_FLAGS  := --erase
    ATPROGRAM_EEPROM_FLAGS := --eeprom
+else ifeq ($(ARCH), POSIX)
+   ATPROGRAM_FLASH_FLAGS   = $(error Host-native POSIX applications cannot be programmed into a device)
+   ATPROGRAM_EEPROM_FLAGS  = $(ATPROGRAM_FLASH_FLAGS)
 else
    $(error Unsupported architecture "$(ARCH)")
 endif
@@ -59,6 +59,8 @@ else ifeq ($(ARCH), XMEGA)
    CROSS        := $(COMPILER_PATH)avr
 else ifeq ($(ARCH), UC3)
    CROSS        := $(COMPILER_PATH)avr32
+else ifeq ($(ARCH), POSIX)
+   CROSS        := $(COMPILER_PATH)$(shell gcc -dumpmachine)
 else
    $(error Unsupported architecture "$(ARCH)")
 endif
@@ -122,7 +124,9 @@ ifneq ($(F_CPU),)
    BASE_CC_FLAGS += -DF_CPU=$(F_CPU)UL
 endif
 ifeq ($(LINKER_RELAXATIONS), Y)
-   BASE_CC_FLAGS += -mrelax
+   ifneq ($(ARCH), POSIX)
+      BASE_CC_FLAGS += -mrelax
+   endif
 endif
 ifeq ($(JUMP_TABLES), N)
    # This flag is required for bootloaders as GCC will emit invalid jump table
@@ -145,7 +149,9 @@ BASE_ASM_FLAGS := -x assembler-with-cpp
 # Create a list of flags to pass to the linker
 BASE_LD_FLAGS := -lm -Wl,-Map=$(TARGET).map,--cref -Wl,--gc-sections
 ifeq ($(LINKER_RELAXATIONS), Y)
-   BASE_LD_FLAGS += -Wl,--relax
+   ifneq ($(ARCH), POSIX)
+      BASE_LD_FLAGS += -Wl,--relax
+   endif
 endif
 ifneq ($(findstring $(ARCH), AVR8 XMEGA),)
    BASE_LD_FLAGS += -mmcu=$(MCU)
@@ -155,7 +161,7 @@ endif
 
 # Determine flags to pass to the size utility based on its reported features (only invoke if size target required)
 # and on an architecture where this non-standard patch is available
-ifneq ($(ARCH), UC3)
+ifneq ($(findstring $(ARCH), AVR8 XMEGA),)
 size: SIZE_MCU_FLAG    := $(shell $(CROSS)-size --help | grep -- --mcu > /dev/null && echo --mcu=$(MCU) )
 size: SIZE_FORMAT_FLAG := $(shell $(CROSS)-size --help | grep -- --format=.*avr > /dev/null && echo --format=avr )
 endif
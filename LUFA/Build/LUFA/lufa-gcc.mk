@@ -41,6 +41,26 @@ endif
 LUFA_CXX_INCLUDES = -I. -I$(patsubst %/,%,$(LUFA_PATH))/..
 LUFA_CXX_DEFINES  = -DARCH=ARCH_$(ARCH) -DBOARD=BOARD_$(BOARD) -DF_USB=$(F_USB)UL
 
+# The host-native POSIX architecture substitutes the AVR-LibC headers used by the demos, and requires 16-bit
+# wide characters to match the UTF-16 string descriptor layout
+ifeq ($(ARCH), POSIX)
+   LUFA_CXX_INCLUDES += -I$(patsubst %/,%,$(LUFA_PATH))/Platform/POSIX/Include
+   LUFA_CXX_FLAGS    += -fshort-wchar
+
+   DMBS_BUILD_TARGETS       += vhost-test
+   DMBS_BUILD_OPTIONAL_VARS += VHOST_TEST_PATH
+   VHOST_TEST_PATH          ?= VirtualHost
+
+# Runs the host-native application against each virtual host script (*.vhost) in the test path, comparing the virtual
+# host transcript against the expected output (*.expected) stored alongside each script
+vhost-test: $(TARGET).elf
+	@for Script in $(sort $(wildcard $(VHOST_TEST_PATH)/*.vhost)); do                                    \
+	   echo ' [VHOST]   :' Running virtual host script \"$$Script\";                                     \
+	   Transcript=`LUFA_VHOST_SCRIPT=$$Script ./$(TARGET).elf < /dev/null` || exit 1;                     \
+	   echo "$$Transcript" | diff -u $${Script%.vhost}.expected - || exit 1;                               \
+	done
+endif
+
 # LUFA specific standard build options
 C_FLAGS   += $(LUFA_CXX_INCLUDES) $(LUFA_CXX_DEFINES) $(LUFA_CXX_FLAGS)
 CPP_FLAGS += $(LUFA_CXX_INCLUDES) $(LUFA_CXX_DEFINES) $(LUFA_CXX_FLAGS)
@@ -17,7 +17,8 @@ DMBS_BUILD_PROVIDED_VARS   += LUFA_SRC_USB_DEVICE LUFA_SRC_USB_HOST    \
                               LUFA_SRC_USB LUFA_SRC_USBCLASS_DEVICE    \
                               LUFA_SRC_USBCLASS_HOST LUFA_SRC_USBCLASS \
                               LUFA_SRC_TEMPERATURE LUFA_SRC_SERIAL     \
-                              LUFA_SRC_TWI LUFA_SRC_PLATFORM
+                              LUFA_SRC_TWI LUFA_SRC_DATAFLASHFTL       \
+                              LUFA_SRC_PLATFORM
 DMBS_BUILD_PROVIDED_MACROS +=
 
 SHELL = /bin/sh
@@ -42,10 +43,16 @@ LUFA_SRC_USB_COMMON      := $(LUFA_ROOT_PATH)/Drivers/USB/Core/$(ARCH)/USBContro
                             $(LUFA_ROOT_PATH)/Drivers/USB/Core/USBTask.c                         \
                             $(LUFA_ROOT_PATH)/Drivers/USB/Class/Common/HIDParser.c               \
 
+ifeq ($(ARCH), POSIX)
+   LUFA_SRC_USB_COMMON   += $(LUFA_ROOT_PATH)/Drivers/USB/Core/$(ARCH)/VirtualHost_$(ARCH).c
+endif
+
 LUFA_SRC_USB_HOST        := $(LUFA_ROOT_PATH)/Drivers/USB/Core/$(ARCH)/Host_$(ARCH).c            \
                             $(LUFA_ROOT_PATH)/Drivers/USB/Core/$(ARCH)/Pipe_$(ARCH).c            \
                             $(LUFA_ROOT_PATH)/Drivers/USB/Core/$(ARCH)/PipeStream_$(ARCH).c      \
                             $(LUFA_ROOT_PATH)/Drivers/USB/Core/HostStandardReq.c                 \
+                            $(LUFA_ROOT_PATH)/Drivers/USB/Core/PipeScheduler.c                   \
+                            $(LUFA_ROOT_PATH)/Drivers/USB/Core/EnumerationCache.c                \
                             $(LUFA_SRC_USB_COMMON)
 
 LUFA_SRC_USB_DEVICE      := $(LUFA_ROOT_PATH)/Drivers/USB/Core/$(ARCH)/Device_$(ARCH).c          \
@@ -83,9 +90,14 @@ LUFA_SRC_SERIAL          := $(LUFA_ROOT_PATH)/Drivers/Peripheral/$(ARCH)/Serial_
 
 LUFA_SRC_TWI             := $(LUFA_ROOT_PATH)/Drivers/Peripheral/$(ARCH)/TWI_$(ARCH).c
 
+LUFA_SRC_DATAFLASHFTL    := $(LUFA_ROOT_PATH)/Drivers/Misc/DataflashFTL.c
+
 ifeq ($(ARCH), UC3)
    LUFA_SRC_PLATFORM     := $(LUFA_ROOT_PATH)/Platform/UC3/Exception.S   \
                             $(LUFA_ROOT_PATH)/Platform/UC3/InterruptManagement.c
+else ifeq ($(ARCH), POSIX)
+   LUFA_SRC_PLATFORM     := $(LUFA_ROOT_PATH)/Platform/POSIX/VirtualBoard.c   \
+                            $(LUFA_ROOT_PATH)/Platform/POSIX/VirtualSDCard.c
 else
    LUFA_SRC_PLATFORM     :=
 endif
@@ -96,6 +108,7 @@ LUFA_SRC_ALL_FILES   := $(LUFA_SRC_USB)            \
                         $(LUFA_SRC_TEMPERATURE)    \
                         $(LUFA_SRC_SERIAL)         \
                         $(LUFA_SRC_TWI)            \
+                        $(LUFA_SRC_DATAFLASHFTL)   \
                         $(LUFA_SRC_PLATFORM)
 
 endif
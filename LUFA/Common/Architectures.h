@@ -70,6 +70,11 @@
 			/** Selects the Atmel XMEGA AVR (ATXMEGA* chips) architecture. */
 			#define ARCH_XMEGA          2
 
+			/** Selects the host-native POSIX architecture, where the USB controller is simulated in software and driven by
+			 *  a virtual host. This allows the USB core and class drivers to be executed and profiled on a development PC.
+			 */
+			#define ARCH_POSIX          3
+
 			#if !defined(__DOXYGEN__)
 				#define ARCH_           ARCH_AVR8
 
@@ -246,6 +246,11 @@
 			/** Selects the Atmel Xplained-MINI specific board drivers, including the driver for the board LEDs. */
 			#define BOARD_XPLAINED_MINI        60
 
+			/** Selects the simulated board drivers for the host-native POSIX architecture, including the drivers for the
+			 *  board LEDs, Buttons, Joystick and Dataflash.
+			 */
+			#define BOARD_VIRTUAL              61
+
 			#if !defined(__DOXYGEN__)
 				#define BOARD_                 BOARD_NONE
 
@@ -139,6 +139,38 @@
 			#define ARCH_HAS_MULTI_ADDRESS_SPACE
 			#define ARCH_LITTLE_ENDIAN
 
+			#include "Endianness.h"
+		#elif (ARCH == ARCH_POSIX)
+			#include <unistd.h>
+			#include <math.h>
+
+			#define PROGMEM
+			#define PSTR(s)                  (s)
+			#define pgm_read_byte(x)         (*(const uint8_t*)(x))
+			#define pgm_read_word(x)         (*(const uint16_t*)(x))
+			#define pgm_read_dword(x)        (*(const uint32_t*)(x))
+			#define pgm_read_ptr(x)          (*(void* const*)(x))
+			#define memcmp_P(...)            memcmp(__VA_ARGS__)
+			#define memcpy_P(...)            memcpy(__VA_ARGS__)
+			#define strlen_P(...)            strlen(__VA_ARGS__)
+			#define strcmp_P(...)            strcmp(__VA_ARGS__)
+			#define strncmp_P(...)           strncmp(__VA_ARGS__)
+			#define strcpy_P(...)            strcpy(__VA_ARGS__)
+			#define strncpy_P(...)           strncpy(__VA_ARGS__)
+			#define printf_P(...)            printf(__VA_ARGS__)
+			#define sprintf_P(...)           sprintf(__VA_ARGS__)
+			#define puts_P(...)              puts(__VA_ARGS__)
+
+			#define ISR(Name, ...)           void Name (void)
+
+			typedef uint8_t uint_reg_t;
+
+			#if (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+				#define ARCH_BIG_ENDIAN
+			#else
+				#define ARCH_LITTLE_ENDIAN
+			#endif
+
 			#include "Endianness.h"
 		#else
 			#error Unknown device architecture specified.
@@ -291,6 +323,8 @@
 					while (Milliseconds--)
 					  _delay_ms(1);
 				}
+				#elif (ARCH == ARCH_POSIX)
+				usleep((useconds_t)Milliseconds * 1000);
 				#endif
 			}
 
@@ -313,6 +347,8 @@
 				return __builtin_mfsr(AVR32_SR);
 				#elif (ARCH == ARCH_XMEGA)
 				return SREG;
+				#elif (ARCH == ARCH_POSIX)
+				return 0;
 				#endif
 			}
 
@@ -216,6 +216,19 @@
 			 */
 			static inline uint8_t Dataflash_ReceiveByte(void) ATTR_ALWAYS_INLINE ATTR_WARN_UNUSED_RESULT;
 
+			/** Starts receiving a byte from the currently selected dataflash IC by sending a dummy byte, without waiting for
+			 *  the transfer to complete, so that other work can be done while the byte is shifted. Each call must be followed
+			 *  by a call to \ref Dataflash_EndReceiveByte() before the next transfer with the dataflash is started.
+			 */
+			static inline void Dataflash_BeginReceiveByte(void) ATTR_ALWAYS_INLINE;
+
+			/** Completes the reception of a byte started by \ref Dataflash_BeginReceiveByte(), waiting until the transfer is
+			 *  complete.
+			 *
+			 *  \return Last response byte from the dataflash
+			 */
+			static inline uint8_t Dataflash_EndReceiveByte(void) ATTR_ALWAYS_INLINE ATTR_WARN_UNUSED_RESULT;
+
 		/* Includes: */
 			#if (BOARD == BOARD_NONE)
 				#define DATAFLASH_TOTALCHIPS  0
@@ -227,6 +240,8 @@
 				static inline uint8_t Dataflash_TransferByte(const uint8_t Byte) { return 0; };
 				static inline void    Dataflash_SendByte(const uint8_t Byte) {};
 				static inline uint8_t Dataflash_ReceiveByte(void) { return 0; };
+				static inline void    Dataflash_BeginReceiveByte(void) {};
+				static inline uint8_t Dataflash_EndReceiveByte(void) { return 0; };
 				static inline uint8_t Dataflash_GetSelectedChip(void) { return 0; };
 				static inline void    Dataflash_SelectChip(const uint8_t ChipMask) {};
 				static inline void    Dataflash_DeselectChip(void) {};
@@ -249,6 +264,8 @@
 				#include "XMEGA/A3BU_XPLAINED/Dataflash.h"
 			#elif (BOARD == BOARD_B1_XPLAINED)
 				#include "XMEGA/B1_XPLAINED/Dataflash.h"
+			#elif (BOARD == BOARD_VIRTUAL)
+				#include "POSIX/VIRTUAL/Dataflash.h"
 			#else
 				#include "Board/Dataflash.h"
 			#endif
@@ -122,6 +122,8 @@
 			#include "UC3/EVK1101/Joystick.h"
 		#elif (BOARD == BOARD_EVK1100)
 			#include "UC3/EVK1100/Joystick.h"
+		#elif (BOARD == BOARD_VIRTUAL)
+			#include "POSIX/VIRTUAL/Joystick.h"
 		#else
 			#include "Board/Joystick.h"
 		#endif
@@ -0,0 +1,91 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2018.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2018  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *  \brief Board specific information header for the POSIX virtual board.
+ *  \copydetails Group_BoardInfo_VIRTUAL
+ *
+ *  \note This file should not be included directly. It is automatically included as needed by the Board driver
+ *        dispatch header located in LUFA/Drivers/Board/Board.h.
+ */
+
+/** \ingroup Group_BoardInfo
+ *  \defgroup Group_BoardInfo_VIRTUAL VIRTUAL
+ *  \brief Board specific information header for the POSIX virtual board.
+ *
+ *  Board specific information header for the simulated board of the host-native POSIX architecture. The board
+ *  hardware is simulated by the \ref Group_PlatformDrivers_POSIXVirtualBoard module.
+ *
+ *  @{
+ */
+
+#ifndef __BOARD_VIRTUAL_H__
+#define __BOARD_VIRTUAL_H__
+
+	/* Includes: */
+		#include "../../../../Common/Common.h"
+		#include "../../Buttons.h"
+		#include "../../Dataflash.h"
+		#include "../../Joystick.h"
+		#include "../../LEDs.h"
+
+	/* Enable C linkage for C++ Compilers: */
+		#if defined(__cplusplus)
+			extern "C" {
+		#endif
+
+	/* Preprocessor Checks: */
+		#if !defined(__INCLUDE_FROM_BOARD_H)
+			#error Do not include this file directly. Include LUFA/Drivers/Board/Board.h instead.
+		#endif
+
+	/* Public Interface - May be used in end-application: */
+		/* Macros: */
+			/** Indicates the board has hardware Buttons mounted. */
+			#define BOARD_HAS_BUTTONS
+
+			/** Indicates the board has a hardware Dataflash mounted. */
+			#define BOARD_HAS_DATAFLASH
+
+			/** Indicates the board has a hardware Joystick mounted. */
+			#define BOARD_HAS_JOYSTICK
+
+			/** Indicates the board has hardware LEDs mounted. */
+			#define BOARD_HAS_LEDS
+
+	/* Disable C linkage for C++ Compilers: */
+		#if defined(__cplusplus)
+			}
+		#endif
+
+#endif
+
+/** @} */
+
@@ -0,0 +1,789 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2018.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2018  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+#define  __INCLUDE_FROM_DATAFLASHFTL_C
+#include "DataflashFTL.h"
+
+/** Physical pages of the current version of each translation page. */
+static uint16_t MapPages[FTL_MAP_PAGES];
+
+/** Physical pages of the previous version of each translation page, retained until it is next rewritten so that the
+ *  page map can be recovered if the current version was only partially programmed when power was lost.
+ */
+static uint16_t PrevMapPages[FTL_MAP_PAGES];
+
+/** Page map updates not yet written to the translation pages, oldest first. */
+static DataflashFTL_MapUpdate_t PendingUpdates[FTL_PENDING_UPDATES];
+
+/** Number of entries in \ref PendingUpdates. */
+static uint8_t PendingUpdateCount;
+
+/** Unused pages of each Dataflash IC which have been erased ahead of time, oldest first. */
+static DataflashFTL_ErasedPage_t ErasedPages[DATAFLASH_TOTALCHIPS][FTL_ERASED_POOL_PAGES];
+
+/** Number of entries of each Dataflash IC in \ref ErasedPages. */
+static uint8_t ErasedPageCount[DATAFLASH_TOTALCHIPS];
+
+/** Next physical page of each Dataflash IC to be examined for reuse, advancing circularly over the IC. */
+static uint16_t NextPage[DATAFLASH_TOTALCHIPS];
+
+/** Write sequence number to be given to the next page written. */
+static uint32_t NextSequence;
+
+/** Dataflash IC to be examined on the next call to \ref DataflashFTL_Task(). */
+static uint8_t TaskChipIndex;
+
+/** Translation layer wear statistics, retrieved via \ref DataflashFTL_GetStats(). */
+static DataflashFTL_Stats_t FTLStats;
+
+bool DataflashFTL_Init(void)
+{
+	uint32_t MapSequence[FTL_MAP_PAGES];
+	uint32_t PrevMapSequence[FTL_MAP_PAGES];
+	uint32_t LastSequence[DATAFLASH_TOTALCHIPS];
+	uint32_t RecoveredSequence[FTL_PENDING_UPDATES];
+	uint16_t MapPagesFound  = 0;
+	uint16_t DataPagesFound = 0;
+
+	DataflashFTL_PageHeader_t Header;
+
+	for (uint16_t MapIndex = 0; MapIndex < FTL_MAP_PAGES; MapIndex++)
+	{
+		MapPages[MapIndex]        = FTL_NO_PAGE;
+		PrevMapPages[MapIndex]    = FTL_NO_PAGE;
+		MapSequence[MapIndex]     = 0;
+		PrevMapSequence[MapIndex] = 0;
+	}
+
+	for (uint8_t ChipIndex = 0; ChipIndex < DATAFLASH_TOTALCHIPS; ChipIndex++)
+	{
+		ErasedPageCount[ChipIndex] = 0;
+		LastSequence[ChipIndex]    = 0;
+		NextPage[ChipIndex]        = (DATAFLASH_FTL_LOGICAL_PAGES + ChipIndex);
+	}
+
+	PendingUpdateCount = 0;
+	NextSequence       = 1;
+	TaskChipIndex      = 0;
+
+	FTLStats = (DataflashFTL_Stats_t){.MinEraseCount = UINT32_MAX};
+
+	/* Find the newest two versions of each translation page, the wear range and the newest page of each Dataflash IC */
+	for (uint16_t PhysicalPage = 0; PhysicalPage < FTL_TOTAL_PAGES; PhysicalPage++)
+	{
+		uint8_t ChipIndex = (PhysicalPage % DATAFLASH_TOTALCHIPS);
+
+		DataflashFTL_ReadHeader(PhysicalPage, &Header);
+
+		FTLStats.MinEraseCount = MIN(FTLStats.MinEraseCount, Header.EraseCount);
+		FTLStats.MaxEraseCount = MAX(FTLStats.MaxEraseCount, Header.EraseCount);
+
+		if (Header.Type == FTL_PAGE_TYPE_NONE)
+		  continue;
+
+		if (Header.Sequence >= NextSequence)
+		  NextSequence = (Header.Sequence + 1);
+
+		/* Writes resume after the most recently written page of each Dataflash IC */
+		if (Header.Sequence > LastSequence[ChipIndex])
+		{
+			LastSequence[ChipIndex] = Header.Sequence;
+			NextPage[ChipIndex]     = (PhysicalPage + DATAFLASH_TOTALCHIPS);
+
+			if (NextPage[ChipIndex] >= FTL_TOTAL_PAGES)
+			  NextPage[ChipIndex] = ChipIndex;
+		}
+
+		if (Header.Type == FTL_PAGE_TYPE_DATA)
+		{
+			DataPagesFound++;
+		}
+		else
+		{
+			uint16_t MapIndex = Header.Index;
+
+			if (Header.Sequence > MapSequence[MapIndex])
+			{
+				if (MapPages[MapIndex] == FTL_NO_PAGE)
+				  MapPagesFound++;
+
+				PrevMapPages[MapIndex]    = MapPages[MapIndex];
+				PrevMapSequence[MapIndex] = MapSequence[MapIndex];
+				MapPages[MapIndex]        = PhysicalPage;
+				MapSequence[MapIndex]     = Header.Sequence;
+			}
+			else if (Header.Sequence > PrevMapSequence[MapIndex])
+			{
+				PrevMapPages[MapIndex]    = PhysicalPage;
+				PrevMapSequence[MapIndex] = Header.Sequence;
+			}
+		}
+	}
+
+	/* Without a complete page map, only a Dataflash holding no data pages (such as on first use) can be formatted */
+	if (MapPagesFound != FTL_MAP_PAGES)
+	{
+		if (DataPagesFound)
+		  return false;
+
+		DataflashFTL_Format();
+		return true;
+	}
+
+	/* Fall back to the previous version of any translation page which was only partially programmed */
+	for (uint16_t MapIndex = 0; MapIndex < FTL_MAP_PAGES; MapIndex++)
+	{
+		DataflashFTL_ReadHeader(MapPages[MapIndex], &Header);
+
+		if (DataflashFTL_GetMapPageCRC(MapPages[MapIndex]) == Header.DataCRC)
+		  continue;
+
+		/* Only one translation page is written at a time, so its previous version must be intact */
+		if (PrevMapPages[MapIndex] == FTL_NO_PAGE)
+		  return false;
+
+		DataflashFTL_ReadHeader(PrevMapPages[MapIndex], &Header);
+
+		if (DataflashFTL_GetMapPageCRC(PrevMapPages[MapIndex]) != Header.DataCRC)
+		  return false;
+
+		MapPages[MapIndex]     = PrevMapPages[MapIndex];
+		MapSequence[MapIndex]  = PrevMapSequence[MapIndex];
+		PrevMapPages[MapIndex] = FTL_NO_PAGE;
+	}
+
+	/* Recover the page map updates which were still held in SRAM, from the data pages newer than their translation page */
+	for (uint16_t PhysicalPage = 0; PhysicalPage < FTL_TOTAL_PAGES; PhysicalPage++)
+	{
+		DataflashFTL_ReadHeader(PhysicalPage, &Header);
+
+		if ((Header.Type != FTL_PAGE_TYPE_DATA) ||
+		    (Header.Sequence <= MapSequence[Header.Index / FTL_MAP_ENTRIES_PER_PAGE]))
+		{
+			continue;
+		}
+
+		uint8_t UpdateIndex;
+
+		for (UpdateIndex = 0; UpdateIndex < PendingUpdateCount; UpdateIndex++)
+		{
+			if (PendingUpdates[UpdateIndex].LogicalPage == Header.Index)
+			  break;
+		}
+
+		/* At most half of the pending updates were unwritten and half in a lost translation page, so more cannot be valid */
+		if (UpdateIndex == PendingUpdateCount)
+		{
+			if (PendingUpdateCount == FTL_PENDING_UPDATES)
+			  return false;
+
+			PendingUpdateCount++;
+		}
+		else if (RecoveredSequence[UpdateIndex] > Header.Sequence)
+		{
+			continue;
+		}
+
+		PendingUpdates[UpdateIndex]    = (DataflashFTL_MapUpdate_t){.LogicalPage = Header.Index, .PhysicalPage = PhysicalPage};
+		RecoveredSequence[UpdateIndex] = Header.Sequence;
+	}
+
+	return true;
+}
+
+uint16_t DataflashFTL_GetPhysicalPage(const uint16_t LogicalPage)
+{
+	if (LogicalPage >= DATAFLASH_FTL_LOGICAL_PAGES)
+	  return DATAFLASH_FTL_NO_PAGE;
+
+	for (uint8_t UpdateIndex = 0; UpdateIndex < PendingUpdateCount; UpdateIndex++)
+	{
+		if (PendingUpdates[UpdateIndex].LogicalPage == LogicalPage)
+		  return PendingUpdates[UpdateIndex].PhysicalPage;
+	}
+
+	uint16_t MapPage = MapPages[LogicalPage / FTL_MAP_ENTRIES_PER_PAGE];
+	uint16_t PhysicalPage;
+
+	DataflashFTL_SelectPage(MapPage);
+	Dataflash_SendByte(DF_CMD_MAINMEMPAGEREAD);
+	Dataflash_SendAddressBytes(MapPage, ((LogicalPage % FTL_MAP_ENTRIES_PER_PAGE) * 2));
+	Dataflash_SendByte(0x00);
+	Dataflash_SendByte(0x00);
+	Dataflash_SendByte(0x00);
+	Dataflash_SendByte(0x00);
+
+	PhysicalPage  = Dataflash_ReceiveByte();
+	PhysicalPage |= ((uint16_t)Dataflash_ReceiveByte() << 8);
+
+	Dataflash_DeselectChip();
+
+	return PhysicalPage;
+}
+
+bool DataflashFTL_ProgramBuffer(const uint16_t LogicalPage,
+                                const bool UseSecondBuffer)
+{
+	if (LogicalPage >= DATAFLASH_FTL_LOGICAL_PAGES)
+	  return false;
+
+	uint32_t EraseCount;
+	bool     IsErased;
+	uint16_t PhysicalPage = DataflashFTL_AllocatePage((LogicalPage % DATAFLASH_TOTALCHIPS), &EraseCount, &IsErased);
+
+	DataflashFTL_SelectPage(PhysicalPage);
+	Dataflash_SendByte(UseSecondBuffer ? DF_CMD_BUFF2WRITE : DF_CMD_BUFF1WRITE);
+	Dataflash_SendAddressBytes(0, DATAFLASH_PAGE_SIZE);
+	DataflashFTL_SendHeader(FTL_PAGE_TYPE_DATA, LogicalPage, EraseCount, 0xFFFF);
+	Dataflash_ToggleSelectedChipCS();
+
+	/* Pages erased ahead of time are programmed without the slower erase cycle */
+	if (IsErased)
+	  Dataflash_SendByte(UseSecondBuffer ? DF_CMD_BUFF2TOMAINMEM : DF_CMD_BUFF1TOMAINMEM);
+	else
+	  Dataflash_SendByte(UseSecondBuffer ? DF_CMD_BUFF2TOMAINMEMWITHERASE : DF_CMD_BUFF1TOMAINMEMWITHERASE);
+
+	Dataflash_SendAddressBytes(PhysicalPage, 0);
+	Dataflash_DeselectChip();
+
+	FTLStats.PagesWritten++;
+
+	DataflashFTL_QueueMapUpdate(LogicalPage, PhysicalPage);
+
+	Dataflash_SelectChipFromPage(PhysicalPage);
+
+	return true;
+}
+
+void DataflashFTL_Task(void)
+{
+	uint8_t  ChipIndex = TaskChipIndex;
+	uint16_t PhysicalPage;
+
+	DataflashFTL_PageHeader_t Header;
+
+	TaskChipIndex = ((TaskChipIndex + 1) % DATAFLASH_TOTALCHIPS);
+
+	if (ErasedPageCount[ChipIndex] == FTL_ERASED_POOL_PAGES)
+	  return;
+
+	bool IsLive = DataflashFTL_ExamineNextPage(ChipIndex, &PhysicalPage, &Header);
+
+	/* Skip pages which were erased on a previous pass over the Dataflash IC and are still unused */
+	if (DataflashFTL_IsPageErased(ChipIndex, PhysicalPage))
+	  return;
+
+	if (IsLive)
+	{
+		/* Translation pages are rewritten on every map update, and so never hold on to a little used page */
+		if ((Header.Type == FTL_PAGE_TYPE_MAP) || !(ErasedPageCount[ChipIndex]) ||
+		    ((Header.EraseCount + DATAFLASH_FTL_WEAR_LIMIT) >= FTLStats.MaxEraseCount))
+		{
+			return;
+		}
+
+		DataflashFTL_RelocatePage(PhysicalPage, (Header.Type == FTL_PAGE_TYPE_DATA) ? Header.Index : PhysicalPage);
+	}
+
+	/* Erase the page, leaving a header which only records its new erase count so that it is retained over a power loss */
+	DataflashFTL_SelectPage(PhysicalPage);
+	Dataflash_SendByte(DF_CMD_BUFF2WRITE);
+	Dataflash_SendAddressBytes(0, 0);
+
+	for (uint16_t ByteNum = 0; ByteNum < DATAFLASH_PAGE_SIZE; ByteNum++)
+	  Dataflash_SendByte(0xFF);
+
+	DataflashFTL_SendHeader(FTL_PAGE_TYPE_NONE, 0, (Header.EraseCount + 1), 0);
+	Dataflash_ToggleSelectedChipCS();
+
+	Dataflash_SendByte(DF_CMD_BUFF2TOMAINMEMWITHERASE);
+	Dataflash_SendAddressBytes(PhysicalPage, 0);
+	Dataflash_DeselectChip();
+
+	ErasedPages[ChipIndex][ErasedPageCount[ChipIndex]++] =
+	    (DataflashFTL_ErasedPage_t){.PhysicalPage = PhysicalPage, .EraseCount = (Header.EraseCount + 1)};
+
+	FTLStats.PagesErased++;
+	FTLStats.MaxEraseCount = MAX(FTLStats.MaxEraseCount, (Header.EraseCount + 1));
+}
+
+DataflashFTL_Stats_t* DataflashFTL_GetStats(void)
+{
+	return &FTLStats;
+}
+
+/** Formats the Dataflash for the translation layer, writing translation pages which map each logical page onto the
+ *  physical page of the same address. The translation pages are placed at the start of the spare pages, which are
+ *  not mapped.
+ */
+static void DataflashFTL_Format(void)
+{
+	DataflashFTL_PageHeader_t Header;
+
+	for (uint16_t MapIndex = 0; MapIndex < FTL_MAP_PAGES; MapIndex++)
+	{
+		uint16_t PhysicalPage = (DATAFLASH_FTL_LOGICAL_PAGES + MapIndex);
+		uint16_t LogicalPage  = (MapIndex * FTL_MAP_ENTRIES_PER_PAGE);
+		uint16_t DataCRC      = 0xFFFF;
+
+		DataflashFTL_ReadHeader(PhysicalPage, &Header);
+
+		DataflashFTL_SelectPage(PhysicalPage);
+		Dataflash_SendByte(DF_CMD_BUFF2WRITE);
+		Dataflash_SendAddressBytes(0, 0);
+
+		for (uint16_t EntryIndex = 0; EntryIndex < FTL_MAP_ENTRIES_PER_PAGE; EntryIndex++)
+		{
+			uint16_t MappedPage = (LogicalPage < DATAFLASH_FTL_LOGICAL_PAGES) ? LogicalPage : FTL_NO_PAGE;
+
+			Dataflash_SendByte(MappedPage & 0xFF);
+			Dataflash_SendByte(MappedPage >> 8);
+
+			DataCRC = DataflashFTL_UpdateCRC(DataCRC, (MappedPage & 0xFF));
+			DataCRC = DataflashFTL_UpdateCRC(DataCRC, (MappedPage >> 8));
+
+			LogicalPage++;
+		}
+
+		/* The page header immediately follows the page data in the buffer */
+		DataflashFTL_SendHeader(FTL_PAGE_TYPE_MAP, MapIndex, (Header.EraseCount + 1), DataCRC);
+		Dataflash_ToggleSelectedChipCS();
+
+		Dataflash_SendByte(DF_CMD_BUFF2TOMAINMEMWITHERASE);
+		Dataflash_SendAddressBytes(PhysicalPage, 0);
+		Dataflash_DeselectChip();
+
+		MapPages[MapIndex] = PhysicalPage;
+	}
+
+	/* Start writing after the last translation page of each Dataflash IC */
+	for (uint8_t ChipIndex = 0; ChipIndex < DATAFLASH_TOTALCHIPS; ChipIndex++)
+	{
+		NextPage[ChipIndex] = (DATAFLASH_FTL_LOGICAL_PAGES + ChipIndex);
+
+		while (NextPage[ChipIndex] < (DATAFLASH_FTL_LOGICAL_PAGES + FTL_MAP_PAGES))
+		  NextPage[ChipIndex] += DATAFLASH_TOTALCHIPS;
+	}
+}
+
+/** Selects the Dataflash IC holding the given physical page, and waits until it is ready to accept a new command.
+ *
+ *  \param[in] PhysicalPage  Physical Dataflash page to be accessed
+ */
+static inline void DataflashFTL_SelectPage(const uint16_t PhysicalPage)
+{
+	Dataflash_SelectChipFromPage(PhysicalPage);
+	Dataflash_WaitWhileBusy();
+}
+
+/** Calculates the check value of a page header, from all header fields other than the check value itself.
+ *
+ *  \param[in] Header  Page header to calculate the check value of
+ *
+ *  \return Check value of the page header
+ */
+static uint8_t DataflashFTL_GetHeaderCheck(const DataflashFTL_PageHeader_t* const Header)
+{
+	const uint8_t* HeaderBytes = (const uint8_t*)Header;
+	uint8_t        Check       = 0x5A;
+
+	for (uint8_t ByteIndex = 0; ByteIndex < sizeof(DataflashFTL_PageHeader_t); ByteIndex++)
+	{
+		if (ByteIndex != offsetof(DataflashFTL_PageHeader_t, Check))
+		  Check ^= HeaderBytes[ByteIndex];
+	}
+
+	return Check;
+}
+
+/** Calculates the check value of a page header's erase count, which allows the erase count of a page erased ahead of
+ *  time to be recovered without a valid header.
+ *
+ *  \param[in] EraseCount  Erase count of the page
+ *
+ *  \return Check value of the erase count
+ */
+static uint16_t DataflashFTL_GetEraseCheck(const uint32_t EraseCount)
+{
+	return ((uint16_t)EraseCount ^ (uint16_t)(EraseCount >> 16) ^ 0xA55A);
+}
+
+/** Reads the header of a physical page. If the page does not hold a valid header, the header is returned with a type
+ *  of \ref FTL_PAGE_TYPE_NONE and the erase count recorded when the page was erased ahead of time, or zero if none.
+ *
+ *  \param[in]  PhysicalPage  Physical Dataflash page to read the header of
+ *  \param[out] Header        Location where the page header is to be stored
+ *
+ *  \return Boolean \c true if the page holds a valid header, \c false otherwise
+ */
+static bool DataflashFTL_ReadHeader(const uint16_t PhysicalPage,
+                                    DataflashFTL_PageHeader_t* const Header)
+{
+	uint8_t* HeaderBytes = (uint8_t*)Header;
+
+	DataflashFTL_SelectPage(PhysicalPage);
+	Dataflash_SendByte(DF_CMD_MAINMEMPAGEREAD);
+	Dataflash_SendAddressBytes(PhysicalPage, DATAFLASH_PAGE_SIZE);
+	Dataflash_SendByte(0x00);
+	Dataflash_SendByte(0x00);
+	Dataflash_SendByte(0x00);
+	Dataflash_SendByte(0x00);
+
+	for (uint8_t ByteIndex = 0; ByteIndex < sizeof(DataflashFTL_PageHeader_t); ByteIndex++)
+	  *(HeaderBytes++) = Dataflash_ReceiveByte();
+
+	Dataflash_DeselectChip();
+
+	bool IsValid = (Header->Check == DataflashFTL_GetHeaderCheck(Header)) &&
+	               (((Header->Type == FTL_PAGE_TYPE_DATA) && (Header->Index < DATAFLASH_FTL_LOGICAL_PAGES)) ||
+	                ((Header->Type == FTL_PAGE_TYPE_MAP)  && (Header->Index < FTL_MAP_PAGES)));
+
+	if (!(IsValid))
+	{
+		Header->Type = FTL_PAGE_TYPE_NONE;
+
+		if (Header->EraseCheck != DataflashFTL_GetEraseCheck(Header->EraseCount))
+		  Header->EraseCount = 0;
+	}
+
+	return IsValid;
+}
+
+/** Sends a new page header to the selected Dataflash IC, as part of a buffer write command addressing the spare bytes
+ *  of the buffer. The header is given the next write sequence number. A header of type \ref FTL_PAGE_TYPE_NONE only
+ *  records the erase count of a page erased ahead of time, leaving the other header bytes erased; as the header later
+ *  programmed over it holds the same erase count, the page can still be programmed without an erase cycle.
+ *
+ *  \param[in] Type        Type of the page contents, a \c FTL_PAGE_TYPE_* value
+ *  \param[in] Index       Logical page of a data page, or index of a translation page
+ *  \param[in] EraseCount  Erase count of the physical page the header is to be written to
+ *  \param[in] DataCRC     CRC16 of the contents of a translation page
+ */
+static void DataflashFTL_SendHeader(const uint8_t Type,
+                                    const uint16_t Index,
+                                    const uint32_t EraseCount,
+                                    const uint16_t DataCRC)
+{
+	DataflashFTL_PageHeader_t Header;
+
+	/* Erase count records leave all other header bytes erased */
+	memset(&Header, 0xFF, sizeof(DataflashFTL_PageHeader_t));
+
+	Header.EraseCount = EraseCount;
+	Header.EraseCheck = DataflashFTL_GetEraseCheck(EraseCount);
+
+	if (Type != FTL_PAGE_TYPE_NONE)
+	{
+		Header.Type     = Type;
+		Header.Index    = Index;
+		Header.Sequence = NextSequence++;
+		Header.DataCRC  = DataCRC;
+		Header.Check    = DataflashFTL_GetHeaderCheck(&Header);
+	}
+
+	const uint8_t* HeaderBytes = (const uint8_t*)&Header;
+
+	for (uint8_t ByteIndex = 0; ByteIndex < sizeof(DataflashFTL_PageHeader_t); ByteIndex++)
+	  Dataflash_SendByte(*(HeaderBytes++));
+
+	FTLStats.MaxEraseCount = MAX(FTLStats.MaxEraseCount, EraseCount);
+}
+
+/** Updates a CRC16 (CCITT polynomial) with the next byte of data.
+ *
+ *  \param[in] CRC   Current CRC value, initially 0xFFFF
+ *  \param[in] Data  Next byte of data
+ *
+ *  \return Updated CRC value
+ */
+static uint16_t DataflashFTL_UpdateCRC(uint16_t CRC,
+                                       const uint8_t Data)
+{
+	CRC ^= ((uint16_t)Data << 8);
+
+	for (uint8_t Bit = 0; Bit < 8; Bit++)
+	  CRC = (CRC & 0x8000) ? ((CRC << 1) ^ 0x1021) : (CRC << 1);
+
+	return CRC;
+}
+
+/** Calculates the CRC16 of the contents of a translation page, for comparison with the CRC stored in its header.
+ *
+ *  \param[in] PhysicalPage  Physical Dataflash page holding the translation page
+ *
+ *  \return CRC16 of the page contents
+ */
+static uint16_t DataflashFTL_GetMapPageCRC(const uint16_t PhysicalPage)
+{
+	uint16_t DataCRC = 0xFFFF;
+
+	DataflashFTL_SelectPage(PhysicalPage);
+	Dataflash_SendByte(DF_CMD_MAINMEMPAGEREAD);
+	Dataflash_SendAddressBytes(PhysicalPage, 0);
+	Dataflash_SendByte(0x00);
+	Dataflash_SendByte(0x00);
+	Dataflash_SendByte(0x00);
+	Dataflash_SendByte(0x00);
+
+	for (uint16_t ByteNum = 0; ByteNum < DATAFLASH_PAGE_SIZE; ByteNum++)
+	  DataCRC = DataflashFTL_UpdateCRC(DataCRC, Dataflash_ReceiveByte());
+
+	Dataflash_DeselectChip();
+
+	return DataCRC;
+}
+
+/** Determines if a physical page holds data which is still in use, and so must not be reused.
+ *
+ *  \param[in] PhysicalPage  Physical Dataflash page to check
+ *  \param[in] Header        Header of the physical page
+ *
+ *  \return Boolean \c true if the page is in use, \c false otherwise
+ */
+static bool DataflashFTL_IsPageLive(const uint16_t PhysicalPage,
+                                    const DataflashFTL_PageHeader_t* const Header)
+{
+	switch (Header->Type)
+	{
+		case FTL_PAGE_TYPE_DATA:
+			return (DataflashFTL_GetPhysicalPage(Header->Index) == PhysicalPage);
+		case FTL_PAGE_TYPE_MAP:
+			return ((MapPages[Header->Index] == PhysicalPage) || (PrevMapPages[Header->Index] == PhysicalPage));
+		default:
+			/* Pages without a header still hold their contents from before the Dataflash was formatted, if unmoved */
+			return ((PhysicalPage < DATAFLASH_FTL_LOGICAL_PAGES) &&
+			        (DataflashFTL_GetPhysicalPage(PhysicalPage) == PhysicalPage));
+	}
+}
+
+/** Determines if a physical page has been erased ahead of time and is waiting to be programmed.
+ *
+ *  \param[in] ChipIndex     Index of the Dataflash IC holding the page
+ *  \param[in] PhysicalPage  Physical Dataflash page to check
+ *
+ *  \return Boolean \c true if the page has been erased ahead of time, \c false otherwise
+ */
+static bool DataflashFTL_IsPageErased(const uint8_t ChipIndex,
+                                      const uint16_t PhysicalPage)
+{
+	for (uint8_t PoolIndex = 0; PoolIndex < ErasedPageCount[ChipIndex]; PoolIndex++)
+	{
+		if (ErasedPages[ChipIndex][PoolIndex].PhysicalPage == PhysicalPage)
+		  return true;
+	}
+
+	return false;
+}
+
+/** Reads the header of the next physical page of a Dataflash IC to be examined for reuse, and advances to the
+ *  following page.
+ *
+ *  \param[in]  ChipIndex     Index of the Dataflash IC to examine
+ *  \param[out] PhysicalPage  Location where the examined physical page is to be stored
+ *  \param[out] Header        Location where the header of the examined page is to be stored
+ *
+ *  \return Boolean \c true if the examined page is in use, \c false otherwise
+ */
+static bool DataflashFTL_ExamineNextPage(const uint8_t ChipIndex,
+                                         uint16_t* const PhysicalPage,
+                                         DataflashFTL_PageHeader_t* const Header)
+{
+	*PhysicalPage = NextPage[ChipIndex];
+
+	NextPage[ChipIndex] += DATAFLASH_TOTALCHIPS;
+
+	if (NextPage[ChipIndex] >= FTL_TOTAL_PAGES)
+	  NextPage[ChipIndex] = ChipIndex;
+
+	DataflashFTL_ReadHeader(*PhysicalPage, Header);
+
+	return DataflashFTL_IsPageLive(*PhysicalPage, Header);
+}
+
+/** Finds a fresh physical page of the given Dataflash IC to write, preferring pages erased ahead of time. Otherwise
+ *  the next unused page is taken, which must be erased as it is programmed. The Dataflash is only read.
+ *
+ *  \param[in]  ChipIndex   Index of the Dataflash IC to allocate a page from
+ *  \param[out] EraseCount  Location where the erase count of the page after programming is to be stored
+ *  \param[out] IsErased    Location where a flag indicating if the page has already been erased is to be stored
+ *
+ *  \return Physical Dataflash page to be written
+ */
+static uint16_t DataflashFTL_AllocatePage(const uint8_t ChipIndex,
+                                          uint32_t* const EraseCount,
+                                          bool* const IsErased)
+{
+	uint16_t PhysicalPage;
+
+	DataflashFTL_PageHeader_t Header;
+
+	if (ErasedPageCount[ChipIndex])
+	{
+		DataflashFTL_ErasedPage_t* ErasedPool = ErasedPages[ChipIndex];
+
+		PhysicalPage = ErasedPool[0].PhysicalPage;
+		*EraseCount  = ErasedPool[0].EraseCount;
+		*IsErased    = true;
+
+		ErasedPageCount[ChipIndex]--;
+
+		for (uint8_t PoolIndex = 0; PoolIndex < ErasedPageCount[ChipIndex]; PoolIndex++)
+		  ErasedPool[PoolIndex] = ErasedPool[PoolIndex + 1];
+
+		return PhysicalPage;
+	}
+
+	/* The spare pages guarantee that an unused page is always found within one pass over the Dataflash IC */
+	while (DataflashFTL_ExamineNextPage(ChipIndex, &PhysicalPage, &Header));
+
+	*EraseCount = (Header.EraseCount + 1);
+	*IsErased   = false;
+
+	return PhysicalPage;
+}
+
+/** Records a page map update in SRAM. Once half of \ref FTL_PENDING_UPDATES are pending, the translation page holding
+ *  the oldest update is rewritten with all of its pending updates.
+ *
+ *  \param[in] LogicalPage   Logical page which has been written
+ *  \param[in] PhysicalPage  Physical page now holding the logical page
+ */
+static void DataflashFTL_QueueMapUpdate(const uint16_t LogicalPage,
+                                        const uint16_t PhysicalPage)
+{
+	for (uint8_t UpdateIndex = 0; UpdateIndex < PendingUpdateCount; UpdateIndex++)
+	{
+		if (PendingUpdates[UpdateIndex].LogicalPage == LogicalPage)
+		{
+			PendingUpdates[UpdateIndex].PhysicalPage = PhysicalPage;
+			return;
+		}
+	}
+
+	PendingUpdates[PendingUpdateCount++] = (DataflashFTL_MapUpdate_t){.LogicalPage = LogicalPage, .PhysicalPage = PhysicalPage};
+
+	if (PendingUpdateCount >= (FTL_PENDING_UPDATES / 2))
+	  DataflashFTL_WriteMapPage(PendingUpdates[0].LogicalPage / FTL_MAP_ENTRIES_PER_PAGE);
+}
+
+/** Writes a new version of a translation page to a fresh physical page, applying all pending updates of the logical
+ *  pages it maps. The current version is retained as the previous version.
+ *
+ *  \param[in] MapIndex  Index of the translation page to write
+ */
+static void DataflashFTL_WriteMapPage(const uint16_t MapIndex)
+{
+	uint16_t OldPage = MapPages[MapIndex];
+	uint16_t DataCRC = 0xFFFF;
+	uint32_t EraseCount;
+	bool     IsErased;
+	uint16_t NewPage = DataflashFTL_AllocatePage((MapIndex % DATAFLASH_TOTALCHIPS), &EraseCount, &IsErased);
+
+	/* Copy the current version of the translation page into the second Dataflash buffer */
+	DataflashFTL_SelectPage(OldPage);
+	Dataflash_SendByte(DF_CMD_MAINMEMTOBUFF2);
+	Dataflash_SendAddressBytes(OldPage, 0);
+	Dataflash_WaitWhileBusy();
+
+	/* Apply the pending updates of the translation page in the buffer, and remove them from the pending list */
+	uint8_t RemainingUpdates = 0;
+
+	for (uint8_t UpdateIndex = 0; UpdateIndex < PendingUpdateCount; UpdateIndex++)
+	{
+		DataflashFTL_MapUpdate_t* Update = &PendingUpdates[UpdateIndex];
+
+		if ((Update->LogicalPage / FTL_MAP_ENTRIES_PER_PAGE) != MapIndex)
+		{
+			PendingUpdates[RemainingUpdates++] = *Update;
+			continue;
+		}
+
+		Dataflash_SendByte(DF_CMD_BUFF2WRITE);
+		Dataflash_SendAddressBytes(0, ((Update->LogicalPage % FTL_MAP_ENTRIES_PER_PAGE) * 2));
+		Dataflash_SendByte(Update->PhysicalPage & 0xFF);
+		Dataflash_SendByte(Update->PhysicalPage >> 8);
+		Dataflash_ToggleSelectedChipCS();
+	}
+
+	/* Calculate the CRC of the updated translation page from the buffer */
+	Dataflash_SendByte(DF_CMD_BUFF2READ_LF);
+	Dataflash_SendAddressBytes(0, 0);
+
+	for (uint16_t ByteNum = 0; ByteNum < DATAFLASH_PAGE_SIZE; ByteNum++)
+	  DataCRC = DataflashFTL_UpdateCRC(DataCRC, Dataflash_ReceiveByte());
+
+	Dataflash_ToggleSelectedChipCS();
+
+	Dataflash_SendByte(DF_CMD_BUFF2WRITE);
+	Dataflash_SendAddressBytes(0, DATAFLASH_PAGE_SIZE);
+	DataflashFTL_SendHeader(FTL_PAGE_TYPE_MAP, MapIndex, EraseCount, DataCRC);
+	Dataflash_ToggleSelectedChipCS();
+
+	Dataflash_SendByte(IsErased ? DF_CMD_BUFF2TOMAINMEM : DF_CMD_BUFF2TOMAINMEMWITHERASE);
+	Dataflash_SendAddressBytes(NewPage, 0);
+	Dataflash_DeselectChip();
+
+	PrevMapPages[MapIndex] = OldPage;
+	MapPages[MapIndex]     = NewPage;
+	PendingUpdateCount     = RemainingUpdates;
+
+	FTLStats.MapPagesWritten++;
+}
+
+/** Moves the contents of a physical page onto a page erased ahead of time, and updates the page map.
+ *
+ *  \param[in] SourcePage   Physical page to move
+ *  \param[in] LogicalPage  Logical page held in the physical page
+ */
+static void DataflashFTL_RelocatePage(const uint16_t SourcePage,
+                                      const uint16_t LogicalPage)
+{
+	uint32_t EraseCount;
+	bool     IsErased;
+	uint16_t DestPage = DataflashFTL_AllocatePage((SourcePage % DATAFLASH_TOTALCHIPS), &EraseCount, &IsErased);
+
+	DataflashFTL_SelectPage(SourcePage);
+	Dataflash_SendByte(DF_CMD_MAINMEMTOBUFF2);
+	Dataflash_SendAddressBytes(SourcePage, 0);
+	Dataflash_WaitWhileBusy();
+
+	Dataflash_SendByte(DF_CMD_BUFF2WRITE);
+	Dataflash_SendAddressBytes(0, DATAFLASH_PAGE_SIZE);
+	DataflashFTL_SendHeader(FTL_PAGE_TYPE_DATA, LogicalPage, EraseCount, 0xFFFF);
+	Dataflash_ToggleSelectedChipCS();
+
+	Dataflash_SendByte(IsErased ? DF_CMD_BUFF2TOMAINMEM : DF_CMD_BUFF2TOMAINMEMWITHERASE);
+	Dataflash_SendAddressBytes(DestPage, 0);
+	Dataflash_DeselectChip();
+
+	FTLStats.PagesRelocated++;
+
+	DataflashFTL_QueueMapUpdate(LogicalPage, DestPage);
+}
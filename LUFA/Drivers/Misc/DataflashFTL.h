@@ -0,0 +1,308 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2018.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2018  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *  \brief Wear levelling flash translation layer for the board Dataflash IC(s).
+ *
+ *  Log structured flash translation layer between an application and the board Dataflash IC(s), spreading
+ *  repeated writes of the same pages over the whole Dataflash.
+ */
+
+/** \ingroup Group_MiscDrivers
+ *  \defgroup Group_DataflashFTL Dataflash Flash Translation Layer - LUFA/Drivers/Misc/DataflashFTL.h
+ *  \brief Wear levelling flash translation layer for the board Dataflash IC(s).
+ *
+ *  \section Sec_DataflashFTL_Dependencies Module Source Dependencies
+ *  The following files must be built with any user project that uses this module:
+ *    - LUFA/Drivers/Misc/DataflashFTL.c <i>(Makefile source module name: LUFA_SRC_DATAFLASHFTL)</i>
+ *
+ *  \section Sec_DataflashFTL_ModDescription Module Description
+ *  Log structured flash translation layer for the board Dataflash IC(s). Rather than erasing and reprogramming a
+ *  page in place each time it is written, each write of a logical page is appended to a fresh physical page and the
+ *  logical to physical page map is updated, so that frequently written pages (such as the FAT and directory sectors
+ *  of a file system) are spread over the whole Dataflash.
+ *
+ *  The translation layer withholds \ref DATAFLASH_FTL_SPARE_PAGES pages of the Dataflash to hold its page map and
+ *  to leave unused pages for new writes, presenting \ref DATAFLASH_FTL_LOGICAL_PAGES logical pages to the application.
+ *  A logical page is always stored on the same Dataflash IC as the physical page of the same address, so that any
+ *  alternation between the Dataflash ICs by the application is retained.
+ *
+ *  The page map is held in translation pages on the Dataflash, with the most recent updates buffered in SRAM. Each
+ *  page written also receives a header in the spare bytes following the page data, holding its logical page, a write
+ *  sequence number and its erase count, from which the page map and the wear counters are rebuilt when the Dataflash
+ *  is mounted. As a result, the Dataflash pages must be at least 512 bytes in size.
+ *
+ *  The application reads a logical page from the physical page returned by \ref DataflashFTL_GetPhysicalPage(), and
+ *  writes a logical page by loading its new contents into one of the Dataflash buffers of the Dataflash IC holding the
+ *  logical page and then calling \ref DataflashFTL_ProgramBuffer(). \ref DataflashFTL_Task() must be called repeatedly
+ *  while the Dataflash is otherwise idle, to erase unused pages ahead of time and to level the wear of the pages.
+ *
+ *  \note As the pages withheld by the translation layer are taken from the end of the Dataflash, any file system
+ *        on a Dataflash used without the translation layer must be reformatted once the translation layer is used.
+ *
+ *  \section Sec_DataflashFTL_ExampleUsage Example Usage
+ *  The following snippet is an example of how this module may be used within a typical
+ *  application.
+ *
+ *  \code
+ *      // Initialize the Dataflash IC(s), then mount the translation layer before first use
+ *      Dataflash_Init();
+ *
+ *      if (!(DataflashFTL_Init()))
+ *        printf("Dataflash page map could not be recovered.\r\n");
+ *
+ *      // Read the first byte of logical page 10
+ *      uint16_t PhysicalPage = DataflashFTL_GetPhysicalPage(10);
+ *
+ *      Dataflash_SelectChipFromPage(PhysicalPage);
+ *      Dataflash_WaitWhileBusy();
+ *      Dataflash_SendByte(DF_CMD_MAINMEMPAGEREAD);
+ *      Dataflash_SendAddressBytes(PhysicalPage, 0);
+ *      Dataflash_SendByte(0x00);
+ *      Dataflash_SendByte(0x00);
+ *      Dataflash_SendByte(0x00);
+ *      Dataflash_SendByte(0x00);
+ *
+ *      uint8_t FirstByte = Dataflash_ReceiveByte();
+ *      Dataflash_DeselectChip();
+ *
+ *      // Write logical page 10 with new contents loaded into the first Dataflash buffer of its Dataflash IC
+ *      Dataflash_SelectChipFromPage(10);
+ *      Dataflash_WaitWhileBusy();
+ *      Dataflash_SendByte(DF_CMD_BUFF1WRITE);
+ *      Dataflash_SendAddressBytes(0, 0);
+ *
+ *      for (uint16_t i = 0; i < DATAFLASH_PAGE_SIZE; i++)
+ *        Dataflash_SendByte(i & 0xFF);
+ *
+ *      DataflashFTL_ProgramBuffer(10, false);
+ *      Dataflash_DeselectChip();
+ *  \endcode
+ *
+ *  @{
+ */
+
+#ifndef __DATAFLASH_FTL_H__
+#define __DATAFLASH_FTL_H__
+
+	/* Includes: */
+		#include "../../Common/Common.h"
+		#include "../Board/Dataflash.h"
+
+	/* Enable C linkage for C++ Compilers: */
+		#if defined(__cplusplus)
+			extern "C" {
+		#endif
+
+	/* Public Interface - May be used in end-application: */
+		/* Macros: */
+			#if !defined(DATAFLASH_FTL_SPARE_PAGES) || defined(__DOXYGEN__)
+				/** Number of Dataflash pages withheld from the logical pages by the translation layer, to hold the page
+				 *  map and to leave unused pages for new writes. This must be a multiple of the number of Dataflash ICs.
+				 *  By default 512 pages are withheld, but this can be overridden by defining \c DATAFLASH_FTL_SPARE_PAGES
+				 *  to another value in the user project makefile, passing the define to the compiler using the -D
+				 *  compiler switch.
+				 */
+				#define DATAFLASH_FTL_SPARE_PAGES       512
+			#endif
+
+			#if !defined(DATAFLASH_FTL_WEAR_LIMIT) || defined(__DOXYGEN__)
+				/** Number of erase cycles by which a Dataflash page may lag behind the most worn page before its contents
+				 *  are moved elsewhere by \ref DataflashFTL_Task(), so that rarely written data does not keep its page out
+				 *  of use. By default this is set to 128 erase cycles, but this can be overridden by defining
+				 *  \c DATAFLASH_FTL_WEAR_LIMIT to another value in the user project makefile, passing the define to the
+				 *  compiler using the -D compiler switch.
+				 */
+				#define DATAFLASH_FTL_WEAR_LIMIT        128
+			#endif
+
+			/** Total number of logical pages presented by the translation layer, after the spare pages have been set aside. */
+			#define DATAFLASH_FTL_LOGICAL_PAGES         ((DATAFLASH_PAGES * DATAFLASH_TOTALCHIPS) - DATAFLASH_FTL_SPARE_PAGES)
+
+			/** Page address returned by \ref DataflashFTL_GetPhysicalPage() for a logical page which does not exist. */
+			#define DATAFLASH_FTL_NO_PAGE               0xFFFF
+
+		/* Type Defines: */
+			/** Type define for the translation layer wear statistics, retrieved via \ref DataflashFTL_GetStats(). */
+			typedef struct
+			{
+				uint32_t PagesWritten; /**< Number of logical pages written to fresh physical pages. */
+				uint32_t MapPagesWritten; /**< Number of translation pages written to store page map updates. */
+				uint32_t PagesErased; /**< Number of unused pages erased ahead of time by the background task. */
+				uint32_t PagesRelocated; /**< Number of rarely written pages moved onto worn pages to level the wear. */
+				uint32_t MinEraseCount; /**< Lowest page erase count found when the Dataflash was mounted. */
+				uint32_t MaxEraseCount; /**< Highest page erase count. */
+			} DataflashFTL_Stats_t;
+
+		/* Function Prototypes: */
+			/** Mounts the translation layer, rebuilding the page map from the page headers. If the Dataflash holds no
+			 *  pages written by the translation layer, such as on first use, it is formatted by mapping each logical page
+			 *  onto the physical page of the same address. This must be called after the Dataflash IC(s) have been
+			 *  initialized, and before any other function of the translation layer is used.
+			 *
+			 *  \return Boolean \c true if the Dataflash was mounted, \c false if it holds pages written by the translation
+			 *          layer but its page map could not be recovered. In the latter case the Dataflash must be erased
+			 *          before the translation layer can be used.
+			 */
+			bool DataflashFTL_Init(void);
+
+			/** Retrieves the physical page currently holding the given logical page.
+			 *
+			 *  \param[in] LogicalPage  Logical page to locate, less than \ref DATAFLASH_FTL_LOGICAL_PAGES
+			 *
+			 *  \return Physical Dataflash page holding the logical page, or \ref DATAFLASH_FTL_NO_PAGE if the logical
+			 *          page does not exist.
+			 */
+			uint16_t DataflashFTL_GetPhysicalPage(const uint16_t LogicalPage) ATTR_WARN_UNUSED_RESULT;
+
+			/** Programs the new contents of a logical page, held in one of the Dataflash buffers of the Dataflash IC
+			 *  holding the logical page, into a fresh physical page and updates the page map. The page contents must
+			 *  already have been written to the buffer; the page header is added to the buffer's spare bytes. On
+			 *  return, the Dataflash IC is selected and programming the page.
+			 *
+			 *  \param[in] LogicalPage      Logical page whose contents are held in the Dataflash buffer, less than
+			 *                              \ref DATAFLASH_FTL_LOGICAL_PAGES
+			 *  \param[in] UseSecondBuffer  Indicates if the contents are held in the second Dataflash buffer rather than
+			 *                              the first
+			 *
+			 *  \return Boolean \c true if the page is being programmed, \c false if the logical page does not exist.
+			 */
+			bool DataflashFTL_ProgramBuffer(const uint16_t LogicalPage,
+			                                const bool UseSecondBuffer);
+
+			/** Performs the background work of the translation layer, to be called repeatedly while the Dataflash is
+			 *  idle. Each call examines the next page of one Dataflash IC and, if it is unused, erases it ahead of time.
+			 *  Pages whose erase count lags behind the most worn page by more than \ref DATAFLASH_FTL_WEAR_LIMIT are
+			 *  moved onto an erased page first.
+			 */
+			void DataflashFTL_Task(void);
+
+			/** Retrieves the translation layer wear statistics.
+			 *
+			 *  \return Pointer to the wear statistics.
+			 */
+			DataflashFTL_Stats_t* DataflashFTL_GetStats(void) ATTR_WARN_UNUSED_RESULT ATTR_CONST;
+
+	/* Private Interface - For use in library only: */
+	#if !defined(__DOXYGEN__)
+		/* Macros: */
+			#define FTL_TOTAL_PAGES                     (DATAFLASH_PAGES * DATAFLASH_TOTALCHIPS)
+			#define FTL_MAP_ENTRIES_PER_PAGE            (DATAFLASH_PAGE_SIZE / 2)
+			#define FTL_MAP_PAGES                       ((DATAFLASH_FTL_LOGICAL_PAGES + FTL_MAP_ENTRIES_PER_PAGE - 1) / \
+			                                             FTL_MAP_ENTRIES_PER_PAGE)
+			#define FTL_PENDING_UPDATES                 16
+			#define FTL_ERASED_POOL_PAGES               4
+			#define FTL_NO_PAGE                         DATAFLASH_FTL_NO_PAGE
+
+			#define FTL_PAGE_TYPE_DATA                  0x44
+			#define FTL_PAGE_TYPE_MAP                   0x4D
+			#define FTL_PAGE_TYPE_NONE                  0xFF
+
+		/* Preprocessor Checks: */
+			#if (DATAFLASH_PAGE_SIZE < 512)
+				#error The Dataflash translation layer requires Dataflash pages of at least 512 bytes.
+			#endif
+
+			#if (DATAFLASH_FTL_SPARE_PAGES % DATAFLASH_TOTALCHIPS)
+				#error DATAFLASH_FTL_SPARE_PAGES must be a multiple of the number of Dataflash ICs.
+			#endif
+
+			#if ((DATAFLASH_FTL_SPARE_PAGES / DATAFLASH_TOTALCHIPS) < \
+			     ((((FTL_MAP_PAGES + DATAFLASH_TOTALCHIPS - 1) / DATAFLASH_TOTALCHIPS) * 2) + FTL_ERASED_POOL_PAGES + 2))
+				#error DATAFLASH_FTL_SPARE_PAGES is too small to hold the translation pages of the selected Dataflash.
+			#endif
+
+		/* Type Defines: */
+			typedef struct
+			{
+				uint8_t  Type;
+				uint8_t  Check;
+				uint16_t Index;
+				uint32_t Sequence;
+				uint32_t EraseCount;
+				uint16_t DataCRC;
+				uint16_t EraseCheck;
+			} ATTR_PACKED DataflashFTL_PageHeader_t;
+
+			typedef struct
+			{
+				uint16_t LogicalPage;
+				uint16_t PhysicalPage;
+			} DataflashFTL_MapUpdate_t;
+
+			typedef struct
+			{
+				uint16_t PhysicalPage;
+				uint32_t EraseCount;
+			} DataflashFTL_ErasedPage_t;
+
+		/* Function Prototypes: */
+			#if defined(__INCLUDE_FROM_DATAFLASHFTL_C)
+				static void DataflashFTL_Format(void);
+				static inline void DataflashFTL_SelectPage(const uint16_t PhysicalPage);
+				static uint8_t DataflashFTL_GetHeaderCheck(const DataflashFTL_PageHeader_t* const Header)
+				                                           ATTR_NON_NULL_PTR_ARG(1);
+				static uint16_t DataflashFTL_GetEraseCheck(const uint32_t EraseCount) ATTR_CONST;
+				static bool DataflashFTL_ReadHeader(const uint16_t PhysicalPage,
+				                                    DataflashFTL_PageHeader_t* const Header) ATTR_NON_NULL_PTR_ARG(2);
+				static void DataflashFTL_SendHeader(const uint8_t Type,
+				                                    const uint16_t Index,
+				                                    const uint32_t EraseCount,
+				                                    const uint16_t DataCRC);
+				static uint16_t DataflashFTL_UpdateCRC(uint16_t CRC,
+				                                       const uint8_t Data) ATTR_CONST;
+				static uint16_t DataflashFTL_GetMapPageCRC(const uint16_t PhysicalPage);
+				static bool DataflashFTL_IsPageLive(const uint16_t PhysicalPage,
+				                                    const DataflashFTL_PageHeader_t* const Header) ATTR_NON_NULL_PTR_ARG(2);
+				static bool DataflashFTL_IsPageErased(const uint8_t ChipIndex,
+				                                      const uint16_t PhysicalPage);
+				static bool DataflashFTL_ExamineNextPage(const uint8_t ChipIndex,
+				                                         uint16_t* const PhysicalPage,
+				                                         DataflashFTL_PageHeader_t* const Header) ATTR_NON_NULL_PTR_ARG(2, 3);
+				static uint16_t DataflashFTL_AllocatePage(const uint8_t ChipIndex,
+				                                          uint32_t* const EraseCount,
+				                                          bool* const IsErased) ATTR_NON_NULL_PTR_ARG(2, 3);
+				static void DataflashFTL_QueueMapUpdate(const uint16_t LogicalPage,
+				                                        const uint16_t PhysicalPage);
+				static void DataflashFTL_WriteMapPage(const uint16_t MapIndex);
+				static void DataflashFTL_RelocatePage(const uint16_t SourcePage,
+				                                      const uint16_t LogicalPage);
+			#endif
+	#endif
+
+	/* Disable C linkage for C++ Compilers: */
+		#if defined(__cplusplus)
+			}
+		#endif
+
+#endif
+
+/** @} */
+
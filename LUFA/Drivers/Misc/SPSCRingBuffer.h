@@ -0,0 +1,426 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2018.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2018  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *  \brief Lock-free single producer, single consumer byte ring buffer with bulk span access.
+ *
+ *  Lock-free single producer, single consumer ring buffer, for fast insertion/deletion of bytes
+ *  between an ISR and the main program without masking interrupts.
+ */
+
+/** \ingroup Group_MiscDrivers
+ *  \defgroup Group_SPSCRingBuff Lock-Free SPSC Byte Ring Buffer - LUFA/Drivers/Misc/SPSCRingBuffer.h
+ *  \brief Lock-free single producer, single consumer byte ring buffer with bulk span access.
+ *
+ *  \section Sec_SPSCRingBuff_Dependencies Module Source Dependencies
+ *  The following files must be built with any user project that uses this module:
+ *    - None
+ *
+ *  \section Sec_SPSCRingBuff_ModDescription Module Description
+ *  Lock-free ring buffer for passing bytes from exactly one producer to exactly one consumer,
+ *  such as from a USART receive ISR to the main program. Unlike the \ref Group_RingBuff driver,
+ *  the buffer keeps separate head and tail indices which are each only ever written by one side,
+ *  so that no operation needs to disable global interrupts.
+ *
+ *  The indices are free-running and of the architecture's native register width, so that they
+ *  are read and written atomically and the number of stored bytes is simply their difference.
+ *  As a result, the size of the buffer's storage array must be a power of two, no larger than
+ *  \ref SPSC_RING_BUFFER_MAX_SIZE bytes.
+ *
+ *  In addition to single byte insertion and removal, the buffer provides span functions which
+ *  give direct access to the largest contiguous block of stored data or free space in the
+ *  buffer. This allows data to be moved in bulk directly between the buffer and another
+ *  destination, such as an endpoint bank, without an intermediate copy or a function call
+ *  per byte.
+ *
+ *  \warning Only one execution thread (main program thread or an ISR) may insert into a single
+ *           buffer, and only one execution thread may remove from it. If several threads need to
+ *           insert into or remove from the same buffer, the \ref Group_RingBuff driver should
+ *           be used with additional atomic (mutex) locking instead.
+ *
+ *  \section Sec_SPSCRingBuff_ExampleUsage Example Usage
+ *  The following snippet is an example of how this module may be used within a typical
+ *  application.
+ *
+ *  \code
+ *      // Create the buffer structure and its underlying storage array
+ *      SPSCRingBuffer_t Buffer;
+ *      uint8_t          BufferData[128];
+ *
+ *      // Initialize the buffer with the created storage array
+ *      SPSCRingBuffer_InitBuffer(&Buffer, BufferData, sizeof(BufferData));
+ *
+ *      // Insert some data into the buffer
+ *      SPSCRingBuffer_Write(&Buffer, "HELLO", 5);
+ *
+ *      // Send the buffered data to the host, a contiguous span at a time
+ *      uint8_t* Span;
+ *      uint16_t SpanLength;
+ *
+ *      while ((SpanLength = SPSCRingBuffer_GetReadSpan(&Buffer, &Span)) != 0)
+ *      {
+ *          Endpoint_Write_Stream_LE(Span, SpanLength, NULL);
+ *          SPSCRingBuffer_CommitRead(&Buffer, SpanLength);
+ *      }
+ *  \endcode
+ *
+ *  @{
+ */
+
+#ifndef __SPSC_RING_BUFFER_H__
+#define __SPSC_RING_BUFFER_H__
+
+	/* Includes: */
+		#include "../../Common/Common.h"
+
+	/* Enable C linkage for C++ Compilers: */
+		#if defined(__cplusplus)
+			extern "C" {
+		#endif
+
+	/* Macros: */
+		/** Maximum size in bytes of the storage array of a \ref SPSCRingBuffer_t, which is half the range of the
+		 *  architecture's native register width on 8-bit architectures (128 bytes), or 32768 bytes otherwise.
+		 */
+		#define SPSC_RING_BUFFER_MAX_SIZE   ((sizeof(uint_reg_t) == 1) ? 128 : 32768)
+
+	/* Type Defines: */
+		/** \brief Lock-Free Ring Buffer Management Structure.
+		 *
+		 *  Type define for a new lock-free ring buffer object. Buffers should be initialized via a call to
+		 *  \ref SPSCRingBuffer_InitBuffer() before use.
+		 */
+		typedef struct
+		{
+			uint8_t*            Data; /**< Pointer to the start of the buffer's underlying storage array. */
+			uint_reg_t          Mask; /**< Size of the buffer's underlying storage array, minus one. */
+			volatile uint_reg_t Head; /**< Free-running count of bytes inserted, written only by the producer. */
+			volatile uint_reg_t Tail; /**< Free-running count of bytes removed, written only by the consumer. */
+		} SPSCRingBuffer_t;
+
+	/* Inline Functions: */
+		/** Initializes a lock-free ring buffer ready for use. Buffers must be initialized via this function
+		 *  before any operations are called upon them. Already initialized buffers may be reset by
+		 *  re-initializing them using this function, while neither the producer nor consumer is active.
+		 *
+		 *  \param[out] Buffer   Pointer to a ring buffer structure to initialize.
+		 *  \param[out] DataPtr  Pointer to a global array that will hold the data stored into the ring buffer.
+		 *  \param[in]  Size     Size of the underlying data array, a power of two no larger than
+		 *                       \ref SPSC_RING_BUFFER_MAX_SIZE.
+		 */
+		static inline void SPSCRingBuffer_InitBuffer(SPSCRingBuffer_t* const Buffer,
+		                                             uint8_t* const DataPtr,
+		                                             const uint16_t Size) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+		static inline void SPSCRingBuffer_InitBuffer(SPSCRingBuffer_t* const Buffer,
+		                                             uint8_t* const DataPtr,
+		                                             const uint16_t Size)
+		{
+			Buffer->Data = DataPtr;
+			Buffer->Mask = (Size - 1);
+			Buffer->Head = 0;
+			Buffer->Tail = 0;
+		}
+
+		/** Retrieves the current number of bytes stored in a particular buffer. No locking is required, as
+		 *  each index is read atomically.
+		 *
+		 *  \note The value returned by this function is guaranteed to only be the minimum number of bytes
+		 *        stored in the given buffer when called by the consumer, as the producer may insert more data
+		 *        at any time.
+		 *
+		 *  \param[in] Buffer  Pointer to a ring buffer structure whose count is to be computed.
+		 *
+		 *  \return Number of bytes currently stored in the buffer.
+		 */
+		static inline uint16_t SPSCRingBuffer_GetCount(const SPSCRingBuffer_t* const Buffer) ATTR_WARN_UNUSED_RESULT ATTR_NON_NULL_PTR_ARG(1);
+		static inline uint16_t SPSCRingBuffer_GetCount(const SPSCRingBuffer_t* const Buffer)
+		{
+			return (uint_reg_t)(Buffer->Head - Buffer->Tail);
+		}
+
+		/** Retrieves the free space in a particular buffer.
+		 *
+		 *  \note The value returned by this function is guaranteed to only be the minimum number of bytes
+		 *        free in the given buffer when called by the producer, as the consumer may remove data at
+		 *        any time.
+		 *
+		 *  \param[in] Buffer  Pointer to a ring buffer structure whose free count is to be computed.
+		 *
+		 *  \return Number of free bytes in the buffer.
+		 */
+		static inline uint16_t SPSCRingBuffer_GetFreeCount(const SPSCRingBuffer_t* const Buffer) ATTR_WARN_UNUSED_RESULT ATTR_NON_NULL_PTR_ARG(1);
+		static inline uint16_t SPSCRingBuffer_GetFreeCount(const SPSCRingBuffer_t* const Buffer)
+		{
+			return ((uint16_t)Buffer->Mask + 1) - SPSCRingBuffer_GetCount(Buffer);
+		}
+
+		/** Determines if the specified ring buffer contains any data. This should be tested by the consumer
+		 *  before removing data from the buffer, to ensure that the buffer does not underflow.
+		 *
+		 *  \param[in] Buffer  Pointer to a ring buffer structure to check.
+		 *
+		 *  \return Boolean \c true if the buffer contains no data, \c false otherwise.
+		 */
+		static inline bool SPSCRingBuffer_IsEmpty(const SPSCRingBuffer_t* const Buffer) ATTR_WARN_UNUSED_RESULT ATTR_NON_NULL_PTR_ARG(1);
+		static inline bool SPSCRingBuffer_IsEmpty(const SPSCRingBuffer_t* const Buffer)
+		{
+			return (Buffer->Head == Buffer->Tail);
+		}
+
+		/** Determines if the specified ring buffer contains any free space. This should be tested by the
+		 *  producer before storing data to the buffer, to ensure that no data is lost due to a buffer overrun.
+		 *
+		 *  \param[in] Buffer  Pointer to a ring buffer structure to check.
+		 *
+		 *  \return Boolean \c true if the buffer contains no free space, \c false otherwise.
+		 */
+		static inline bool SPSCRingBuffer_IsFull(const SPSCRingBuffer_t* const Buffer) ATTR_WARN_UNUSED_RESULT ATTR_NON_NULL_PTR_ARG(1);
+		static inline bool SPSCRingBuffer_IsFull(const SPSCRingBuffer_t* const Buffer)
+		{
+			return (SPSCRingBuffer_GetCount(Buffer) > Buffer->Mask);
+		}
+
+		/** Inserts an element into the ring buffer. The caller must ensure the buffer is not full.
+		 *
+		 *  \warning This function may only be called by the buffer's single producer.
+		 *
+		 *  \param[in,out] Buffer  Pointer to a ring buffer structure to insert into.
+		 *  \param[in]     Data    Data element to insert into the buffer.
+		 */
+		static inline void SPSCRingBuffer_Insert(SPSCRingBuffer_t* const Buffer,
+		                                         const uint8_t Data) ATTR_NON_NULL_PTR_ARG(1);
+		static inline void SPSCRingBuffer_Insert(SPSCRingBuffer_t* const Buffer,
+		                                         const uint8_t Data)
+		{
+			uint_reg_t Head = Buffer->Head;
+
+			Buffer->Data[Head & Buffer->Mask] = Data;
+			GCC_MEMORY_BARRIER();
+
+			Buffer->Head = (Head + 1);
+		}
+
+		/** Removes an element from the ring buffer. The caller must ensure the buffer is not empty.
+		 *
+		 *  \warning This function may only be called by the buffer's single consumer.
+		 *
+		 *  \param[in,out] Buffer  Pointer to a ring buffer structure to retrieve from.
+		 *
+		 *  \return Next data element stored in the buffer.
+		 */
+		static inline uint8_t SPSCRingBuffer_Remove(SPSCRingBuffer_t* const Buffer) ATTR_NON_NULL_PTR_ARG(1);
+		static inline uint8_t SPSCRingBuffer_Remove(SPSCRingBuffer_t* const Buffer)
+		{
+			uint_reg_t Tail = Buffer->Tail;
+			uint8_t    Data = Buffer->Data[Tail & Buffer->Mask];
+
+			GCC_MEMORY_BARRIER();
+			Buffer->Tail = (Tail + 1);
+
+			return Data;
+		}
+
+		/** Returns the next element stored in the ring buffer, without removing it.
+		 *
+		 *  \param[in] Buffer  Pointer to a ring buffer structure to retrieve from.
+		 *
+		 *  \return Next data element stored in the buffer.
+		 */
+		static inline uint8_t SPSCRingBuffer_Peek(const SPSCRingBuffer_t* const Buffer) ATTR_WARN_UNUSED_RESULT ATTR_NON_NULL_PTR_ARG(1);
+		static inline uint8_t SPSCRingBuffer_Peek(const SPSCRingBuffer_t* const Buffer)
+		{
+			return Buffer->Data[Buffer->Tail & Buffer->Mask];
+		}
+
+		/** Retrieves the largest contiguous block of stored data at the front of the ring buffer, for in-place
+		 *  reading by the consumer. Once the data has been used, it must be removed from the buffer via
+		 *  \ref SPSCRingBuffer_CommitRead(). When the stored data wraps around the end of the storage array, a
+		 *  second call after the commit returns the remainder.
+		 *
+		 *  \warning This function may only be called by the buffer's single consumer.
+		 *
+		 *  \param[in]  Buffer  Pointer to a ring buffer structure to retrieve from.
+		 *  \param[out] Span    Location where a pointer to the start of the contiguous data is to be stored.
+		 *
+		 *  \return Number of contiguous bytes available at the returned location, or zero if the buffer is empty.
+		 */
+		static inline uint16_t SPSCRingBuffer_GetReadSpan(const SPSCRingBuffer_t* const Buffer,
+		                                                  uint8_t** const Span) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+		static inline uint16_t SPSCRingBuffer_GetReadSpan(const SPSCRingBuffer_t* const Buffer,
+		                                                  uint8_t** const Span)
+		{
+			uint_reg_t Tail       = Buffer->Tail;
+			uint16_t   Count      = (uint_reg_t)(Buffer->Head - Tail);
+			uint16_t   TailOffset = (Tail & Buffer->Mask);
+			uint16_t   ToEnd      = ((uint16_t)Buffer->Mask + 1) - TailOffset;
+
+			*Span = &Buffer->Data[TailOffset];
+			return MIN(Count, ToEnd);
+		}
+
+		/** Removes the given number of bytes from the front of the ring buffer, after they have been read in
+		 *  place via \ref SPSCRingBuffer_GetReadSpan().
+		 *
+		 *  \warning This function may only be called by the buffer's single consumer.
+		 *
+		 *  \param[in,out] Buffer  Pointer to a ring buffer structure to remove from.
+		 *  \param[in]     Length  Number of bytes to remove, no more than the length of the last read span.
+		 */
+		static inline void SPSCRingBuffer_CommitRead(SPSCRingBuffer_t* const Buffer,
+		                                             const uint16_t Length) ATTR_NON_NULL_PTR_ARG(1);
+		static inline void SPSCRingBuffer_CommitRead(SPSCRingBuffer_t* const Buffer,
+		                                             const uint16_t Length)
+		{
+			GCC_MEMORY_BARRIER();
+			Buffer->Tail = (Buffer->Tail + Length);
+		}
+
+		/** Retrieves the largest contiguous block of free space at the back of the ring buffer, for in-place
+		 *  writing by the producer. Once the space has been filled, the data must be added to the buffer via
+		 *  \ref SPSCRingBuffer_CommitWrite(). When the free space wraps around the end of the storage array, a
+		 *  second call after the commit returns the remainder.
+		 *
+		 *  \warning This function may only be called by the buffer's single producer.
+		 *
+		 *  \param[in]  Buffer  Pointer to a ring buffer structure to insert into.
+		 *  \param[out] Span    Location where a pointer to the start of the contiguous free space is to be stored.
+		 *
+		 *  \return Number of contiguous free bytes at the returned location, or zero if the buffer is full.
+		 */
+		static inline uint16_t SPSCRingBuffer_GetWriteSpan(const SPSCRingBuffer_t* const Buffer,
+		                                                   uint8_t** const Span) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+		static inline uint16_t SPSCRingBuffer_GetWriteSpan(const SPSCRingBuffer_t* const Buffer,
+		                                                   uint8_t** const Span)
+		{
+			uint_reg_t Head       = Buffer->Head;
+			uint16_t   FreeCount  = ((uint16_t)Buffer->Mask + 1) - (uint_reg_t)(Head - Buffer->Tail);
+			uint16_t   HeadOffset = (Head & Buffer->Mask);
+			uint16_t   ToEnd      = ((uint16_t)Buffer->Mask + 1) - HeadOffset;
+
+			*Span = &Buffer->Data[HeadOffset];
+			return MIN(FreeCount, ToEnd);
+		}
+
+		/** Adds the given number of bytes to the back of the ring buffer, after they have been written in
+		 *  place via \ref SPSCRingBuffer_GetWriteSpan().
+		 *
+		 *  \warning This function may only be called by the buffer's single producer.
+		 *
+		 *  \param[in,out] Buffer  Pointer to a ring buffer structure to insert into.
+		 *  \param[in]     Length  Number of bytes to add, no more than the length of the last write span.
+		 */
+		static inline void SPSCRingBuffer_CommitWrite(SPSCRingBuffer_t* const Buffer,
+		                                              const uint16_t Length) ATTR_NON_NULL_PTR_ARG(1);
+		static inline void SPSCRingBuffer_CommitWrite(SPSCRingBuffer_t* const Buffer,
+		                                              const uint16_t Length)
+		{
+			GCC_MEMORY_BARRIER();
+			Buffer->Head = (Buffer->Head + Length);
+		}
+
+		/** Copies as many bytes as will fit from the given array into the ring buffer, in at most two
+		 *  contiguous blocks.
+		 *
+		 *  \warning This function may only be called by the buffer's single producer.
+		 *
+		 *  \param[in,out] Buffer  Pointer to a ring buffer structure to insert into.
+		 *  \param[in]     Data    Pointer to the data to insert.
+		 *  \param[in]     Length  Number of bytes to insert.
+		 *
+		 *  \return Number of bytes inserted into the buffer.
+		 */
+		static inline uint16_t SPSCRingBuffer_Write(SPSCRingBuffer_t* const Buffer,
+		                                            const void* const Data,
+		                                            const uint16_t Length) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+		static inline uint16_t SPSCRingBuffer_Write(SPSCRingBuffer_t* const Buffer,
+		                                            const void* const Data,
+		                                            const uint16_t Length)
+		{
+			const uint8_t* DataPtr      = (const uint8_t*)Data;
+			uint16_t       BytesWritten = 0;
+
+			for (uint8_t Pass = 0; (Pass < 2) && (BytesWritten < Length); Pass++)
+			{
+				uint8_t* Span;
+				uint16_t SpanLength = MIN(SPSCRingBuffer_GetWriteSpan(Buffer, &Span), (Length - BytesWritten));
+
+				memcpy(Span, &DataPtr[BytesWritten], SpanLength);
+				SPSCRingBuffer_CommitWrite(Buffer, SpanLength);
+
+				BytesWritten += SpanLength;
+			}
+
+			return BytesWritten;
+		}
+
+		/** Copies as many bytes as are available, up to the given length, from the ring buffer into the given
+		 *  array, in at most two contiguous blocks.
+		 *
+		 *  \warning This function may only be called by the buffer's single consumer.
+		 *
+		 *  \param[in,out] Buffer  Pointer to a ring buffer structure to remove from.
+		 *  \param[out]    Data    Pointer to the location where the removed data is to be stored.
+		 *  \param[in]     Length  Maximum number of bytes to remove.
+		 *
+		 *  \return Number of bytes removed from the buffer.
+		 */
+		static inline uint16_t SPSCRingBuffer_Read(SPSCRingBuffer_t* const Buffer,
+		                                           void* const Data,
+		                                           const uint16_t Length) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+		static inline uint16_t SPSCRingBuffer_Read(SPSCRingBuffer_t* const Buffer,
+		                                           void* const Data,
+		                                           const uint16_t Length)
+		{
+			uint8_t* DataPtr   = (uint8_t*)Data;
+			uint16_t BytesRead = 0;
+
+			for (uint8_t Pass = 0; (Pass < 2) && (BytesRead < Length); Pass++)
+			{
+				uint8_t* Span;
+				uint16_t SpanLength = MIN(SPSCRingBuffer_GetReadSpan(Buffer, &Span), (Length - BytesRead));
+
+				memcpy(&DataPtr[BytesRead], Span, SpanLength);
+				SPSCRingBuffer_CommitRead(Buffer, SpanLength);
+
+				BytesRead += SpanLength;
+			}
+
+			return BytesRead;
+		}
+
+	/* Disable C linkage for C++ Compilers: */
+		#if defined(__cplusplus)
+			}
+		#endif
+
+#endif
+
+/** @} */
+
@@ -247,6 +247,29 @@
 				return SPDR;
 			}
 
+			/** Starts sending and receiving a byte through the SPI interface without waiting for the transfer to complete,
+			 *  so that other work can be done while the byte is shifted. Each call must be followed by a call to
+			 *  \ref SPI_EndTransferByte() before the next transfer is started.
+			 *
+			 *  \param[in] Byte  Byte to send through the SPI interface.
+			 */
+			static inline void SPI_BeginTransferByte(const uint8_t Byte) ATTR_ALWAYS_INLINE;
+			static inline void SPI_BeginTransferByte(const uint8_t Byte)
+			{
+				SPDR = Byte;
+			}
+
+			/** Completes a transfer started by \ref SPI_BeginTransferByte(), blocking until the transfer is complete.
+			 *
+			 *  \return Response byte from the attached SPI device.
+			 */
+			static inline uint8_t SPI_EndTransferByte(void) ATTR_ALWAYS_INLINE;
+			static inline uint8_t SPI_EndTransferByte(void)
+			{
+				while (!(SPSR & (1 << SPIF)));
+				return SPDR;
+			}
+
 	/* Disable C linkage for C++ Compilers: */
 		#if defined(__cplusplus)
 			}
@@ -36,12 +36,30 @@
 
 FILE USARTSerialStream;
 
+#if defined(SERIAL_BUFFERED)
+SPSCRingBuffer_t Serial_TxBuffer;
+SPSCRingBuffer_t Serial_RxBuffer;
+
+static uint8_t Serial_TxBufferData[SERIAL_TX_BUFFER_SIZE];
+static uint8_t Serial_RxBufferData[SERIAL_RX_BUFFER_SIZE];
+
+static volatile Serial_BufferedErrors_t Serial_ErrorCounts;
+
+	#define Serial_OutputByte(DataByte)   Serial_BufferedSendByte(DataByte)
+	#define Serial_InputByte()            Serial_BufferedReceiveByte()
+	#define Serial_IsInputAvailable()     (Serial_BufferedBytesReceived() != 0)
+#else
+	#define Serial_OutputByte(DataByte)   Serial_SendByte(DataByte)
+	#define Serial_InputByte()            Serial_ReceiveByte()
+	#define Serial_IsInputAvailable()     Serial_IsCharReceived()
+#endif
+
 int Serial_putchar(char DataByte,
                    FILE *Stream)
 {
 	(void)Stream;
 
-	Serial_SendByte(DataByte);
+	Serial_OutputByte(DataByte);
 	return 0;
 }
 
@@ -49,18 +67,18 @@ int Serial_getchar(FILE *Stream)
 {
 	(void)Stream;
 
-	if (!(Serial_IsCharReceived()))
+	if (!(Serial_IsInputAvailable()))
 	  return _FDEV_EOF;
 
-	return Serial_ReceiveByte();
+	return Serial_InputByte();
 }
 
 int Serial_getchar_Blocking(FILE *Stream)
 {
 	(void)Stream;
 
-	while (!(Serial_IsCharReceived()));
-	return Serial_ReceiveByte();
+	while (!(Serial_IsInputAvailable()));
+	return Serial_InputByte();
 }
 
 void Serial_SendString_P(const char* FlashStringPtr)
@@ -69,7 +87,7 @@ void Serial_SendString_P(const char* FlashStringPtr)
 
 	while ((CurrByte = pgm_read_byte(FlashStringPtr)) != 0x00)
 	{
-		Serial_SendByte(CurrByte);
+		Serial_OutputByte(CurrByte);
 		FlashStringPtr++;
 	}
 }
@@ -80,7 +98,7 @@ void Serial_SendString(const char* StringPtr)
 
 	while ((CurrByte = *StringPtr) != 0x00)
 	{
-		Serial_SendByte(CurrByte);
+		Serial_OutputByte(CurrByte);
 		StringPtr++;
 	}
 }
@@ -90,8 +108,18 @@ void Serial_SendData(const void* Buffer,
 {
 	uint8_t* CurrByte = (uint8_t*)Buffer;
 
+	#if defined(SERIAL_BUFFERED)
+	while (Length)
+	{
+		uint16_t BytesQueued = Serial_BufferedSendData(CurrByte, Length);
+
+		CurrByte += BytesQueued;
+		Length   -= BytesQueued;
+	}
+	#else
 	while (Length--)
 	  Serial_SendByte(*(CurrByte++));
+	#endif
 }
 
 void Serial_CreateStream(FILE* Stream)
@@ -118,4 +146,82 @@ void Serial_CreateBlockingStream(FILE* Stream)
 	*Stream = (FILE)FDEV_SETUP_STREAM(Serial_putchar, Serial_getchar_Blocking, _FDEV_SETUP_RW);
 }
 
+#if defined(SERIAL_BUFFERED)
+void Serial_BufferedInit(const uint32_t BaudRate,
+                         const bool DoubleSpeed)
+{
+	Serial_Init(BaudRate, DoubleSpeed);
+
+	SPSCRingBuffer_InitBuffer(&Serial_TxBuffer, Serial_TxBufferData, sizeof(Serial_TxBufferData));
+	SPSCRingBuffer_InitBuffer(&Serial_RxBuffer, Serial_RxBufferData, sizeof(Serial_RxBufferData));
+
+	Serial_ErrorCounts.OverrunErrors   = 0;
+	Serial_ErrorCounts.FramingErrors   = 0;
+	Serial_ErrorCounts.BufferOverflows = 0;
+
+	UCSR1B |= (1 << RXCIE1);
+}
+
+uint16_t Serial_BufferedSendData(const void* Buffer,
+                                 uint16_t Length)
+{
+	uint16_t BytesQueued = SPSCRingBuffer_Write(&Serial_TxBuffer, Buffer, Length);
+
+	if (BytesQueued)
+	  Serial_BufferedStartTransmit();
+
+	return BytesQueued;
+}
+
+uint16_t Serial_BufferedReceiveData(void* Buffer,
+                                    uint16_t Length)
+{
+	return SPSCRingBuffer_Read(&Serial_RxBuffer, Buffer, Length);
+}
+
+void Serial_BufferedGetErrors(Serial_BufferedErrors_t* const Errors)
+{
+	uint_reg_t CurrentGlobalInt = GetGlobalInterruptMask();
+	GlobalInterruptDisable();
+
+	Errors->OverrunErrors   = Serial_ErrorCounts.OverrunErrors;
+	Errors->FramingErrors   = Serial_ErrorCounts.FramingErrors;
+	Errors->BufferOverflows = Serial_ErrorCounts.BufferOverflows;
+
+	Serial_ErrorCounts.OverrunErrors   = 0;
+	Serial_ErrorCounts.FramingErrors   = 0;
+	Serial_ErrorCounts.BufferOverflows = 0;
+
+	SetGlobalInterruptMask(CurrentGlobalInt);
+}
+
+ISR(USART1_RX_vect, ISR_BLOCK)
+{
+	/* Error flags must be read before the data register, as reading the data register clears them */
+	uint8_t Status   = UCSR1A;
+	uint8_t DataByte = UDR1;
+
+	if (Status & (1 << DOR1))
+	  Serial_ErrorCounts.OverrunErrors++;
+
+	if (Status & (1 << FE1))
+	  Serial_ErrorCounts.FramingErrors++;
+
+	if (SPSCRingBuffer_IsFull(&Serial_RxBuffer))
+	  Serial_ErrorCounts.BufferOverflows++;
+	else
+	  SPSCRingBuffer_Insert(&Serial_RxBuffer, DataByte);
+}
+
+ISR(USART1_UDRE_vect, ISR_BLOCK)
+{
+	if (!(SPSCRingBuffer_IsEmpty(&Serial_TxBuffer)))
+	  UDR1 = SPSCRingBuffer_Remove(&Serial_TxBuffer);
+
+	/* Stop the interrupt once the buffer is drained; it is re-enabled whenever new data is queued */
+	if (SPSCRingBuffer_IsEmpty(&Serial_TxBuffer))
+	  UCSR1B &= ~(1 << UDRIE1);
+}
+#endif
+
 #endif
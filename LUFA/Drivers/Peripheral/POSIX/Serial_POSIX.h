@@ -0,0 +1,223 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2018.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2018  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *  \brief Serial USART Peripheral Driver (POSIX)
+ *
+ *  Simulated serial USART driver for the host-native POSIX architecture.
+ *
+ *  \note This file should not be included directly. It is automatically included as needed by the USART driver
+ *        dispatch header located in LUFA/Drivers/Peripheral/Serial.h.
+ */
+
+/** \ingroup Group_Serial
+ *  \defgroup Group_Serial_POSIX Serial USART Peripheral Driver (POSIX)
+ *
+ *  \section Sec_Serial_POSIX_ModDescription Module Description
+ *  Simulated serial USART driver for the host-native POSIX architecture. Data transmitted through the USART is
+ *  written to the process' standard error stream, and data is received from the process' standard input. Standard
+ *  error is used so that the USART output remains separate from the virtual USB host's transcript on standard output.
+ *
+ *  \note This file should not be included directly. It is automatically included as needed by the USART driver
+ *        dispatch header located in LUFA/Drivers/Peripheral/Serial.h.
+ *
+ *  \section Sec_Serial_POSIX_ExampleUsage Example Usage
+ *  The following snippet is an example of how this module may be used within a typical
+ *  application.
+ *
+ *  \code
+ *      // Initialize the serial USART driver before first use, with 9600 baud (and no double-speed mode)
+ *      Serial_Init(9600, false);
+ *
+ *      // Send a string through the USART
+ *      Serial_SendString("Test String\r\n");
+ *
+ *      // Send a raw byte through the USART
+ *      Serial_SendByte(0xDC);
+ *
+ *      // Receive a byte through the USART (or -1 if no data received)
+ *      int16_t DataByte = Serial_ReceiveByte();
+ *  \endcode
+ *
+ *  @{
+ */
+
+#ifndef __SERIAL_POSIX_H__
+#define __SERIAL_POSIX_H__
+
+	/* Includes: */
+		#include "../../../Common/Common.h"
+		#include "../../Misc/TerminalCodes.h"
+
+		#include <stdio.h>
+		#include <poll.h>
+
+	/* Enable C linkage for C++ Compilers: */
+		#if defined(__cplusplus)
+			extern "C" {
+		#endif
+
+	/* Preprocessor Checks: */
+		#if !defined(__INCLUDE_FROM_SERIAL_H) && !defined(__INCLUDE_FROM_SERIAL_C)
+			#error Do not include this file directly. Include LUFA/Drivers/Peripheral/Serial.h instead.
+		#endif
+
+	/* Public Interface - May be used in end-application: */
+		/* Function Prototypes: */
+			/** Transmits a given NUL terminated string located in program space (FLASH) through the USART.
+			 *
+			 *  \param[in] FlashStringPtr  Pointer to a string located in program space.
+			 */
+			void Serial_SendString_P(const char* FlashStringPtr) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Transmits a given NUL terminated string located in SRAM memory through the USART.
+			 *
+			 *  \param[in] StringPtr  Pointer to a string located in SRAM space.
+			 */
+			void Serial_SendString(const char* StringPtr) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Transmits a given buffer located in SRAM memory through the USART.
+			 *
+			 *  \param[in] Buffer  Pointer to a buffer containing the data to send.
+			 *  \param[in] Length  Length of the data to send, in bytes.
+			 */
+			void Serial_SendData(const void* Buffer, uint16_t Length) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Redirects the standard output stream to the USART, so that the regular \c <stdio.h> output functions
+			 *  such as \c printf() write to the USART.
+			 *
+			 *  \note Unlike the AVR-LibC based architectures, a new stream cannot be constructed in place; the \c Stream
+			 *        parameter must be \c NULL, and other values are ignored.
+			 *
+			 *  \param[in,out] Stream  Must be \c NULL, to configure \c stdout to use the USART.
+			 *
+			 *  \pre The USART must first be configured via a call to \ref Serial_Init() before the stream is used.
+			 */
+			void Serial_CreateStream(FILE* Stream);
+
+			/** Identical to \ref Serial_CreateStream(), provided for compatibility with the other architectures.
+			 *
+			 *  \param[in,out] Stream  Must be \c NULL, to configure \c stdout to use the USART.
+			 *
+			 *  \pre The USART must first be configured via a call to \ref Serial_Init() before the stream is used.
+			 */
+			void Serial_CreateBlockingStream(FILE* Stream);
+
+		/* Inline Functions: */
+			/** Initializes the USART, ready for serial data transmission and reception. The baud rate is not
+			 *  applicable to the simulated USART, and is ignored.
+			 *
+			 *  \param[in] BaudRate     Serial baud rate, in bits per second.
+			 *  \param[in] DoubleSpeed  Enables double speed mode when set, ignored on this architecture.
+			 */
+			static inline void Serial_Init(const uint32_t BaudRate,
+			                               const bool DoubleSpeed);
+			static inline void Serial_Init(const uint32_t BaudRate,
+			                               const bool DoubleSpeed)
+			{
+				(void)BaudRate;
+				(void)DoubleSpeed;
+			}
+
+			/** Turns off the USART driver, disabling and returning used hardware to their default configuration. */
+			static inline void Serial_Disable(void);
+			static inline void Serial_Disable(void)
+			{
+				fflush(stderr);
+			}
+
+			/** Indicates whether a character has been received through the USART.
+			 *
+			 *  \return Boolean \c true if a character has been received, \c false otherwise.
+			 */
+			static inline bool Serial_IsCharReceived(void) ATTR_WARN_UNUSED_RESULT ATTR_ALWAYS_INLINE;
+			static inline bool Serial_IsCharReceived(void)
+			{
+				struct pollfd InputFD = {.fd = STDIN_FILENO, .events = POLLIN};
+
+				return ((poll(&InputFD, 1, 0) > 0) && (InputFD.revents & POLLIN));
+			}
+
+			/** Indicates whether there is hardware buffer space for a new transmit on the USART. This
+			 *  function can be used to determine if a call to \ref Serial_SendByte() will block in advance.
+			 *
+			 *  \return Boolean \c true if a character can be queued for transmission immediately, \c false otherwise.
+			 */
+			static inline bool Serial_IsSendReady(void) ATTR_WARN_UNUSED_RESULT ATTR_ALWAYS_INLINE;
+			static inline bool Serial_IsSendReady(void)
+			{
+				return true;
+			}
+
+			/** Indicates whether the hardware USART transmit buffer is completely empty, indicating all
+			 *  pending transmissions have completed.
+			 *
+			 *  \return Boolean \c true if no characters are buffered for transmission, \c false otherwise.
+			 */
+			static inline bool Serial_IsSendComplete(void) ATTR_WARN_UNUSED_RESULT ATTR_ALWAYS_INLINE;
+			static inline bool Serial_IsSendComplete(void)
+			{
+				return true;
+			}
+
+			/** Transmits a given byte through the USART.
+			 *
+			 *  \param[in] DataByte  Byte to transmit through the USART.
+			 */
+			static inline void Serial_SendByte(const char DataByte) ATTR_ALWAYS_INLINE;
+			static inline void Serial_SendByte(const char DataByte)
+			{
+				fputc(DataByte, stderr);
+			}
+
+			/** Receives the next byte from the USART.
+			 *
+			 *  \return Next byte received from the USART, or a negative value if no byte has been received.
+			 */
+			static inline int16_t Serial_ReceiveByte(void) ATTR_ALWAYS_INLINE;
+			static inline int16_t Serial_ReceiveByte(void)
+			{
+				uint8_t DataByte;
+
+				if (!(Serial_IsCharReceived()) || (read(STDIN_FILENO, &DataByte, 1) != 1))
+				  return -1;
+
+				return DataByte;
+			}
+
+	/* Disable C linkage for C++ Compilers: */
+		#if defined(__cplusplus)
+			}
+		#endif
+
+#endif
+
+/** @} */
+
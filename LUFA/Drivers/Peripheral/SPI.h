@@ -68,6 +68,8 @@
 			#include "AVR8/SPI_AVR8.h"
 		#elif (ARCH == ARCH_XMEGA)
 			#include "XMEGA/SPI_XMEGA.h"
+		#elif (ARCH == ARCH_POSIX)
+			#include "POSIX/SPI_POSIX.h"
 		#else
 			#error The SPI peripheral driver is not currently available for your selected architecture.
 		#endif
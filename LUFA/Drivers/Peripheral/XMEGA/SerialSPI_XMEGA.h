@@ -201,6 +201,35 @@
 				return SerialSPI_TransferByte(USART, 0);
 			}
 
+			/** Starts sending and receiving a byte through the USART SPI interface without waiting for the transfer to
+			 *  complete, so that other work can be done while the byte is shifted. Each call must be followed by a call to
+			 *  \ref SerialSPI_EndTransferByte() before the next transfer is started.
+			 *
+			 *  \param[in,out] USART     Pointer to the base of the USART peripheral within the device.
+			 *  \param[in]     DataByte  Byte to send through the USART SPI interface.
+			 */
+			static inline void SerialSPI_BeginTransferByte(USART_t* const USART,
+			                                               const uint8_t DataByte) ATTR_ALWAYS_INLINE ATTR_NON_NULL_PTR_ARG(1);
+			static inline void SerialSPI_BeginTransferByte(USART_t* const USART,
+			                                               const uint8_t DataByte)
+			{
+				USART->DATA = DataByte;
+			}
+
+			/** Completes a transfer started by \ref SerialSPI_BeginTransferByte(), blocking until the transfer is complete.
+			 *
+			 *  \param[in,out] USART  Pointer to the base of the USART peripheral within the device.
+			 *
+			 *  \return Response byte from the attached SPI device.
+			 */
+			static inline uint8_t SerialSPI_EndTransferByte(USART_t* const USART) ATTR_ALWAYS_INLINE ATTR_NON_NULL_PTR_ARG(1);
+			static inline uint8_t SerialSPI_EndTransferByte(USART_t* const USART)
+			{
+				while (!(USART->STATUS & USART_TXCIF_bm));
+				USART->STATUS = USART_TXCIF_bm;
+				return USART->DATA;
+			}
+
 	/* Disable C linkage for C++ Compilers: */
 		#if defined(__cplusplus)
 			}
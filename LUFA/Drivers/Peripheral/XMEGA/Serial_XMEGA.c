@@ -36,12 +36,56 @@
 
 FILE USARTSerialStream;
 
+#if defined(SERIAL_BUFFERED)
+SPSCRingBuffer_t Serial_TxBuffer;
+SPSCRingBuffer_t Serial_RxBuffer;
+
+static uint8_t Serial_TxBufferData[SERIAL_TX_BUFFER_SIZE];
+static uint8_t Serial_RxBufferData[SERIAL_RX_BUFFER_SIZE];
+
+static volatile Serial_BufferedErrors_t Serial_ErrorCounts;
+#endif
+
+static inline void Serial_OutputByte(USART_t* const USART,
+                                     const char DataByte)
+{
+	#if defined(SERIAL_BUFFERED)
+	if (USART == &SERIAL_BUFFERED_PORT)
+	{
+		Serial_BufferedSendByte(DataByte);
+		return;
+	}
+	#endif
+
+	Serial_SendByte(USART, DataByte);
+}
+
+static inline bool Serial_IsInputAvailable(USART_t* const USART)
+{
+	#if defined(SERIAL_BUFFERED)
+	if (USART == &SERIAL_BUFFERED_PORT)
+	  return (Serial_BufferedBytesReceived() != 0);
+	#endif
+
+	return Serial_IsCharReceived(USART);
+}
+
+static inline int16_t Serial_InputByte(USART_t* const USART)
+{
+	#if defined(SERIAL_BUFFERED)
+	if (USART == &SERIAL_BUFFERED_PORT)
+	  return Serial_BufferedReceiveByte();
+	#endif
+
+	return Serial_ReceiveByte(USART);
+}
+
 int Serial_putchar(char DataByte,
                    FILE *Stream)
 {
 	USART_t* USART = fdev_get_udata(Stream);
 
-	Serial_SendByte(USART, DataByte);
+	Serial_OutputByte(USART, DataByte);
 	return 0;
 }
 
@@ -49,18 +93,18 @@ int Serial_getchar(FILE *Stream)
 {
 	USART_t* USART = fdev_get_udata(Stream);
 
-	if (!(Serial_IsCharReceived(USART)))
+	if (!(Serial_IsInputAvailable(USART)))
 	  return _FDEV_EOF;
 
-	return Serial_ReceiveByte(USART);
+	return Serial_InputByte(USART);
 }
 
 int Serial_getchar_Blocking(FILE *Stream)
 {
 	USART_t* USART = fdev_get_udata(Stream);
 
-	while (!(Serial_IsCharReceived(USART)));
-	return Serial_ReceiveByte(USART);
+	while (!(Serial_IsInputAvailable(USART)));
+	return Serial_InputByte(USART);
 }
 
 void Serial_SendString_P(USART_t* const USART,
@@ -70,7 +114,7 @@ void Serial_SendString_P(USART_t* const USART,
 
 	while ((CurrByte = pgm_read_byte(FlashStringPtr)) != 0x00)
 	{
-		Serial_SendByte(USART, CurrByte);
+		Serial_OutputByte(USART, CurrByte);
 		FlashStringPtr++;
 	}
 }
@@ -82,7 +126,7 @@ void Serial_SendString(USART_t* const USART,
 
 	while ((CurrByte = *StringPtr) != 0x00)
 	{
-		Serial_SendByte(USART, CurrByte);
+		Serial_OutputByte(USART, CurrByte);
 		StringPtr++;
 	}
 }
@@ -93,6 +137,21 @@ void Serial_SendData(USART_t* const USART,
 {
 	uint8_t* CurrByte = (uint8_t*)Buffer;
 
+	#if defined(SERIAL_BUFFERED)
+	if (USART == &SERIAL_BUFFERED_PORT)
+	{
+		while (Length)
+		{
+			uint16_t BytesQueued = Serial_BufferedSendData(CurrByte, Length);
+
+			CurrByte += BytesQueued;
+			Length   -= BytesQueued;
+		}
+
+		return;
+	}
+	#endif
+
 	while (Length--)
 	  Serial_SendByte(USART, *(CurrByte++));
 }
@@ -123,4 +182,83 @@ void Serial_CreateBlockingStream(USART_t* USART, FILE* Stream)
     fdev_set_udata(Stream, USART);
 }
 
+#if defined(SERIAL_BUFFERED)
+void Serial_BufferedInit(const uint32_t BaudRate,
+                         const bool DoubleSpeed)
+{
+	SERIAL_BUFFERED_PORT.CTRLA = 0;
+
+	SPSCRingBuffer_InitBuffer(&Serial_TxBuffer, Serial_TxBufferData, sizeof(Serial_TxBufferData));
+	SPSCRingBuffer_InitBuffer(&Serial_RxBuffer, Serial_RxBufferData, sizeof(Serial_RxBufferData));
+
+	Serial_ErrorCounts.OverrunErrors   = 0;
+	Serial_ErrorCounts.FramingErrors   = 0;
+	Serial_ErrorCounts.BufferOverflows = 0;
+
+	Serial_Init(&SERIAL_BUFFERED_PORT, BaudRate, DoubleSpeed);
+	SERIAL_BUFFERED_PORT.CTRLA = USART_RXCINTLVL_LO_gc;
+}
+
+uint16_t Serial_BufferedSendData(const void* Buffer,
+                                 uint16_t Length)
+{
+	uint16_t BytesQueued = SPSCRingBuffer_Write(&Serial_TxBuffer, Buffer, Length);
+
+	if (BytesQueued)
+	  Serial_BufferedStartTransmit();
+
+	return BytesQueued;
+}
+
+uint16_t Serial_BufferedReceiveData(void* Buffer,
+                                    uint16_t Length)
+{
+	return SPSCRingBuffer_Read(&Serial_RxBuffer, Buffer, Length);
+}
+
+void Serial_BufferedGetErrors(Serial_BufferedErrors_t* const Errors)
+{
+	uint_reg_t CurrentGlobalInt = GetGlobalInterruptMask();
+	GlobalInterruptDisable();
+
+	Errors->OverrunErrors   = Serial_ErrorCounts.OverrunErrors;
+	Errors->FramingErrors   = Serial_ErrorCounts.FramingErrors;
+	Errors->BufferOverflows = Serial_ErrorCounts.BufferOverflows;
+
+	Serial_ErrorCounts.OverrunErrors   = 0;
+	Serial_ErrorCounts.FramingErrors   = 0;
+	Serial_ErrorCounts.BufferOverflows = 0;
+
+	SetGlobalInterruptMask(CurrentGlobalInt);
+}
+
+ISR(SERIAL_BUFFERED_VECTOR(_RXC_vect), ISR_BLOCK)
+{
+	/* Error flags must be read before the data register, as reading the data register clears them */
+	uint8_t Status   = SERIAL_BUFFERED_PORT.STATUS;
+	uint8_t DataByte = SERIAL_BUFFERED_PORT.DATA;
+
+	if (Status & USART_BUFOVF_bm)
+	  Serial_ErrorCounts.OverrunErrors++;
+
+	if (Status & USART_FERR_bm)
+	  Serial_ErrorCounts.FramingErrors++;
+
+	if (SPSCRingBuffer_IsFull(&Serial_RxBuffer))
+	  Serial_ErrorCounts.BufferOverflows++;
+	else
+	  SPSCRingBuffer_Insert(&Serial_RxBuffer, DataByte);
+}
+
+ISR(SERIAL_BUFFERED_VECTOR(_DRE_vect), ISR_BLOCK)
+{
+	if (!(SPSCRingBuffer_IsEmpty(&Serial_TxBuffer)))
+	  SERIAL_BUFFERED_PORT.DATA = SPSCRingBuffer_Remove(&Serial_TxBuffer);
+
+	/* Stop the interrupt once the buffer is drained; it is re-enabled whenever new data is queued */
+	if (SPSCRingBuffer_IsEmpty(&Serial_TxBuffer))
+	  SERIAL_BUFFERED_PORT.CTRLA &= ~USART_DREINTLVL_gm;
+}
+#endif
+
 #endif
@@ -61,6 +61,37 @@
  *      uint8_t DataByte = Serial_RxByte(&USARTD0);
  *  \endcode
  *
+ *  \section Sec_Serial_XMEGA_BufferedMode Buffered Mode
+ *  By default the driver is entirely polled, so that each transmitted byte waits for the USART's data register
+ *  to become free. When the \c SERIAL_BUFFERED compile time token is defined, the driver instead provides an
+ *  interrupt driven buffered mode for one of the device's USARTs, where transmitted data is queued into a RAM buffer
+ *  and sent by the USART's data register empty interrupt, and received data is placed into a second RAM buffer by
+ *  the USART's receive complete interrupt. The USART to buffer is selected by defining the \c SERIAL_BUFFERED_USART
+ *  token to the USART's port and instance number, e.g. \c D0 for \c USARTD0. The sizes of the buffers may be set with
+ *  the \c SERIAL_TX_BUFFER_SIZE and \c SERIAL_RX_BUFFER_SIZE tokens, and must each be a power of two no larger than
+ *  128 bytes.
+ *
+ *  In buffered mode the selected USART must be initialized with \ref Serial_BufferedInit() rather than \ref Serial_Init(),
+ *  and low level interrupts must be enabled in the PMIC along with global interrupts. The string and data transmission
+ *  functions and the streams created by \ref Serial_CreateStream() and \ref Serial_CreateBlockingStream() then use the
+ *  buffers automatically when given the buffered USART, only waiting when the transmit buffer is full, so that \c printf()
+ *  output at a low baud rate does not stall the rest of the application. The \ref Serial_SendByte() and
+ *  \ref Serial_ReceiveByte() functions access the USART hardware directly, and must not be used on the buffered USART.
+ *
+ *  \code
+ *      // Initialize the buffered serial USART (SERIAL_BUFFERED_USART) with 9600 baud (and no double-speed mode)
+ *      Serial_BufferedInit(9600, false);
+ *      PMIC.CTRL |= PMIC_LOLVLEN_bm;
+ *      GlobalInterruptEnable();
+ *
+ *      // Queue as much of a block of data as will currently fit into the transmit buffer, without waiting
+ *      uint16_t BytesQueued = Serial_BufferedSendData(Block, sizeof(Block));
+ *
+ *      // Read out any received data, without waiting
+ *      uint8_t  ReceivedData[16];
+ *      uint16_t BytesReceived = Serial_BufferedReceiveData(ReceivedData, sizeof(ReceivedData));
+ *  \endcode
+ *
  *  @{
  */
 
@@ -93,6 +124,52 @@
 			                   FILE *Stream);
 			int Serial_getchar(FILE *Stream);
 			int Serial_getchar_Blocking(FILE *Stream);
+
+		#if defined(SERIAL_BUFFERED)
+		/* Includes: */
+			#include "../../Misc/SPSCRingBuffer.h"
+
+		/* Macros: */
+			#if !defined(SERIAL_BUFFERED_USART)
+				#error SERIAL_BUFFERED_USART must be defined to the USART to buffer (e.g. D0 for USARTD0) when SERIAL_BUFFERED is used.
+			#endif
+
+			#if !defined(SERIAL_TX_BUFFER_SIZE)
+				#define SERIAL_TX_BUFFER_SIZE   64
+			#endif
+
+			#if !defined(SERIAL_RX_BUFFER_SIZE)
+				#define SERIAL_RX_BUFFER_SIZE   64
+			#endif
+
+			#if ((SERIAL_TX_BUFFER_SIZE & (SERIAL_TX_BUFFER_SIZE - 1)) || (SERIAL_TX_BUFFER_SIZE > 128))
+				#error SERIAL_TX_BUFFER_SIZE must be a power of two no larger than 128.
+			#endif
+
+			#if ((SERIAL_RX_BUFFER_SIZE & (SERIAL_RX_BUFFER_SIZE - 1)) || (SERIAL_RX_BUFFER_SIZE > 128))
+				#error SERIAL_RX_BUFFER_SIZE must be a power of two no larger than 128.
+			#endif
+
+			#define SERIAL_BUFFERED_PORT            CONCAT_EXPANDED(USART, SERIAL_BUFFERED_USART)
+			#define SERIAL_BUFFERED_VECTOR(Vector)  CONCAT_EXPANDED(USART, CONCAT_EXPANDED(SERIAL_BUFFERED_USART, Vector))
+
+		/* External Variables: */
+			extern SPSCRingBuffer_t Serial_TxBuffer;
+			extern SPSCRingBuffer_t Serial_RxBuffer;
+
+		/* Inline Functions: */
+			static inline void Serial_BufferedStartTransmit(void) ATTR_ALWAYS_INLINE;
+			static inline void Serial_BufferedStartTransmit(void)
+			{
+				/* The data register empty ISR clears its own enable bit, so the read-modify-write must not be interrupted */
+				uint_reg_t CurrentGlobalInt = GetGlobalInterruptMask();
+				GlobalInterruptDisable();
+
+				SERIAL_BUFFERED_PORT.CTRLA |= USART_DREINTLVL_LO_gc;
+
+				SetGlobalInterruptMask(CurrentGlobalInt);
+			}
+		#endif
 	#endif
 
 	/* Public Interface - May be used in end-application: */
@@ -115,6 +192,17 @@
 			 */
 			#define SERIAL_2X_UBBRVAL(Baud) ((((F_CPU / 8) + (Baud / 2)) / (Baud)) - 1)
 
+		#if defined(SERIAL_BUFFERED) || defined(__DOXYGEN__)
+		/* Type Defines: */
+			/** Type define for the error counters of the buffered USART, retrieved via \ref Serial_BufferedGetErrors(). */
+			typedef struct
+			{
+				uint16_t OverrunErrors; /**< Number of received bytes lost because the hardware USART receive buffer overran. */
+				uint16_t FramingErrors; /**< Number of bytes received with an invalid stop bit. */
+				uint16_t BufferOverflows; /**< Number of received bytes discarded because the receive buffer was full. */
+			} Serial_BufferedErrors_t;
+		#endif
+
 		/* Function Prototypes: */
 			/** Transmits a given string located in program space (FLASH) through the USART.
 			 *
@@ -170,6 +258,55 @@
 			 */
 			void Serial_CreateBlockingStream(USART_t* USART, FILE* Stream);
 
+		#if defined(SERIAL_BUFFERED) || defined(__DOXYGEN__)
+			/** Initializes the USART selected by the \c SERIAL_BUFFERED_USART token in buffered mode, ready for interrupt driven
+			 *  serial data transmission and reception. This empties the transmit and receive buffers, clears the error counters,
+			 *  configures the USART as per \ref Serial_Init() and enables the USART's receive complete interrupt at low priority.
+			 *
+			 *  \note This function is only available when the \c SERIAL_BUFFERED compile time token is defined.
+			 *
+			 *  \param[in] BaudRate     Serial baud rate, in bits per second. This should be the target baud rate regardless of the
+			 *                          \c DoubleSpeed parameter's value.
+			 *  \param[in] DoubleSpeed  Enables double speed mode when set, halving the sample time to double the baud rate.
+			 */
+			void Serial_BufferedInit(const uint32_t BaudRate,
+			                         const bool DoubleSpeed);
+
+			/** Queues as much of the given buffer located in SRAM memory as will currently fit into the transmit buffer of the
+			 *  buffered USART, without waiting for space to become available.
+			 *
+			 *  \note This function is only available when the \c SERIAL_BUFFERED compile time token is defined.
+			 *
+			 *  \param[in] Buffer  Pointer to a buffer containing the data to send.
+			 *  \param[in] Length  Length of the data to send, in bytes.
+			 *
+			 *  \return Number of bytes queued for transmission, which may be less than the requested length.
+			 */
+			uint16_t Serial_BufferedSendData(const void* Buffer,
+			                                 uint16_t Length) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Reads as many bytes as are currently available, up to the given length, from the receive buffer of the buffered
+			 *  USART into the given buffer located in SRAM memory, without waiting for further data to arrive.
+			 *
+			 *  \note This function is only available when the \c SERIAL_BUFFERED compile time token is defined.
+			 *
+			 *  \param[out] Buffer  Pointer to a buffer where the received data is to be stored.
+			 *  \param[in]  Length  Maximum number of bytes to read.
+			 *
+			 *  \return Number of bytes read from the receive buffer.
+			 */
+			uint16_t Serial_BufferedReceiveData(void* Buffer,
+			                                    uint16_t Length) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Retrieves the buffered USART's receive error counters, and resets them back to zero.
+			 *
+			 *  \note This function is only available when the \c SERIAL_BUFFERED compile time token is defined.
+			 *
+			 *  \param[out] Errors  Pointer to a structure where the error counts are to be stored.
+			 */
+			void Serial_BufferedGetErrors(Serial_BufferedErrors_t* const Errors) ATTR_NON_NULL_PTR_ARG(1);
+		#endif
+
 		/* Inline Functions: */
 			/** Initializes the USART, ready for serial data transmission and reception. This initializes the interface to
 			 *  standard 8-bit, no parity, 1 stop bit settings suitable for most applications.
@@ -278,6 +415,79 @@
 				return USART->DATA;
 			}
 
+		#if defined(SERIAL_BUFFERED) || defined(__DOXYGEN__)
+			/** Retrieves the number of bytes waiting in the receive buffer of the buffered USART.
+			 *
+			 *  \note This function is only available when the \c SERIAL_BUFFERED compile time token is defined.
+			 *
+			 *  \return Number of received bytes which have not yet been read.
+			 */
+			static inline uint16_t Serial_BufferedBytesReceived(void) ATTR_WARN_UNUSED_RESULT ATTR_ALWAYS_INLINE;
+			static inline uint16_t Serial_BufferedBytesReceived(void)
+			{
+				return SPSCRingBuffer_GetCount(&Serial_RxBuffer);
+			}
+
+			/** Retrieves the amount of free space in the transmit buffer of the buffered USART. This function can be used to
+			 *  determine in advance whether a call to \ref Serial_BufferedSendByte() will block, or how much of a block of data
+			 *  \ref Serial_BufferedSendData() will accept.
+			 *
+			 *  \note This function is only available when the \c SERIAL_BUFFERED compile time token is defined.
+			 *
+			 *  \return Number of bytes which can be queued for transmission immediately.
+			 */
+			static inline uint16_t Serial_BufferedSendFreeCount(void) ATTR_WARN_UNUSED_RESULT ATTR_ALWAYS_INLINE;
+			static inline uint16_t Serial_BufferedSendFreeCount(void)
+			{
+				return SPSCRingBuffer_GetFreeCount(&Serial_TxBuffer);
+			}
+
+			/** Queues a given byte for transmission through the buffered USART.
+			 *
+			 *  \note If the transmit buffer is full, this function will block until the USART has sent enough data to make
+			 *        space for the new byte.
+			 *
+			 *  \note This function is only available when the \c SERIAL_BUFFERED compile time token is defined.
+			 *
+			 *  \param[in] DataByte  Byte to transmit through the USART.
+			 */
+			static inline void Serial_BufferedSendByte(const char DataByte);
+			static inline void Serial_BufferedSendByte(const char DataByte)
+			{
+				while (SPSCRingBuffer_IsFull(&Serial_TxBuffer));
+
+				SPSCRingBuffer_Insert(&Serial_TxBuffer, DataByte);
+				Serial_BufferedStartTransmit();
+			}
+
+			/** Receives the next byte from the receive buffer of the buffered USART.
+			 *
+			 *  \note This function is only available when the \c SERIAL_BUFFERED compile time token is defined.
+			 *
+			 *  \return Next byte received from the USART, or a negative value if no byte has been received.
+			 */
+			static inline int16_t Serial_BufferedReceiveByte(void);
+			static inline int16_t Serial_BufferedReceiveByte(void)
+			{
+				if (SPSCRingBuffer_IsEmpty(&Serial_RxBuffer))
+				  return -1;
+
+				return SPSCRingBuffer_Remove(&Serial_RxBuffer);
+			}
+
+			/** Waits until all data queued in the transmit buffer of the buffered USART has been handed to the USART hardware.
+			 *  This can be combined with \ref Serial_IsSendComplete() to wait until the final byte has left the USART before it
+			 *  is disabled.
+			 *
+			 *  \note This function is only available when the \c SERIAL_BUFFERED compile time token is defined.
+			 */
+			static inline void Serial_BufferedFlush(void);
+			static inline void Serial_BufferedFlush(void)
+			{
+				while (!(SPSCRingBuffer_IsEmpty(&Serial_TxBuffer)));
+			}
+		#endif
+
 	/* Disable C linkage for C++ Compilers: */
 		#if defined(__cplusplus)
 			}
@@ -112,6 +112,98 @@
 		#define CDC_CONTROL_LINE_IN_OVERRUNERROR (1 << 6)
 		//@}
 
+		/** Initializer for a \ref USB_CDC_Descriptor_ACMFunction_t descriptor block, describing a complete CDC-ACM virtual
+		 *  serial port function within a device's configuration descriptor. This allows devices with several virtual serial
+		 *  ports to declare an array of identical functions, differing only in their interface numbers and endpoints.
+		 *
+		 *  \param[in] FirstInterface      Interface number of the function's CDC control interface; the data interface
+		 *                                 uses the next interface number.
+		 *  \param[in] NotificationEPAddr  Address of the function's device-to-host notification IN endpoint.
+		 *  \param[in] NotificationEPSize  Size in bytes of the function's notification IN endpoint.
+		 *  \param[in] DataINEPAddr        Address of the function's device-to-host data IN endpoint.
+		 *  \param[in] DataOUTEPAddr       Address of the function's host-to-device data OUT endpoint.
+		 *  \param[in] DataEPSize          Size in bytes of the function's data IN and OUT endpoints.
+		 */
+		#define CDC_ACM_FUNCTION_DESCRIPTOR(FirstInterface, NotificationEPAddr, NotificationEPSize, \
+		                                    DataINEPAddr, DataOUTEPAddr, DataEPSize)                \
+			{                                                                                       \
+				.IAD =                                                                              \
+					{                                                                               \
+						.Header                = {.Size = sizeof(USB_Descriptor_Interface_Association_t), .Type = DTYPE_InterfaceAssociation}, \
+						.FirstInterfaceIndex   = (FirstInterface),                                  \
+						.TotalInterfaces       = 2,                                                 \
+						.Class                 = CDC_CSCP_CDCClass,                                 \
+						.SubClass              = CDC_CSCP_ACMSubclass,                              \
+						.Protocol              = CDC_CSCP_ATCommandProtocol,                        \
+						.IADStrIndex           = NO_DESCRIPTOR                                      \
+					},                                                                              \
+				.CCI_Interface =                                                                    \
+					{                                                                               \
+						.Header                = {.Size = sizeof(USB_Descriptor_Interface_t), .Type = DTYPE_Interface}, \
+						.InterfaceNumber       = (FirstInterface),                                  \
+						.AlternateSetting      = 0,                                                 \
+						.TotalEndpoints        = 1,                                                 \
+						.Class                 = CDC_CSCP_CDCClass,                                 \
+						.SubClass              = CDC_CSCP_ACMSubclass,                              \
+						.Protocol              = CDC_CSCP_ATCommandProtocol,                        \
+						.InterfaceStrIndex     = NO_DESCRIPTOR                                      \
+					},                                                                              \
+				.Functional_Header =                                                                \
+					{                                                                               \
+						.Header                = {.Size = sizeof(USB_CDC_Descriptor_FunctionalHeader_t), .Type = CDC_DTYPE_CSInterface}, \
+						.Subtype               = CDC_DSUBTYPE_CSInterface_Header,                   \
+						.CDCSpecification      = VERSION_BCD(1,1,0)                                 \
+					},                                                                              \
+				.Functional_ACM =                                                                   \
+					{                                                                               \
+						.Header                = {.Size = sizeof(USB_CDC_Descriptor_FunctionalACM_t), .Type = CDC_DTYPE_CSInterface}, \
+						.Subtype               = CDC_DSUBTYPE_CSInterface_ACM,                      \
+						.Capabilities          = 0x06                                               \
+					},                                                                              \
+				.Functional_Union =                                                                 \
+					{                                                                               \
+						.Header                = {.Size = sizeof(USB_CDC_Descriptor_FunctionalUnion_t), .Type = CDC_DTYPE_CSInterface}, \
+						.Subtype               = CDC_DSUBTYPE_CSInterface_Union,                    \
+						.MasterInterfaceNumber = (FirstInterface),                                  \
+						.SlaveInterfaceNumber  = ((FirstInterface) + 1)                             \
+					},                                                                              \
+				.ManagementEndpoint =                                                               \
+					{                                                                               \
+						.Header                = {.Size = sizeof(USB_Descriptor_Endpoint_t), .Type = DTYPE_Endpoint}, \
+						.EndpointAddress       = (NotificationEPAddr),                              \
+						.Attributes            = (EP_TYPE_INTERRUPT | ENDPOINT_ATTR_NO_SYNC | ENDPOINT_USAGE_DATA), \
+						.EndpointSize          = (NotificationEPSize),                              \
+						.PollingIntervalMS     = 0xFF                                               \
+					},                                                                              \
+				.DCI_Interface =                                                                    \
+					{                                                                               \
+						.Header                = {.Size = sizeof(USB_Descriptor_Interface_t), .Type = DTYPE_Interface}, \
+						.InterfaceNumber       = ((FirstInterface) + 1),                            \
+						.AlternateSetting      = 0,                                                 \
+						.TotalEndpoints        = 2,                                                 \
+						.Class                 = CDC_CSCP_CDCDataClass,                             \
+						.SubClass              = CDC_CSCP_NoDataSubclass,                           \
+						.Protocol              = CDC_CSCP_NoDataProtocol,                           \
+						.InterfaceStrIndex     = NO_DESCRIPTOR                                      \
+					},                                                                              \
+				.DataOutEndpoint =                                                                  \
+					{                                                                               \
+						.Header                = {.Size = sizeof(USB_Descriptor_Endpoint_t), .Type = DTYPE_Endpoint}, \
+						.EndpointAddress       = (DataOUTEPAddr),                                   \
+						.Attributes            = (EP_TYPE_BULK | ENDPOINT_ATTR_NO_SYNC | ENDPOINT_USAGE_DATA), \
+						.EndpointSize          = (DataEPSize),                                      \
+						.PollingIntervalMS     = 0x05                                               \
+					},                                                                              \
+				.DataInEndpoint =                                                                   \
+					{                                                                               \
+						.Header                = {.Size = sizeof(USB_Descriptor_Endpoint_t), .Type = DTYPE_Endpoint}, \
+						.EndpointAddress       = (DataINEPAddr),                                    \
+						.Attributes            = (EP_TYPE_BULK | ENDPOINT_ATTR_NO_SYNC | ENDPOINT_USAGE_DATA), \
+						.EndpointSize          = (DataEPSize),                                      \
+						.PollingIntervalMS     = 0x05                                               \
+					}                                                                               \
+			}
+
 	/* Enums: */
 		/** Enum for possible Class, Subclass and Protocol values of device and interface descriptors relating to the CDC
 		 *  device class.
@@ -353,6 +445,27 @@
 			uint8_t bSlaveInterface0; /**< Interface number of the CDC Data interface. */
 		} ATTR_PACKED USB_CDC_StdDescriptor_FunctionalUnion_t;
 
+		/** \brief CDC-ACM Virtual Serial Port Function Descriptor Block.
+		 *
+		 *  Type define for the complete set of descriptors making up a single CDC-ACM virtual serial port function within a
+		 *  device's configuration descriptor: the Interface Association Descriptor linking the two interfaces together, the
+		 *  CDC control interface with its class-specific functional descriptors and notification endpoint, and the CDC data
+		 *  interface with its data endpoints. Devices with several virtual serial ports may declare an array of this type in
+		 *  their configuration descriptor, initialized via \ref CDC_ACM_FUNCTION_DESCRIPTOR().
+		 */
+		typedef struct
+		{
+			USB_Descriptor_Interface_Association_t IAD; /**< Interface Association Descriptor for the function. */
+			USB_Descriptor_Interface_t             CCI_Interface; /**< CDC control interface descriptor. */
+			USB_CDC_Descriptor_FunctionalHeader_t  Functional_Header; /**< CDC class-specific functional header descriptor. */
+			USB_CDC_Descriptor_FunctionalACM_t     Functional_ACM; /**< CDC class-specific functional ACM descriptor. */
+			USB_CDC_Descriptor_FunctionalUnion_t   Functional_Union; /**< CDC class-specific functional Union descriptor. */
+			USB_Descriptor_Endpoint_t              ManagementEndpoint; /**< Notification IN endpoint descriptor. */
+			USB_Descriptor_Interface_t             DCI_Interface; /**< CDC data interface descriptor. */
+			USB_Descriptor_Endpoint_t              DataOutEndpoint; /**< Data OUT endpoint descriptor. */
+			USB_Descriptor_Endpoint_t              DataInEndpoint; /**< Data IN endpoint descriptor. */
+		} ATTR_PACKED USB_CDC_Descriptor_ACMFunction_t;
+
 		/** \brief CDC Virtual Serial Port Line Encoding Settings Structure.
 		 *
 		 *  Type define for a CDC Line Encoding structure, used to hold the various encoding parameters for a virtual
@@ -30,25 +30,28 @@
 
 #define  __INCLUDE_FROM_USB_DRIVER
 #define  __INCLUDE_FROM_HID_DRIVER
+#define  __INCLUDE_FROM_HIDPARSER_C
 #include "HIDParser.h"
 
-uint8_t USB_ProcessHIDReport(const uint8_t* ReportData,
-                             uint16_t ReportSize,
-                             HID_ReportInfo_t* const ParserData)
+static uint8_t USB_ParseHIDReport(const uint8_t* ReportData,
+                                  uint16_t ReportSize,
+                                  HID_ReportLayout_t* const Layout,
+                                  HID_CollectionPath_t* const CollectionPaths,
+                                  HID_ReportInfo_t* const ParserData,
+                                  const HID_ReportItemCallbackPtr_t ItemCallback)
 {
 	HID_StateTable_t      StateTable[HID_STATETABLE_STACK_DEPTH];
 	HID_StateTable_t*     CurrStateTable     = &StateTable[0];
 	HID_CollectionPath_t* CurrCollectionPath = NULL;
-	HID_ReportSizeInfo_t* CurrReportIDInfo   = &ParserData->ReportIDSizes[0];
+	HID_ReportSizeInfo_t* CurrReportIDInfo   = &Layout->ReportIDSizes[0];
 	uint16_t              UsageList[HID_USAGE_STACK_DEPTH];
 	uint8_t               UsageListSize      = 0;
 	HID_MinMax_t          UsageMinMax        = {0, 0};
 
-	memset(ParserData,       0x00, sizeof(HID_ReportInfo_t));
+	memset(Layout,           0x00, sizeof(HID_ReportLayout_t));
 	memset(CurrStateTable,   0x00, sizeof(HID_StateTable_t));
-	memset(CurrReportIDInfo, 0x00, sizeof(HID_ReportSizeInfo_t));
 
-	ParserData->TotalDeviceReports = 1;
+	Layout->TotalDeviceReports = 1;
 
 	while (ReportSize)
 	{
@@ -61,6 +64,9 @@ uint8_t USB_ProcessHIDReport(const uint8_t* ReportData,
 		switch (HIDReportItem & HID_RI_DATA_SIZE_MASK)
 		{
 			case HID_RI_DATA_BITS_32:
+				if (ReportSize < 4)
+				  return HID_PARSE_TruncatedReportItem;
+
 				ReportItemData  = (((uint32_t)ReportData[3] << 24) | ((uint32_t)ReportData[2] << 16) |
 			                       ((uint16_t)ReportData[1] << 8)  | ReportData[0]);
 				ReportSize     -= 4;
@@ -68,12 +74,18 @@ uint8_t USB_ProcessHIDReport(const uint8_t* ReportData,
 				break;
 
 			case HID_RI_DATA_BITS_16:
+				if (ReportSize < 2)
+				  return HID_PARSE_TruncatedReportItem;
+
 				ReportItemData  = (((uint16_t)ReportData[1] << 8) | (ReportData[0]));
 				ReportSize     -= 2;
 				ReportData     += 2;
 				break;
 
 			case HID_RI_DATA_BITS_8:
+				if (ReportSize < 1)
+				  return HID_PARSE_TruncatedReportItem;
+
 				ReportItemData  = ReportData[0];
 				ReportSize     -= 1;
 				ReportData     += 1;
@@ -102,6 +114,15 @@ uint8_t USB_ProcessHIDReport(const uint8_t* ReportData,
 				  return HID_PARSE_HIDStackUnderflow;
 
 				CurrStateTable--;
+
+				/* Report ID is a global item, so the restored state may belong to a different report */
+				if (Layout->UsingReportIDs && (CurrReportIDInfo->ReportID != CurrStateTable->ReportID))
+				{
+					CurrReportIDInfo = USB_GetHIDReportSizeInfo(Layout, CurrStateTable->ReportID);
+
+					if (CurrReportIDInfo == NULL)
+					  return HID_PARSE_InsufficientReportIDItems;
+				}
 				break;
 
 			case HID_RI_USAGE_PAGE(0):
@@ -113,6 +134,15 @@ uint8_t USB_ProcessHIDReport(const uint8_t* ReportData,
 
 			case HID_RI_LOGICAL_MINIMUM(0):
 				CurrStateTable->Attributes.Logical.Minimum  = ReportItemData;
+
+				#if defined(HID_EXTRACTION_PLANS)
+				{
+					uint8_t DataSize = (HIDReportItem & HID_RI_DATA_SIZE_MASK);
+					uint8_t DataBits = (DataSize == HID_RI_DATA_BITS_32) ? 32 : (DataSize * 8);
+
+					CurrStateTable->LogicalMinimumNegative = (DataBits && (ReportItemData & ((uint32_t)1 << (DataBits - 1))));
+				}
+				#endif
 				break;
 
 			case HID_RI_LOGICAL_MAXIMUM(0):
@@ -146,30 +176,23 @@ uint8_t USB_ProcessHIDReport(const uint8_t* ReportData,
 			case HID_RI_REPORT_ID(0):
 				CurrStateTable->ReportID                    = ReportItemData;
 
-				if (ParserData->UsingReportIDs)
+				if (Layout->UsingReportIDs)
 				{
-					CurrReportIDInfo = NULL;
-
-					for (uint8_t i = 0; i < ParserData->TotalDeviceReports; i++)
-					{
-						if (ParserData->ReportIDSizes[i].ReportID == CurrStateTable->ReportID)
-						{
-							CurrReportIDInfo = &ParserData->ReportIDSizes[i];
-							break;
-						}
-					}
+					CurrReportIDInfo = USB_GetHIDReportSizeInfo(Layout, CurrStateTable->ReportID);
 
 					if (CurrReportIDInfo == NULL)
-					{
-						if (ParserData->TotalDeviceReports == HID_MAX_REPORT_IDS)
-						  return HID_PARSE_InsufficientReportIDItems;
-
-						CurrReportIDInfo = &ParserData->ReportIDSizes[ParserData->TotalDeviceReports++];
-						memset(CurrReportIDInfo, 0x00, sizeof(HID_ReportSizeInfo_t));
-					}
+					  return HID_PARSE_InsufficientReportIDItems;
+				}
+				else if (CurrReportIDInfo->ReportSizeBits[HID_REPORT_ITEM_In] ||
+				         CurrReportIDInfo->ReportSizeBits[HID_REPORT_ITEM_Out] ||
+				         CurrReportIDInfo->ReportSizeBits[HID_REPORT_ITEM_Feature])
+				{
+					/* The first report's size entry is renamed to the new report ID, which would misattribute any data
+					 * already declared outside of a numbered report */
+					return HID_PARSE_ItemsWithoutReportID;
 				}
 
-				ParserData->UsingReportIDs = true;
+				Layout->UsingReportIDs = true;
 
 				CurrReportIDInfo->ReportID = CurrStateTable->ReportID;
 				break;
@@ -192,17 +215,17 @@ uint8_t USB_ProcessHIDReport(const uint8_t* ReportData,
 			case HID_RI_COLLECTION(0):
 				if (CurrCollectionPath == NULL)
 				{
-					CurrCollectionPath = &ParserData->CollectionPaths[0];
+					CurrCollectionPath = &CollectionPaths[0];
 				}
 				else
 				{
 					HID_CollectionPath_t* ParentCollectionPath = CurrCollectionPath;
 
-					CurrCollectionPath = &ParserData->CollectionPaths[1];
+					CurrCollectionPath = &CollectionPaths[1];
 
 					while (CurrCollectionPath->Parent != NULL)
 					{
-						if (CurrCollectionPath == &ParserData->CollectionPaths[HID_MAX_COLLECTIONS - 1])
+						if (CurrCollectionPath == &CollectionPaths[HID_MAX_COLLECTIONS - 1])
 						  return HID_PARSE_InsufficientCollectionPaths;
 
 						CurrCollectionPath++;
@@ -277,9 +300,21 @@ uint8_t USB_ProcessHIDReport(const uint8_t* ReportData,
 
 					NewReportItem.BitOffset = CurrReportIDInfo->ReportSizeBits[NewReportItem.ItemType];
 
+					if (((uint32_t)NewReportItem.BitOffset + CurrStateTable->Attributes.BitSize) > UINT16_MAX)
+					  return HID_PARSE_ReportTooLarge;
+
 					CurrReportIDInfo->ReportSizeBits[NewReportItem.ItemType] += CurrStateTable->Attributes.BitSize;
 
-					ParserData->LargestReportSizeBits = MAX(ParserData->LargestReportSizeBits, CurrReportIDInfo->ReportSizeBits[NewReportItem.ItemType]);
+					Layout->LargestReportSizeBits = MAX(Layout->LargestReportSizeBits, CurrReportIDInfo->ReportSizeBits[NewReportItem.ItemType]);
+
+					/* In streaming mode, hand each finished item to the application instead of storing it */
+					if (ParserData == NULL)
+					{
+						if (!(ReportItemData & HID_IOF_CONSTANT))
+						  ItemCallback(&NewReportItem);
+
+						continue;
+					}
 
 					if (ParserData->TotalReportItems == HID_MAX_REPORTITEMS)
 					  return HID_PARSE_InsufficientReportItems;
@@ -288,7 +323,14 @@ uint8_t USB_ProcessHIDReport(const uint8_t* ReportData,
 					       &NewReportItem, sizeof(HID_ReportItem_t));
 
 					if (!(ReportItemData & HID_IOF_CONSTANT) && CALLBACK_HIDParser_FilterHIDReportItem(&NewReportItem))
-					  ParserData->TotalReportItems++;
+					{
+						#if defined(HID_EXTRACTION_PLANS)
+						USB_CompileHIDExtractionStep(&ParserData->ExtractionPlan[ParserData->TotalReportItems],
+						                             &NewReportItem, CurrStateTable->LogicalMinimumNegative);
+						#endif
+
+						ParserData->TotalReportItems++;
+					}
 				}
 
 				break;
@@ -305,12 +347,68 @@ uint8_t USB_ProcessHIDReport(const uint8_t* ReportData,
 		}
 	}
 
+	return HID_PARSE_Successful;
+}
+
+static HID_ReportSizeInfo_t* USB_GetHIDReportSizeInfo(HID_ReportLayout_t* const Layout,
+                                                      const uint8_t ReportID)
+{
+	HID_ReportSizeInfo_t* ReportIDInfo;
+
+	for (uint8_t i = 0; i < Layout->TotalDeviceReports; i++)
+	{
+		if (Layout->ReportIDSizes[i].ReportID == ReportID)
+		  return &Layout->ReportIDSizes[i];
+	}
+
+	if (Layout->TotalDeviceReports == HID_MAX_REPORT_IDS)
+	  return NULL;
+
+	ReportIDInfo = &Layout->ReportIDSizes[Layout->TotalDeviceReports++];
+	memset(ReportIDInfo, 0x00, sizeof(HID_ReportSizeInfo_t));
+	ReportIDInfo->ReportID = ReportID;
+
+	return ReportIDInfo;
+}
+
+uint8_t USB_ProcessHIDReport(const uint8_t* ReportData,
+                             uint16_t ReportSize,
+                             HID_ReportInfo_t* const ParserData)
+{
+	HID_ReportLayout_t Layout;
+	uint8_t            ErrorCode;
+
+	memset(ParserData, 0x00, sizeof(HID_ReportInfo_t));
+
+	ErrorCode = USB_ParseHIDReport(ReportData, ReportSize, &Layout, ParserData->CollectionPaths, ParserData, NULL);
+
+	ParserData->TotalDeviceReports    = Layout.TotalDeviceReports;
+	ParserData->LargestReportSizeBits = Layout.LargestReportSizeBits;
+	ParserData->UsingReportIDs        = Layout.UsingReportIDs;
+	memcpy(ParserData->ReportIDSizes, Layout.ReportIDSizes, sizeof(ParserData->ReportIDSizes));
+
+	if (ErrorCode != HID_PARSE_Successful)
+	  return ErrorCode;
+
 	if (!(ParserData->TotalReportItems))
 	  return HID_PARSE_NoUnfilteredReportItems;
 
 	return HID_PARSE_Successful;
 }
 
+uint8_t USB_StreamHIDReport(const uint8_t* ReportData,
+                            uint16_t ReportSize,
+                            HID_ReportLayout_t* const Layout,
+                            const HID_ReportItemCallbackPtr_t ItemCallback)
+{
+	/* Collection paths are only needed while their items are being handed to the application */
+	HID_CollectionPath_t CollectionPaths[HID_MAX_COLLECTIONS];
+
+	memset(CollectionPaths, 0x00, sizeof(CollectionPaths));
+
+	return USB_ParseHIDReport(ReportData, ReportSize, Layout, CollectionPaths, NULL, ItemCallback);
+}
+
 bool USB_GetHIDReportItemInfo(const uint8_t* ReportData,
                               HID_ReportItem_t* const ReportItem)
 {
@@ -344,6 +442,133 @@ bool USB_GetHIDReportItemInfo(const uint8_t* ReportData,
 	return true;
 }
 
+bool USB_PackHIDReportItem(const HID_ReportItem_t* const ReportItem,
+                           HID_PackedReportItem_t* const PackedItem)
+{
+	uint8_t BitSize = ReportItem->Attributes.BitSize;
+
+	if ((ReportItem->BitOffset > HID_PACKED_ITEM_MAX_BIT_OFFSET) || !(BitSize) || (BitSize > 32))
+	  return false;
+
+	PackedItem->Location = ((ReportItem->BitOffset << 5) | (BitSize - 1));
+	PackedItem->ReportID = ReportItem->ReportID;
+	PackedItem->ItemType = ReportItem->ItemType;
+	PackedItem->Usage    = ReportItem->Attributes.Usage;
+
+	return true;
+}
+
+bool USB_GetHIDPackedReportItemValue(const uint8_t* ReportData,
+                                     const HID_PackedReportItem_t* const PackedItem,
+                                     uint32_t* const Value)
+{
+	if (PackedItem->ReportID)
+	{
+		if (PackedItem->ReportID != ReportData[0])
+		  return false;
+
+		ReportData++;
+	}
+
+	uint16_t BitOffset = HID_PACKED_ITEM_BIT_OFFSET(PackedItem);
+	uint8_t  BitSize   = HID_PACKED_ITEM_BIT_SIZE(PackedItem);
+	uint8_t  Shift     = (BitOffset % 8);
+	uint8_t  ByteCount = ((Shift + BitSize + 7) / 8);
+
+	const uint8_t* ItemData = &ReportData[BitOffset / 8];
+	uint32_t       RawValue = (ItemData[0] >> Shift);
+
+	for (uint8_t i = 1; i < ByteCount; i++)
+	  RawValue |= ((uint32_t)ItemData[i] << ((i * 8) - Shift));
+
+	if (BitSize < 32)
+	  RawValue &= (((uint32_t)1 << BitSize) - 1);
+
+	*Value = RawValue;
+	return true;
+}
+
+#if defined(HID_EXTRACTION_PLANS)
+static void USB_CompileHIDExtractionStep(HID_ExtractionStep_t* const Step,
+                                         const HID_ReportItem_t* const ReportItem,
+                                         const bool IsSigned)
+{
+	uint8_t BitSize = MIN(ReportItem->Attributes.BitSize, 32);
+
+	Step->ByteOffset = (ReportItem->BitOffset / 8);
+	Step->Shift      = (ReportItem->BitOffset % 8);
+	Step->ByteCount  = MAX(((Step->Shift + BitSize + 7) / 8), 1);
+	Step->Mask       = (BitSize == 32) ? 0xFFFFFFFF : (((uint32_t)1 << BitSize) - 1);
+	Step->SignBit    = (IsSigned && BitSize) ? ((uint32_t)1 << (BitSize - 1)) : 0;
+	Step->ReportID   = ReportItem->ReportID;
+	Step->ItemType   = ReportItem->ItemType;
+}
+
+uint8_t USB_GetHIDReportItemValues(const HID_ReportInfo_t* const ParserData,
+                                   const uint8_t* ReportData,
+                                   uint16_t ReportLength,
+                                   const uint8_t ReportType,
+                                   int32_t* const Values)
+{
+	uint8_t ReportID        = 0;
+	uint8_t ValuesExtracted = 0;
+
+	if (ParserData->UsingReportIDs)
+	{
+		if (!(ReportLength))
+		  return 0;
+
+		ReportID = ReportData[0];
+
+		ReportData++;
+		ReportLength--;
+	}
+
+	for (uint8_t ItemIndex = 0; ItemIndex < ParserData->TotalReportItems; ItemIndex++)
+	{
+		const HID_ExtractionStep_t* Step = &ParserData->ExtractionPlan[ItemIndex];
+
+		if ((Step->ReportID != ReportID) || (Step->ItemType != ReportType))
+		  continue;
+
+		if ((Step->ByteOffset + Step->ByteCount) > ReportLength)
+		  continue;
+
+		const uint8_t* ItemData   = &ReportData[Step->ByteOffset];
+		uint16_t       BytesAfter = (ReportLength - Step->ByteOffset);
+		uint32_t       RawValue;
+
+		/* Load a whole little endian word at the item's first byte where the report is long enough, falling back
+		 * to loading only the bytes spanned by the item at the end of the report */
+		if (BytesAfter >= sizeof(uint32_t))
+		{
+			memcpy(&RawValue, ItemData, sizeof(uint32_t));
+			RawValue = le32_to_cpu(RawValue);
+		}
+		else
+		{
+			RawValue = ItemData[0];
+
+			for (uint8_t i = 1; i < BytesAfter; i++)
+			  RawValue |= ((uint32_t)ItemData[i] << (i * 8));
+		}
+
+		RawValue >>= Step->Shift;
+
+		if (Step->ByteCount > sizeof(uint32_t))
+		  RawValue |= ((uint32_t)ItemData[sizeof(uint32_t)] << (32 - Step->Shift));
+
+		RawValue &= Step->Mask;
+
+		/* Sign extend the value from its sign bit; this is a no-op for unsigned items, whose sign bit mask is zero */
+		Values[ItemIndex] = (int32_t)((RawValue ^ Step->SignBit) - Step->SignBit);
+		ValuesExtracted++;
+	}
+
+	return ValuesExtracted;
+}
+#endif
+
 void USB_SetHIDReportItemInfo(uint8_t* ReportData,
                               HID_ReportItem_t* const ReportItem)
 {
@@ -375,12 +600,26 @@ void USB_SetHIDReportItemInfo(uint8_t* ReportData,
 uint16_t USB_GetHIDReportSize(HID_ReportInfo_t* const ParserData,
                               const uint8_t ReportID,
                               const uint8_t ReportType)
+{
+	return USB_GetHIDReportSizeFromTable(ParserData->ReportIDSizes, ReportID, ReportType);
+}
+
+uint16_t USB_GetHIDReportLayoutSize(const HID_ReportLayout_t* const Layout,
+                                    const uint8_t ReportID,
+                                    const uint8_t ReportType)
+{
+	return USB_GetHIDReportSizeFromTable(Layout->ReportIDSizes, ReportID, ReportType);
+}
+
+static uint16_t USB_GetHIDReportSizeFromTable(const HID_ReportSizeInfo_t* const ReportIDSizes,
+                                              const uint8_t ReportID,
+                                              const uint8_t ReportType)
 {
 	for (uint8_t i = 0; i < HID_MAX_REPORT_IDS; i++)
 	{
-		uint16_t ReportSizeBits = ParserData->ReportIDSizes[i].ReportSizeBits[ReportType];
+		uint16_t ReportSizeBits = ReportIDSizes[i].ReportSizeBits[ReportType];
 
-		if (ParserData->ReportIDSizes[i].ReportID == ReportID)
+		if (ReportIDSizes[i].ReportID == ReportID)
 		  return (ReportSizeBits / 8) + ((ReportSizeBits % 8) ? 1 : 0);
 	}
 
@@ -141,6 +141,25 @@
 		 */
 		#define HID_ALIGN_DATA(ReportItem, Type) ((Type)(ReportItem->Value << ((8 * sizeof(Type)) - ReportItem->Attributes.BitSize)))
 
+		/** Largest report item bit offset which can be stored in a \ref HID_PackedReportItem_t packed report item. */
+		#define HID_PACKED_ITEM_MAX_BIT_OFFSET   2047
+
+		/** Retrieves the bit offset of a \ref HID_PackedReportItem_t packed report item within its report.
+		 *
+		 *  \param[in] PackedItem  Pointer to the packed report item whose bit offset is to be retrieved.
+		 *
+		 *  \return Bit offset of the report item's data in its report, excluding any report ID.
+		 */
+		#define HID_PACKED_ITEM_BIT_OFFSET(PackedItem) ((PackedItem)->Location >> 5)
+
+		/** Retrieves the size in bits of a \ref HID_PackedReportItem_t packed report item's data.
+		 *
+		 *  \param[in] PackedItem  Pointer to the packed report item whose size is to be retrieved.
+		 *
+		 *  \return Size in bits of the report item's data, from 1 to 32.
+		 */
+		#define HID_PACKED_ITEM_BIT_SIZE(PackedItem)   (((PackedItem)->Location & 0x1F) + 1)
+
 	/* Public Interface - May be used in end-application: */
 		/* Enums: */
 			/** Enum for the possible error codes in the return value of the \ref USB_ProcessHIDReport() function. */
@@ -155,6 +174,9 @@
 				HID_PARSE_UsageListOverflow           = 6, /**< More than \ref HID_USAGE_STACK_DEPTH usages listed in a row. */
 				HID_PARSE_InsufficientReportIDItems   = 7, /**< More than \ref HID_MAX_REPORT_IDS report IDs in the device. */
 				HID_PARSE_NoUnfilteredReportItems     = 8, /**< All report items from the device were filtered by the filtering callback routine. */
+				HID_PARSE_TruncatedReportItem         = 9, /**< A report item's data extends past the end of the report descriptor. */
+				HID_PARSE_ReportTooLarge              = 10, /**< A report's size exceeds the 65535 bits which can be addressed by a report item. */
+				HID_PARSE_ItemsWithoutReportID        = 11, /**< Report data was declared before the first REPORT ID item of a device using report IDs. */
 			};
 
 		/* Type Defines: */
@@ -246,6 +268,24 @@
 				                             */
 			} HID_ReportSizeInfo_t;
 
+			/** \brief HID Parser Report Item Extraction Step Structure.
+			 *
+			 *  Type define for a precompiled report item extraction step, giving the location and encoding of a single report
+			 *  item's data within a report so that its value can be extracted with a few whole byte loads, shifts and masks
+			 *  rather than bit by bit. An array of extraction steps (an extraction plan) is generated alongside the parsed report
+			 *  items by \ref USB_ProcessHIDReport() when the \c HID_EXTRACTION_PLANS compile time token is defined.
+			 */
+			typedef struct
+			{
+				uint16_t ByteOffset; /**< Offset in bytes of the first report byte holding the item's data, excluding any report ID. */
+				uint8_t  Shift;      /**< Bit position of the item's least significant bit within its first report byte. */
+				uint8_t  ByteCount;  /**< Number of report bytes spanned by the item's data. */
+				uint32_t Mask;       /**< Mask of the item's data bits, once shifted down to bit zero. */
+				uint32_t SignBit;    /**< Mask of the item's sign bit if its logical minimum is negative, or zero if unsigned. */
+				uint8_t  ReportID;   /**< Report ID the item belongs to, or 0x00 if device has only one report. */
+				uint8_t  ItemType;   /**< Report item type, a value in \ref HID_ReportItemTypes_t. */
+			} HID_ExtractionStep_t;
+
 			/** \brief HID Parser State Structure.
 			 *
 			 *  Type define for a complete processed HID report, including all report item data and collections.
@@ -265,8 +305,57 @@
 				bool                 UsingReportIDs; /**< Indicates if the device has at least one REPORT ID
 				                                      *   element in its HID report descriptor.
 				                                      */
+				#if defined(HID_EXTRACTION_PLANS) || defined(__DOXYGEN__)
+				HID_ExtractionStep_t ExtractionPlan[HID_MAX_REPORTITEMS]; /**< Extraction steps for each of the stored report items,
+				                                                           *   indexed in the same order as the \c ReportItems array.
+				                                                           *
+				                                                           *   \note Only available when the \c HID_EXTRACTION_PLANS
+				                                                           *         compile time token is defined.
+				                                                           */
+				#endif
 			} HID_ReportInfo_t;
 
+			/** \brief HID Parser Report Layout Structure.
+			 *
+			 *  Type define for the report size information of a HID interface, generated by \ref USB_StreamHIDReport() when a
+			 *  HID report descriptor is parsed in streaming mode. This holds the same report size information as the
+			 *  \ref HID_ReportInfo_t structure, without any of the report items or collections.
+			 */
+			typedef struct
+			{
+				uint8_t              TotalDeviceReports; /**< Number of reports within the HID interface */
+				HID_ReportSizeInfo_t ReportIDSizes[HID_MAX_REPORT_IDS]; /**< Report sizes for each report in the interface */
+				uint16_t             LargestReportSizeBits; /**< Largest report that the attached device will generate, in bits */
+				bool                 UsingReportIDs; /**< Indicates if the device has at least one REPORT ID
+				                                      *   element in its HID report descriptor.
+				                                      */
+			} HID_ReportLayout_t;
+
+			/** \brief HID Parser Packed Report Item Structure.
+			 *
+			 *  Type define for a compact report item, holding only the information needed to locate and identify a report
+			 *  item's data in a report. Applications parsing report descriptors in streaming mode via \ref USB_StreamHIDReport()
+			 *  may keep a packed copy of each report item of interest, created via \ref USB_PackHIDReportItem(), in place of
+			 *  a full \ref HID_ReportItem_t structure.
+			 */
+			typedef struct
+			{
+				uint16_t    Location; /**< Bit offset of the item in its report (upper 11 bits) and size in bits of the item's
+				                       *   data less one (lower 5 bits); use \ref HID_PACKED_ITEM_BIT_OFFSET() and
+				                       *   \ref HID_PACKED_ITEM_BIT_SIZE() to retrieve these values.
+				                       */
+				uint8_t     ReportID; /**< Report ID this item belongs to, or 0x00 if device has only one report */
+				uint8_t     ItemType; /**< Report item type, a value in \ref HID_ReportItemTypes_t. */
+				HID_Usage_t Usage;    /**< Usage of the report item. */
+			} HID_PackedReportItem_t;
+
+			/** Type define for a streaming mode HID report parser callback function, called by \ref USB_StreamHIDReport() for
+			 *  each finished non-constant IN, OUT and FEATURE report item. The item and its collection path are only valid
+			 *  for the duration of the callback; the application should copy the parts of any item it wishes to keep, for
+			 *  example into a \ref HID_PackedReportItem_t via \ref USB_PackHIDReportItem().
+			 */
+			typedef void (* HID_ReportItemCallbackPtr_t)(const HID_ReportItem_t* const ReportItem);
+
 		/* Function Prototypes: */
 			/** Function to process a given HID report returned from an attached device, and store it into a given
 			 *  \ref HID_ReportInfo_t structure.
@@ -281,6 +370,51 @@
 			                             uint16_t ReportSize,
 			                             HID_ReportInfo_t* const ParserData) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(3);
 
+			/** Function to process a given HID report returned from an attached device in streaming mode. Rather than
+			 *  storing every report item into a \ref HID_ReportInfo_t structure, each finished non-constant report item is
+			 *  handed to the given callback function, which can retain only the items the application needs. Only the report
+			 *  size information is stored, so that complex report descriptors can be parsed within a small amount of RAM.
+			 *
+			 *  \note The \ref CALLBACK_HIDParser_FilterHIDReportItem() callback is not called in streaming mode.
+			 *
+			 *  \param[in]  ReportData    Buffer containing the device's HID report table.
+			 *  \param[in]  ReportSize    Size in bytes of the HID report table.
+			 *  \param[out] Layout        Pointer to a \ref HID_ReportLayout_t instance for the report size information.
+			 *  \param[in]  ItemCallback  Callback function to call for each finished report item.
+			 *
+			 *  \return A value in the \ref HID_Parse_ErrorCodes_t enum.
+			 */
+			uint8_t USB_StreamHIDReport(const uint8_t* ReportData,
+			                            uint16_t ReportSize,
+			                            HID_ReportLayout_t* const Layout,
+			                            const HID_ReportItemCallbackPtr_t ItemCallback) ATTR_NON_NULL_PTR_ARG(1)
+			                            ATTR_NON_NULL_PTR_ARG(3) ATTR_NON_NULL_PTR_ARG(4);
+
+			/** Creates a compact \ref HID_PackedReportItem_t copy of the given report item, for applications which only need to
+			 *  locate and identify the item's data in later reports.
+			 *
+			 *  \param[in]  ReportItem  Pointer to the report item to pack.
+			 *  \param[out] PackedItem  Pointer to the packed report item to create.
+			 *
+			 *  \return Boolean \c true if the item was packed, \c false if its bit offset exceeds
+			 *          \ref HID_PACKED_ITEM_MAX_BIT_OFFSET or its size is not between 1 and 32 bits.
+			 */
+			bool USB_PackHIDReportItem(const HID_ReportItem_t* const ReportItem,
+			                           HID_PackedReportItem_t* const PackedItem) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+
+			/** Extracts the given packed report item's value out of the given HID report.
+			 *
+			 *  \param[in]  ReportData  Buffer containing an IN or FEATURE report from an attached device.
+			 *  \param[in]  PackedItem  Pointer to the packed report item of interest.
+			 *  \param[out] Value       Pointer to the location where the item's value is to be stored.
+			 *
+			 *  \returns Boolean \c true if the item to retrieve was located in the given report, \c false otherwise.
+			 */
+			bool USB_GetHIDPackedReportItemValue(const uint8_t* ReportData,
+			                                     const HID_PackedReportItem_t* const PackedItem,
+			                                     uint32_t* const Value) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2)
+			                                     ATTR_NON_NULL_PTR_ARG(3);
+
 			/** Extracts the given report item's value out of the given HID report and places it into the Value
 			 *  member of the report item's \ref HID_ReportItem_t structure.
 			 *
@@ -297,6 +431,33 @@
 			bool USB_GetHIDReportItemInfo(const uint8_t* ReportData,
 			                              HID_ReportItem_t* const ReportItem) ATTR_NON_NULL_PTR_ARG(1);
 
+			#if defined(HID_EXTRACTION_PLANS) || defined(__DOXYGEN__)
+			/** Extracts the values of all stored report items of the given type out of the given HID report in a single pass,
+			 *  using the extraction plan generated by \ref USB_ProcessHIDReport(). This is considerably faster than calling
+			 *  \ref USB_GetHIDReportItemInfo() for each report item, as each item is read with whole byte loads instead of one
+			 *  bit at a time. Values of items with a negative logical minimum are sign extended.
+			 *
+			 *  Each extracted value is written to the \c Values array at the same index as the item's entry in the parser
+			 *  output's \c ReportItems array; entries for items which are not part of the given report are not modified.
+			 *
+			 *  \note This function is only available when the \c HID_EXTRACTION_PLANS compile time token is defined.
+			 *
+			 *  \param[in]  ParserData    Pointer to a \ref HID_ReportInfo_t instance containing the parser output.
+			 *  \param[in]  ReportData    Buffer containing an IN or FEATURE report from an attached device.
+			 *  \param[in]  ReportLength  Length in bytes of the report in the \c ReportData buffer, including any report ID.
+			 *  \param[in]  ReportType    Type of the report, a value from the \ref HID_ReportItemTypes_t enum.
+			 *  \param[out] Values        Array of at least \c TotalReportItems entries where the item values are to be stored.
+			 *
+			 *  \return Number of report item values extracted from the report.
+			 */
+			uint8_t USB_GetHIDReportItemValues(const HID_ReportInfo_t* const ParserData,
+			                                   const uint8_t* ReportData,
+			                                   uint16_t ReportLength,
+			                                   const uint8_t ReportType,
+			                                   int32_t* const Values) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2)
+			                                   ATTR_NON_NULL_PTR_ARG(5);
+			#endif
+
 			/** Retrieves the given report item's value out of the \c Value member of the report item's
 			 *  \ref HID_ReportItem_t structure and places it into the correct position in the HID report
 			 *  buffer. The report buffer is assumed to have the appropriate bits cleared before calling
@@ -326,6 +487,20 @@
 			                              const uint8_t ReportID,
 			                              const uint8_t ReportType) ATTR_CONST ATTR_NON_NULL_PTR_ARG(1);
 
+			/** Retrieves the size of a given HID report in bytes from its Report ID, from the report size information
+			 *  generated by \ref USB_StreamHIDReport().
+			 *
+			 *  \param[in] Layout      Pointer to a \ref HID_ReportLayout_t instance containing the report size information.
+			 *  \param[in] ReportID    Report ID of the report whose size is to be determined.
+			 *  \param[in] ReportType  Type of the report whose size is to be determined, a value from the
+			 *                         \ref HID_ReportItemTypes_t enum.
+			 *
+			 *  \return Size of the report in bytes, or \c 0 if the report does not exist.
+			 */
+			uint16_t USB_GetHIDReportLayoutSize(const HID_ReportLayout_t* const Layout,
+			                                    const uint8_t ReportID,
+			                                    const uint8_t ReportType) ATTR_NON_NULL_PTR_ARG(1);
+
 			/** Callback routine for the HID Report Parser. This callback <b>must</b> be implemented by the user code when
 			 *  the parser is used, to determine what report IN, OUT and FEATURE item's information is stored into the user
 			 *  \ref HID_ReportInfo_t structure. This can be used to filter only those items the application will be using, so that
@@ -350,7 +525,32 @@
 				 HID_ReportItem_Attributes_t Attributes;
 				 uint8_t                     ReportCount;
 				 uint8_t                     ReportID;
+				 #if defined(HID_EXTRACTION_PLANS)
+				 bool                        LogicalMinimumNegative;
+				 #endif
 			} HID_StateTable_t;
+
+		/* Function Prototypes: */
+			#if defined(__INCLUDE_FROM_HIDPARSER_C)
+				static uint8_t USB_ParseHIDReport(const uint8_t* ReportData,
+				                                  uint16_t ReportSize,
+				                                  HID_ReportLayout_t* const Layout,
+				                                  HID_CollectionPath_t* const CollectionPaths,
+				                                  HID_ReportInfo_t* const ParserData,
+				                                  const HID_ReportItemCallbackPtr_t ItemCallback) ATTR_NON_NULL_PTR_ARG(1)
+				                                  ATTR_NON_NULL_PTR_ARG(3) ATTR_NON_NULL_PTR_ARG(4);
+				static HID_ReportSizeInfo_t* USB_GetHIDReportSizeInfo(HID_ReportLayout_t* const Layout,
+				                                                      const uint8_t ReportID) ATTR_NON_NULL_PTR_ARG(1);
+				static uint16_t USB_GetHIDReportSizeFromTable(const HID_ReportSizeInfo_t* const ReportIDSizes,
+				                                              const uint8_t ReportID,
+				                                              const uint8_t ReportType) ATTR_NON_NULL_PTR_ARG(1);
+			#endif
+
+			#if defined(__INCLUDE_FROM_HIDPARSER_C) && defined(HID_EXTRACTION_PLANS)
+				static void USB_CompileHIDExtractionStep(HID_ExtractionStep_t* const Step,
+				                                         const HID_ReportItem_t* const ReportItem,
+				                                         const bool IsSigned) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+			#endif
 	#endif
 
 	/* Disable C linkage for C++ Compilers: */
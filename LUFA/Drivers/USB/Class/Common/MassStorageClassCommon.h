@@ -119,6 +119,24 @@
 
 		/** SCSI Command Code for a MODE SENSE (10) command. */
 		#define SCSI_CMD_MODE_SENSE_10                         0x5A
+
+		/** SCSI Command Code for a SYNCHRONIZE CACHE (10) command. */
+		#define SCSI_CMD_SYNCHRONIZE_CACHE_10                  0x35
+
+		/** SCSI Command Code for a READ (16) command. */
+		#define SCSI_CMD_READ_16                               0x88
+
+		/** SCSI Command Code for a WRITE (16) command. */
+		#define SCSI_CMD_WRITE_16                              0x8A
+
+		/** SCSI Command Code for a SERVICE ACTION IN (16) command, whose service action selects the issued command. */
+		#define SCSI_CMD_SERVICE_ACTION_IN_16                  0x9E
+		//@}
+
+		/** \name SCSI Service Action Values */
+		//@{
+		/** SCSI Service Action of a \ref SCSI_CMD_SERVICE_ACTION_IN_16 command, for a READ CAPACITY (16) command. */
+		#define SCSI_SERVICE_ACTION_READ_CAPACITY_16           0x10
 		//@}
 
 		/** \name SCSI Sense Key Values */
@@ -176,6 +194,12 @@
 		/** SCSI Additional Sense Code to indicate that the logical unit (LUN) addressed is not ready. */
 		#define SCSI_ASENSE_LOGICAL_UNIT_NOT_READY             0x04
 
+		/** SCSI Additional Sense Code to indicate that the medium failed to store written data. */
+		#define SCSI_ASENSE_WRITE_ERROR                        0x0C
+
+		/** SCSI Additional Sense Code to indicate that data could not be read from the medium. */
+		#define SCSI_ASENSE_UNRECOVERED_READ_ERROR             0x11
+
 		/** SCSI Additional Sense Code to indicate an invalid field was encountered while processing the issued command. */
 		#define SCSI_ASENSE_INVALID_FIELD_IN_CDB               0x24
 
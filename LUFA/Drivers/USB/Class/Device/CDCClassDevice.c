@@ -137,22 +137,103 @@ void CDC_Device_USBTask(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo)
 	if ((USB_DeviceState != DEVICE_STATE_Configured) || !(CDCInterfaceInfo->State.LineEncoding.BaudRateBPS))
 	  return;
 
+	if (CDCInterfaceInfo->State.NotificationPending)
+	{
+		Endpoint_SelectEndpoint(CDCInterfaceInfo->Config.NotificationEndpoint.Address);
+
+		if (Endpoint_IsINReady())
+		  CDC_Device_WriteSerialStateNotification(CDCInterfaceInfo);
+	}
+
 	#if !defined(NO_CLASS_DRIVER_AUTOFLUSH)
 	Endpoint_SelectEndpoint(CDCInterfaceInfo->Config.DataINEndpoint.Address);
 
-	if (Endpoint_IsINReady())
-	  CDC_Device_Flush(CDCInterfaceInfo);
+	if (!(Endpoint_IsINReady()))
+	  return;
+
+	if (CDCInterfaceInfo->Config.FlushHoldFrames)
+	{
+		uint16_t BytesPending = Endpoint_BytesInEndpoint();
+
+		/* Send full packets straight away, deferring the terminating zero length packet until the hold time passes
+		 * without any more data being written, so that a continuous stream of data is sent in full packets only */
+		if (BytesPending && !(Endpoint_IsReadWriteAllowed()))
+		{
+			Endpoint_ClearIN();
+
+			CDCInterfaceInfo->State.ZLPPending         = true;
+			CDCInterfaceInfo->State.FlushHoldRemaining = CDCInterfaceInfo->Config.FlushHoldFrames;
+			return;
+		}
+
+		bool ThresholdReached = (BytesPending && CDCInterfaceInfo->Config.FlushThreshold &&
+		                         (BytesPending >= CDCInterfaceInfo->Config.FlushThreshold));
+
+		if (!(ThresholdReached) && CDCInterfaceInfo->State.FlushHoldRemaining)
+		  return;
+	}
+
+	CDC_Device_Flush(CDCInterfaceInfo);
 	#endif
 }
 
+bool CDC_Device_ConfigureMultiPortEndpoints(USB_ClassInfo_CDC_Device_t* const Ports,
+                                            const uint8_t TotalPorts)
+{
+	for (uint8_t PortIndex = 0; PortIndex < TotalPorts; PortIndex++)
+	{
+		if (!(CDC_Device_ConfigureEndpoints(&Ports[PortIndex])))
+		  return false;
+	}
+
+	return true;
+}
+
+void CDC_Device_ProcessMultiPortControlRequest(USB_ClassInfo_CDC_Device_t* const Ports,
+                                               const uint8_t TotalPorts)
+{
+	if (!(Endpoint_IsSETUPReceived()))
+	  return;
+
+	for (uint8_t PortIndex = 0; PortIndex < TotalPorts; PortIndex++)
+	{
+		if (USB_ControlRequest.wIndex == Ports[PortIndex].Config.ControlInterfaceNumber)
+		{
+			CDC_Device_ProcessControlRequest(&Ports[PortIndex]);
+			break;
+		}
+	}
+}
+
+void CDC_Device_MultiPortUSBTask(USB_ClassInfo_CDC_Device_t* const Ports,
+                                 const uint8_t TotalPorts)
+{
+	if (USB_DeviceState != DEVICE_STATE_Configured)
+	  return;
+
+	/* Only visit the endpoints of ports with unflushed data or a queued notification, so that the cost of each
+	 * pass does not grow with the number of idle ports */
+	for (uint8_t PortIndex = 0; PortIndex < TotalPorts; PortIndex++)
+	{
+		USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo = &Ports[PortIndex];
+
+		if (CDCInterfaceInfo->State.TxPending || CDCInterfaceInfo->State.NotificationPending)
+		  CDC_Device_USBTask(CDCInterfaceInfo);
+	}
+}
+
 uint8_t CDC_Device_SendString(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo,
                               const char* const String)
 {
 	if ((USB_DeviceState != DEVICE_STATE_Configured) || !(CDCInterfaceInfo->State.LineEncoding.BaudRateBPS))
 	  return ENDPOINT_RWSTREAM_DeviceDisconnected;
 
+	uint16_t Length = strlen(String);
+
 	Endpoint_SelectEndpoint(CDCInterfaceInfo->Config.DataINEndpoint.Address);
-	return Endpoint_Write_Stream_LE(String, strlen(String), NULL);
+	CDC_Device_StartFlushHold(CDCInterfaceInfo);
+
+	return CDC_Device_CountSent(CDCInterfaceInfo, Length, Endpoint_Write_Stream_LE(String, Length, NULL));
 }
 
 uint8_t CDC_Device_SendData(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo,
@@ -163,7 +244,9 @@ uint8_t CDC_Device_SendData(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo,
 	  return ENDPOINT_RWSTREAM_DeviceDisconnected;
 
 	Endpoint_SelectEndpoint(CDCInterfaceInfo->Config.DataINEndpoint.Address);
-	return Endpoint_Write_Stream_LE(Buffer, Length, NULL);
+	CDC_Device_StartFlushHold(CDCInterfaceInfo);
+
+	return CDC_Device_CountSent(CDCInterfaceInfo, Length, Endpoint_Write_Stream_LE(Buffer, Length, NULL));
 }
 
 #if defined(ARCH_HAS_FLASH_ADDRESS_SPACE)
@@ -173,8 +256,12 @@ uint8_t CDC_Device_SendData(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo,
 		if ((USB_DeviceState != DEVICE_STATE_Configured) || !(CDCInterfaceInfo->State.LineEncoding.BaudRateBPS))
 		  return ENDPOINT_RWSTREAM_DeviceDisconnected;
 
+		uint16_t Length = strlen_P(String);
+
 		Endpoint_SelectEndpoint(CDCInterfaceInfo->Config.DataINEndpoint.Address);
-		return Endpoint_Write_PStream_LE(String, strlen_P(String), NULL);
+		CDC_Device_StartFlushHold(CDCInterfaceInfo);
+
+		return CDC_Device_CountSent(CDCInterfaceInfo, Length, Endpoint_Write_PStream_LE(String, Length, NULL));
 	}
 
 	uint8_t CDC_Device_SendData_P(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo,
@@ -185,7 +272,9 @@ uint8_t CDC_Device_SendData(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo,
 		  return ENDPOINT_RWSTREAM_DeviceDisconnected;
 
 		Endpoint_SelectEndpoint(CDCInterfaceInfo->Config.DataINEndpoint.Address);
-		return Endpoint_Write_PStream_LE(Buffer, Length, NULL);
+		CDC_Device_StartFlushHold(CDCInterfaceInfo);
+
+		return CDC_Device_CountSent(CDCInterfaceInfo, Length, Endpoint_Write_PStream_LE(Buffer, Length, NULL));
 	}
 #endif
 
@@ -207,7 +296,11 @@ uint8_t CDC_Device_SendByte(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo,
 		  return ErrorCode;
 	}
 
+	CDC_Device_StartFlushHold(CDCInterfaceInfo);
+
 	Endpoint_Write_8(Data);
+	CDCInterfaceInfo->State.TxStatistics.BytesSent++;
+
 	return ENDPOINT_READYWAIT_NoError;
 }
 
@@ -220,11 +313,23 @@ uint8_t CDC_Device_Flush(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo)
 
 	Endpoint_SelectEndpoint(CDCInterfaceInfo->Config.DataINEndpoint.Address);
 
-	if (!(Endpoint_BytesInEndpoint()))
-	  return ENDPOINT_READYWAIT_NoError;
+	uint16_t BytesInPacket = Endpoint_BytesInEndpoint();
+
+	if (!(BytesInPacket))
+	{
+		if (!(CDCInterfaceInfo->State.ZLPPending))
+		{
+			CDCInterfaceInfo->State.TxPending = false;
+			return ENDPOINT_READYWAIT_NoError;
+		}
+
+		if ((ErrorCode = Endpoint_WaitUntilReady()) != ENDPOINT_READYWAIT_NoError)
+		  return ErrorCode;
+	}
 
-	bool BankFull = !(Endpoint_IsReadWriteAllowed());
+	bool BankFull = (BytesInPacket && !(Endpoint_IsReadWriteAllowed()));
 
+	CDCInterfaceInfo->State.ZLPPending = false;
 	Endpoint_ClearIN();
 
 	if (BankFull)
@@ -233,11 +338,55 @@ uint8_t CDC_Device_Flush(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo)
 		  return ErrorCode;
 
 		Endpoint_ClearIN();
+		BytesInPacket = 0;
 	}
 
+	CDCInterfaceInfo->State.TxPending = false;
+	CDCInterfaceInfo->State.TxStatistics.ShortPackets++;
+	CDCInterfaceInfo->State.TxStatistics.ShortPacketBytes += BytesInPacket;
+
 	return ENDPOINT_READYWAIT_NoError;
 }
 
+uint8_t CDC_Device_GetTxFillPercentage(const USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo)
+{
+	uint16_t EndpointSize     = CDCInterfaceInfo->Config.DataINEndpoint.Size;
+	uint32_t ShortPacketBytes = CDCInterfaceInfo->State.TxStatistics.ShortPacketBytes;
+	uint32_t FullPackets      = ((CDCInterfaceInfo->State.TxStatistics.BytesSent - ShortPacketBytes) / EndpointSize);
+	uint32_t TotalPackets     = (FullPackets + CDCInterfaceInfo->State.TxStatistics.ShortPackets);
+
+	if (!(TotalPackets))
+	  return 0;
+
+	/* Express the short packet payload in whole and fractional packets first, so that the scaling cannot overflow */
+	uint32_t FilledPercent = (FullPackets * 100) + ((ShortPacketBytes / EndpointSize) * 100) +
+	                         (((ShortPacketBytes % EndpointSize) * 100) / EndpointSize);
+
+	return (FilledPercent / TotalPackets);
+}
+
+static void CDC_Device_StartFlushHold(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo)
+{
+	CDCInterfaceInfo->State.TxPending = true;
+
+	/* Start the flush hold time when the first byte of a new packet is about to be written */
+	if (!(Endpoint_BytesInEndpoint()))
+	{
+		CDCInterfaceInfo->State.ZLPPending         = false;
+		CDCInterfaceInfo->State.FlushHoldRemaining = CDCInterfaceInfo->Config.FlushHoldFrames;
+	}
+}
+
+static uint8_t CDC_Device_CountSent(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo,
+                                    const uint16_t Length,
+                                    const uint8_t ErrorCode)
+{
+	if (ErrorCode == ENDPOINT_RWSTREAM_NoError)
+	  CDCInterfaceInfo->State.TxStatistics.BytesSent += Length;
+
+	return ErrorCode;
+}
+
 uint16_t CDC_Device_BytesReceived(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo)
 {
 	if ((USB_DeviceState != DEVICE_STATE_Configured) || !(CDCInterfaceInfo->State.LineEncoding.BaudRateBPS))
@@ -290,20 +439,39 @@ void CDC_Device_SendControlLineStateChange(USB_ClassInfo_CDC_Device_t* const CDC
 	  return;
 
 	Endpoint_SelectEndpoint(CDCInterfaceInfo->Config.NotificationEndpoint.Address);
+	CDC_Device_WriteSerialStateNotification(CDCInterfaceInfo);
+}
 
+void CDC_Device_QueueControlLineStateChange(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo)
+{
+	if ((USB_DeviceState != DEVICE_STATE_Configured) || !(CDCInterfaceInfo->State.LineEncoding.BaudRateBPS))
+	  return;
+
+	CDCInterfaceInfo->State.NotificationPending = true;
+}
+
+static void CDC_Device_WriteSerialStateNotification(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo)
+{
 	USB_Request_Header_t Notification = (USB_Request_Header_t)
 		{
 			.bmRequestType = (REQDIR_DEVICETOHOST | REQTYPE_CLASS | REQREC_INTERFACE),
 			.bRequest      = CDC_NOTIF_SerialState,
 			.wValue        = CPU_TO_LE16(0),
-			.wIndex        = CPU_TO_LE16(0),
+			.wIndex        = CPU_TO_LE16(CDCInterfaceInfo->Config.ControlInterfaceNumber),
 			.wLength       = CPU_TO_LE16(sizeof(CDCInterfaceInfo->State.ControlLineStates.DeviceToHost)),
 		};
 
-	Endpoint_Write_Stream_LE(&Notification, sizeof(USB_Request_Header_t), NULL);
-	Endpoint_Write_Stream_LE(&CDCInterfaceInfo->State.ControlLineStates.DeviceToHost,
-	                         sizeof(CDCInterfaceInfo->State.ControlLineStates.DeviceToHost),
-	                         NULL);
+	Endpoint_StreamSegment_t NotificationSegments[] =
+		{
+			{.Buffer = &Notification, .Length = sizeof(USB_Request_Header_t)},
+			{.Buffer = &CDCInterfaceInfo->State.ControlLineStates.DeviceToHost,
+			 .Length = sizeof(CDCInterfaceInfo->State.ControlLineStates.DeviceToHost)},
+		};
+
+	/* Any queued notification is superseded, as this one carries the current line states */
+	CDCInterfaceInfo->State.NotificationPending = false;
+
+	Endpoint_Write_StreamV(NotificationSegments, 2, NULL);
 	Endpoint_ClearIN();
 }
 
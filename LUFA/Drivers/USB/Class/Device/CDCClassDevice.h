@@ -104,8 +104,19 @@
 					USB_Endpoint_Table_t DataINEndpoint; /**< Data IN endpoint configuration table. */
 					USB_Endpoint_Table_t DataOUTEndpoint; /**< Data OUT endpoint configuration table. */
 					USB_Endpoint_Table_t NotificationEndpoint; /**< Notification IN Endpoint configuration table. */
+
+					uint8_t  FlushHoldFrames; /**< Maximum number of frames (milliseconds) that \ref CDC_Device_USBTask() may hold a
+					                           *   partially filled data IN packet back to gather more data before flushing it, or
+					                           *   zero to flush pending data on every call. Requires \ref CDC_Device_MillisecondElapsed()
+					                           *   to be called once per frame.
+					                           */
+					uint16_t FlushThreshold; /**< Number of pending data IN bytes at which \ref CDC_Device_USBTask() flushes a held
+					                          *   packet without waiting for \c FlushHoldFrames to elapse, or zero to hold packets
+					                          *   until they are full or the hold time elapses. Ignored if \c FlushHoldFrames is zero.
+					                          */
 				} Config; /**< Config data for the USB class interface within the device. All elements in this section
-				           *   <b>must</b> be set or the interface will fail to enumerate and operate correctly.
+				           *   <b>must</b> be set or the interface will fail to enumerate and operate correctly, except for
+				           *   the optional \c FlushHoldFrames and \c FlushThreshold transmit aggregation settings.
 				           */
 				struct
 				{
@@ -124,6 +135,28 @@
 					                                  *   This is generally only used if the virtual serial port data is to be
 					                                  *   reconstructed on a physical UART.
 					                                  */
+
+					uint8_t FlushHoldRemaining; /**< Number of frames remaining before a held data IN packet is flushed. */
+					bool    ZLPPending; /**< Indicates that the last data IN packet sent was full, and must be followed by a zero
+					                     *   length packet to end the transfer if no further data is sent.
+					                     */
+					bool    TxPending; /**< Indicates that data has been written to the data IN endpoint through the class driver's
+					                    *   send functions which has not yet been flushed to the host.
+					                    */
+					bool    NotificationPending; /**< Indicates that a control line state change notification has been queued
+					                              *   via \ref CDC_Device_QueueControlLineStateChange() but not yet sent.
+					                              */
+
+					struct
+					{
+						uint32_t BytesSent; /**< Total number of data bytes written to the data IN endpoint. */
+						uint32_t ShortPackets; /**< Number of short (less than full) data IN packets sent by \ref CDC_Device_Flush(),
+						                        *   including zero length packets.
+						                        */
+						uint32_t ShortPacketBytes; /**< Total number of data bytes sent in short data IN packets. */
+					} TxStatistics; /**< Data IN packet statistics, used by \ref CDC_Device_GetTxFillPercentage() to determine
+					                 *   how well the data sent to the host is being aggregated into full packets.
+					                 */
 				} State; /**< State data for the USB class interface within the device. All elements in this section
 				          *   are reset to their defaults when the interface is enumerated.
 				          */
@@ -150,6 +183,16 @@
 			/** General management task for a given CDC class interface, required for the correct operation of the interface. This should
 			 *  be called frequently in the main program loop, before the master USB management task \ref USB_USBTask().
 			 *
+			 *  Unless the \c NO_CLASS_DRIVER_AUTOFLUSH compile time token is defined, this flushes data waiting to be sent to the host.
+			 *  By default any pending data is flushed on every call, which minimizes latency but may send many small packets when the
+			 *  application writes data a little at a time. If the interface's \c FlushHoldFrames setting is non-zero, a partially
+			 *  filled packet is instead held back until either it reaches \c FlushThreshold bytes or it has been pending for
+			 *  \c FlushHoldFrames frames, whichever comes first. Full packets are sent immediately, with the zero length packet
+			 *  ending a transfer on a packet boundary deferred until no further data has been written for \c FlushHoldFrames frames.
+			 *
+			 *  Any control line state change notification queued via \ref CDC_Device_QueueControlLineStateChange() is also sent
+			 *  once the interface's notification endpoint is ready.
+			 *
 			 *  \param[in,out] CDCInterfaceInfo  Pointer to a structure containing a CDC Class configuration and state.
 			 */
 			void CDC_Device_USBTask(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
@@ -325,6 +368,67 @@
 			 */
 			void CDC_Device_SendControlLineStateChange(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
 
+			/** Determines the average fill level of the data IN packets sent to the host by the given CDC interface since it was
+			 *  configured, from the interface's \c TxStatistics. This can be used to tune the \c FlushHoldFrames and \c FlushThreshold
+			 *  transmit aggregation settings, trading the latency of the sent data against the number of packets sent per second.
+			 *
+			 *  \note Full packets sent directly by the application through the endpoint APIs, and short packets not sent via
+			 *        \ref CDC_Device_Flush(), are not included.
+			 *
+			 *  \param[in] CDCInterfaceInfo  Pointer to a structure containing a CDC Class configuration and state.
+			 *
+			 *  \return Average fill level of the sent data IN packets as a percentage of the endpoint size, or zero if no
+			 *          packets have been sent.
+			 */
+			uint8_t CDC_Device_GetTxFillPercentage(const USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo) ATTR_WARN_UNUSED_RESULT
+			                                       ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Queues a Serial Control Line State Change notification to the host, to be sent by the next call to
+			 *  \ref CDC_Device_USBTask() or \ref CDC_Device_MultiPortUSBTask() once the interface's notification endpoint is
+			 *  ready. Unlike \ref CDC_Device_SendControlLineStateChange() this never blocks; if the control line states change
+			 *  again before the notification is sent, only the latest \c ControlLineStates.DeviceToHost value is sent.
+			 *
+			 *  \param[in,out] CDCInterfaceInfo  Pointer to a structure containing a CDC Class configuration and state.
+			 */
+			void CDC_Device_QueueControlLineStateChange(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Configures the endpoints of each of the given CDC interfaces, ready for use. This is equivalent to calling
+			 *  \ref CDC_Device_ConfigureEndpoints() on each interface in turn, and should be linked to the library
+			 *  \ref EVENT_USB_Device_ConfigurationChanged() event in devices with several virtual serial ports.
+			 *
+			 *  \param[in,out] Ports       Pointer to an array of CDC Class configuration and state structures.
+			 *  \param[in]     TotalPorts  Number of CDC interfaces in the \c Ports array.
+			 *
+			 *  \return Boolean \c true if the endpoints of all interfaces were successfully configured, \c false otherwise.
+			 */
+			bool CDC_Device_ConfigureMultiPortEndpoints(USB_ClassInfo_CDC_Device_t* const Ports,
+			                                            const uint8_t TotalPorts) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Processes incoming control requests from the host that are directed to any of the given CDC interfaces, handing
+			 *  each request only to the interface it is addressed to. This should be linked to the library
+			 *  \ref EVENT_USB_Device_ControlRequest() event in devices with several virtual serial ports.
+			 *
+			 *  \param[in,out] Ports       Pointer to an array of CDC Class configuration and state structures.
+			 *  \param[in]     TotalPorts  Number of CDC interfaces in the \c Ports array.
+			 */
+			void CDC_Device_ProcessMultiPortControlRequest(USB_ClassInfo_CDC_Device_t* const Ports,
+			                                               const uint8_t TotalPorts) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** General management task for a set of CDC interfaces, replacing individual calls to \ref CDC_Device_USBTask() for
+			 *  each interface in devices with several virtual serial ports. This should be called frequently in the main program
+			 *  loop, before the master USB management task \ref USB_USBTask().
+			 *
+			 *  Only the interfaces with data written through the class driver's send functions and not yet flushed, or with a
+			 *  notification queued via \ref CDC_Device_QueueControlLineStateChange(), are serviced; idle interfaces are skipped
+			 *  without selecting any of their endpoints. Data written directly to an interface's data IN endpoint via the
+			 *  low level endpoint APIs must therefore be flushed by the application.
+			 *
+			 *  \param[in,out] Ports       Pointer to an array of CDC Class configuration and state structures.
+			 *  \param[in]     TotalPorts  Number of CDC interfaces in the \c Ports array.
+			 */
+			void CDC_Device_MultiPortUSBTask(USB_ClassInfo_CDC_Device_t* const Ports,
+			                                 const uint8_t TotalPorts) ATTR_NON_NULL_PTR_ARG(1);
+
 			#if defined(FDEV_SETUP_STREAM) || defined(__DOXYGEN__)
 			/** Creates a standard character stream for the given CDC Device instance so that it can be used with all the regular
 			 *  functions in the standard <stdio.h> library that accept a \c FILE stream as a destination (e.g. \c fprintf()). The created
@@ -359,6 +463,36 @@
 			                                     FILE* const Stream) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
 			#endif
 
+		/* Inline Functions: */
+			/** Indicates that a frame (millisecond) has elapsed on the given CDC interface, so that partially filled data IN packets
+			 *  held back by the interface's \c FlushHoldFrames transmit aggregation setting are flushed on time. This should be called
+			 *  once per millisecond when \c FlushHoldFrames is non-zero. It is recommended that this be called by the
+			 *  \ref EVENT_USB_Device_StartOfFrame() event, once SOF events have been enabled via \ref USB_Device_EnableSOFEvents().
+			 *
+			 *  \param[in,out] CDCInterfaceInfo  Pointer to a structure containing a CDC Class configuration and state.
+			 */
+			static inline void CDC_Device_MillisecondElapsed(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo) ATTR_ALWAYS_INLINE ATTR_NON_NULL_PTR_ARG(1);
+			static inline void CDC_Device_MillisecondElapsed(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo)
+			{
+				if (CDCInterfaceInfo->State.FlushHoldRemaining)
+				  CDCInterfaceInfo->State.FlushHoldRemaining--;
+			}
+
+			/** Indicates that a frame (millisecond) has elapsed on each of the given CDC interfaces, equivalent to calling
+			 *  \ref CDC_Device_MillisecondElapsed() on each interface in turn.
+			 *
+			 *  \param[in,out] Ports       Pointer to an array of CDC Class configuration and state structures.
+			 *  \param[in]     TotalPorts  Number of CDC interfaces in the \c Ports array.
+			 */
+			static inline void CDC_Device_MultiPortMillisecondElapsed(USB_ClassInfo_CDC_Device_t* const Ports,
+			                                                          const uint8_t TotalPorts) ATTR_ALWAYS_INLINE ATTR_NON_NULL_PTR_ARG(1);
+			static inline void CDC_Device_MultiPortMillisecondElapsed(USB_ClassInfo_CDC_Device_t* const Ports,
+			                                                          const uint8_t TotalPorts)
+			{
+				for (uint8_t PortIndex = 0; PortIndex < TotalPorts; PortIndex++)
+				  CDC_Device_MillisecondElapsed(&Ports[PortIndex]);
+			}
+
 	/* Private Interface - For use in library only: */
 	#if !defined(__DOXYGEN__)
 		/* Function Prototypes: */
@@ -370,6 +504,12 @@
 				static int CDC_Device_getchar_Blocking(FILE* Stream) ATTR_NON_NULL_PTR_ARG(1);
 				#endif
 
+				static void CDC_Device_WriteSerialStateNotification(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
+				static void CDC_Device_StartFlushHold(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
+				static uint8_t CDC_Device_CountSent(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo,
+				                                    const uint16_t Length,
+				                                    const uint8_t ErrorCode) ATTR_NON_NULL_PTR_ARG(1);
+
 				void CDC_Device_Event_Stub(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo);
 				void CDC_Device_Event_Stub_2(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo, const uint8_t _1);
 
@@ -59,10 +59,11 @@ void HID_Device_ProcessControlRequest(USB_ClassInfo_HID_Device_t* const HIDInter
 
 				CALLBACK_HID_Device_CreateHIDReport(HIDInterfaceInfo, &ReportID, ReportType, ReportData, &ReportSize);
 
-				if (HIDInterfaceInfo->Config.PrevReportINBuffer != NULL)
+				if (HIDInterfaceInfo->State.LastReportINBuffer != NULL)
 				{
-					memcpy(HIDInterfaceInfo->Config.PrevReportINBuffer, ReportData,
+					memcpy(HIDInterfaceInfo->State.LastReportINBuffer, ReportData,
 					       HIDInterfaceInfo->Config.PrevReportINBufferSize);
+					HIDInterfaceInfo->State.LastReportINID = ReportID;
 				}
 
 				Endpoint_SelectEndpoint(ENDPOINT_CONTROLEP);
@@ -118,19 +119,56 @@ void HID_Device_ProcessControlRequest(USB_ClassInfo_HID_Device_t* const HIDInter
 		case HID_REQ_SetIdle:
 			if (USB_ControlRequest.bmRequestType == (REQDIR_HOSTTODEVICE | REQTYPE_CLASS | REQREC_INTERFACE))
 			{
+				uint8_t  ReportID  = (USB_ControlRequest.wValue & 0xFF);
+				uint16_t IdleCount = ((USB_ControlRequest.wValue & 0xFF00) >> 6);
+
+				#if defined(HID_DEVICE_IDLE_REPORT_IDS)
+				if (ReportID)
+				{
+					HID_Device_ReportIdle_t* ReportIdle = HID_Device_GetReportIdle(HIDInterfaceInfo, ReportID, true);
+
+					/* Leave the request unhandled so that it is stalled if there is no idle timer free for the report ID */
+					if (ReportIdle == NULL)
+					  break;
+
+					Endpoint_ClearSETUP();
+					Endpoint_ClearStatusStage();
+
+					ReportIdle->IdleCount       = IdleCount;
+					ReportIdle->IdleMSRemaining = 0;
+					break;
+				}
+
+				/* An idle rate for report ID zero applies to every report of the interface */
+				for (uint8_t i = 0; i < HID_DEVICE_IDLE_REPORT_IDS; i++)
+				  HIDInterfaceInfo->State.ReportIdle[i].IdleCount = IdleCount;
+				#else
+				(void)ReportID;
+				#endif
+
 				Endpoint_ClearSETUP();
 				Endpoint_ClearStatusStage();
 
-				HIDInterfaceInfo->State.IdleCount = ((USB_ControlRequest.wValue & 0xFF00) >> 6);
+				HIDInterfaceInfo->State.IdleCount = IdleCount;
 			}
 
 			break;
 		case HID_REQ_GetIdle:
 			if (USB_ControlRequest.bmRequestType == (REQDIR_DEVICETOHOST | REQTYPE_CLASS | REQREC_INTERFACE))
 			{
+				uint16_t IdleCount = HIDInterfaceInfo->State.IdleCount;
+
+				#if defined(HID_DEVICE_IDLE_REPORT_IDS)
+				HID_Device_ReportIdle_t* ReportIdle = HID_Device_GetReportIdle(HIDInterfaceInfo,
+				                                                               (USB_ControlRequest.wValue & 0xFF), false);
+
+				if (ReportIdle != NULL)
+				  IdleCount = ReportIdle->IdleCount;
+				#endif
+
 				Endpoint_ClearSETUP();
 				while (!(Endpoint_IsINReady()));
-				Endpoint_Write_8(HIDInterfaceInfo->State.IdleCount >> 2);
+				Endpoint_Write_8(IdleCount >> 2);
 				Endpoint_ClearIN();
 				Endpoint_ClearStatusStage();
 			}
@@ -144,6 +182,16 @@ bool HID_Device_ConfigureEndpoints(USB_ClassInfo_HID_Device_t* const HIDInterfac
 	memset(&HIDInterfaceInfo->State, 0x00, sizeof(HIDInterfaceInfo->State));
 	HIDInterfaceInfo->State.UsingReportProtocol = true;
 	HIDInterfaceInfo->State.IdleCount           = 500;
+	HIDInterfaceInfo->State.NextReportINBuffer  = HIDInterfaceInfo->Config.ReportINBuffer;
+	HIDInterfaceInfo->State.LastReportINBuffer  = HIDInterfaceInfo->Config.PrevReportINBuffer;
+
+	if (HIDInterfaceInfo->Config.ReportINBuffer != NULL)
+	{
+		memset(HIDInterfaceInfo->Config.ReportINBuffer, 0x00, HIDInterfaceInfo->Config.PrevReportINBufferSize);
+
+		if (HIDInterfaceInfo->Config.PrevReportINBuffer != NULL)
+		  memset(HIDInterfaceInfo->Config.PrevReportINBuffer, 0x00, HIDInterfaceInfo->Config.PrevReportINBufferSize);
+	}
 
 	HIDInterfaceInfo->Config.ReportINEndpoint.Type = EP_TYPE_INTERRUPT;
 
@@ -158,6 +206,17 @@ void HID_Device_USBTask(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo)
 	if (USB_DeviceState != DEVICE_STATE_Configured)
 	  return;
 
+	#if defined(HID_DEVICE_REPORT_QUEUE)
+	if (HIDInterfaceInfo->State.ReportQueueCount)
+	{
+		HID_Device_SendQueuedReports(HIDInterfaceInfo);
+
+		/* Reports still waiting in the queue take priority over new reports from the application */
+		if (HIDInterfaceInfo->State.ReportQueueCount)
+		  return;
+	}
+	#endif
+
 	if (HIDInterfaceInfo->State.PrevFrameNum == USB_Device_GetFrameNumber())
 	{
 		#if defined(USB_DEVICE_OPT_LOWSPEED)
@@ -172,40 +231,225 @@ void HID_Device_USBTask(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo)
 
 	if (Endpoint_IsReadWriteAllowed())
 	{
-		uint8_t  ReportINData[HIDInterfaceInfo->Config.PrevReportINBufferSize];
-		uint8_t  ReportID     = 0;
-		uint16_t ReportINSize = 0;
+		if (HIDInterfaceInfo->State.NextReportINBuffer != NULL)
+		{
+			void*    ReportINData = HIDInterfaceInfo->State.NextReportINBuffer;
+			uint8_t  ReportID     = 0;
+			uint16_t ReportINSize = 0;
+
+			bool ForceSend     = CALLBACK_HID_Device_CreateHIDReport(HIDInterfaceInfo, &ReportID, HID_REPORT_ITEM_In,
+			                                                         ReportINData, &ReportINSize);
+			bool StatesChanged = HIDInterfaceInfo->State.ReportINChanged;
+
+			/* Double buffered reports are neither cleared nor compared, as each field written by the callback via
+			 * HID_Device_UpdateReportINField() is checked against the previous report; swap the report buffers on a
+			 * change so that the new report becomes the previous report, rather than copying it */
+			if (HIDInterfaceInfo->State.LastReportINBuffer != NULL)
+			{
+				StatesChanged |= (ReportID != HIDInterfaceInfo->State.LastReportINID);
 
-		memset(ReportINData, 0, sizeof(ReportINData));
+				if (StatesChanged)
+				{
+					HIDInterfaceInfo->State.NextReportINBuffer = HIDInterfaceInfo->State.LastReportINBuffer;
+					HIDInterfaceInfo->State.LastReportINBuffer = ReportINData;
+					HIDInterfaceInfo->State.LastReportINID     = ReportID;
+				}
+			}
 
-		bool ForceSend         = CALLBACK_HID_Device_CreateHIDReport(HIDInterfaceInfo, &ReportID, HID_REPORT_ITEM_In,
-		                                                             ReportINData, &ReportINSize);
-		bool StatesChanged     = false;
-		bool IdlePeriodElapsed = (HIDInterfaceInfo->State.IdleCount && !(HIDInterfaceInfo->State.IdleMSRemaining));
+			HIDInterfaceInfo->State.ReportINChanged = false;
 
-		if (HIDInterfaceInfo->Config.PrevReportINBuffer != NULL)
+			if (ReportINSize && (ForceSend || StatesChanged || HID_Device_IdlePeriodElapsed(HIDInterfaceInfo, ReportID)))
+			  HID_Device_SendReportIN(HIDInterfaceInfo, ReportID, ReportINData, ReportINSize);
+		}
+		else
+		{
+			uint8_t  ReportINData[HIDInterfaceInfo->Config.PrevReportINBufferSize];
+			uint8_t  ReportID     = 0;
+			uint16_t ReportINSize = 0;
+
+			memset(ReportINData, 0, sizeof(ReportINData));
+
+			bool ForceSend     = CALLBACK_HID_Device_CreateHIDReport(HIDInterfaceInfo, &ReportID, HID_REPORT_ITEM_In,
+			                                                         ReportINData, &ReportINSize);
+			bool StatesChanged = HIDInterfaceInfo->State.ReportINChanged;
+
+			if (HIDInterfaceInfo->Config.PrevReportINBuffer != NULL)
+			{
+				StatesChanged |= (memcmp(ReportINData, HIDInterfaceInfo->Config.PrevReportINBuffer, ReportINSize) != 0);
+				memcpy(HIDInterfaceInfo->Config.PrevReportINBuffer, ReportINData, HIDInterfaceInfo->Config.PrevReportINBufferSize);
+				HIDInterfaceInfo->State.LastReportINID = ReportID;
+			}
+
+			HIDInterfaceInfo->State.ReportINChanged = false;
+
+			if (ReportINSize && (ForceSend || StatesChanged || HID_Device_IdlePeriodElapsed(HIDInterfaceInfo, ReportID)))
+			  HID_Device_SendReportIN(HIDInterfaceInfo, ReportID, ReportINData, ReportINSize);
+		}
+
+		HIDInterfaceInfo->State.PrevFrameNum = USB_Device_GetFrameNumber();
+	}
+}
+
+static void HID_Device_SendReportIN(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo,
+                                    const uint8_t ReportID,
+                                    const void* const ReportINData,
+                                    const uint16_t ReportINSize)
+{
+	#if defined(HID_DEVICE_IDLE_REPORT_IDS)
+	HID_Device_ReportIdle_t* ReportIdle = HID_Device_GetReportIdle(HIDInterfaceInfo, ReportID, false);
+
+	if (ReportIdle != NULL)
+	  ReportIdle->IdleMSRemaining = ReportIdle->IdleCount;
+	else
+	  HIDInterfaceInfo->State.IdleMSRemaining = HIDInterfaceInfo->State.IdleCount;
+	#else
+	HIDInterfaceInfo->State.IdleMSRemaining = HIDInterfaceInfo->State.IdleCount;
+	#endif
+
+	Endpoint_SelectEndpoint(HIDInterfaceInfo->Config.ReportINEndpoint.Address);
+
+	if (ReportID)
+	  Endpoint_Write_8(ReportID);
+
+	Endpoint_Write_Stream_LE(ReportINData, ReportINSize, NULL);
+
+	Endpoint_ClearIN();
+}
+
+static bool HID_Device_IdlePeriodElapsed(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo,
+                                         const uint8_t ReportID)
+{
+	#if defined(HID_DEVICE_IDLE_REPORT_IDS)
+	HID_Device_ReportIdle_t* ReportIdle = HID_Device_GetReportIdle(HIDInterfaceInfo, ReportID, false);
+
+	if (ReportIdle != NULL)
+	  return (ReportIdle->IdleCount && !(ReportIdle->IdleMSRemaining));
+	#endif
+
+	return (HIDInterfaceInfo->State.IdleCount && !(HIDInterfaceInfo->State.IdleMSRemaining));
+}
+
+#if defined(HID_DEVICE_REPORT_QUEUE)
+bool HID_Device_QueueReport(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo,
+                            const uint8_t ReportID,
+                            const void* const ReportData,
+                            const uint8_t ReportSize)
+{
+	HID_Device_QueuedReport_t* QueuedReport;
+
+	if (ReportSize > HIDInterfaceInfo->Config.PrevReportINBufferSize)
+	  return false;
+
+	/* A newer report supersedes a waiting report of the same ID, which keeps its place and original queueing time */
+	for (uint8_t i = 0; i < HIDInterfaceInfo->State.ReportQueueCount; i++)
+	{
+		QueuedReport = HID_Device_GetQueuedReport(HIDInterfaceInfo, i);
+
+		if (QueuedReport->ReportID == ReportID)
 		{
-			StatesChanged = (memcmp(ReportINData, HIDInterfaceInfo->Config.PrevReportINBuffer, ReportINSize) != 0);
-			memcpy(HIDInterfaceInfo->Config.PrevReportINBuffer, ReportINData, HIDInterfaceInfo->Config.PrevReportINBufferSize);
+			QueuedReport->ReportSize = ReportSize;
+			memcpy(&QueuedReport[1], ReportData, ReportSize);
+
+			HIDInterfaceInfo->State.ReportsCoalesced++;
+			return true;
 		}
+	}
+
+	if (HIDInterfaceInfo->State.ReportQueueCount == HIDInterfaceInfo->Config.ReportQueueDepth)
+	  return false;
+
+	QueuedReport = HID_Device_GetQueuedReport(HIDInterfaceInfo, HIDInterfaceInfo->State.ReportQueueCount);
+
+	QueuedReport->ReportID       = ReportID;
+	QueuedReport->ReportSize     = ReportSize;
+	QueuedReport->QueuedFrameNum = USB_Device_GetFrameNumber();
+	memcpy(&QueuedReport[1], ReportData, ReportSize);
+
+	HIDInterfaceInfo->State.ReportQueueCount++;
+	return true;
+}
+
+static HID_Device_QueuedReport_t* HID_Device_GetQueuedReport(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo,
+                                                             const uint8_t Position)
+{
+	uint8_t Index = (HIDInterfaceInfo->State.ReportQueueHead + Position);
 
-		if (ReportINSize && (ForceSend || StatesChanged || IdlePeriodElapsed))
+	if (Index >= HIDInterfaceInfo->Config.ReportQueueDepth)
+	  Index -= HIDInterfaceInfo->Config.ReportQueueDepth;
+
+	return (HID_Device_QueuedReport_t*)((uint8_t*)HIDInterfaceInfo->Config.ReportQueueBuffer +
+	                                    (Index * (sizeof(HID_Device_QueuedReport_t) + HIDInterfaceInfo->Config.PrevReportINBufferSize)));
+}
+
+static void HID_Device_SendQueuedReports(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo)
+{
+	Endpoint_SelectEndpoint(HIDInterfaceInfo->Config.ReportINEndpoint.Address);
+
+	/* Send queued reports back-to-back for as long as the endpoint has a free bank to load them into */
+	while (HIDInterfaceInfo->State.ReportQueueCount && Endpoint_IsReadWriteAllowed())
+	{
+		HID_Device_QueuedReport_t* QueuedReport     = HID_Device_GetQueuedReport(HIDInterfaceInfo, 0);
+		void*                      PrevReportINData = HIDInterfaceInfo->State.LastReportINBuffer;
+		bool                       StatesChanged    = true;
+
+		/* Queued reports are compared against and become the previous report, in the same way as created reports - as the
+		 * queue mixes reports of several IDs, a report with a different ID to the previous report is always a change */
+		if (PrevReportINData != NULL)
 		{
-			HIDInterfaceInfo->State.IdleMSRemaining = HIDInterfaceInfo->State.IdleCount;
+			StatesChanged = ((QueuedReport->ReportID != HIDInterfaceInfo->State.LastReportINID) ||
+			                 (memcmp(&QueuedReport[1], PrevReportINData, QueuedReport->ReportSize) != 0));
 
-			Endpoint_SelectEndpoint(HIDInterfaceInfo->Config.ReportINEndpoint.Address);
+			memcpy(PrevReportINData, &QueuedReport[1], QueuedReport->ReportSize);
+			memset((uint8_t*)PrevReportINData + QueuedReport->ReportSize, 0x00,
+			       (HIDInterfaceInfo->Config.PrevReportINBufferSize - QueuedReport->ReportSize));
+			HIDInterfaceInfo->State.LastReportINID = QueuedReport->ReportID;
+		}
 
-			if (ReportID)
-			  Endpoint_Write_8(ReportID);
+		if (StatesChanged || HID_Device_IdlePeriodElapsed(HIDInterfaceInfo, QueuedReport->ReportID))
+		{
+			uint16_t Latency = ((USB_Device_GetFrameNumber() - QueuedReport->QueuedFrameNum) & 0x07FF);
 
-			Endpoint_Write_Stream_LE(ReportINData, ReportINSize, NULL);
+			HID_Device_SendReportIN(HIDInterfaceInfo, QueuedReport->ReportID, &QueuedReport[1], QueuedReport->ReportSize);
 
-			Endpoint_ClearIN();
+			HIDInterfaceInfo->State.ReportsSent++;
+			HIDInterfaceInfo->State.LatencyTotalFrames += Latency;
+			HIDInterfaceInfo->State.LatencyMaxFrames    = MAX(HIDInterfaceInfo->State.LatencyMaxFrames, Latency);
 		}
 
-		HIDInterfaceInfo->State.PrevFrameNum = USB_Device_GetFrameNumber();
+		if (++HIDInterfaceInfo->State.ReportQueueHead == HIDInterfaceInfo->Config.ReportQueueDepth)
+		  HIDInterfaceInfo->State.ReportQueueHead = 0;
+
+		HIDInterfaceInfo->State.ReportQueueCount--;
 	}
 }
+#endif
+
+#if defined(HID_DEVICE_IDLE_REPORT_IDS)
+static HID_Device_ReportIdle_t* HID_Device_GetReportIdle(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo,
+                                                         const uint8_t ReportID,
+                                                         const bool Allocate)
+{
+	HID_Device_ReportIdle_t* FreeReportIdle = NULL;
+
+	if (!(ReportID))
+	  return NULL;
+
+	for (uint8_t i = 0; i < HID_DEVICE_IDLE_REPORT_IDS; i++)
+	{
+		HID_Device_ReportIdle_t* ReportIdle = &HIDInterfaceInfo->State.ReportIdle[i];
+
+		if (ReportIdle->ReportID == ReportID)
+		  return ReportIdle;
+		else if (!(ReportIdle->ReportID) && (FreeReportIdle == NULL))
+		  FreeReportIdle = ReportIdle;
+	}
+
+	if (Allocate && (FreeReportIdle != NULL))
+	  FreeReportIdle->ReportID = ReportID;
+
+	return (Allocate ? FreeReportIdle : NULL);
+}
+#endif
 
 #endif
 
@@ -68,7 +68,46 @@
 		#endif
 
 	/* Public Interface - May be used in end-application: */
+		/* Macros: */
+			#if defined(HID_DEVICE_REPORT_QUEUE) || defined(__DOXYGEN__)
+			/** Gives the size in bytes of a HID device report queue buffer, for use as the \c ReportQueueBuffer of a HID
+			 *  interface's configuration when the \c HID_DEVICE_REPORT_QUEUE token is defined.
+			 *
+			 *  \param[in] Depth       Maximum number of reports which may be queued at once.
+			 *  \param[in] ReportSize  Size in bytes of the largest queued report, i.e. the interface's \c PrevReportINBufferSize.
+			 */
+			#define HID_DEVICE_REPORT_QUEUE_BUFFER_SIZE(Depth, ReportSize) ((Depth) * (sizeof(HID_Device_QueuedReport_t) + (ReportSize)))
+			#endif
+
 		/* Type Defines: */
+			#if defined(HID_DEVICE_REPORT_QUEUE) || defined(__DOXYGEN__)
+			/** \brief HID Class Device Mode Queued Report Header Structure.
+			 *
+			 *  Type define for the header of each entry in a HID interface's report queue, which is followed by the queued
+			 *  report's data.
+			 */
+			typedef struct
+			{
+				uint8_t  ReportID; /**< Report ID of the queued report, or zero if the interface does not use report IDs. */
+				uint8_t  ReportSize; /**< Size in bytes of the queued report's data. */
+				uint16_t QueuedFrameNum; /**< USB frame number at which the report was first queued. */
+			} HID_Device_QueuedReport_t;
+			#endif
+
+			#if defined(HID_DEVICE_IDLE_REPORT_IDS) || defined(__DOXYGEN__)
+			/** \brief HID Class Device Mode Per-Report Idle Timer Structure.
+			 *
+			 *  Type define for the idle period timer of a single report ID, kept by the HID device class driver when the
+			 *  \c HID_DEVICE_IDLE_REPORT_IDS token is defined, so that the host may set a different idle rate for each report.
+			 */
+			typedef struct
+			{
+				uint8_t  ReportID; /**< Report ID the idle timer applies to, or zero if the timer is unused. */
+				uint16_t IdleCount; /**< Report idle period, in milliseconds, set by the host. */
+				uint16_t IdleMSRemaining; /**< Total number of milliseconds remaining before the idle period elapsed. */
+			} HID_Device_ReportIdle_t;
+			#endif
+
 			/** \brief HID Class Device Mode Configuration and State Structure.
 			 *
 			 *  Class state structure. An instance of this structure should be made for each HID interface
@@ -105,6 +144,26 @@
 					                                  *  exclusively (i.e. \c PrevReportINBuffer is \c NULL) this value must still be
 					                                  *  set to the size of the largest report the device can issue to the host.
 					                                  */
+					void*    ReportINBuffer; /**< Optional pointer to an application buffer of \c PrevReportINBufferSize bytes in which
+					                          *  the driver builds input reports, in place of a temporary buffer that is created and
+					                          *  copied for each report. When set together with \c PrevReportINBuffer, the two buffers
+					                          *  are swapped by pointer each time a changed report is created, so that whole reports are
+					                          *  neither copied, cleared nor compared. When set alone, the buffer holds a single
+					                          *  persistent report. In both modes a report is only sent when forced, when the idle period
+					                          *  elapses or when marked as changed via \ref HID_Device_UpdateReportINField() or
+					                          *  \ref HID_Device_MarkReportINChanged().
+					                          *
+					                          *  \note The report buffer is never cleared by the driver, and in the double buffered mode
+					                          *        holds an older report when given to \ref CALLBACK_HID_Device_CreateHIDReport(). The
+					                          *        callback must therefore write every field of the input report, via
+					                          *        \ref HID_Device_UpdateReportINField().
+					                          */
+					#if defined(HID_DEVICE_REPORT_QUEUE) || defined(__DOXYGEN__)
+					void*    ReportQueueBuffer; /**< Pointer to a buffer of \ref HID_DEVICE_REPORT_QUEUE_BUFFER_SIZE() bytes, in which
+					                             *   reports queued via \ref HID_Device_QueueReport() are held until sent.
+					                             */
+					uint8_t  ReportQueueDepth; /**< Maximum number of reports which can be held in \c ReportQueueBuffer. */
+					#endif
 				} Config; /**< Config data for the USB class interface within the device. All elements in this section
 				           *   <b>must</b> be set or the interface will fail to enumerate and operate correctly.
 				           */
@@ -115,6 +174,31 @@
 					uint16_t IdleCount; /**< Report idle period, in milliseconds, set by the host. */
 					uint16_t IdleMSRemaining; /**< Total number of milliseconds remaining before the idle period elapsed - this
 				                               *   should be decremented by the user application if non-zero each millisecond. */
+					void*    NextReportINBuffer; /**< Buffer the next input report is created in, when \c ReportINBuffer is set. */
+					void*    LastReportINBuffer; /**< Buffer holding the previously created input report, if any. */
+					uint8_t  LastReportINID; /**< Report ID of the report held in \c LastReportINBuffer. */
+					bool     ReportINChanged; /**< Indicates that the application has marked the next input report as changed. */
+					#if defined(HID_DEVICE_IDLE_REPORT_IDS) || defined(__DOXYGEN__)
+					HID_Device_ReportIdle_t ReportIdle[HID_DEVICE_IDLE_REPORT_IDS]; /**< Idle timers of the report IDs for which
+					                                                                 *   the host has set an individual idle rate.
+					                                                                 */
+					#endif
+					#if defined(HID_DEVICE_REPORT_QUEUE) || defined(__DOXYGEN__)
+					uint8_t  ReportQueueHead; /**< Index of the oldest entry in the report queue. */
+					uint8_t  ReportQueueCount; /**< Number of reports waiting in the report queue. */
+					uint16_t ReportsSent; /**< Number of queued reports sent to the host, excluding unchanged reports which were
+					                       *   dropped.
+					                       */
+					uint16_t ReportsCoalesced; /**< Number of queued reports superseded by a newer report of the same ID before
+					                            *   being sent.
+					                            */
+					uint16_t LatencyMaxFrames; /**< Largest number of frames between a report being queued and being loaded into
+					                            *   the endpoint for the host, excluding the host's polling delay.
+					                            */
+					uint32_t LatencyTotalFrames; /**< Total number of frames between queueing and sending of all sent reports,
+					                              *   for calculating the average queueing latency with \c ReportsSent.
+					                              */
+					#endif
 				} State; /**< State data for the USB class interface within the device. All elements in this section
 				          *   are reset to their defaults when the interface is enumerated.
 				          */
@@ -145,6 +229,30 @@
 			 */
 			void HID_Device_USBTask(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
 
+			#if defined(HID_DEVICE_REPORT_QUEUE) || defined(__DOXYGEN__)
+			/** Queues an input report for sending on the given HID interface, in addition to the reports created via the
+			 *  \ref CALLBACK_HID_Device_CreateHIDReport() callback. Queued reports are sent by \ref HID_Device_USBTask() in order,
+			 *  as many at once as the endpoint has free banks, without waiting for the next frame. If a report with the same
+			 *  report ID is already waiting in the queue, it is replaced in place by the new report. Like created reports, each
+			 *  queued report is compared against the previous report when the interface has a \c PrevReportINBuffer, and is
+			 *  only sent if its report ID or data differs or its idle period has elapsed.
+			 *
+			 *  \note This function is only available when the \c HID_DEVICE_REPORT_QUEUE token is defined, and the interface's
+			 *        \c ReportQueueBuffer and \c ReportQueueDepth configuration entries are set.
+			 *
+			 *  \param[in,out] HIDInterfaceInfo  Pointer to a structure containing a HID Class configuration and state.
+			 *  \param[in]     ReportID          Report ID of the report to queue, or zero if the interface does not use report IDs.
+			 *  \param[in]     ReportData        Pointer to the report data to queue, excluding the report ID.
+			 *  \param[in]     ReportSize        Size in bytes of the report data, no larger than \c PrevReportINBufferSize.
+			 *
+			 *  \return Boolean \c true if the report was queued, \c false if the queue is full or the report too large.
+			 */
+			bool HID_Device_QueueReport(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo,
+			                            const uint8_t ReportID,
+			                            const void* const ReportData,
+			                            const uint8_t ReportSize) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(3);
+			#endif
+
 			/** HID class driver callback for the user creation of a HID IN report. This callback may fire in response to either
 			 *  HID class control requests from the host, or by the normal HID endpoint polling procedure. Inside this callback the
 			 *  user is responsible for the creation of the next HID input report to be sent to the host.
@@ -197,8 +305,87 @@
 			{
 				if (HIDInterfaceInfo->State.IdleMSRemaining)
 				  HIDInterfaceInfo->State.IdleMSRemaining--;
+
+				#if defined(HID_DEVICE_IDLE_REPORT_IDS)
+				for (uint8_t i = 0; i < HID_DEVICE_IDLE_REPORT_IDS; i++)
+				{
+					if (HIDInterfaceInfo->State.ReportIdle[i].IdleMSRemaining)
+					  HIDInterfaceInfo->State.ReportIdle[i].IdleMSRemaining--;
+				}
+				#endif
+			}
+
+			/** Marks the next input report created on the given HID interface as changed, so that it is sent to the host without
+			 *  first being compared against the previous report. This may be called from within the
+			 *  \ref CALLBACK_HID_Device_CreateHIDReport() callback by applications which track changes to their report data.
+			 *
+			 *  \param[in,out] HIDInterfaceInfo  Pointer to a structure containing a HID Class configuration and state.
+			 */
+			static inline void HID_Device_MarkReportINChanged(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo) ATTR_ALWAYS_INLINE ATTR_NON_NULL_PTR_ARG(1);
+			static inline void HID_Device_MarkReportINChanged(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo)
+			{
+				HIDInterfaceInfo->State.ReportINChanged = true;
+			}
+
+			/** Updates a single field of an input report being created in the \ref CALLBACK_HID_Device_CreateHIDReport() callback,
+			 *  marking the report as changed if the field's value differs from its value in the previous report. This allows the
+			 *  driver to skip the comparison of whole reports when the interface's \c ReportINBuffer is set, both when used as a
+			 *  persistent report and when double buffered with \c PrevReportINBuffer; in the latter mode the field is compared
+			 *  against the same field of the previous report buffer, rather than against the older report it is written over.
+			 *
+			 *  \param[in,out] HIDInterfaceInfo  Pointer to a structure containing a HID Class configuration and state.
+			 *  \param[out]    Field             Pointer to the report field to update, within the report buffer.
+			 *  \param[in]     Value             Pointer to the new value of the report field.
+			 *  \param[in]     Size              Size in bytes of the report field.
+			 */
+			static inline void HID_Device_UpdateReportINField(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo,
+			                                                  void* const Field,
+			                                                  const void* const Value,
+			                                                  const uint8_t Size) ATTR_ALWAYS_INLINE ATTR_NON_NULL_PTR_ARG(1)
+			                                                  ATTR_NON_NULL_PTR_ARG(2) ATTR_NON_NULL_PTR_ARG(3);
+			static inline void HID_Device_UpdateReportINField(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo,
+			                                                  void* const Field,
+			                                                  const void* const Value,
+			                                                  const uint8_t Size)
+			{
+				const void* PrevField = Field;
+				uintptr_t   Offset    = ((uintptr_t)Field - (uintptr_t)HIDInterfaceInfo->State.NextReportINBuffer);
+
+				if ((HIDInterfaceInfo->State.LastReportINBuffer != NULL) && (HIDInterfaceInfo->State.NextReportINBuffer != NULL) &&
+				    (Offset < HIDInterfaceInfo->Config.PrevReportINBufferSize))
+				{
+					PrevField = ((const uint8_t*)HIDInterfaceInfo->State.LastReportINBuffer + Offset);
+				}
+
+				if (memcmp(PrevField, Value, Size) != 0)
+				  HIDInterfaceInfo->State.ReportINChanged = true;
+
+				memcpy(Field, Value, Size);
 			}
 
+	/* Private Interface - For use in library only: */
+	#if !defined(__DOXYGEN__)
+		/* Function Prototypes: */
+			#if defined(__INCLUDE_FROM_HID_DEVICE_C)
+				static void HID_Device_SendReportIN(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo,
+				                                    const uint8_t ReportID,
+				                                    const void* const ReportINData,
+				                                    const uint16_t ReportINSize) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(3);
+				static bool HID_Device_IdlePeriodElapsed(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo,
+				                                         const uint8_t ReportID) ATTR_NON_NULL_PTR_ARG(1);
+				#if defined(HID_DEVICE_REPORT_QUEUE)
+				static HID_Device_QueuedReport_t* HID_Device_GetQueuedReport(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo,
+				                                                             const uint8_t Position) ATTR_NON_NULL_PTR_ARG(1);
+				static void HID_Device_SendQueuedReports(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
+				#endif
+				#if defined(HID_DEVICE_IDLE_REPORT_IDS)
+				static HID_Device_ReportIdle_t* HID_Device_GetReportIdle(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo,
+				                                                         const uint8_t ReportID,
+				                                                         const bool Allocate) ATTR_NON_NULL_PTR_ARG(1);
+				#endif
+			#endif
+	#endif
+
 	/* Disable C linkage for C++ Compilers: */
 		#if defined(__cplusplus)
 			}
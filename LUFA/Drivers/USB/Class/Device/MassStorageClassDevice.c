@@ -131,12 +131,48 @@ void MS_Device_USBTask(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo)
 	}
 }
 
+static bool MS_Device_IsValidCommandBlock(const USB_ClassInfo_MS_Device_t* const MSInterfaceInfo,
+                                          const MS_CommandBlockWrapper_t* const CommandBlock)
+{
+	return ((CommandBlock->Signature         == CPU_TO_LE32(MS_CBW_SIGNATURE))     &&
+	        (CommandBlock->LUN               <  MSInterfaceInfo->Config.TotalLUNs) &&
+	        !(CommandBlock->Flags             & 0x1F)                              &&
+	        (CommandBlock->SCSICommandLength != 0)                                 &&
+	        (CommandBlock->SCSICommandLength <= 16));
+}
+
 static bool MS_Device_ReadInCommandBlock(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo)
 {
 	uint16_t BytesProcessed;
 
 	Endpoint_SelectEndpoint(MSInterfaceInfo->Config.DataOUTEndpoint.Address);
 
+	#if defined(ENDPOINT_HAS_BANK_ACCESS)
+	uint16_t BankLength;
+	const MS_CommandBlockWrapper_t* BankCommandBlock = Endpoint_AcquireBank(&BankLength);
+
+	/* Validate the wrapper in place when it is held entirely within the bank, copying out only a valid command */
+	if (BankLength >= sizeof(MS_CommandBlockWrapper_t))
+	{
+		if (!(MS_Device_IsValidCommandBlock(MSInterfaceInfo, BankCommandBlock)))
+		{
+			Endpoint_StallTransaction();
+			Endpoint_SelectEndpoint(MSInterfaceInfo->Config.DataINEndpoint.Address);
+			Endpoint_StallTransaction();
+
+			return false;
+		}
+
+		memcpy(&MSInterfaceInfo->State.CommandBlock, BankCommandBlock,
+		       ((sizeof(MS_CommandBlockWrapper_t) - 16) + BankCommandBlock->SCSICommandLength));
+
+		Endpoint_CommitBank(sizeof(MS_CommandBlockWrapper_t));
+		Endpoint_ClearOUT();
+
+		return true;
+	}
+	#endif
+
 	BytesProcessed = 0;
 	while (Endpoint_Read_Stream_LE(&MSInterfaceInfo->State.CommandBlock,
 	                               (sizeof(MS_CommandBlockWrapper_t) - 16), &BytesProcessed) ==
@@ -146,11 +182,7 @@ static bool MS_Device_ReadInCommandBlock(USB_ClassInfo_MS_Device_t* const MSInte
 		  return false;
 	}
 
-	if ((MSInterfaceInfo->State.CommandBlock.Signature         != CPU_TO_LE32(MS_CBW_SIGNATURE))     ||
-	    (MSInterfaceInfo->State.CommandBlock.LUN               >= MSInterfaceInfo->Config.TotalLUNs) ||
-		(MSInterfaceInfo->State.CommandBlock.Flags              & 0x1F)                              ||
-		(MSInterfaceInfo->State.CommandBlock.SCSICommandLength == 0)                                 ||
-		(MSInterfaceInfo->State.CommandBlock.SCSICommandLength >  16))
+	if (!(MS_Device_IsValidCommandBlock(MSInterfaceInfo, &MSInterfaceInfo->State.CommandBlock)))
 	{
 		Endpoint_StallTransaction();
 		Endpoint_SelectEndpoint(MSInterfaceInfo->Config.DataINEndpoint.Address);
@@ -146,6 +146,8 @@
 			#if defined(__INCLUDE_FROM_MASSSTORAGE_DEVICE_C)
 				static void MS_Device_ReturnCommandStatus(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
 				static bool MS_Device_ReadInCommandBlock(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
+				static bool MS_Device_IsValidCommandBlock(const USB_ClassInfo_MS_Device_t* const MSInterfaceInfo,
+				                                          const MS_CommandBlockWrapper_t* const CommandBlock) ATTR_NON_NULL_PTR_ARG(1, 2);
 			#endif
 
 	#endif
@@ -453,17 +453,35 @@ uint8_t RNDIS_Device_ReadPacket(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfa
 	if (!(Endpoint_IsOUTReceived()))
 		return ENDPOINT_RWSTREAM_NoError;
 
-	RNDIS_Packet_Message_t RNDISPacketHeader;
-	Endpoint_Read_Stream_LE(&RNDISPacketHeader, sizeof(RNDIS_Packet_Message_t), NULL);
+	uint32_t DataLength;
+
+	#if defined(ENDPOINT_HAS_BANK_ACCESS)
+	uint16_t BankLength;
+	const RNDIS_Packet_Message_t* BankPacketHeader = Endpoint_AcquireBank(&BankLength);
 
-	if (le32_to_cpu(RNDISPacketHeader.DataLength) > ETHERNET_FRAME_SIZE_MAX)
+	/* Parse the packet header in place when it is held entirely within the bank, rather than copying it out */
+	if (BankLength >= sizeof(RNDIS_Packet_Message_t))
+	{
+		DataLength = le32_to_cpu(BankPacketHeader->DataLength);
+		Endpoint_CommitBank(sizeof(RNDIS_Packet_Message_t));
+	}
+	else
+	#endif
+	{
+		RNDIS_Packet_Message_t RNDISPacketHeader;
+		Endpoint_Read_Stream_LE(&RNDISPacketHeader, sizeof(RNDIS_Packet_Message_t), NULL);
+
+		DataLength = le32_to_cpu(RNDISPacketHeader.DataLength);
+	}
+
+	if (DataLength > ETHERNET_FRAME_SIZE_MAX)
 	{
 		Endpoint_StallTransaction();
 
 		return RNDIS_ERROR_LOGICAL_CMD_FAILED;
 	}
 
-	*PacketLength = (uint16_t)le32_to_cpu(RNDISPacketHeader.DataLength);
+	*PacketLength = (uint16_t)DataLength;
 
 	Endpoint_Read_Stream_LE(Buffer, *PacketLength, NULL);
 	Endpoint_ClearOUT();
@@ -497,8 +515,13 @@ uint8_t RNDIS_Device_SendPacket(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfa
 	RNDISPacketHeader.DataOffset    = CPU_TO_LE32(sizeof(RNDIS_Packet_Message_t) - sizeof(RNDIS_Message_Header_t));
 	RNDISPacketHeader.DataLength    = cpu_to_le32(PacketLength);
 
-	Endpoint_Write_Stream_LE(&RNDISPacketHeader, sizeof(RNDIS_Packet_Message_t), NULL);
-	Endpoint_Write_Stream_LE(Buffer, PacketLength, NULL);
+	Endpoint_StreamSegment_t PacketSegments[] =
+		{
+			{.Buffer = &RNDISPacketHeader, .Length = sizeof(RNDIS_Packet_Message_t)},
+			{.Buffer = Buffer,             .Length = PacketLength},
+		};
+
+	Endpoint_Write_StreamV(PacketSegments, 2, NULL);
 	Endpoint_ClearIN();
 
 	return ENDPOINT_RWSTREAM_NoError;
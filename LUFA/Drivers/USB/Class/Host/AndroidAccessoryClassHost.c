@@ -59,29 +59,31 @@ uint8_t AOA_Host_ConfigurePipes(USB_ClassInfo_AOA_Host_t* const AOAInterfaceInfo
 	USB_Descriptor_Endpoint_t*  DataINEndpoint  = NULL;
 	USB_Descriptor_Endpoint_t*  DataOUTEndpoint = NULL;
 	USB_Descriptor_Interface_t* AOAInterface    = NULL;
+	uint8_t                     CurrInterface   = USB_CONFIG_INDEX_NONE;
+	uint8_t                     EndpointCursor  = 0;
 
 	memset(&AOAInterfaceInfo->State, 0x00, sizeof(AOAInterfaceInfo->State));
 
-	if (DESCRIPTOR_TYPE(ConfigDescriptorData) != DTYPE_Configuration)
+	const USB_ConfigIndex_t* ConfigIndex = USB_GetConfigIndex(ConfigDescriptorSize, ConfigDescriptorData);
+
+	if (!(ConfigIndex))
 	  return AOA_ENUMERROR_InvalidConfigDescriptor;
 
-	if (USB_GetNextDescriptorComp(&ConfigDescriptorSize, &ConfigDescriptorData,
-	                              DCOMP_AOA_Host_NextAndroidAccessoryInterface) != DESCRIPTOR_SEARCH_COMP_Found)
+	if ((CurrInterface = USB_ConfigIndex_FindNextInterface(ConfigIndex, CurrInterface,
+	                                                       DCOMP_AOA_Host_NextAndroidAccessoryInterface)) == USB_CONFIG_INDEX_NONE)
 	{
 		return AOA_ENUMERROR_NoCompatibleInterfaceFound;
 	}
 
-	AOAInterface = DESCRIPTOR_PCAST(ConfigDescriptorData, USB_Descriptor_Interface_t);
+	AOAInterface = USB_ConfigIndex_GetInterface(ConfigIndex, CurrInterface);
 
 	while (!(DataINEndpoint) || !(DataOUTEndpoint))
 	{
-		if (USB_GetNextDescriptorComp(&ConfigDescriptorSize, &ConfigDescriptorData,
-		                              DCOMP_AOA_Host_NextInterfaceBulkEndpoint) != DESCRIPTOR_SEARCH_COMP_Found)
-		{
-			return AOA_ENUMERROR_NoCompatibleInterfaceFound;
-		}
+		USB_Descriptor_Endpoint_t* EndpointData = USB_ConfigIndex_FindNextEndpoint(ConfigIndex, CurrInterface, &EndpointCursor,
+		                                                                           DCOMP_AOA_Host_NextInterfaceBulkEndpoint);
 
-		USB_Descriptor_Endpoint_t* EndpointData = DESCRIPTOR_PCAST(ConfigDescriptorData, USB_Descriptor_Endpoint_t);
+		if (!(EndpointData))
+		  return AOA_ENUMERROR_NoCompatibleInterfaceFound;
 
 		if ((EndpointData->EndpointAddress & ENDPOINT_DIR_MASK) == ENDPOINT_DIR_IN)
 		  DataINEndpoint  = EndpointData;
@@ -45,48 +45,55 @@ uint8_t Audio_Host_ConfigurePipes(USB_ClassInfo_Audio_Host_t* const AudioInterfa
 	USB_Descriptor_Endpoint_t*  DataOUTEndpoint         = NULL;
 	USB_Descriptor_Interface_t* AudioControlInterface   = NULL;
 	USB_Descriptor_Interface_t* AudioStreamingInterface = NULL;
+	uint8_t                     CurrInterface           = USB_CONFIG_INDEX_NONE;
+	uint8_t                     EndpointCursor          = 0;
 
 	memset(&AudioInterfaceInfo->State, 0x00, sizeof(AudioInterfaceInfo->State));
 
-	if (DESCRIPTOR_TYPE(ConfigDescriptorData) != DTYPE_Configuration)
+	const USB_ConfigIndex_t* ConfigIndex = USB_GetConfigIndex(ConfigDescriptorSize, ConfigDescriptorData);
+
+	if (!(ConfigIndex))
 	  return AUDIO_ENUMERROR_InvalidConfigDescriptor;
 
 	while ((AudioInterfaceInfo->Config.DataINPipe.Address  && !(DataINEndpoint)) ||
 	       (AudioInterfaceInfo->Config.DataOUTPipe.Address && !(DataOUTEndpoint)))
 	{
-		if (!(AudioControlInterface) ||
-		    USB_GetNextDescriptorComp(&ConfigDescriptorSize, &ConfigDescriptorData,
-		                              DCOMP_Audio_Host_NextAudioInterfaceDataEndpoint) != DESCRIPTOR_SEARCH_COMP_Found)
+		USB_Descriptor_Endpoint_t* EndpointData = NULL;
+
+		if (AudioControlInterface)
+		{
+			EndpointData = USB_ConfigIndex_FindNextEndpoint(ConfigIndex, CurrInterface, &EndpointCursor,
+			                                                DCOMP_Audio_Host_NextAudioInterfaceDataEndpoint);
+		}
+
+		if (!(EndpointData))
 		{
-			if (!(AudioControlInterface) ||
-			    USB_GetNextDescriptorComp(&ConfigDescriptorSize, &ConfigDescriptorData,
-			                              DCOMP_Audio_Host_NextAudioStreamInterface) != DESCRIPTOR_SEARCH_COMP_Found)
+			if (!(AudioControlInterface))
 			{
-				if (USB_GetNextDescriptorComp(&ConfigDescriptorSize, &ConfigDescriptorData,
-				                              DCOMP_Audio_Host_NextAudioControlInterface) != DESCRIPTOR_SEARCH_COMP_Found)
+				if ((CurrInterface = USB_ConfigIndex_FindNextInterface(ConfigIndex, CurrInterface,
+				                                                       DCOMP_Audio_Host_NextAudioControlInterface)) == USB_CONFIG_INDEX_NONE)
 				{
 					return AUDIO_ENUMERROR_NoCompatibleInterfaceFound;
 				}
 
-				AudioControlInterface = DESCRIPTOR_PCAST(ConfigDescriptorData, USB_Descriptor_Interface_t);
+				AudioControlInterface = USB_ConfigIndex_GetInterface(ConfigIndex, CurrInterface);
+			}
 
-				if (USB_GetNextDescriptorComp(&ConfigDescriptorSize, &ConfigDescriptorData,
-				                              DCOMP_Audio_Host_NextAudioStreamInterface) != DESCRIPTOR_SEARCH_COMP_Found)
-				{
-					return AUDIO_ENUMERROR_NoCompatibleInterfaceFound;
-				}
+			if ((CurrInterface = USB_ConfigIndex_FindNextInterface(ConfigIndex, CurrInterface,
+			                                                       DCOMP_Audio_Host_NextAudioStreamInterface)) == USB_CONFIG_INDEX_NONE)
+			{
+				return AUDIO_ENUMERROR_NoCompatibleInterfaceFound;
 			}
 
-			AudioStreamingInterface = DESCRIPTOR_PCAST(ConfigDescriptorData, USB_Descriptor_Interface_t);
+			AudioStreamingInterface = USB_ConfigIndex_GetInterface(ConfigIndex, CurrInterface);
 
 			DataINEndpoint  = NULL;
 			DataOUTEndpoint = NULL;
+			EndpointCursor  = 0;
 
 			continue;
 		}
 
-		USB_Descriptor_Endpoint_t* EndpointData = DESCRIPTOR_PCAST(ConfigDescriptorData, USB_Descriptor_Endpoint_t);
-
 		if ((EndpointData->EndpointAddress & ENDPOINT_DIR_MASK) == ENDPOINT_DIR_IN)
 		  DataINEndpoint  = EndpointData;
 		else
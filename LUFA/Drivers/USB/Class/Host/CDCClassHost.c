@@ -45,22 +45,32 @@ uint8_t CDC_Host_ConfigurePipes(USB_ClassInfo_CDC_Host_t* const CDCInterfaceInfo
 	USB_Descriptor_Endpoint_t*  DataOUTEndpoint      = NULL;
 	USB_Descriptor_Endpoint_t*  NotificationEndpoint = NULL;
 	USB_Descriptor_Interface_t* CDCControlInterface  = NULL;
+	uint8_t                     CurrInterface        = USB_CONFIG_INDEX_NONE;
+	uint8_t                     EndpointCursor       = 0;
 
 	memset(&CDCInterfaceInfo->State, 0x00, sizeof(CDCInterfaceInfo->State));
 
-	if (DESCRIPTOR_TYPE(ConfigDescriptorData) != DTYPE_Configuration)
+	const USB_ConfigIndex_t* ConfigIndex = USB_GetConfigIndex(ConfigDescriptorSize, ConfigDescriptorData);
+
+	if (!(ConfigIndex))
 	  return CDC_ENUMERROR_InvalidConfigDescriptor;
 
 	while (!(DataINEndpoint) || !(DataOUTEndpoint) || !(NotificationEndpoint))
 	{
-		if (!(CDCControlInterface) ||
-		    USB_GetNextDescriptorComp(&ConfigDescriptorSize, &ConfigDescriptorData,
-		                              DCOMP_CDC_Host_NextCDCInterfaceEndpoint) != DESCRIPTOR_SEARCH_COMP_Found)
+		USB_Descriptor_Endpoint_t* EndpointData = NULL;
+
+		if (CDCControlInterface)
+		{
+			EndpointData = USB_ConfigIndex_FindNextEndpoint(ConfigIndex, CurrInterface, &EndpointCursor,
+			                                                DCOMP_CDC_Host_NextCDCInterfaceEndpoint);
+		}
+
+		if (!(EndpointData))
 		{
 			if (NotificationEndpoint)
 			{
-				if (USB_GetNextDescriptorComp(&ConfigDescriptorSize, &ConfigDescriptorData,
-				                              DCOMP_CDC_Host_NextCDCDataInterface) != DESCRIPTOR_SEARCH_COMP_Found)
+				if ((CurrInterface = USB_ConfigIndex_FindNextInterface(ConfigIndex, CurrInterface,
+				                                                       DCOMP_CDC_Host_NextCDCDataInterface)) == USB_CONFIG_INDEX_NONE)
 				{
 					return CDC_ENUMERROR_NoCompatibleInterfaceFound;
 				}
@@ -70,22 +80,21 @@ uint8_t CDC_Host_ConfigurePipes(USB_ClassInfo_CDC_Host_t* const CDCInterfaceInfo
 			}
 			else
 			{
-				if (USB_GetNextDescriptorComp(&ConfigDescriptorSize, &ConfigDescriptorData,
-				                              DCOMP_CDC_Host_NextCDCControlInterface) != DESCRIPTOR_SEARCH_COMP_Found)
+				if ((CurrInterface = USB_ConfigIndex_FindNextInterface(ConfigIndex, CurrInterface,
+				                                                       DCOMP_CDC_Host_NextCDCControlInterface)) == USB_CONFIG_INDEX_NONE)
 				{
 					return CDC_ENUMERROR_NoCompatibleInterfaceFound;
 				}
 
-				CDCControlInterface = DESCRIPTOR_PCAST(ConfigDescriptorData, USB_Descriptor_Interface_t);
+				CDCControlInterface = USB_ConfigIndex_GetInterface(ConfigIndex, CurrInterface);
 
 				NotificationEndpoint = NULL;
 			}
 
+			EndpointCursor = 0;
 			continue;
 		}
 
-		USB_Descriptor_Endpoint_t* EndpointData = DESCRIPTOR_PCAST(ConfigDescriptorData, USB_Descriptor_Endpoint_t);
-
 		if ((EndpointData->EndpointAddress & ENDPOINT_DIR_MASK) == ENDPOINT_DIR_IN)
 		{
 			if ((EndpointData->Attributes & EP_TYPE_MASK) == EP_TYPE_INTERRUPT)
@@ -45,49 +45,57 @@ uint8_t HID_Host_ConfigurePipes(USB_ClassInfo_HID_Host_t* const HIDInterfaceInfo
 	USB_Descriptor_Endpoint_t*  DataOUTEndpoint = NULL;
 	USB_Descriptor_Interface_t* HIDInterface    = NULL;
 	USB_HID_Descriptor_HID_t*   HIDDescriptor   = NULL;
+	uint8_t                     CurrInterface   = USB_CONFIG_INDEX_NONE;
+	uint8_t                     EndpointCursor  = 0;
+
+	#if defined(PERIODIC_PIPE_SCHEDULER)
+	Pipe_UnschedulePeriodicPipe(&HIDInterfaceInfo->State.ReportQueue);
+	#endif
 
 	memset(&HIDInterfaceInfo->State, 0x00, sizeof(HIDInterfaceInfo->State));
 
-	if (DESCRIPTOR_TYPE(ConfigDescriptorData) != DTYPE_Configuration)
+	const USB_ConfigIndex_t* ConfigIndex = USB_GetConfigIndex(ConfigDescriptorSize, ConfigDescriptorData);
+
+	if (!(ConfigIndex))
 	  return HID_ENUMERROR_InvalidConfigDescriptor;
 
 	while (!(DataINEndpoint) || !(DataOUTEndpoint))
 	{
-		if (!(HIDInterface) ||
-		    USB_GetNextDescriptorComp(&ConfigDescriptorSize, &ConfigDescriptorData,
-		                              DCOMP_HID_Host_NextHIDInterfaceEndpoint) != DESCRIPTOR_SEARCH_COMP_Found)
+		USB_Descriptor_Endpoint_t* EndpointData = NULL;
+
+		if (HIDInterface)
+		{
+			EndpointData = USB_ConfigIndex_FindNextEndpoint(ConfigIndex, CurrInterface, &EndpointCursor,
+			                                                DCOMP_HID_Host_NextHIDInterfaceEndpoint);
+		}
+
+		if (!(EndpointData))
 		{
 			if (DataINEndpoint)
 			  break;
 
 			do
 			{
-				if (USB_GetNextDescriptorComp(&ConfigDescriptorSize, &ConfigDescriptorData,
-				                              DCOMP_HID_Host_NextHIDInterface) != DESCRIPTOR_SEARCH_COMP_Found)
+				if ((CurrInterface = USB_ConfigIndex_FindNextInterface(ConfigIndex, CurrInterface,
+				                                                       DCOMP_HID_Host_NextHIDInterface)) == USB_CONFIG_INDEX_NONE)
 				{
 					return HID_ENUMERROR_NoCompatibleInterfaceFound;
 				}
 
-				HIDInterface = DESCRIPTOR_PCAST(ConfigDescriptorData, USB_Descriptor_Interface_t);
+				HIDInterface = USB_ConfigIndex_GetInterface(ConfigIndex, CurrInterface);
 			} while (HIDInterfaceInfo->Config.HIDInterfaceProtocol &&
 					 (HIDInterface->Protocol != HIDInterfaceInfo->Config.HIDInterfaceProtocol));
 
-			if (USB_GetNextDescriptorComp(&ConfigDescriptorSize, &ConfigDescriptorData,
-			                              DCOMP_HID_Host_NextHIDDescriptor) != DESCRIPTOR_SEARCH_COMP_Found)
-			{
-				return HID_ENUMERROR_NoCompatibleInterfaceFound;
-			}
-
-			HIDDescriptor = DESCRIPTOR_PCAST(ConfigDescriptorData, USB_HID_Descriptor_HID_t);
+			if (!(HIDDescriptor = USB_ConfigIndex_FindClassDescriptor(ConfigIndex, CurrInterface, HID_DTYPE_HID)))
+			  return HID_ENUMERROR_NoCompatibleInterfaceFound;
 
 			DataINEndpoint  = NULL;
 			DataOUTEndpoint = NULL;
+			EndpointCursor  = 0;
 
 			continue;
 		}
 
-		USB_Descriptor_Endpoint_t* EndpointData = DESCRIPTOR_PCAST(ConfigDescriptorData, USB_Descriptor_Endpoint_t);
-
 		if ((EndpointData->EndpointAddress & ENDPOINT_DIR_MASK) == ENDPOINT_DIR_IN)
 		  DataINEndpoint  = EndpointData;
 		else
@@ -101,6 +109,22 @@ uint8_t HID_Host_ConfigurePipes(USB_ClassInfo_HID_Host_t* const HIDInterfaceInfo
 	if (!(Pipe_ConfigurePipeTable(&HIDInterfaceInfo->Config.DataINPipe, 1)))
 	  return HID_ENUMERROR_PipeConfigurationFailed;
 
+	#if defined(PERIODIC_PIPE_SCHEDULER)
+	if (HIDInterfaceInfo->Config.ReportQueueBuffer)
+	{
+		Pipe_PeriodicPipe_t* ReportQueue = &HIDInterfaceInfo->State.ReportQueue;
+
+		ReportQueue->Config.PipeAddress = HIDInterfaceInfo->Config.DataINPipe.Address;
+		ReportQueue->Config.Interval    = Pipe_GetPeriodicInterval(EP_TYPE_INTERRUPT, DataINEndpoint->PollingIntervalMS);
+		ReportQueue->Config.PacketSize  = HIDInterfaceInfo->Config.DataINPipe.Size;
+		ReportQueue->Config.QueueBuffer = HIDInterfaceInfo->Config.ReportQueueBuffer;
+		ReportQueue->Config.QueueSize   = HIDInterfaceInfo->Config.ReportQueueSize;
+
+		if (!(Pipe_SchedulePeriodicPipe(ReportQueue)))
+		  return HID_ENUMERROR_PipeConfigurationFailed;
+	}
+	#endif
+
 	if (DataOUTEndpoint)
 	{
 		HIDInterfaceInfo->Config.DataOUTPipe.Size = le16_to_cpu(DataOUTEndpoint->EndpointSize);
@@ -136,18 +160,6 @@ static uint8_t DCOMP_HID_Host_NextHIDInterface(void* const CurrentDescriptor)
 	return DESCRIPTOR_SEARCH_NotFound;
 }
 
-static uint8_t DCOMP_HID_Host_NextHIDDescriptor(void* const CurrentDescriptor)
-{
-	USB_Descriptor_Header_t* Header = DESCRIPTOR_PCAST(CurrentDescriptor, USB_Descriptor_Header_t);
-
-	if (Header->Type == HID_DTYPE_HID)
-	  return DESCRIPTOR_SEARCH_Found;
-	else if (Header->Type == DTYPE_Interface)
-	  return DESCRIPTOR_SEARCH_Fail;
-	else
-	  return DESCRIPTOR_SEARCH_NotFound;
-}
-
 static uint8_t DCOMP_HID_Host_NextHIDInterfaceEndpoint(void* const CurrentDescriptor)
 {
 	USB_Descriptor_Header_t* Header = DESCRIPTOR_PCAST(CurrentDescriptor, USB_Descriptor_Header_t);
@@ -195,6 +207,33 @@ uint8_t HID_Host_ReceiveReport(USB_ClassInfo_HID_Host_t* const HIDInterfaceInfo,
 
 	uint8_t ErrorCode;
 
+	#if defined(PERIODIC_PIPE_SCHEDULER)
+	if (HIDInterfaceInfo->Config.ReportQueueBuffer)
+	{
+		uint16_t TimeoutMSRem        = USB_STREAM_TIMEOUT_MS;
+		uint16_t PreviousFrameNumber = USB_Host_GetFrameNumber();
+
+		while (!(Pipe_IsPeriodicPacketReceived(&HIDInterfaceInfo->State.ReportQueue)))
+		{
+			if (USB_HostState == HOST_STATE_Unattached)
+			  return PIPE_RWSTREAM_DeviceDisconnected;
+
+			uint16_t CurrentFrameNumber = USB_Host_GetFrameNumber();
+
+			if (CurrentFrameNumber != PreviousFrameNumber)
+			{
+				PreviousFrameNumber = CurrentFrameNumber;
+
+				if (!(TimeoutMSRem--))
+				  return PIPE_RWSTREAM_Timeout;
+			}
+		}
+
+		Pipe_ReadPeriodicPacket(&HIDInterfaceInfo->State.ReportQueue, Buffer);
+		return PIPE_RWSTREAM_NoError;
+	}
+	#endif
+
 	Pipe_SelectPipe(HIDInterfaceInfo->Config.DataINPipe.Address);
 	Pipe_Unfreeze();
 
@@ -248,10 +287,13 @@ uint8_t HID_Host_SendReportByID(USB_ClassInfo_HID_Host_t* const HIDInterfaceInfo
 		Pipe_SelectPipe(HIDInterfaceInfo->Config.DataOUTPipe.Address);
 		Pipe_Unfreeze();
 
-		if (ReportID)
-		  Pipe_Write_Stream_LE(&ReportID, sizeof(ReportID), NULL);
+		Pipe_StreamSegment_t ReportSegments[] =
+			{
+				{.Buffer = &ReportID, .Length = (ReportID ? sizeof(ReportID) : 0)},
+				{.Buffer = Buffer,    .Length = ReportSize},
+			};
 
-		if ((ErrorCode = Pipe_Write_Stream_LE(Buffer, ReportSize, NULL)) != PIPE_RWSTREAM_NoError)
+		if ((ErrorCode = Pipe_Write_StreamV(ReportSegments, 2, NULL)) != PIPE_RWSTREAM_NoError)
 		  return ErrorCode;
 
 		Pipe_ClearOUT();
@@ -286,6 +328,11 @@ bool HID_Host_IsReportReceived(USB_ClassInfo_HID_Host_t* const HIDInterfaceInfo)
 	if ((USB_HostState != HOST_STATE_Configured) || !(HIDInterfaceInfo->State.IsActive))
 	  return false;
 
+	#if defined(PERIODIC_PIPE_SCHEDULER)
+	if (HIDInterfaceInfo->Config.ReportQueueBuffer)
+	  return Pipe_IsPeriodicPacketReceived(&HIDInterfaceInfo->State.ReportQueue);
+	#endif
+
 	bool ReportReceived;
 
 	Pipe_SelectPipe(HIDInterfaceInfo->Config.DataINPipe.Address);
@@ -98,6 +98,21 @@
 					                                  *        this field is unavailable.
 					                                  */
 					#endif
+
+					#if defined(PERIODIC_PIPE_SCHEDULER) || defined(__DOXYGEN__)
+					uint8_t* ReportQueueBuffer; /**< Optional buffer used to queue received IN reports when the data IN pipe is
+					                             *   polled by the periodic pipe scheduler at the device's endpoint interval, or
+					                             *   \c NULL to poll the pipe directly from \ref HID_Host_IsReportReceived().
+					                             *
+					                             *  \note This field is only available when the \c PERIODIC_PIPE_SCHEDULER compile
+					                             *        time token is defined.
+					                             */
+					uint16_t ReportQueueSize; /**< Size of the report queue buffer in bytes, see \ref PIPE_PERIODIC_QUEUE_SIZE().
+					                           *
+					                           *  \note This field is only available when the \c PERIODIC_PIPE_SCHEDULER compile
+					                           *        time token is defined.
+					                           */
+					#endif
 				} Config; /**< Config data for the USB class interface within the device. All elements in this section
 				           *   <b>must</b> be set or the interface will fail to enumerate and operate correctly.
 				           */
@@ -119,6 +134,12 @@
 					uint16_t HIDReportSize; /**< Size in bytes of the HID report descriptor in the device. */
 
 					uint8_t LargestReportSize; /**< Largest report the device will send, in bytes. */
+
+					#if defined(PERIODIC_PIPE_SCHEDULER) || defined(__DOXYGEN__)
+					Pipe_PeriodicPipe_t ReportQueue; /**< Periodic pipe scheduler entry for the data IN pipe, used when a report
+					                                  *   queue buffer is set in the interface's configuration.
+					                                  */
+					#endif
 				} State; /**< State data for the USB class interface within the device. All elements in this section
 				          *   <b>may</b> be set to initial values, but may also be ignored to default to sane values when
 				          *   the interface is enumerated.
@@ -164,6 +185,9 @@
 			 *  \attention The destination buffer should be large enough to accommodate the largest report that the attached device
 			 *             can generate.
 			 *
+			 *  \note When the data IN pipe is polled by the periodic pipe scheduler, the oldest queued report is returned, and the
+			 *        destination buffer must be at least as large as the data IN pipe's endpoint size.
+			 *
 			 *  \param[in,out] HIDInterfaceInfo  Pointer to a structure containing a HID Class host configuration and state.
 			 *  \param[in]     Buffer            Buffer to store the received report into.
 			 *
@@ -222,7 +246,9 @@
 			                                ATTR_NON_NULL_PTR_ARG(3);
 			#endif
 
-			/** Determines if a HID IN report has been received from the attached device on the data IN pipe.
+			/** Determines if a HID IN report has been received from the attached device on the data IN pipe. When a report
+			 *  queue buffer is set in the interface's configuration and the \c PERIODIC_PIPE_SCHEDULER compile time token is
+			 *  defined, this instead determines if a report is waiting in the queue filled by the periodic pipe scheduler.
 			 *
 			 *  \pre This function must only be called when the Host state machine is in the \ref HOST_STATE_Configured state or the
 			 *       call will fail.
@@ -295,8 +321,6 @@
 			#if defined(__INCLUDE_FROM_HID_HOST_C)
 				static uint8_t DCOMP_HID_Host_NextHIDInterface(void* const CurrentDescriptor)
 				                                               ATTR_WARN_UNUSED_RESULT ATTR_NON_NULL_PTR_ARG(1);
-				static uint8_t DCOMP_HID_Host_NextHIDDescriptor(void* const CurrentDescriptor)
-				                                                ATTR_WARN_UNUSED_RESULT ATTR_NON_NULL_PTR_ARG(1);
 				static uint8_t DCOMP_HID_Host_NextHIDInterfaceEndpoint(void* const CurrentDescriptor)
 				                                                       ATTR_WARN_UNUSED_RESULT ATTR_NON_NULL_PTR_ARG(1);
 			#endif
@@ -44,34 +44,43 @@ uint8_t MIDI_Host_ConfigurePipes(USB_ClassInfo_MIDI_Host_t* const MIDIInterfaceI
 	USB_Descriptor_Endpoint_t*  DataINEndpoint  = NULL;
 	USB_Descriptor_Endpoint_t*  DataOUTEndpoint = NULL;
 	USB_Descriptor_Interface_t* MIDIInterface   = NULL;
+	uint8_t                     CurrInterface   = USB_CONFIG_INDEX_NONE;
+	uint8_t                     EndpointCursor  = 0;
 
 	memset(&MIDIInterfaceInfo->State, 0x00, sizeof(MIDIInterfaceInfo->State));
 
-	if (DESCRIPTOR_TYPE(ConfigDescriptorData) != DTYPE_Configuration)
+	const USB_ConfigIndex_t* ConfigIndex = USB_GetConfigIndex(ConfigDescriptorSize, ConfigDescriptorData);
+
+	if (!(ConfigIndex))
 	  return MIDI_ENUMERROR_InvalidConfigDescriptor;
 
 	while (!(DataINEndpoint) || !(DataOUTEndpoint))
 	{
-		if (!(MIDIInterface) ||
-		    USB_GetNextDescriptorComp(&ConfigDescriptorSize, &ConfigDescriptorData,
-		                              DCOMP_MIDI_Host_NextMIDIStreamingDataEndpoint) != DESCRIPTOR_SEARCH_COMP_Found)
+		USB_Descriptor_Endpoint_t* EndpointData = NULL;
+
+		if (MIDIInterface)
+		{
+			EndpointData = USB_ConfigIndex_FindNextEndpoint(ConfigIndex, CurrInterface, &EndpointCursor,
+			                                                DCOMP_MIDI_Host_NextMIDIStreamingDataEndpoint);
+		}
+
+		if (!(EndpointData))
 		{
-			if (USB_GetNextDescriptorComp(&ConfigDescriptorSize, &ConfigDescriptorData,
-			                              DCOMP_MIDI_Host_NextMIDIStreamingInterface) != DESCRIPTOR_SEARCH_COMP_Found)
+			if ((CurrInterface = USB_ConfigIndex_FindNextInterface(ConfigIndex, CurrInterface,
+			                                                       DCOMP_MIDI_Host_NextMIDIStreamingInterface)) == USB_CONFIG_INDEX_NONE)
 			{
 				return MIDI_ENUMERROR_NoCompatibleInterfaceFound;
 			}
 
-			MIDIInterface = DESCRIPTOR_PCAST(ConfigDescriptorData, USB_Descriptor_Interface_t);
+			MIDIInterface = USB_ConfigIndex_GetInterface(ConfigIndex, CurrInterface);
 
 			DataINEndpoint  = NULL;
 			DataOUTEndpoint = NULL;
+			EndpointCursor  = 0;
 
 			continue;
 		}
 
-		USB_Descriptor_Endpoint_t* EndpointData = DESCRIPTOR_PCAST(ConfigDescriptorData, USB_Descriptor_Endpoint_t);
-
 		if ((EndpointData->EndpointAddress & ENDPOINT_DIR_MASK) == ENDPOINT_DIR_IN)
 		  DataINEndpoint  = EndpointData;
 		else
@@ -44,34 +44,43 @@ uint8_t MS_Host_ConfigurePipes(USB_ClassInfo_MS_Host_t* const MSInterfaceInfo,
 	USB_Descriptor_Endpoint_t*  DataINEndpoint       = NULL;
 	USB_Descriptor_Endpoint_t*  DataOUTEndpoint      = NULL;
 	USB_Descriptor_Interface_t* MassStorageInterface = NULL;
+	uint8_t                     CurrInterface        = USB_CONFIG_INDEX_NONE;
+	uint8_t                     EndpointCursor       = 0;
 
 	memset(&MSInterfaceInfo->State, 0x00, sizeof(MSInterfaceInfo->State));
 
-	if (DESCRIPTOR_TYPE(ConfigDescriptorData) != DTYPE_Configuration)
+	const USB_ConfigIndex_t* ConfigIndex = USB_GetConfigIndex(ConfigDescriptorSize, ConfigDescriptorData);
+
+	if (!(ConfigIndex))
 	  return MS_ENUMERROR_InvalidConfigDescriptor;
 
 	while (!(DataINEndpoint) || !(DataOUTEndpoint))
 	{
-		if (!(MassStorageInterface) ||
-		    USB_GetNextDescriptorComp(&ConfigDescriptorSize, &ConfigDescriptorData,
-		                              DCOMP_MS_Host_NextMSInterfaceEndpoint) != DESCRIPTOR_SEARCH_COMP_Found)
+		USB_Descriptor_Endpoint_t* EndpointData = NULL;
+
+		if (MassStorageInterface)
+		{
+			EndpointData = USB_ConfigIndex_FindNextEndpoint(ConfigIndex, CurrInterface, &EndpointCursor,
+			                                                DCOMP_MS_Host_NextMSInterfaceEndpoint);
+		}
+
+		if (!(EndpointData))
 		{
-			if (USB_GetNextDescriptorComp(&ConfigDescriptorSize, &ConfigDescriptorData,
-			                              DCOMP_MS_Host_NextMSInterface) != DESCRIPTOR_SEARCH_COMP_Found)
+			if ((CurrInterface = USB_ConfigIndex_FindNextInterface(ConfigIndex, CurrInterface,
+			                                                       DCOMP_MS_Host_NextMSInterface)) == USB_CONFIG_INDEX_NONE)
 			{
 				return MS_ENUMERROR_NoCompatibleInterfaceFound;
 			}
 
-			MassStorageInterface = DESCRIPTOR_PCAST(ConfigDescriptorData, USB_Descriptor_Interface_t);
+			MassStorageInterface = USB_ConfigIndex_GetInterface(ConfigIndex, CurrInterface);
 
 			DataINEndpoint  = NULL;
 			DataOUTEndpoint = NULL;
+			EndpointCursor  = 0;
 
 			continue;
 		}
 
-		USB_Descriptor_Endpoint_t* EndpointData = DESCRIPTOR_PCAST(ConfigDescriptorData, USB_Descriptor_Endpoint_t);
-
 		if ((EndpointData->EndpointAddress & ENDPOINT_DIR_MASK) == ENDPOINT_DIR_IN)
 		  DataINEndpoint  = EndpointData;
 		else
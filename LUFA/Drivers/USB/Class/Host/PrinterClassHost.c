@@ -44,34 +44,43 @@ uint8_t PRNT_Host_ConfigurePipes(USB_ClassInfo_PRNT_Host_t* const PRNTInterfaceI
 	USB_Descriptor_Endpoint_t*  DataINEndpoint   = NULL;
 	USB_Descriptor_Endpoint_t*  DataOUTEndpoint  = NULL;
 	USB_Descriptor_Interface_t* PrinterInterface = NULL;
+	uint8_t                     CurrInterface    = USB_CONFIG_INDEX_NONE;
+	uint8_t                     EndpointCursor   = 0;
 
 	memset(&PRNTInterfaceInfo->State, 0x00, sizeof(PRNTInterfaceInfo->State));
 
-	if (DESCRIPTOR_TYPE(ConfigDescriptorData) != DTYPE_Configuration)
+	const USB_ConfigIndex_t* ConfigIndex = USB_GetConfigIndex(ConfigDescriptorSize, ConfigDescriptorData);
+
+	if (!(ConfigIndex))
 	  return PRNT_ENUMERROR_InvalidConfigDescriptor;
 
 	while (!(DataINEndpoint) || !(DataOUTEndpoint))
 	{
-		if (!(PrinterInterface) ||
-		    USB_GetNextDescriptorComp(&ConfigDescriptorSize, &ConfigDescriptorData,
-		                              DCOMP_PRNT_Host_NextPRNTInterfaceEndpoint) != DESCRIPTOR_SEARCH_COMP_Found)
+		USB_Descriptor_Endpoint_t* EndpointData = NULL;
+
+		if (PrinterInterface)
+		{
+			EndpointData = USB_ConfigIndex_FindNextEndpoint(ConfigIndex, CurrInterface, &EndpointCursor,
+			                                                DCOMP_PRNT_Host_NextPRNTInterfaceEndpoint);
+		}
+
+		if (!(EndpointData))
 		{
-			if (USB_GetNextDescriptorComp(&ConfigDescriptorSize, &ConfigDescriptorData,
-			                              DCOMP_PRNT_Host_NextPRNTInterface) != DESCRIPTOR_SEARCH_COMP_Found)
+			if ((CurrInterface = USB_ConfigIndex_FindNextInterface(ConfigIndex, CurrInterface,
+			                                                       DCOMP_PRNT_Host_NextPRNTInterface)) == USB_CONFIG_INDEX_NONE)
 			{
 				return PRNT_ENUMERROR_NoCompatibleInterfaceFound;
 			}
 
-			PrinterInterface = DESCRIPTOR_PCAST(ConfigDescriptorData, USB_Descriptor_Interface_t);
+			PrinterInterface = USB_ConfigIndex_GetInterface(ConfigIndex, CurrInterface);
 
 			DataINEndpoint  = NULL;
 			DataOUTEndpoint = NULL;
+			EndpointCursor  = 0;
 
 			continue;
 		}
 
-		USB_Descriptor_Endpoint_t* EndpointData = DESCRIPTOR_PCAST(ConfigDescriptorData, USB_Descriptor_Endpoint_t);
-
 		if ((EndpointData->EndpointAddress & ENDPOINT_DIR_MASK) == ENDPOINT_DIR_IN)
 		  DataINEndpoint  = EndpointData;
 		else
@@ -45,24 +45,32 @@ uint8_t RNDIS_Host_ConfigurePipes(USB_ClassInfo_RNDIS_Host_t* const RNDISInterfa
 	USB_Descriptor_Endpoint_t*  DataOUTEndpoint       = NULL;
 	USB_Descriptor_Endpoint_t*  NotificationEndpoint  = NULL;
 	USB_Descriptor_Interface_t* RNDISControlInterface = NULL;
+	uint8_t                     CurrInterface         = USB_CONFIG_INDEX_NONE;
+	uint8_t                     EndpointCursor        = 0;
 
 	memset(&RNDISInterfaceInfo->State, 0x00, sizeof(RNDISInterfaceInfo->State));
 
-	if (DESCRIPTOR_TYPE(ConfigDescriptorData) != DTYPE_Configuration)
-	  return RNDIS_ENUMERROR_InvalidConfigDescriptor;
+	const USB_ConfigIndex_t* ConfigIndex = USB_GetConfigIndex(ConfigDescriptorSize, ConfigDescriptorData);
 
-	RNDISControlInterface = DESCRIPTOR_PCAST(ConfigDescriptorData, USB_Descriptor_Interface_t);
+	if (!(ConfigIndex))
+	  return RNDIS_ENUMERROR_InvalidConfigDescriptor;
 
 	while (!(DataINEndpoint) || !(DataOUTEndpoint) || !(NotificationEndpoint))
 	{
-		if (!(RNDISControlInterface) ||
-		    USB_GetNextDescriptorComp(&ConfigDescriptorSize, &ConfigDescriptorData,
-		                              DCOMP_RNDIS_Host_NextRNDISInterfaceEndpoint) != DESCRIPTOR_SEARCH_COMP_Found)
+		USB_Descriptor_Endpoint_t* EndpointData = NULL;
+
+		if (RNDISControlInterface)
+		{
+			EndpointData = USB_ConfigIndex_FindNextEndpoint(ConfigIndex, CurrInterface, &EndpointCursor,
+			                                                DCOMP_RNDIS_Host_NextRNDISInterfaceEndpoint);
+		}
+
+		if (!(EndpointData))
 		{
 			if (NotificationEndpoint)
 			{
-				if (USB_GetNextDescriptorComp(&ConfigDescriptorSize, &ConfigDescriptorData,
-											  DCOMP_RNDIS_Host_NextRNDISDataInterface) != DESCRIPTOR_SEARCH_COMP_Found)
+				if ((CurrInterface = USB_ConfigIndex_FindNextInterface(ConfigIndex, CurrInterface,
+				                                                       DCOMP_RNDIS_Host_NextRNDISDataInterface)) == USB_CONFIG_INDEX_NONE)
 				{
 					return RNDIS_ENUMERROR_NoCompatibleInterfaceFound;
 				}
@@ -72,22 +80,21 @@ uint8_t RNDIS_Host_ConfigurePipes(USB_ClassInfo_RNDIS_Host_t* const RNDISInterfa
 			}
 			else
 			{
-				if (USB_GetNextDescriptorComp(&ConfigDescriptorSize, &ConfigDescriptorData,
-											  DCOMP_RNDIS_Host_NextRNDISControlInterface) != DESCRIPTOR_SEARCH_COMP_Found)
+				if ((CurrInterface = USB_ConfigIndex_FindNextInterface(ConfigIndex, CurrInterface,
+				                                                       DCOMP_RNDIS_Host_NextRNDISControlInterface)) == USB_CONFIG_INDEX_NONE)
 				{
 					return RNDIS_ENUMERROR_NoCompatibleInterfaceFound;
 				}
 
-				RNDISControlInterface = DESCRIPTOR_PCAST(ConfigDescriptorData, USB_Descriptor_Interface_t);
+				RNDISControlInterface = USB_ConfigIndex_GetInterface(ConfigIndex, CurrInterface);
 
 				NotificationEndpoint = NULL;
 			}
 
+			EndpointCursor = 0;
 			continue;
 		}
 
-		USB_Descriptor_Endpoint_t* EndpointData = DESCRIPTOR_PCAST(ConfigDescriptorData, USB_Descriptor_Endpoint_t);
-
 		if ((EndpointData->EndpointAddress & ENDPOINT_DIR_MASK) == ENDPOINT_DIR_IN)
 		{
 			if ((EndpointData->Attributes & EP_TYPE_MASK) == EP_TYPE_INTERRUPT)
@@ -458,13 +465,15 @@ uint8_t RNDIS_Host_SendPacket(USB_ClassInfo_RNDIS_Host_t* const RNDISInterfaceIn
 	Pipe_SelectPipe(RNDISInterfaceInfo->Config.DataOUTPipe.Address);
 	Pipe_Unfreeze();
 
-	if ((ErrorCode = Pipe_Write_Stream_LE(&DeviceMessage, sizeof(RNDIS_Packet_Message_t),
-	                                      NULL)) != PIPE_RWSTREAM_NoError)
-	{
-		return ErrorCode;
-	}
+	Pipe_StreamSegment_t PacketSegments[] =
+		{
+			{.Buffer = &DeviceMessage, .Length = sizeof(RNDIS_Packet_Message_t)},
+			{.Buffer = Buffer,         .Length = PacketLength},
+		};
+
+	if ((ErrorCode = Pipe_Write_StreamV(PacketSegments, 2, NULL)) != PIPE_RWSTREAM_NoError)
+	  return ErrorCode;
 
-	Pipe_Write_Stream_LE(Buffer, PacketLength, NULL);
 	Pipe_ClearOUT();
 
 	Pipe_Freeze();
@@ -45,35 +45,44 @@ uint8_t SI_Host_ConfigurePipes(USB_ClassInfo_SI_Host_t* const SIInterfaceInfo,
 	USB_Descriptor_Endpoint_t*  DataOUTEndpoint     = NULL;
 	USB_Descriptor_Endpoint_t*  EventsEndpoint      = NULL;
 	USB_Descriptor_Interface_t* StillImageInterface = NULL;
+	uint8_t                     CurrInterface       = USB_CONFIG_INDEX_NONE;
+	uint8_t                     EndpointCursor      = 0;
 
 	memset(&SIInterfaceInfo->State, 0x00, sizeof(SIInterfaceInfo->State));
 
-	if (DESCRIPTOR_TYPE(ConfigDescriptorData) != DTYPE_Configuration)
+	const USB_ConfigIndex_t* ConfigIndex = USB_GetConfigIndex(ConfigDescriptorSize, ConfigDescriptorData);
+
+	if (!(ConfigIndex))
 	  return SI_ENUMERROR_InvalidConfigDescriptor;
 
 	while (!(DataINEndpoint) || !(DataOUTEndpoint) || !(EventsEndpoint))
 	{
-		if (!(StillImageInterface) ||
-		    USB_GetNextDescriptorComp(&ConfigDescriptorSize, &ConfigDescriptorData,
-		                              DCOMP_SI_Host_NextSIInterfaceEndpoint) != DESCRIPTOR_SEARCH_COMP_Found)
+		USB_Descriptor_Endpoint_t* EndpointData = NULL;
+
+		if (StillImageInterface)
 		{
-			if (USB_GetNextDescriptorComp(&ConfigDescriptorSize, &ConfigDescriptorData,
-			                              DCOMP_SI_Host_NextSIInterface) != DESCRIPTOR_SEARCH_COMP_Found)
+			EndpointData = USB_ConfigIndex_FindNextEndpoint(ConfigIndex, CurrInterface, &EndpointCursor,
+			                                                DCOMP_SI_Host_NextSIInterfaceEndpoint);
+		}
+
+		if (!(EndpointData))
+		{
+			if ((CurrInterface = USB_ConfigIndex_FindNextInterface(ConfigIndex, CurrInterface,
+			                                                       DCOMP_SI_Host_NextSIInterface)) == USB_CONFIG_INDEX_NONE)
 			{
 				return SI_ENUMERROR_NoCompatibleInterfaceFound;
 			}
 
-			StillImageInterface = DESCRIPTOR_PCAST(ConfigDescriptorData, USB_Descriptor_Interface_t);
+			StillImageInterface = USB_ConfigIndex_GetInterface(ConfigIndex, CurrInterface);
 
 			DataINEndpoint  = NULL;
 			DataOUTEndpoint = NULL;
 			EventsEndpoint  = NULL;
+			EndpointCursor  = 0;
 
 			continue;
 		}
 
-		USB_Descriptor_Endpoint_t* EndpointData = DESCRIPTOR_PCAST(ConfigDescriptorData, USB_Descriptor_Endpoint_t);
-
 		if ((EndpointData->EndpointAddress & ENDPOINT_DIR_MASK) == ENDPOINT_DIR_IN)
 		{
 			if ((EndpointData->Attributes & EP_TYPE_MASK) == EP_TYPE_INTERRUPT)
@@ -171,16 +180,16 @@ uint8_t SI_Host_SendBlockHeader(USB_ClassInfo_SI_Host_t* const SIInterfaceInfo,
 	Pipe_SelectPipe(SIInterfaceInfo->Config.DataOUTPipe.Address);
 	Pipe_Unfreeze();
 
-	if ((ErrorCode = Pipe_Write_Stream_LE(PIMAHeader, PIMA_COMMAND_SIZE(0), NULL)) != PIPE_RWSTREAM_NoError)
-	  return ErrorCode;
-
 	uint8_t ParamBytes = (PIMAHeader->DataLength - PIMA_COMMAND_SIZE(0));
 
-	if (ParamBytes)
-	{
-		if ((ErrorCode = Pipe_Write_Stream_LE(&PIMAHeader->Params, ParamBytes, NULL)) != PIPE_RWSTREAM_NoError)
-		  return ErrorCode;
-	}
+	Pipe_StreamSegment_t HeaderSegments[] =
+		{
+			{.Buffer = PIMAHeader,          .Length = PIMA_COMMAND_SIZE(0)},
+			{.Buffer = &PIMAHeader->Params, .Length = ParamBytes},
+		};
+
+	if ((ErrorCode = Pipe_Write_StreamV(HeaderSegments, 2, NULL)) != PIPE_RWSTREAM_NoError)
+	  return ErrorCode;
 
 	Pipe_ClearOUT();
 	Pipe_Freeze();
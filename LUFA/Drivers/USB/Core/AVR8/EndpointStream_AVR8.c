@@ -204,6 +204,16 @@ uint8_t Endpoint_Null_Stream(uint16_t Length,
 	#include "Template/Template_Endpoint_RW.c"
 #endif
 
+#define  TEMPLATE_FUNC_NAME                        Endpoint_Write_StreamV
+#define  TEMPLATE_SEGMENT_TYPE                     Endpoint_StreamSegment_t
+#define  TEMPLATE_SEGMENT_FLASH                    ENDPOINT_SEGMENT_FLASH
+#define  TEMPLATE_SEGMENT_EEPROM                   ENDPOINT_SEGMENT_EEPROM
+#define  TEMPLATE_NO_ERROR                         ENDPOINT_RWSTREAM_NoError
+#define  TEMPLATE_WRITE_STREAM                     Endpoint_Write_Stream_LE
+#define  TEMPLATE_WRITE_PSTREAM                    Endpoint_Write_PStream_LE
+#define  TEMPLATE_WRITE_ESTREAM                    Endpoint_Write_EStream_LE
+#include "../Template/Template_Write_StreamV.c"
+
 #endif
 
 #define  TEMPLATE_FUNC_NAME                        Endpoint_Write_Control_Stream_LE
@@ -270,6 +280,162 @@ uint8_t Endpoint_Null_Stream(uint16_t Length,
 	#include "Template/Template_Endpoint_Control_R.c"
 #endif
 
+#if defined(ASYNC_ENDPOINT_TRANSFERS) && !defined(CONTROL_ONLY_DEVICE)
+static Endpoint_Transfer_t Endpoint_Transfers[ENDPOINT_TOTAL_ENDPOINTS];
+
+static void Endpoint_CompleteTransfer(Endpoint_Transfer_t* const Transfer,
+                                      const uint8_t ErrorCode)
+{
+	uint8_t                     Address  = Transfer->Address;
+	Endpoint_TransferCallback_t Callback = Transfer->Callback;
+
+	UEIENX &= ~((1 << TXINE) | (1 << RXOUTE));
+	Transfer->Address = 0;
+
+	if (Callback != NULL)
+	  Callback(Address, Transfer->BytesTransferred, ErrorCode);
+}
+
+static void Endpoint_ServiceINTransfer(Endpoint_Transfer_t* const Transfer)
+{
+	while (Endpoint_IsINReady())
+	{
+		uint16_t BankLength = MIN(Endpoint_BytesRemainingInBank(), Transfer->BytesRemaining);
+		uint8_t* BufferPtr  = Transfer->BufferPtr;
+
+		Transfer->BufferPtr        += BankLength;
+		Transfer->BytesRemaining   -= BankLength;
+		Transfer->BytesTransferred += BankLength;
+
+		while (BankLength--)
+		  Endpoint_Write_8(*(BufferPtr++));
+
+		Endpoint_ClearIN();
+
+		if (!(Transfer->BytesRemaining))
+		{
+			Endpoint_CompleteTransfer(Transfer, ENDPOINT_RWSTREAM_NoError);
+			return;
+		}
+	}
+}
+
+static void Endpoint_ServiceOUTTransfer(Endpoint_Transfer_t* const Transfer)
+{
+	uint16_t BankSize = (8 << ((UECFG1X >> EPSIZE0) & 0x07));
+
+	while (Endpoint_IsOUTReceived())
+	{
+		uint16_t PacketLength = Endpoint_BytesInEndpoint();
+		uint16_t BankLength   = MIN(PacketLength, Transfer->BytesRemaining);
+		uint8_t* BufferPtr    = Transfer->BufferPtr;
+
+		Transfer->BufferPtr        += BankLength;
+		Transfer->BytesRemaining   -= BankLength;
+		Transfer->BytesTransferred += BankLength;
+
+		while (BankLength--)
+		  *(BufferPtr++) = Endpoint_Read_8();
+
+		Endpoint_ClearOUT();
+
+		if (!(Transfer->BytesRemaining) || (PacketLength < BankSize))
+		{
+			Endpoint_CompleteTransfer(Transfer, ENDPOINT_RWSTREAM_NoError);
+			return;
+		}
+	}
+}
+
+bool Endpoint_SubmitTransfer(const uint8_t Address,
+                             void* const Buffer,
+                             const uint16_t Length,
+                             const Endpoint_TransferCallback_t Callback)
+{
+	Endpoint_Transfer_t* Transfer = &Endpoint_Transfers[Address & ENDPOINT_EPNUM_MASK];
+
+	uint_reg_t CurrentGlobalInt = GetGlobalInterruptMask();
+	GlobalInterruptDisable();
+
+	if (Transfer->Address)
+	{
+		SetGlobalInterruptMask(CurrentGlobalInt);
+		return false;
+	}
+
+	Transfer->BufferPtr        = (uint8_t*)Buffer;
+	Transfer->BytesRemaining   = Length;
+	Transfer->BytesTransferred = 0;
+	Transfer->Callback         = Callback;
+	Transfer->Address          = Address;
+
+	uint8_t PrevSelectedEndpoint = Endpoint_GetCurrentEndpoint();
+
+	Endpoint_SelectEndpoint(Address);
+	UEIENX |= (Address & ENDPOINT_DIR_IN) ? (1 << TXINE) : (1 << RXOUTE);
+	Endpoint_SelectEndpoint(PrevSelectedEndpoint);
+
+	SetGlobalInterruptMask(CurrentGlobalInt);
+	return true;
+}
+
+bool Endpoint_IsTransferPending(const uint8_t Address)
+{
+	return (Endpoint_Transfers[Address & ENDPOINT_EPNUM_MASK].Address ? true : false);
+}
+
+uint16_t Endpoint_AbortTransfer(const uint8_t Address)
+{
+	Endpoint_Transfer_t* Transfer = &Endpoint_Transfers[Address & ENDPOINT_EPNUM_MASK];
+
+	uint_reg_t CurrentGlobalInt = GetGlobalInterruptMask();
+	GlobalInterruptDisable();
+
+	uint8_t PrevSelectedEndpoint = Endpoint_GetCurrentEndpoint();
+
+	Endpoint_SelectEndpoint(Address);
+	UEIENX &= ~((1 << TXINE) | (1 << RXOUTE));
+	Endpoint_SelectEndpoint(PrevSelectedEndpoint);
+
+	Transfer->Address = 0;
+
+	SetGlobalInterruptMask(CurrentGlobalInt);
+	return Transfer->BytesTransferred;
+}
+
+void Endpoint_ServiceTransfers(void)
+{
+	for (uint8_t EPNum = 1; EPNum < ENDPOINT_TOTAL_ENDPOINTS; EPNum++)
+	{
+		Endpoint_Transfer_t* Transfer = &Endpoint_Transfers[EPNum];
+
+		if (!(Transfer->Address) || !(Endpoint_HasEndpointInterrupted(EPNum)))
+		  continue;
+
+		Endpoint_SelectEndpoint(Transfer->Address);
+
+		if (Transfer->Address & ENDPOINT_DIR_IN)
+		  Endpoint_ServiceINTransfer(Transfer);
+		else
+		  Endpoint_ServiceOUTTransfer(Transfer);
+	}
+}
+
+void Endpoint_CancelTransfers(void)
+{
+	for (uint8_t EPNum = 1; EPNum < ENDPOINT_TOTAL_ENDPOINTS; EPNum++)
+	{
+		Endpoint_Transfer_t* Transfer = &Endpoint_Transfers[EPNum];
+
+		if (!(Transfer->Address))
+		  continue;
+
+		Endpoint_SelectEndpoint(Transfer->Address);
+		Endpoint_CompleteTransfer(Transfer, ENDPOINT_RWSTREAM_DeviceDisconnected);
+	}
+}
+#endif
+
 #endif
 
 #endif
@@ -427,6 +427,50 @@
 			                                        uint16_t Length) ATTR_NON_NULL_PTR_ARG(1);
 			//@}
 
+			/** \name Scatter-gather stream functions */
+			//@{
+
+			/** Writes the given list of source data segments to the currently selected endpoint as a single continuous
+			 *  stream, in little endian byte order. The segments are packed back to back into the endpoint banks without
+			 *  an intermediate copy and without waiting for the endpoint to become ready between segments, so that a
+			 *  header and payload held in separate buffers are sent in as few packets as possible. Each segment may
+			 *  reside in any of the memory spaces supported by the architecture, as indicated by its \c MemorySpace field.
+			 *
+			 *  If the BytesProcessed parameter is \c NULL, the entire stream transfer is attempted at once, failing or
+			 *  succeeding as a single unit. Otherwise the transfer is performed as a series of chunks in the same manner
+			 *  as \ref Endpoint_Write_Stream_LE(), with BytesProcessed tracking the total number of bytes written across
+			 *  all segments.
+			 *
+			 *  As with the other stream functions, the last packet is not automatically sent once the final segment has
+			 *  been written; the user is responsible for manually sending the last written packet to the host via the
+			 *  \ref Endpoint_ClearIN() macro.
+			 *
+			 *  <b>Example Usage:</b>
+			 *  \code
+			 *  Endpoint_StreamSegment_t Segments[] =
+			 *      {
+			 *          {.Buffer = &Header, .Length = sizeof(Header)},
+			 *          {.Buffer = Payload, .Length = PayloadLength},
+			 *      };
+			 *
+			 *  if (Endpoint_Write_StreamV(Segments, 2, NULL) == ENDPOINT_RWSTREAM_NoError)
+			 *    Endpoint_ClearIN();
+			 *  \endcode
+			 *
+			 *  \note This routine should not be used on CONTROL type endpoints.
+			 *
+			 *  \param[in] Segments        Pointer to an array of source data segments to write.
+			 *  \param[in] TotalSegments   Number of segments in the array.
+			 *  \param[in] BytesProcessed  Pointer to a location where the total number of bytes processed in the current
+			 *                             transaction should be updated, \c NULL if the entire stream should be written at once.
+			 *
+			 *  \return A value from the \ref Endpoint_Stream_RW_ErrorCodes_t enum.
+			 */
+			uint8_t Endpoint_Write_StreamV(const Endpoint_StreamSegment_t* const Segments,
+			                               const uint8_t TotalSegments,
+			                               uint16_t* const BytesProcessed) ATTR_NON_NULL_PTR_ARG(1);
+			//@}
+
 			/** \name Stream functions for EEPROM source/destination data */
 			//@{
 
@@ -647,6 +691,112 @@
 			                                          uint16_t Length) ATTR_NON_NULL_PTR_ARG(1);
 			//@}
 
+	#if (defined(ASYNC_ENDPOINT_TRANSFERS) && !defined(CONTROL_ONLY_DEVICE)) || defined(__DOXYGEN__)
+	/* Public Interface - May be used in end-application: */
+		/* Type Defines: */
+			/** Type define for an asynchronous endpoint transfer completion callback, registered via
+			 *  \ref Endpoint_SubmitTransfer(). The callback is executed from within the USB controller's endpoint
+			 *  interrupt once the transfer has completed or has been cancelled, and should therefore be kept short.
+			 *
+			 *  \param[in] Address           Address of the endpoint whose transfer has completed.
+			 *  \param[in] BytesTransferred  Total number of bytes transferred to or from the user buffer.
+			 *  \param[in] ErrorCode         A value from the \ref Endpoint_Stream_RW_ErrorCodes_t enum.
+			 */
+			typedef void (*Endpoint_TransferCallback_t)(const uint8_t Address,
+			                                            const uint16_t BytesTransferred,
+			                                            const uint8_t ErrorCode);
+
+		/* Function Prototypes: */
+			/** \name Asynchronous transfer functions */
+			//@{
+
+			/** Queues a buffer for transmission to (IN endpoints) or reception from (OUT endpoints) the host on the
+			 *  given endpoint, without blocking. The endpoint banks are filled or drained from within the USB
+			 *  controller's endpoint interrupt as each bank becomes available, leaving the main application free to
+			 *  perform other tasks while the transfer is in progress. Only a single transfer may be pending on each
+			 *  endpoint at any one time; the completion callback may submit the next transfer on the same endpoint.
+			 *
+			 *  IN transfers complete once the last byte has been handed to the USB controller, with the final
+			 *  (possibly partially filled) bank being sent automatically. A zero length IN transfer sends a single
+			 *  zero length packet. OUT transfers complete once the given number of bytes have been received, or once
+			 *  a short packet is received from the host. Any bytes of the final packet which do not fit into the user
+			 *  buffer are discarded, thus OUT transfer lengths should be a multiple of the endpoint bank size.
+			 *
+			 *  <b>Example Usage:</b>
+			 *  \code
+			 *  static uint8_t Buffer[64];
+			 *
+			 *  static void OUTTransferComplete(const uint8_t Address,
+			 *                                  const uint16_t BytesTransferred,
+			 *                                  const uint8_t ErrorCode)
+			 *  {
+			 *      if (ErrorCode == ENDPOINT_RWSTREAM_NoError)
+			 *        Endpoint_SubmitTransfer(Address, Buffer, sizeof(Buffer), OUTTransferComplete);
+			 *  }
+			 *
+			 *  // Start the first transfer once the endpoint has been configured
+			 *  Endpoint_SubmitTransfer(OUT_EPADDR, Buffer, sizeof(Buffer), OUTTransferComplete);
+			 *  \endcode
+			 *
+			 *  \note This routine should not be used on CONTROL type endpoints. The buffer must remain valid and
+			 *        untouched by the application until the transfer has completed or has been aborted.
+			 *        \n\n
+			 *
+			 *  \note Pending transfers are cancelled with an error code of \ref ENDPOINT_RWSTREAM_DeviceDisconnected
+			 *        when the device endpoints are reset due to a bus reset or disconnection. The completion callback
+			 *        must not resubmit a transfer in this case; new transfers should instead be submitted once the
+			 *        endpoints have been reconfigured.
+			 *
+			 *  \param[in] Address   Address of the configured endpoint to transfer data on.
+			 *  \param[in] Buffer    Pointer to the source (IN) or destination (OUT) data buffer.
+			 *  \param[in] Length    Number of bytes to transfer.
+			 *  \param[in] Callback  Function to call once the transfer completes, or \c NULL if not required.
+			 *
+			 *  \return Boolean \c true if the transfer was queued, \c false if a transfer is already pending on the endpoint.
+			 */
+			bool Endpoint_SubmitTransfer(const uint8_t Address,
+			                             void* const Buffer,
+			                             const uint16_t Length,
+			                             const Endpoint_TransferCallback_t Callback);
+
+			/** Determines if an asynchronous transfer queued via \ref Endpoint_SubmitTransfer() is still pending on
+			 *  the given endpoint.
+			 *
+			 *  \param[in] Address  Address of the endpoint to check.
+			 *
+			 *  \return Boolean \c true if a transfer is pending on the endpoint, \c false otherwise.
+			 */
+			bool Endpoint_IsTransferPending(const uint8_t Address) ATTR_WARN_UNUSED_RESULT;
+
+			/** Aborts an asynchronous transfer queued via \ref Endpoint_SubmitTransfer() on the given endpoint. The
+			 *  transfer's completion callback is not executed. Any partially filled IN endpoint bank is left in place,
+			 *  and may be sent or discarded by the application as required.
+			 *
+			 *  \param[in] Address  Address of the endpoint whose transfer is to be aborted.
+			 *
+			 *  \return Number of bytes transferred before the transfer was aborted.
+			 */
+			uint16_t Endpoint_AbortTransfer(const uint8_t Address);
+			//@}
+
+	/* Private Interface - For use in library only: */
+	#if !defined(__DOXYGEN__)
+		/* Type Defines: */
+			typedef struct
+			{
+				uint8_t*                    BufferPtr;
+				uint16_t                    BytesRemaining;
+				uint16_t                    BytesTransferred;
+				Endpoint_TransferCallback_t Callback;
+				uint8_t                     Address;
+			} Endpoint_Transfer_t;
+
+		/* Function Prototypes: */
+			void Endpoint_ServiceTransfers(void);
+			void Endpoint_CancelTransfers(void);
+	#endif
+	#endif
+
 	/* Disable C linkage for C++ Compilers: */
 		#if defined(__cplusplus)
 			}
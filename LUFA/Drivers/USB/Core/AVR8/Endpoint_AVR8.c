@@ -114,6 +114,10 @@ bool Endpoint_ConfigureEndpoint_Prv(const uint8_t Number,
 
 void Endpoint_ClearEndpoints(void)
 {
+	#if defined(ASYNC_ENDPOINT_TRANSFERS) && !defined(CONTROL_ONLY_DEVICE)
+	Endpoint_CancelTransfers();
+	#endif
+
 	UEINT = 0;
 
 	for (uint8_t EPNum = 0; EPNum < ENDPOINT_TOTAL_ENDPOINTS; EPNum++)
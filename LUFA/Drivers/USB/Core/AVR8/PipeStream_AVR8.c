@@ -215,6 +215,200 @@ uint8_t Pipe_Null_Stream(uint16_t Length,
 #define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         eeprom_update_byte(BufferPtr, Pipe_Read_8())
 #include "Template/Template_Pipe_RW.c"
 
+#define  TEMPLATE_FUNC_NAME                        Pipe_Write_StreamV
+#define  TEMPLATE_SEGMENT_TYPE                     Pipe_StreamSegment_t
+#define  TEMPLATE_SEGMENT_FLASH                    PIPE_SEGMENT_FLASH
+#define  TEMPLATE_SEGMENT_EEPROM                   PIPE_SEGMENT_EEPROM
+#define  TEMPLATE_NO_ERROR                         PIPE_RWSTREAM_NoError
+#define  TEMPLATE_WRITE_STREAM                     Pipe_Write_Stream_LE
+#define  TEMPLATE_WRITE_PSTREAM                    Pipe_Write_PStream_LE
+#define  TEMPLATE_WRITE_ESTREAM                    Pipe_Write_EStream_LE
+#include "../Template/Template_Write_StreamV.c"
+
+#if defined(ASYNC_PIPE_TRANSFERS)
+static Pipe_Transfer_t Pipe_Transfers[PIPE_TOTAL_PIPES];
+
+static void Pipe_CompleteTransfer(Pipe_Transfer_t* const Transfer,
+                                  const uint8_t ErrorCode)
+{
+	uint8_t                 Address  = Transfer->Address;
+	Pipe_TransferCallback_t Callback = Transfer->Callback;
+
+	UPIENX &= ~((1 << RXINE) | (1 << TXOUTE) | (1 << RXSTALLE));
+
+	if ((Address & PIPE_DIR_IN) || (ErrorCode != PIPE_RWSTREAM_NoError))
+	  Pipe_Freeze();
+
+	Transfer->Address = 0;
+
+	if (Callback != NULL)
+	  Callback(Address, Transfer->BytesTransferred, ErrorCode);
+}
+
+static void Pipe_ServiceINTransfer(Pipe_Transfer_t* const Transfer)
+{
+	uint16_t BankSize = (8 << ((UPCFG1X >> EPSIZE0) & 0x07));
+
+	while (Pipe_IsINReceived())
+	{
+		uint16_t PacketLength = Pipe_BytesInPipe();
+		uint16_t BankLength   = MIN(PacketLength, Transfer->BytesRemaining);
+		uint8_t* BufferPtr    = Transfer->BufferPtr;
+
+		Transfer->BufferPtr        += BankLength;
+		Transfer->BytesRemaining   -= BankLength;
+		Transfer->BytesTransferred += BankLength;
+
+		while (BankLength--)
+		  *(BufferPtr++) = Pipe_Read_8();
+
+		Pipe_ClearIN();
+
+		if (!(Transfer->BytesRemaining) || (PacketLength < BankSize))
+		{
+			Pipe_CompleteTransfer(Transfer, PIPE_RWSTREAM_NoError);
+			return;
+		}
+	}
+}
+
+static void Pipe_ServiceOUTTransfer(Pipe_Transfer_t* const Transfer)
+{
+	uint16_t BankSize = (8 << ((UPCFG1X >> EPSIZE0) & 0x07));
+
+	while (Pipe_IsOUTReady())
+	{
+		uint16_t BankLength = MIN(BankSize - Pipe_BytesInPipe(), Transfer->BytesRemaining);
+		uint8_t* BufferPtr  = Transfer->BufferPtr;
+
+		Transfer->BufferPtr        += BankLength;
+		Transfer->BytesRemaining   -= BankLength;
+		Transfer->BytesTransferred += BankLength;
+
+		while (BankLength--)
+		  Pipe_Write_8(*(BufferPtr++));
+
+		Pipe_ClearOUT();
+
+		if (!(Transfer->BytesRemaining))
+		{
+			Pipe_CompleteTransfer(Transfer, PIPE_RWSTREAM_NoError);
+			return;
+		}
+	}
+}
+
+bool Pipe_SubmitTransfer(const uint8_t Address,
+                         void* const Buffer,
+                         const uint16_t Length,
+                         const Pipe_TransferCallback_t Callback)
+{
+	Pipe_Transfer_t* Transfer = &Pipe_Transfers[Address & PIPE_PIPENUM_MASK];
+
+	uint_reg_t CurrentGlobalInt = GetGlobalInterruptMask();
+	GlobalInterruptDisable();
+
+	if (Transfer->Address)
+	{
+		SetGlobalInterruptMask(CurrentGlobalInt);
+		return false;
+	}
+
+	Transfer->BufferPtr        = (uint8_t*)Buffer;
+	Transfer->BytesRemaining   = Length;
+	Transfer->BytesTransferred = 0;
+	Transfer->Callback         = Callback;
+	Transfer->Address          = Address;
+
+	uint8_t PrevSelectedPipe = Pipe_GetCurrentPipe();
+
+	Pipe_SelectPipe(Address);
+
+	if (Address & PIPE_DIR_IN)
+	{
+		Pipe_SetPipeToken(PIPE_TOKEN_IN);
+		UPIENX |= ((1 << RXINE) | (1 << RXSTALLE));
+	}
+	else
+	{
+		Pipe_SetPipeToken(PIPE_TOKEN_OUT);
+		UPIENX |= ((1 << TXOUTE) | (1 << RXSTALLE));
+	}
+
+	Pipe_Unfreeze();
+	Pipe_SelectPipe(PrevSelectedPipe);
+
+	SetGlobalInterruptMask(CurrentGlobalInt);
+	return true;
+}
+
+bool Pipe_IsTransferPending(const uint8_t Address)
+{
+	return (Pipe_Transfers[Address & PIPE_PIPENUM_MASK].Address ? true : false);
+}
+
+uint16_t Pipe_AbortTransfer(const uint8_t Address)
+{
+	Pipe_Transfer_t* Transfer = &Pipe_Transfers[Address & PIPE_PIPENUM_MASK];
+
+	uint_reg_t CurrentGlobalInt = GetGlobalInterruptMask();
+	GlobalInterruptDisable();
+
+	uint8_t PrevSelectedPipe = Pipe_GetCurrentPipe();
+
+	Pipe_SelectPipe(Address);
+	UPIENX &= ~((1 << RXINE) | (1 << TXOUTE) | (1 << RXSTALLE));
+	Pipe_Freeze();
+	Pipe_SelectPipe(PrevSelectedPipe);
+
+	Transfer->Address = 0;
+
+	SetGlobalInterruptMask(CurrentGlobalInt);
+	return Transfer->BytesTransferred;
+}
+
+void Pipe_ServiceTransfers(void)
+{
+	for (uint8_t PNum = 1; PNum < PIPE_TOTAL_PIPES; PNum++)
+	{
+		Pipe_Transfer_t* Transfer = &Pipe_Transfers[PNum];
+
+		if (!(Transfer->Address) || !(Pipe_HasPipeInterrupted(PNum)))
+		  continue;
+
+		Pipe_SelectPipe(Transfer->Address);
+
+		if (Pipe_IsStalled())
+		{
+			Pipe_ClearStall();
+			Pipe_CompleteTransfer(Transfer, PIPE_RWSTREAM_PipeStalled);
+		}
+		else if (Transfer->Address & PIPE_DIR_IN)
+		{
+			Pipe_ServiceINTransfer(Transfer);
+		}
+		else
+		{
+			Pipe_ServiceOUTTransfer(Transfer);
+		}
+	}
+}
+
+void Pipe_CancelTransfers(void)
+{
+	for (uint8_t PNum = 1; PNum < PIPE_TOTAL_PIPES; PNum++)
+	{
+		Pipe_Transfer_t* Transfer = &Pipe_Transfers[PNum];
+
+		if (!(Transfer->Address))
+		  continue;
+
+		Pipe_SelectPipe(Transfer->Address);
+		Pipe_CompleteTransfer(Transfer, PIPE_RWSTREAM_DeviceDisconnected);
+	}
+}
+#endif
+
 #endif
 
 #endif
@@ -341,6 +341,39 @@
 			                            uint16_t* const BytesProcessed) ATTR_NON_NULL_PTR_ARG(1);
 			//@}
 
+			/** \name Scatter-gather stream functions */
+			//@{
+
+			/** Writes the given list of source data segments to the currently selected pipe as a single continuous
+			 *  stream, in little endian byte order. The segments are packed back to back into the pipe banks without an
+			 *  intermediate copy and without waiting for the pipe to become ready between segments, so that a header
+			 *  and payload held in separate buffers are sent in as few packets as possible. Each segment may reside in
+			 *  any of the memory spaces supported by the architecture, as indicated by its \c MemorySpace field.
+			 *
+			 *  If the BytesProcessed parameter is \c NULL, the entire stream transfer is attempted at once, failing or
+			 *  succeeding as a single unit. Otherwise the transfer is performed as a series of chunks in the same manner
+			 *  as \ref Pipe_Write_Stream_LE(), with BytesProcessed tracking the total number of bytes written across
+			 *  all segments.
+			 *
+			 *  As with the other stream functions, the last packet is not automatically sent once the final segment has
+			 *  been written; the user is responsible for manually sending the last written packet to the device via the
+			 *  \ref Pipe_ClearOUT() macro.
+			 *
+			 *  \note The pipe token is set automatically, thus this can be used on bi-directional pipes directly without
+			 *        having to explicitly change the data direction with a call to \ref Pipe_SetPipeToken().
+			 *
+			 *  \param[in] Segments        Pointer to an array of source data segments to write.
+			 *  \param[in] TotalSegments   Number of segments in the array.
+			 *  \param[in] BytesProcessed  Pointer to a location where the total number of bytes processed in the current
+			 *                             transaction should be updated, \c NULL if the entire stream should be written at once.
+			 *
+			 *  \return A value from the \ref Pipe_Stream_RW_ErrorCodes_t enum.
+			 */
+			uint8_t Pipe_Write_StreamV(const Pipe_StreamSegment_t* const Segments,
+			                           const uint8_t TotalSegments,
+			                           uint16_t* const BytesProcessed) ATTR_NON_NULL_PTR_ARG(1);
+			//@}
+
 			/** \name Stream functions for EEPROM source/destination data */
 			//@{
 
@@ -431,6 +464,100 @@
 			                              uint16_t* const BytesProcessed) ATTR_NON_NULL_PTR_ARG(1);
 			//@}
 
+	#if defined(ASYNC_PIPE_TRANSFERS) || defined(__DOXYGEN__)
+	/* Public Interface - May be used in end-application: */
+		/* Type Defines: */
+			/** Type define for an asynchronous pipe transfer completion callback, registered via
+			 *  \ref Pipe_SubmitTransfer(). The callback is executed from within the USB controller's pipe interrupt
+			 *  once the transfer has completed or has been cancelled, and should therefore be kept short.
+			 *
+			 *  \param[in] Address           Address of the pipe whose transfer has completed.
+			 *  \param[in] BytesTransferred  Total number of bytes transferred to or from the user buffer.
+			 *  \param[in] ErrorCode         A value from the \ref Pipe_Stream_RW_ErrorCodes_t enum.
+			 */
+			typedef void (*Pipe_TransferCallback_t)(const uint8_t Address,
+			                                        const uint16_t BytesTransferred,
+			                                        const uint8_t ErrorCode);
+
+		/* Function Prototypes: */
+			/** \name Asynchronous transfer functions */
+			//@{
+
+			/** Queues a buffer for transmission to (OUT pipes) or reception from (IN pipes) the attached device on the
+			 *  given pipe, without blocking. The pipe is unfrozen and its banks are filled or drained from within the
+			 *  USB controller's pipe interrupt as each bank becomes available, so that transfers on several pipes - for
+			 *  example a Mass Storage block read and a HID interrupt pipe - may be in progress at the same time, each
+			 *  serviced as the hardware schedules its transactions. Only a single transfer may be pending on each pipe
+			 *  at any one time; the completion callback may submit the next transfer on the same pipe.
+			 *
+			 *  IN transfers complete once the given number of bytes have been received, or once a short packet is
+			 *  received from the device, after which the pipe is frozen again. Any bytes of the final packet which do
+			 *  not fit into the user buffer are discarded, thus IN transfer lengths should be a multiple of the pipe
+			 *  bank size. OUT transfers complete once the last byte has been handed to the USB controller, with the
+			 *  final (possibly partially filled) bank being sent automatically; the pipe is left unfrozen so that the
+			 *  queued banks may be transmitted. A zero length OUT transfer sends a single zero length packet.
+			 *
+			 *  If the attached device stalls the pipe, the stall condition is cleared locally and the transfer is
+			 *  completed with an error code of \ref PIPE_RWSTREAM_PipeStalled; the application should then issue a
+			 *  CLEAR FEATURE request to the device via \ref USB_Host_ClearEndpointStall().
+			 *
+			 *  \note This routine should not be used on CONTROL type pipes. The buffer must remain valid and untouched
+			 *        by the application until the transfer has completed or has been aborted.
+			 *        \n\n
+			 *
+			 *  \note Pending transfers are cancelled with an error code of \ref PIPE_RWSTREAM_DeviceDisconnected when
+			 *        the pipes are reset due to the device being disconnected. The completion callback must not resubmit
+			 *        a transfer in this case.
+			 *
+			 *  \param[in] Address   Address of the configured pipe to transfer data on.
+			 *  \param[in] Buffer    Pointer to the source (OUT) or destination (IN) data buffer.
+			 *  \param[in] Length    Number of bytes to transfer.
+			 *  \param[in] Callback  Function to call once the transfer completes, or \c NULL if not required.
+			 *
+			 *  \return Boolean \c true if the transfer was queued, \c false if a transfer is already pending on the pipe.
+			 */
+			bool Pipe_SubmitTransfer(const uint8_t Address,
+			                         void* const Buffer,
+			                         const uint16_t Length,
+			                         const Pipe_TransferCallback_t Callback);
+
+			/** Determines if an asynchronous transfer queued via \ref Pipe_SubmitTransfer() is still pending on the
+			 *  given pipe.
+			 *
+			 *  \param[in] Address  Address of the pipe to check.
+			 *
+			 *  \return Boolean \c true if a transfer is pending on the pipe, \c false otherwise.
+			 */
+			bool Pipe_IsTransferPending(const uint8_t Address) ATTR_WARN_UNUSED_RESULT;
+
+			/** Aborts an asynchronous transfer queued via \ref Pipe_SubmitTransfer() on the given pipe, freezing the
+			 *  pipe. The transfer's completion callback is not executed.
+			 *
+			 *  \param[in] Address  Address of the pipe whose transfer is to be aborted.
+			 *
+			 *  \return Number of bytes transferred before the transfer was aborted.
+			 */
+			uint16_t Pipe_AbortTransfer(const uint8_t Address);
+			//@}
+
+	/* Private Interface - For use in library only: */
+	#if !defined(__DOXYGEN__)
+		/* Type Defines: */
+			typedef struct
+			{
+				uint8_t*                BufferPtr;
+				uint16_t                BytesRemaining;
+				uint16_t                BytesTransferred;
+				Pipe_TransferCallback_t Callback;
+				uint8_t                 Address;
+			} Pipe_Transfer_t;
+
+		/* Function Prototypes: */
+			void Pipe_ServiceTransfers(void);
+			void Pipe_CancelTransfers(void);
+	#endif
+	#endif
+
 	/* Disable C linkage for C++ Compilers: */
 		#if defined(__cplusplus)
 			}
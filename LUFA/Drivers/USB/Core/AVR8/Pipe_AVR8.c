@@ -134,6 +134,14 @@ bool Pipe_ConfigurePipe(const uint8_t Address,
 
 void Pipe_ClearPipes(void)
 {
+	#if defined(ASYNC_PIPE_TRANSFERS)
+	Pipe_CancelTransfers();
+	#endif
+
+	#if defined(PERIODIC_PIPE_SCHEDULER)
+	Pipe_ClearPeriodicPipes();
+	#endif
+
 	UPINT = 0;
 
 	for (uint8_t PNum = 0; PNum < PIPE_TOTAL_PIPES; PNum++)
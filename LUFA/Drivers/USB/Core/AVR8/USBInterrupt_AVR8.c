@@ -182,12 +182,21 @@ ISR(USB_GEN_vect, ISR_BLOCK)
 	#endif
 
 	#if defined(USB_CAN_BE_HOST)
-	#if !defined(NO_SOF_EVENTS)
+	#if !defined(NO_SOF_EVENTS) || defined(PERIODIC_PIPE_SCHEDULER)
 	if (USB_INT_HasOccurred(USB_INT_HSOFI) && USB_INT_IsEnabled(USB_INT_HSOFI))
 	{
 		USB_INT_Clear(USB_INT_HSOFI);
 
+		#if defined(PERIODIC_PIPE_SCHEDULER)
+		Pipe_ServicePeriodicPipes();
+		#endif
+
+		#if !defined(NO_SOF_EVENTS) && defined(PERIODIC_PIPE_SCHEDULER)
+		if (USB_Host_SOFEventsEnabled)
+		  EVENT_USB_Host_StartOfFrame();
+		#elif !defined(NO_SOF_EVENTS)
 		EVENT_USB_Host_StartOfFrame();
+		#endif
 	}
 	#endif
 
@@ -257,21 +266,47 @@ ISR(USB_GEN_vect, ISR_BLOCK)
 	#endif
 }
 
-#if defined(INTERRUPT_CONTROL_ENDPOINT) && defined(USB_CAN_BE_DEVICE)
+#if ((defined(INTERRUPT_CONTROL_ENDPOINT) || (defined(ASYNC_ENDPOINT_TRANSFERS) && !defined(CONTROL_ONLY_DEVICE))) && defined(USB_CAN_BE_DEVICE)) || \
+    (defined(ASYNC_PIPE_TRANSFERS) && defined(USB_CAN_BE_HOST))
 ISR(USB_COM_vect, ISR_BLOCK)
 {
+	#if defined(ASYNC_PIPE_TRANSFERS) && defined(USB_CAN_BE_HOST)
+	if (USB_CurrentMode == USB_MODE_Host)
+	{
+		uint8_t PrevSelectedPipe = Pipe_GetCurrentPipe();
+
+		Pipe_ServiceTransfers();
+
+		Pipe_SelectPipe(PrevSelectedPipe);
+		return;
+	}
+	#endif
+
+	#if defined(USB_CAN_BE_DEVICE)
 	uint8_t PrevSelectedEndpoint = Endpoint_GetCurrentEndpoint();
 
+	#if defined(ASYNC_ENDPOINT_TRANSFERS) && !defined(CONTROL_ONLY_DEVICE)
+	Endpoint_ServiceTransfers();
+	#endif
+
+	#if defined(INTERRUPT_CONTROL_ENDPOINT)
 	Endpoint_SelectEndpoint(ENDPOINT_CONTROLEP);
-	USB_INT_Disable(USB_INT_RXSTPI);
 
-	GlobalInterruptEnable();
+	if (USB_INT_HasOccurred(USB_INT_RXSTPI) && USB_INT_IsEnabled(USB_INT_RXSTPI))
+	{
+		USB_INT_Disable(USB_INT_RXSTPI);
 
-	USB_Device_ProcessControlRequest();
+		GlobalInterruptEnable();
+
+		USB_Device_ProcessControlRequest();
+
+		Endpoint_SelectEndpoint(ENDPOINT_CONTROLEP);
+		USB_INT_Enable(USB_INT_RXSTPI);
+	}
+	#endif
 
-	Endpoint_SelectEndpoint(ENDPOINT_CONTROLEP);
-	USB_INT_Enable(USB_INT_RXSTPI);
 	Endpoint_SelectEndpoint(PrevSelectedEndpoint);
+	#endif
 }
 #endif
 
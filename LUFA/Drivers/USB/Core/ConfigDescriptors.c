@@ -61,6 +61,8 @@ uint8_t USB_Host_GetDeviceConfigDescriptor(const uint8_t ConfigNumber,
 
 	USB_ControlRequest.wLength = *ConfigSizePtr;
 
+	USB_InvalidateConfigIndex();
+
 	if ((ErrorCode = USB_Host_SendControlRequest(BufferPtr)) != HOST_SENDCONTROL_Successful)
 	  return ErrorCode;
 
@@ -144,3 +146,298 @@ uint8_t USB_GetNextDescriptorComp(uint16_t* const BytesRem,
 	return DESCRIPTOR_SEARCH_COMP_EndOfDescriptor;
 }
 
+#if defined(USB_CAN_BE_HOST)
+static USB_ConfigIndex_t USB_ConfigIndex;
+
+#if defined(USE_CONFIG_DESCRIPTOR_INDEX)
+static uint16_t USB_ConfigIndex_Checksum(const uint8_t* Data,
+                                         uint16_t Length)
+{
+	uint8_t Sum1 = 0;
+	uint8_t Sum2 = 0;
+
+	while (Length--)
+	{
+		Sum1 += *(Data++);
+		Sum2 += Sum1;
+	}
+
+	return (((uint16_t)Sum2 << 8) | Sum1);
+}
+#endif
+
+static uint16_t USB_ConfigIndex_GetInterfaceOffset(const USB_ConfigIndex_t* const ConfigIndex,
+                                                   const uint8_t Interface)
+{
+	#if defined(USE_CONFIG_DESCRIPTOR_INDEX)
+	if (!(ConfigIndex->Truncated))
+	  return ConfigIndex->Interfaces[Interface].Offset;
+	#endif
+
+	uint8_t CurrInterface = 0;
+
+	for (uint16_t CurrOffset = DESCRIPTOR_SIZE(ConfigIndex->ConfigDescriptor); CurrOffset < ConfigIndex->ParsedSize;
+	     CurrOffset += DESCRIPTOR_SIZE(&ConfigIndex->ConfigDescriptor[CurrOffset]))
+	{
+		if (DESCRIPTOR_TYPE(&ConfigIndex->ConfigDescriptor[CurrOffset]) != DTYPE_Interface)
+		  continue;
+
+		if (CurrInterface++ == Interface)
+		  return CurrOffset;
+	}
+
+	return 0;
+}
+
+const USB_ConfigIndex_t* USB_GetConfigIndex(const uint16_t ConfigDescriptorSize,
+                                            const void* const ConfigDescriptorData)
+{
+	USB_ConfigIndex_t* ConfigIndex = &USB_ConfigIndex;
+
+	if ((ConfigDescriptorSize < sizeof(USB_Descriptor_Configuration_Header_t)) ||
+	    (DESCRIPTOR_TYPE(ConfigDescriptorData) != DTYPE_Configuration))
+	{
+		return NULL;
+	}
+
+	#if defined(USE_CONFIG_DESCRIPTOR_INDEX)
+	uint16_t Checksum = USB_ConfigIndex_Checksum(ConfigDescriptorData, ConfigDescriptorSize);
+
+	if ((ConfigIndex->ConfigDescriptor == ConfigDescriptorData) && (ConfigIndex->ConfigDescriptorSize == ConfigDescriptorSize) &&
+	    (ConfigIndex->Checksum == Checksum))
+	{
+		return ConfigIndex;
+	}
+
+	memset(ConfigIndex, 0x00, sizeof(USB_ConfigIndex_t));
+
+	USB_ConfigIndex_Interface_t* CurrInterface = NULL;
+	#endif
+
+	uint16_t CurrOffset = DESCRIPTOR_SIZE(ConfigDescriptorData);
+
+	while (CurrOffset < ConfigDescriptorSize)
+	{
+		const void* CurrDescriptor     = &((const uint8_t*)ConfigDescriptorData)[CurrOffset];
+		uint8_t     CurrDescriptorSize = DESCRIPTOR_SIZE(CurrDescriptor);
+
+		if ((CurrDescriptorSize < sizeof(USB_Descriptor_Header_t)) ||
+		    (CurrDescriptorSize > (ConfigDescriptorSize - CurrOffset)))
+		{
+			break;
+		}
+
+		#if defined(USE_CONFIG_DESCRIPTOR_INDEX)
+		switch (DESCRIPTOR_TYPE(CurrDescriptor))
+		{
+			case DTYPE_Interface:
+				if (CurrInterface != NULL)
+				  CurrInterface->EndOffset = CurrOffset;
+
+				if (ConfigIndex->TotalInterfaces == USB_CONFIG_INDEX_MAX_INTERFACES)
+				{
+					CurrInterface          = NULL;
+					ConfigIndex->Truncated = true;
+					break;
+				}
+
+				CurrInterface = &ConfigIndex->Interfaces[ConfigIndex->TotalInterfaces++];
+				CurrInterface->Offset        = CurrOffset;
+				CurrInterface->FirstEndpoint = ConfigIndex->TotalEndpoints;
+				break;
+			case DTYPE_InterfaceAssociation:
+				if (CurrInterface != NULL)
+				  CurrInterface->EndOffset = CurrOffset;
+
+				CurrInterface = NULL;
+				break;
+			case DTYPE_Endpoint:
+				if (CurrInterface == NULL)
+				  break;
+
+				if (ConfigIndex->TotalEndpoints == USB_CONFIG_INDEX_MAX_ENDPOINTS)
+				{
+					ConfigIndex->Truncated = true;
+					break;
+				}
+
+				ConfigIndex->EndpointOffsets[ConfigIndex->TotalEndpoints++] = CurrOffset;
+				CurrInterface->TotalEndpoints++;
+				break;
+			default:
+				if ((CurrInterface != NULL) && !(CurrInterface->ClassOffset))
+				  CurrInterface->ClassOffset = CurrOffset;
+
+				break;
+		}
+		#endif
+
+		CurrOffset += CurrDescriptorSize;
+	}
+
+	#if defined(USE_CONFIG_DESCRIPTOR_INDEX)
+	if (CurrInterface != NULL)
+	  CurrInterface->EndOffset = CurrOffset;
+
+	ConfigIndex->Checksum             = Checksum;
+	#endif
+
+	ConfigIndex->ConfigDescriptor     = ConfigDescriptorData;
+	ConfigIndex->ConfigDescriptorSize = ConfigDescriptorSize;
+	ConfigIndex->ParsedSize           = CurrOffset;
+
+	return ConfigIndex;
+}
+
+void USB_InvalidateConfigIndex(void)
+{
+	USB_ConfigIndex.ConfigDescriptor = NULL;
+}
+
+USB_Descriptor_Interface_t* USB_ConfigIndex_GetInterface(const USB_ConfigIndex_t* const ConfigIndex,
+                                                         const uint8_t Interface)
+{
+	return DESCRIPTOR_PCAST(&ConfigIndex->ConfigDescriptor[USB_ConfigIndex_GetInterfaceOffset(ConfigIndex, Interface)],
+	                        USB_Descriptor_Interface_t);
+}
+
+uint8_t USB_ConfigIndex_FindNextInterface(const USB_ConfigIndex_t* const ConfigIndex,
+                                          const uint8_t PrevInterface,
+                                          ConfigComparatorPtr_t const ComparatorRoutine)
+{
+	uint8_t FirstInterface = (uint8_t)(PrevInterface + 1);
+
+	#if defined(USE_CONFIG_DESCRIPTOR_INDEX)
+	if (!(ConfigIndex->Truncated))
+	{
+		for (uint8_t Interface = FirstInterface; Interface < ConfigIndex->TotalInterfaces; Interface++)
+		{
+			if (ComparatorRoutine(USB_ConfigIndex_GetInterface(ConfigIndex, Interface)) == DESCRIPTOR_SEARCH_Found)
+			  return Interface;
+		}
+
+		return USB_CONFIG_INDEX_NONE;
+	}
+	#endif
+
+	uint8_t Interface = 0;
+
+	for (uint16_t CurrOffset = DESCRIPTOR_SIZE(ConfigIndex->ConfigDescriptor); CurrOffset < ConfigIndex->ParsedSize;
+	     CurrOffset += DESCRIPTOR_SIZE(&ConfigIndex->ConfigDescriptor[CurrOffset]))
+	{
+		void* CurrDescriptor = (void*)&ConfigIndex->ConfigDescriptor[CurrOffset];
+
+		if (DESCRIPTOR_TYPE(CurrDescriptor) != DTYPE_Interface)
+		  continue;
+
+		if (Interface == USB_CONFIG_INDEX_NONE)
+		  break;
+
+		if ((Interface >= FirstInterface) && (ComparatorRoutine(CurrDescriptor) == DESCRIPTOR_SEARCH_Found))
+		  return Interface;
+
+		Interface++;
+	}
+
+	return USB_CONFIG_INDEX_NONE;
+}
+
+USB_Descriptor_Endpoint_t* USB_ConfigIndex_FindNextEndpoint(const USB_ConfigIndex_t* const ConfigIndex,
+                                                            const uint8_t Interface,
+                                                            uint8_t* const EndpointCursor,
+                                                            ConfigComparatorPtr_t const ComparatorRoutine)
+{
+	#if defined(USE_CONFIG_DESCRIPTOR_INDEX)
+	if (!(ConfigIndex->Truncated))
+	{
+		const USB_ConfigIndex_Interface_t* InterfaceEntry = &ConfigIndex->Interfaces[Interface];
+
+		while (*EndpointCursor < InterfaceEntry->TotalEndpoints)
+		{
+			uint16_t EndpointOffset = ConfigIndex->EndpointOffsets[InterfaceEntry->FirstEndpoint + (*EndpointCursor)++];
+			void*    Endpoint       = (void*)&ConfigIndex->ConfigDescriptor[EndpointOffset];
+
+			if (ComparatorRoutine(Endpoint) == DESCRIPTOR_SEARCH_Found)
+			  return DESCRIPTOR_PCAST(Endpoint, USB_Descriptor_Endpoint_t);
+		}
+
+		return NULL;
+	}
+	#endif
+
+	uint16_t CurrOffset = USB_ConfigIndex_GetInterfaceOffset(ConfigIndex, Interface);
+	uint8_t  Endpoint   = 0;
+
+	if (!(CurrOffset))
+	  return NULL;
+
+	while ((CurrOffset += DESCRIPTOR_SIZE(&ConfigIndex->ConfigDescriptor[CurrOffset])) < ConfigIndex->ParsedSize)
+	{
+		void* CurrDescriptor = (void*)&ConfigIndex->ConfigDescriptor[CurrOffset];
+
+		if ((DESCRIPTOR_TYPE(CurrDescriptor) == DTYPE_Interface) ||
+		    (DESCRIPTOR_TYPE(CurrDescriptor) == DTYPE_InterfaceAssociation))
+		{
+			break;
+		}
+
+		if ((DESCRIPTOR_TYPE(CurrDescriptor) != DTYPE_Endpoint) || (Endpoint++ < *EndpointCursor))
+		  continue;
+
+		(*EndpointCursor)++;
+
+		if (ComparatorRoutine(CurrDescriptor) == DESCRIPTOR_SEARCH_Found)
+		  return DESCRIPTOR_PCAST(CurrDescriptor, USB_Descriptor_Endpoint_t);
+	}
+
+	return NULL;
+}
+
+void* USB_ConfigIndex_FindClassDescriptor(const USB_ConfigIndex_t* const ConfigIndex,
+                                          const uint8_t Interface,
+                                          const uint8_t Type)
+{
+	#if defined(USE_CONFIG_DESCRIPTOR_INDEX)
+	if (!(ConfigIndex->Truncated))
+	{
+		const USB_ConfigIndex_Interface_t* InterfaceEntry = &ConfigIndex->Interfaces[Interface];
+
+		if (!(InterfaceEntry->ClassOffset))
+		  return NULL;
+
+		for (uint16_t CurrOffset = InterfaceEntry->ClassOffset; CurrOffset < InterfaceEntry->EndOffset;
+		     CurrOffset += DESCRIPTOR_SIZE(&ConfigIndex->ConfigDescriptor[CurrOffset]))
+		{
+			void* CurrDescriptor = (void*)&ConfigIndex->ConfigDescriptor[CurrOffset];
+
+			if (DESCRIPTOR_TYPE(CurrDescriptor) == Type)
+			  return CurrDescriptor;
+		}
+
+		return NULL;
+	}
+	#endif
+
+	uint16_t CurrOffset = USB_ConfigIndex_GetInterfaceOffset(ConfigIndex, Interface);
+
+	if (!(CurrOffset))
+	  return NULL;
+
+	while ((CurrOffset += DESCRIPTOR_SIZE(&ConfigIndex->ConfigDescriptor[CurrOffset])) < ConfigIndex->ParsedSize)
+	{
+		void* CurrDescriptor = (void*)&ConfigIndex->ConfigDescriptor[CurrOffset];
+
+		if ((DESCRIPTOR_TYPE(CurrDescriptor) == DTYPE_Interface) ||
+		    (DESCRIPTOR_TYPE(CurrDescriptor) == DTYPE_InterfaceAssociation))
+		{
+			break;
+		}
+
+		if (DESCRIPTOR_TYPE(CurrDescriptor) == Type)
+		  return CurrDescriptor;
+	}
+
+	return NULL;
+}
+#endif
+
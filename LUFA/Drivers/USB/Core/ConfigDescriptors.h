@@ -66,6 +66,14 @@
 			#error Do not include this file directly. Include LUFA/Drivers/USB/USB.h instead.
 		#endif
 
+		#if defined(USB_CONFIG_INDEX_MAX_INTERFACES) && ((USB_CONFIG_INDEX_MAX_INTERFACES < 1) || (USB_CONFIG_INDEX_MAX_INTERFACES > 254))
+			#error USB_CONFIG_INDEX_MAX_INTERFACES must be between 1 and 254.
+		#endif
+
+		#if defined(USB_CONFIG_INDEX_MAX_ENDPOINTS) && ((USB_CONFIG_INDEX_MAX_ENDPOINTS < 1) || (USB_CONFIG_INDEX_MAX_ENDPOINTS > 255))
+			#error USB_CONFIG_INDEX_MAX_ENDPOINTS must be between 1 and 255.
+		#endif
+
 	/* Public Interface - May be used in end-application: */
 		/* Macros: */
 			/** Casts a pointer to a descriptor inside the configuration descriptor into a pointer to the given
@@ -105,6 +113,34 @@
 			/** Returns the descriptor's size, expressed as the 8-bit value indicating the number of bytes. */
 			#define DESCRIPTOR_SIZE(DescriptorPtr)    DESCRIPTOR_PCAST(DescriptorPtr, USB_Descriptor_Header_t)->Size
 
+			#if !defined(USB_CONFIG_INDEX_MAX_INTERFACES) || defined(__DOXYGEN__)
+				/** Maximum number of interface descriptors (including alternate settings) which can be recorded in a
+				 *  \ref USB_ConfigIndex_t configuration descriptor index when the \c USE_CONFIG_DESCRIPTOR_INDEX token is
+				 *  defined. Configuration descriptors with more interfaces are searched linearly instead.
+				 *
+				 *  This value may be overridden in the user project makefile as the value of the
+				 *  \ref USB_CONFIG_INDEX_MAX_INTERFACES token, and passed to the compiler using the -D switch.
+				 */
+				#define USB_CONFIG_INDEX_MAX_INTERFACES   16
+			#endif
+
+			#if !defined(USB_CONFIG_INDEX_MAX_ENDPOINTS) || defined(__DOXYGEN__)
+				/** Maximum number of endpoint descriptors which can be recorded in a \ref USB_ConfigIndex_t configuration
+				 *  descriptor index when the \c USE_CONFIG_DESCRIPTOR_INDEX token is defined. Configuration descriptors with
+				 *  more endpoints are searched linearly instead.
+				 *
+				 *  This value may be overridden in the user project makefile as the value of the
+				 *  \ref USB_CONFIG_INDEX_MAX_ENDPOINTS token, and passed to the compiler using the -D switch.
+				 */
+				#define USB_CONFIG_INDEX_MAX_ENDPOINTS    32
+			#endif
+
+			/** Interface index value returned by the configuration descriptor index search functions when no matching
+			 *  interface exists. This value may also be passed as the previous interface index to
+			 *  \ref USB_ConfigIndex_FindNextInterface() to start a search from the first indexed interface.
+			 */
+			#define USB_CONFIG_INDEX_NONE             0xFF
+
 		/* Type Defines: */
 			/** Type define for a Configuration Descriptor comparator function (function taking a pointer to an array
 			 *  of type void, returning a uint8_t value).
@@ -113,6 +149,53 @@
 			 */
 			typedef uint8_t (* ConfigComparatorPtr_t)(void*);
 
+			/** \brief Configuration Descriptor Index Interface Entry.
+			 *
+			 *  Type define for the index entry of a single interface descriptor (or alternate setting) within a
+			 *  \ref USB_ConfigIndex_t configuration descriptor index. All offsets are relative to the start of the
+			 *  indexed configuration descriptor.
+			 */
+			typedef struct
+			{
+				uint16_t Offset; /**< Offset of the interface descriptor. */
+				uint16_t ClassOffset; /**< Offset of the first class-specific (non-endpoint) descriptor belonging to the
+				                       *   interface, or zero if the interface has no class-specific descriptors.
+				                       */
+				uint16_t EndOffset; /**< Offset of the first descriptor following the interface's descriptors. */
+				uint8_t  FirstEndpoint; /**< Index of the interface's first endpoint in the index's endpoint table. */
+				uint8_t  TotalEndpoints; /**< Number of endpoints of the interface recorded in the endpoint table. */
+			} USB_ConfigIndex_Interface_t;
+
+			/** \brief Configuration Descriptor Index.
+			 *
+			 *  Type define for a configuration descriptor index, returned by \ref USB_GetConfigIndex(). When the
+			 *  \c USE_CONFIG_DESCRIPTOR_INDEX token is defined the index is built in a single pass over a device's
+			 *  configuration descriptor, recording the location of every interface descriptor and alternate setting, the
+			 *  endpoints belonging to each, and the start of each interface's class-specific descriptors, so that class
+			 *  drivers can locate their interfaces and endpoints by table lookup rather than by repeatedly walking the
+			 *  entire configuration descriptor. Otherwise, or if the configuration descriptor does not fit into the index
+			 *  tables, the index search functions walk the configuration descriptor instead.
+			 */
+			typedef struct
+			{
+				const uint8_t* ConfigDescriptor; /**< Pointer to the start of the indexed configuration descriptor. */
+				uint16_t       ConfigDescriptorSize; /**< Size in bytes of the indexed configuration descriptor. */
+				uint16_t       ParsedSize; /**< Number of bytes of well formed descriptors at the start of the configuration
+				                            *   descriptor, which are searched by the index search functions.
+				                            */
+				#if defined(USE_CONFIG_DESCRIPTOR_INDEX) || defined(__DOXYGEN__)
+				uint16_t       Checksum; /**< Checksum of the indexed configuration descriptor's contents. */
+				uint8_t        TotalInterfaces; /**< Number of interface descriptors recorded in the index. */
+				uint8_t        TotalEndpoints; /**< Number of endpoint descriptors recorded in the index. */
+				bool           Truncated; /**< Indicates that the configuration descriptor contained more interfaces or
+				                           *   endpoints than the index could hold, so that the index search functions
+				                           *   must walk the configuration descriptor instead of the index tables.
+				                           */
+				USB_ConfigIndex_Interface_t Interfaces[USB_CONFIG_INDEX_MAX_INTERFACES]; /**< Interface entry table. */
+				uint16_t       EndpointOffsets[USB_CONFIG_INDEX_MAX_ENDPOINTS]; /**< Endpoint descriptor offset table. */
+				#endif
+			} USB_ConfigIndex_t;
+
 		/* Enums: */
 			/** Enum for the possible return codes of the \ref USB_Host_GetDeviceConfigDescriptor() function. */
 			enum USB_Host_GetConfigDescriptor_ErrorCodes_t
@@ -255,6 +338,94 @@
 			                                  ConfigComparatorPtr_t const ComparatorRoutine) ATTR_NON_NULL_PTR_ARG(1)
 			                                  ATTR_NON_NULL_PTR_ARG(2) ATTR_NON_NULL_PTR_ARG(3);
 
+			#if defined(USB_CAN_BE_HOST) || defined(__DOXYGEN__)
+				/** Validates the given configuration descriptor and returns an index for it, which can then be searched with
+				 *  \ref USB_ConfigIndex_FindNextInterface(), \ref USB_ConfigIndex_FindNextEndpoint() and
+				 *  \ref USB_ConfigIndex_FindClassDescriptor().
+				 *
+				 *  When the \c USE_CONFIG_DESCRIPTOR_INDEX token is defined, the index tables are built in a single pass, or the
+				 *  existing index is returned if the same configuration descriptor has already been indexed, allowing several
+				 *  class drivers to share the result of a single walk over a large composite device's configuration descriptor.
+				 *  The library maintains a single index, keyed on the configuration descriptor's location, size and a checksum
+				 *  of its contents, so that it is rebuilt whenever a different or modified configuration descriptor is given.
+				 *
+				 *  \param[in] ConfigDescriptorSize  Size in bytes of the configuration descriptor.
+				 *  \param[in] ConfigDescriptorData  Pointer to the start of the configuration descriptor.
+				 *
+				 *  \return Pointer to the configuration descriptor index, or \c NULL if the given data does not start with a
+				 *          configuration descriptor.
+				 */
+				const USB_ConfigIndex_t* USB_GetConfigIndex(const uint16_t ConfigDescriptorSize,
+				                                            const void* const ConfigDescriptorData) ATTR_NON_NULL_PTR_ARG(2);
+
+				/** Discards the library's configuration descriptor index, so that the next call to \ref USB_GetConfigIndex()
+				 *  rebuilds it from the given configuration descriptor. This is called automatically by
+				 *  \ref USB_Host_GetDeviceConfigDescriptor().
+				 *
+				 *  \note This function has no effect unless the \c USE_CONFIG_DESCRIPTOR_INDEX token is defined.
+				 */
+				void USB_InvalidateConfigIndex(void);
+
+				/** Searches a configuration descriptor index for the next interface descriptor after the given interface which
+				 *  matches the given comparator function. Comparator functions are as used with \ref USB_GetNextDescriptorComp(),
+				 *  and are only ever passed interface descriptors.
+				 *
+				 *  \param[in] ConfigIndex        Pointer to the configuration descriptor index to search.
+				 *  \param[in] PrevInterface      Index of the interface to start the search after, or \ref USB_CONFIG_INDEX_NONE
+				 *                                to search from the first indexed interface.
+				 *  \param[in] ComparatorRoutine  Name of the comparator search function to use on each interface descriptor.
+				 *
+				 *  \return Index of the matching interface, or \ref USB_CONFIG_INDEX_NONE if no further interface matches.
+				 */
+				uint8_t USB_ConfigIndex_FindNextInterface(const USB_ConfigIndex_t* const ConfigIndex,
+				                                          const uint8_t PrevInterface,
+				                                          ConfigComparatorPtr_t const ComparatorRoutine) ATTR_NON_NULL_PTR_ARG(1)
+				                                          ATTR_NON_NULL_PTR_ARG(3);
+
+				/** Searches the endpoints belonging to an indexed interface for the next endpoint descriptor which matches the
+				 *  given comparator function. Comparator functions are as used with \ref USB_GetNextDescriptorComp(), and are
+				 *  only ever passed endpoint descriptors.
+				 *
+				 *  \param[in]     ConfigIndex        Pointer to the configuration descriptor index to search.
+				 *  \param[in]     Interface          Index of the interface whose endpoints are to be searched.
+				 *  \param[in,out] EndpointCursor     Pointer to the number of the interface's endpoints already searched, which
+				 *                                    should be zero for the first search and is updated by each call.
+				 *  \param[in]     ComparatorRoutine  Name of the comparator search function to use on each endpoint descriptor.
+				 *
+				 *  \return Pointer to the matching endpoint descriptor, or \c NULL if no further endpoint matches.
+				 */
+				USB_Descriptor_Endpoint_t* USB_ConfigIndex_FindNextEndpoint(const USB_ConfigIndex_t* const ConfigIndex,
+				                                                            const uint8_t Interface,
+				                                                            uint8_t* const EndpointCursor,
+				                                                            ConfigComparatorPtr_t const ComparatorRoutine)
+				                                                            ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(3)
+				                                                            ATTR_NON_NULL_PTR_ARG(4);
+
+				/** Retrieves the first class-specific descriptor of the given type belonging to an indexed interface.
+				 *
+				 *  \param[in] ConfigIndex  Pointer to the configuration descriptor index to search.
+				 *  \param[in] Interface    Index of the interface whose class-specific descriptors are to be searched.
+				 *  \param[in] Type         Descriptor type value to search for.
+				 *
+				 *  \return Pointer to the matching descriptor, or \c NULL if the interface has no descriptor of the given type.
+				 */
+				void* USB_ConfigIndex_FindClassDescriptor(const USB_ConfigIndex_t* const ConfigIndex,
+				                                          const uint8_t Interface,
+				                                          const uint8_t Type) ATTR_NON_NULL_PTR_ARG(1);
+
+				/** Retrieves a pointer to an indexed interface descriptor.
+				 *
+				 *  \param[in] ConfigIndex  Pointer to the configuration descriptor index.
+				 *  \param[in] Interface    Index of the interface within the configuration descriptor index, as returned by
+				 *                          \ref USB_ConfigIndex_FindNextInterface().
+				 *
+				 *  \return Pointer to the interface descriptor within the indexed configuration descriptor.
+				 */
+				USB_Descriptor_Interface_t* USB_ConfigIndex_GetInterface(const USB_ConfigIndex_t* const ConfigIndex,
+				                                                         const uint8_t Interface) ATTR_WARN_UNUSED_RESULT
+				                                                         ATTR_NON_NULL_PTR_ARG(1);
+			#endif
+
 		/* Inline Functions: */
 			/** Skips over the current sub-descriptor inside the configuration descriptor, so that the pointer then
 			    points to the next sub-descriptor. The bytes remaining value is automatically decremented.
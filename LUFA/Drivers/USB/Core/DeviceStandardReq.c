@@ -389,5 +389,111 @@ static void USB_Device_ClearSetFeature(void)
 	Endpoint_ClearStatusStage();
 }
 
+bool USB_IsDescriptorTableSorted(const USB_Descriptor_TableEntry_t* const Table,
+                                 const uint8_t TotalEntries)
+{
+	uint16_t PrevValue = 0;
+
+	for (uint8_t EntryIndex = 0; EntryIndex < TotalEntries; EntryIndex++)
+	{
+		uint16_t EntryValue = pgm_read_word(&Table[EntryIndex].wValue);
+
+		if (EntryValue < PrevValue)
+		  return false;
+
+		PrevValue = EntryValue;
+	}
+
+	return true;
+}
+
+uint16_t USB_GetDescriptorFromTable(const USB_Descriptor_TableEntry_t* const Table,
+                                    const uint8_t TotalEntries,
+                                    const uint16_t wValue,
+                                    const uint16_t wIndex,
+                                    const void** const DescriptorAddress
+#if defined(ARCH_HAS_MULTI_ADDRESS_SPACE) && \
+    !(defined(USE_FLASH_DESCRIPTORS) || defined(USE_EEPROM_DESCRIPTORS) || defined(USE_RAM_DESCRIPTORS))
+                                    , uint8_t* const DescriptorMemorySpace
+#endif
+                                    )
+{
+	USB_Descriptor_TableEntry_t Entry;
+
+	#if !defined(NDEBUG)
+	static const USB_Descriptor_TableEntry_t* SortedTable = NULL;
+
+	/* An unsorted table would silently hide some of its descriptors from the binary search, so refuse all requests;
+	 * the table is only verified on its first lookup, and again only if the application switches between tables */
+	if (Table != SortedTable)
+	{
+		if (!(USB_IsDescriptorTableSorted(Table, TotalEntries)))
+		{
+			*DescriptorAddress = NULL;
+			return NO_DESCRIPTOR;
+		}
+
+		SortedTable = Table;
+	}
+	#endif
+
+	uint8_t LowerBound = 0;
+	uint8_t UpperBound = TotalEntries;
+
+	/* Binary search for the first entry with the requested wValue */
+	while (LowerBound < UpperBound)
+	{
+		uint8_t MiddleEntry = (LowerBound + ((UpperBound - LowerBound) >> 1));
+
+		memcpy_P(&Entry, &Table[MiddleEntry], sizeof(USB_Descriptor_TableEntry_t));
+
+		if (Entry.wValue < wValue)
+		  LowerBound = (MiddleEntry + 1);
+		else
+		  UpperBound = MiddleEntry;
+	}
+
+	while (LowerBound < TotalEntries)
+	{
+		memcpy_P(&Entry, &Table[LowerBound++], sizeof(USB_Descriptor_TableEntry_t));
+
+		if (Entry.wValue != wValue)
+		  break;
+
+		if ((Entry.wIndex != USB_DESCRIPTOR_ANY_INDEX) && (Entry.wIndex != wIndex))
+		  continue;
+
+		*DescriptorAddress = Entry.Address;
+
+		#if defined(ARCH_HAS_MULTI_ADDRESS_SPACE) && \
+		    !(defined(USE_FLASH_DESCRIPTORS) || defined(USE_EEPROM_DESCRIPTORS) || defined(USE_RAM_DESCRIPTORS))
+		*DescriptorMemorySpace = Entry.MemorySpace;
+		#endif
+
+		if (Entry.Size != USB_DESCRIPTOR_SIZE_FROM_HEADER)
+		  return Entry.Size;
+
+		const uint8_t* DescriptorLength = &((const USB_Descriptor_Header_t*)Entry.Address)->Size;
+
+		#if defined(USE_RAM_DESCRIPTORS) || !defined(ARCH_HAS_MULTI_ADDRESS_SPACE)
+		return *DescriptorLength;
+		#elif defined(USE_EEPROM_DESCRIPTORS)
+		return eeprom_read_byte(DescriptorLength);
+		#elif defined(USE_FLASH_DESCRIPTORS)
+		return pgm_read_byte(DescriptorLength);
+		#else
+		if (Entry.MemorySpace == MEMSPACE_FLASH)
+		  return pgm_read_byte(DescriptorLength);
+		else if (Entry.MemorySpace == MEMSPACE_EEPROM)
+		  return eeprom_read_byte(DescriptorLength);
+		else
+		  return *DescriptorLength;
+		#endif
+	}
+
+	*DescriptorAddress = NULL;
+	return NO_DESCRIPTOR;
+}
+
 #endif
 
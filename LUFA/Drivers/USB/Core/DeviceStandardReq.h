@@ -61,6 +61,57 @@
 		#endif
 
 	/* Public Interface - May be used in end-application: */
+		/* Macros: */
+			/** Value for the \c wIndex field of a \ref USB_Descriptor_TableEntry_t, indicating that the entry matches a
+			 *  descriptor request regardless of the request's \c wIndex value.
+			 *
+			 *  \ingroup Group_Device
+			 */
+			#define USB_DESCRIPTOR_ANY_INDEX            0xFFFF
+
+			/** Value for the \c Size field of a \ref USB_Descriptor_TableEntry_t, indicating that the size of the descriptor
+			 *  should be read from the length field of its standard descriptor header when it is requested. This is required
+			 *  for variable length descriptors such as \ref USB_Descriptor_String_t, whose size cannot be determined via
+			 *  \c sizeof().
+			 *
+			 *  \ingroup Group_Device
+			 */
+			#define USB_DESCRIPTOR_SIZE_FROM_HEADER     0
+
+			/** Convenience macro to create a \ref USB_Descriptor_TableEntry_t for a fixed size descriptor, which matches
+			 *  requests for the given descriptor type and number regardless of the request's \c wIndex value.
+			 *
+			 *  \param[in] Type        Type of the descriptor, a value from the \ref USB_DescriptorTypes_t enum or a
+			 *                         class-specific descriptor type.
+			 *  \param[in] Number      Index of the descriptor within its type.
+			 *  \param[in] Descriptor  Descriptor variable the entry refers to, whose size is taken via \c sizeof().
+			 *
+			 *  \ingroup Group_Device
+			 */
+			#define USB_DESCRIPTOR_TABLE_ENTRY(Type, Number, Descriptor) \
+			    { .wValue = (((Type) << 8) | (Number)), .wIndex = USB_DESCRIPTOR_ANY_INDEX, .Address = &(Descriptor), .Size = sizeof(Descriptor) }
+
+			/** Convenience macro to create a \ref USB_Descriptor_TableEntry_t for a string descriptor created via
+			 *  \ref USB_STRING_DESCRIPTOR() or \ref USB_STRING_DESCRIPTOR_ARRAY(), which matches requests for the given
+			 *  string index in any language.
+			 *
+			 *  \param[in] Number      Index of the string descriptor.
+			 *  \param[in] Descriptor  String descriptor variable the entry refers to.
+			 *
+			 *  \ingroup Group_Device
+			 */
+			#define USB_DESCRIPTOR_TABLE_STRING(Number, Descriptor) \
+			    { .wValue = ((DTYPE_String << 8) | (Number)), .wIndex = USB_DESCRIPTOR_ANY_INDEX, .Address = &(Descriptor), .Size = USB_DESCRIPTOR_SIZE_FROM_HEADER }
+
+			/** Retrieves the number of entries in a descriptor table array, for passing to
+			 *  \ref USB_GetDescriptorFromTable().
+			 *
+			 *  \param[in] Table  Descriptor table array of \ref USB_Descriptor_TableEntry_t elements.
+			 *
+			 *  \ingroup Group_Device
+			 */
+			#define USB_DESCRIPTOR_TABLE_SIZE(Table)    (sizeof(Table) / sizeof(Table[0]))
+
 		/* Enums: */
 			#if defined(ARCH_HAS_MULTI_ADDRESS_SPACE) || defined(__DOXYGEN__)
 				/** Enum for the possible descriptor memory spaces, for the \c MemoryAddressSpace parameter of the
@@ -81,6 +132,48 @@
 				};
 			#endif
 
+		/* Type Defines: */
+			/** \brief Descriptor Table Entry.
+			 *
+			 *  Type define for an entry in a descriptor table, which maps a descriptor request onto the location and size
+			 *  of the descriptor to return. Descriptor tables are searched via \ref USB_GetDescriptorFromTable(), which
+			 *  can be used to implement \ref CALLBACK_USB_GetDescriptor() without a hand-written dispatch on the request.
+			 *
+			 *  Descriptor tables must be located in FLASH memory via the \c PROGMEM attribute, and their entries must be
+			 *  sorted in ascending order of \c wValue (i.e. by descriptor type, then by descriptor number). Several entries
+			 *  may share the same \c wValue if they differ in their \c wIndex value, such as for strings in several languages.
+			 *  Unless \c NDEBUG is defined, the order is verified via \ref USB_IsDescriptorTableSorted() on the first lookup
+			 *  of each table.
+			 *
+			 *  Use of a descriptor table is optional; applications may continue to implement \ref CALLBACK_USB_GetDescriptor()
+			 *  with their own dispatch on the request, as most of the library demos do.
+			 *
+			 *  \ingroup Group_Device
+			 */
+			typedef struct
+			{
+				uint16_t    wValue; /**< Descriptor type in the upper byte and descriptor number in the lower byte, as given in
+				                     *   the \c wValue field of a GET DESCRIPTOR request.
+				                     */
+				uint16_t    wIndex; /**< Value of the request's \c wIndex field the entry matches, such as a string language
+				                     *   ID, or \ref USB_DESCRIPTOR_ANY_INDEX to match any value.
+				                     */
+				const void* Address; /**< Location of the descriptor in memory. */
+				uint16_t    Size; /**< Size of the descriptor in bytes, or \ref USB_DESCRIPTOR_SIZE_FROM_HEADER to read the size
+				                   *   from the descriptor's header.
+				                   */
+				#if (defined(ARCH_HAS_MULTI_ADDRESS_SPACE) || defined(__DOXYGEN__)) && \
+				    !(defined(USE_FLASH_DESCRIPTORS) || defined(USE_EEPROM_DESCRIPTORS) || defined(USE_RAM_DESCRIPTORS))
+				uint8_t     MemorySpace; /**< Memory space of the descriptor, a value from the \ref USB_DescriptorMemorySpaces_t
+				                          *   enum. This defaults to \ref MEMSPACE_FLASH in entries created via the table entry
+				                          *   macros.
+				                          *
+				                          *   \note This field is only present on architectures with multiple address spaces
+				                          *         when none of the \c USE_*_DESCRIPTORS compile time options are used.
+				                          */
+				#endif
+			} USB_Descriptor_TableEntry_t;
+
 		/* Global Variables: */
 			/** Indicates the currently set configuration number of the device. USB devices may have several
 			 *  different configurations which the host can select between; this indicates the currently selected
@@ -120,6 +213,51 @@
 				extern bool USB_Device_CurrentlySelfPowered;
 			#endif
 
+		/* Function Prototypes: */
+			/** Verifies that the entries of a descriptor table are sorted in ascending order of \c wValue, as required by
+			 *  \ref USB_GetDescriptorFromTable(). This is checked automatically on the first lookup of each table unless the
+			 *  \c NDEBUG token is defined, but may also be called by the application, for example from a start-up self test.
+			 *
+			 *  \param[in] Table         Pointer to the start of the descriptor table, located in FLASH memory.
+			 *  \param[in] TotalEntries  Number of entries in the table, see \ref USB_DESCRIPTOR_TABLE_SIZE().
+			 *
+			 *  \return Boolean \c true if the table is correctly sorted, \c false otherwise.
+			 *
+			 *  \ingroup Group_Device
+			 */
+			bool USB_IsDescriptorTableSorted(const USB_Descriptor_TableEntry_t* const Table,
+			                                 const uint8_t TotalEntries) ATTR_WARN_UNUSED_RESULT ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Searches a sorted descriptor table for the descriptor matching the given GET DESCRIPTOR request values,
+			 *  via a binary search on the request's \c wValue. The parameters and return value of this function match
+			 *  those of \ref CALLBACK_USB_GetDescriptor(), so that the callback may simply return the result of this
+			 *  function for the application's descriptor table.
+			 *
+			 *  \param[in]  Table                  Pointer to the start of the descriptor table, located in FLASH memory.
+			 *  \param[in]  TotalEntries           Number of entries in the table, see \ref USB_DESCRIPTOR_TABLE_SIZE().
+			 *  \param[in]  wValue                 The \c wValue field of the descriptor request.
+			 *  \param[in]  wIndex                 The \c wIndex field of the descriptor request.
+			 *  \param[out] DescriptorAddress      Location where the address of the matching descriptor is to be stored.
+			 *  \param[out] DescriptorMemorySpace  Location where the memory space of the matching descriptor is to be stored.
+			 *                                     This parameter does not exist when one of the \c USE_*_DESCRIPTORS compile
+			 *                                     time options is used, or on architectures which use a unified address space.
+			 *
+			 *  \return Size in bytes of the matching descriptor, or \ref NO_DESCRIPTOR if no entry matches the request, or if
+			 *          \c NDEBUG is not defined and the table is not sorted.
+			 *
+			 *  \ingroup Group_Device
+			 */
+			uint16_t USB_GetDescriptorFromTable(const USB_Descriptor_TableEntry_t* const Table,
+			                                    const uint8_t TotalEntries,
+			                                    const uint16_t wValue,
+			                                    const uint16_t wIndex,
+			                                    const void** const DescriptorAddress
+			#if (defined(ARCH_HAS_MULTI_ADDRESS_SPACE) || defined(__DOXYGEN__)) && \
+			    !(defined(USE_FLASH_DESCRIPTORS) || defined(USE_EEPROM_DESCRIPTORS) || defined(USE_RAM_DESCRIPTORS))
+			                                    , uint8_t* const DescriptorMemorySpace
+			#endif
+			                                    ) ATTR_WARN_UNUSED_RESULT ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(5);
+
 	/* Private Interface - For use in library only: */
 	#if !defined(__DOXYGEN__)
 		#if defined(USE_RAM_DESCRIPTORS) && defined(USE_EEPROM_DESCRIPTORS)
@@ -0,0 +1,273 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2018.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2018  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+
+#define  __INCLUDE_FROM_USB_DRIVER
+#include "USBMode.h"
+
+#if defined(USB_CAN_BE_HOST) && defined(HOST_ENUM_CACHE)
+
+#define  __INCLUDE_FROM_ENUMERATIONCACHE_C
+#include "EnumerationCache.h"
+
+static uint16_t USB_Host_UpdateEnumCacheCRC(uint16_t CRC,
+                                            const void* const Data,
+                                            uint16_t Length)
+{
+	const uint8_t* DataPtr = (const uint8_t*)Data;
+
+	while (Length--)
+	{
+		CRC ^= *(DataPtr++);
+
+		for (uint8_t Bit = 0; Bit < 8; Bit++)
+		  CRC = (CRC & 0x0001) ? ((CRC >> 1) ^ 0x8408) : (CRC >> 1);
+	}
+
+	return CRC;
+}
+
+static inline uint16_t USB_Host_GetEnumCacheSlotOffset(const uint8_t Slot)
+{
+	return ((uint16_t)Slot * HOST_ENUM_CACHE_SLOT_SIZE);
+}
+
+static uint16_t USB_Host_GetEnumCacheChecksum(const USB_Host_EnumCacheHeader_t* const Header,
+                                              const void* const Data)
+{
+	uint16_t CRC = USB_Host_UpdateEnumCacheCRC(0xFFFF, Header, offsetof(USB_Host_EnumCacheHeader_t, Checksum));
+
+	return USB_Host_UpdateEnumCacheCRC(CRC, Data, Header->DataSize);
+}
+
+static bool USB_Host_ReadEnumCacheSlot(const uint8_t Slot,
+                                       USB_Host_EnumCacheHeader_t* const Header)
+{
+	uint16_t Offset = USB_Host_GetEnumCacheSlotOffset(Slot);
+
+	CALLBACK_USB_Host_ReadEnumCache(Offset, Header, sizeof(USB_Host_EnumCacheHeader_t));
+
+	if (Header->DataSize > HOST_ENUM_CACHE_DATA_SIZE)
+	  return false;
+
+	uint16_t CRC            = USB_Host_UpdateEnumCacheCRC(0xFFFF, Header, offsetof(USB_Host_EnumCacheHeader_t, Checksum));
+	uint8_t  BytesRemaining = Header->DataSize;
+
+	Offset += sizeof(USB_Host_EnumCacheHeader_t);
+
+	while (BytesRemaining)
+	{
+		uint8_t Chunk[8];
+		uint8_t ChunkSize = MIN(BytesRemaining, sizeof(Chunk));
+
+		CALLBACK_USB_Host_ReadEnumCache(Offset, Chunk, ChunkSize);
+		CRC = USB_Host_UpdateEnumCacheCRC(CRC, Chunk, ChunkSize);
+
+		Offset         += ChunkSize;
+		BytesRemaining -= ChunkSize;
+	}
+
+	return (CRC == Header->Checksum);
+}
+
+static uint8_t USB_Host_FindEnumCacheSlot(const USB_Host_EnumCacheKey_t* const Key,
+                                          USB_Host_EnumCacheHeader_t* const Header)
+{
+	for (uint8_t Slot = 0; Slot < HOST_ENUM_CACHE_SLOTS; Slot++)
+	{
+		if (!(USB_Host_ReadEnumCacheSlot(Slot, Header)))
+		  continue;
+
+		if (memcmp(&Header->Key, Key, sizeof(USB_Host_EnumCacheKey_t)) == 0)
+		  return Slot;
+	}
+
+	return HOST_ENUM_CACHE_SLOTS;
+}
+
+static void USB_Host_EraseEnumCacheSlot(const uint8_t Slot)
+{
+	uint8_t InvalidDataSize = 0xFF;
+
+	CALLBACK_USB_Host_WriteEnumCache(USB_Host_GetEnumCacheSlotOffset(Slot) + offsetof(USB_Host_EnumCacheHeader_t, DataSize),
+	                                 &InvalidDataSize, sizeof(InvalidDataSize));
+}
+
+uint8_t USB_Host_GetEnumCacheKey(const uint8_t ConfigNumber,
+                                 USB_Host_EnumCacheKey_t* const Key)
+{
+	uint8_t                               ErrorCode;
+	USB_Descriptor_Device_t               DeviceDescriptor;
+	USB_Descriptor_Configuration_Header_t ConfigHeader;
+
+	if ((ErrorCode = USB_Host_GetDeviceDescriptor(&DeviceDescriptor)) != HOST_SENDCONTROL_Successful)
+	  return ErrorCode;
+
+	if ((ErrorCode = USB_Host_GetDescriptor(DTYPE_Configuration, (ConfigNumber - 1), &ConfigHeader,
+	                                        sizeof(USB_Descriptor_Configuration_Header_t))) != HOST_SENDCONTROL_Successful)
+	{
+		return ErrorCode;
+	}
+
+	if ((DeviceDescriptor.Header.Type != DTYPE_Device) || (ConfigHeader.Header.Type != DTYPE_Configuration))
+	  return HOST_GETCONFIG_InvalidData;
+
+	Key->VendorID      = le16_to_cpu(DeviceDescriptor.VendorID);
+	Key->ProductID     = le16_to_cpu(DeviceDescriptor.ProductID);
+	Key->ReleaseNumber = le16_to_cpu(DeviceDescriptor.ReleaseNumber);
+	Key->ConfigHash    = USB_Host_UpdateEnumCacheCRC(0xFFFF, &ConfigHeader, sizeof(USB_Descriptor_Configuration_Header_t));
+
+	return HOST_GETCONFIG_Successful;
+}
+
+bool USB_Host_LoadEnumCache(const USB_Host_EnumCacheKey_t* const Key,
+                            void* const Data,
+                            const uint8_t DataSize)
+{
+	USB_Host_EnumCacheHeader_t Header;
+
+	uint8_t Slot = USB_Host_FindEnumCacheSlot(Key, &Header);
+
+	if ((Slot == HOST_ENUM_CACHE_SLOTS) || (Header.DataSize != DataSize))
+	  return false;
+
+	CALLBACK_USB_Host_ReadEnumCache(USB_Host_GetEnumCacheSlotOffset(Slot) + sizeof(USB_Host_EnumCacheHeader_t),
+	                                Data, DataSize);
+
+	return true;
+}
+
+bool USB_Host_SaveEnumCache(const USB_Host_EnumCacheKey_t* const Key,
+                            const void* const Data,
+                            const uint8_t DataSize)
+{
+	USB_Host_EnumCacheHeader_t Header;
+
+	uint8_t  MatchingSlot   = HOST_ENUM_CACHE_SLOTS;
+	uint8_t  FreeSlot       = HOST_ENUM_CACHE_SLOTS;
+	uint8_t  OldestSlot     = 0;
+	uint16_t OldestSequence = 0;
+	uint16_t NewestSequence = 0;
+	bool     CacheEmpty     = true;
+
+	if (DataSize > HOST_ENUM_CACHE_DATA_SIZE)
+	  return false;
+
+	for (uint8_t Slot = 0; Slot < HOST_ENUM_CACHE_SLOTS; Slot++)
+	{
+		if (!(USB_Host_ReadEnumCacheSlot(Slot, &Header)))
+		{
+			if (FreeSlot == HOST_ENUM_CACHE_SLOTS)
+			  FreeSlot = Slot;
+
+			continue;
+		}
+
+		if (memcmp(&Header.Key, Key, sizeof(USB_Host_EnumCacheKey_t)) == 0)
+		{
+			MatchingSlot = Slot;
+
+			if (Header.DataSize == DataSize)
+			{
+				/* Skip the rewrite if the existing entry already holds the given data, to avoid wearing the storage */
+				uint16_t ExistingChecksum = Header.Checksum;
+
+				if (USB_Host_GetEnumCacheChecksum(&Header, Data) == ExistingChecksum)
+				{
+					const uint8_t* DataPtr   = (const uint8_t*)Data;
+					uint16_t       Offset    = (USB_Host_GetEnumCacheSlotOffset(Slot) + sizeof(USB_Host_EnumCacheHeader_t));
+					bool           DataMatch = true;
+
+					for (uint8_t i = 0; (i < DataSize) && DataMatch; i++)
+					{
+						uint8_t StoredByte;
+
+						CALLBACK_USB_Host_ReadEnumCache(Offset++, &StoredByte, sizeof(StoredByte));
+						DataMatch = (StoredByte == DataPtr[i]);
+					}
+
+					if (DataMatch)
+					  return true;
+				}
+			}
+		}
+
+		if (CacheEmpty || ((int16_t)(Header.Sequence - NewestSequence) > 0))
+		  NewestSequence = Header.Sequence;
+
+		if (CacheEmpty || ((int16_t)(Header.Sequence - OldestSequence) < 0))
+		{
+			OldestSequence = Header.Sequence;
+			OldestSlot     = Slot;
+		}
+
+		CacheEmpty = false;
+	}
+
+	uint8_t TargetSlot = OldestSlot;
+
+	if (MatchingSlot != HOST_ENUM_CACHE_SLOTS)
+	  TargetSlot = MatchingSlot;
+	else if (FreeSlot != HOST_ENUM_CACHE_SLOTS)
+	  TargetSlot = FreeSlot;
+
+	Header.Key      = *Key;
+	Header.Sequence = (CacheEmpty ? 0 : (NewestSequence + 1));
+	Header.DataSize = DataSize;
+	Header.Checksum = USB_Host_GetEnumCacheChecksum(&Header, Data);
+
+	uint16_t Offset = USB_Host_GetEnumCacheSlotOffset(TargetSlot);
+
+	/* Invalidate the slot before it is rewritten, so that an interrupted write cannot leave a valid stale entry */
+	USB_Host_EraseEnumCacheSlot(TargetSlot);
+	CALLBACK_USB_Host_WriteEnumCache(Offset + sizeof(USB_Host_EnumCacheHeader_t), Data, DataSize);
+	CALLBACK_USB_Host_WriteEnumCache(Offset, &Header, sizeof(USB_Host_EnumCacheHeader_t));
+
+	return true;
+}
+
+void USB_Host_InvalidateEnumCache(const USB_Host_EnumCacheKey_t* const Key)
+{
+	USB_Host_EnumCacheHeader_t Header;
+
+	uint8_t Slot = USB_Host_FindEnumCacheSlot(Key, &Header);
+
+	if (Slot != HOST_ENUM_CACHE_SLOTS)
+	  USB_Host_EraseEnumCacheSlot(Slot);
+}
+
+void USB_Host_ClearEnumCache(void)
+{
+	for (uint8_t Slot = 0; Slot < HOST_ENUM_CACHE_SLOTS; Slot++)
+	  USB_Host_EraseEnumCacheSlot(Slot);
+}
+
+#endif
+
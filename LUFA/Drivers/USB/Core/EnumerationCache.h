@@ -0,0 +1,228 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2018.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2018  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+
+/** \file
+ *  \brief USB host persistent enumeration cache.
+ *
+ *  This file contains structures, function prototypes and macros related to the caching of the parsed configuration
+ *  of attached devices in non-volatile memory when the library is in USB host mode.
+ *
+ *  \note This file should not be included directly. It is automatically included as needed by the USB driver
+ *        dispatch header located in LUFA/Drivers/USB/USB.h.
+ */
+
+/** \ingroup Group_USB
+ *  \defgroup Group_EnumerationCache Enumeration Cache
+ *  \brief Persistent cache of parsed device configurations for USB host mode.
+ *
+ *  Functions, macros, variables, enums and types related to the caching of the parsed configuration of attached
+ *  devices in non-volatile memory. Normally a host application retrieves and parses the complete configuration
+ *  descriptor of a device each time it is attached, before configuring the pipes required to communicate with it. When
+ *  devices are frequently re-attached, this can instead be shortened to a small verification read of the device
+ *  descriptor and configuration descriptor header via \ref USB_Host_GetEnumCacheKey(), followed by a restore of the
+ *  previously parsed class driver configuration and state via \ref USB_Host_LoadEnumCache().
+ *
+ *  Cache entries are keyed by the device's Vendor ID, Product ID and release number, along with a hash of its
+ *  configuration descriptor header. Each entry holds an opaque block of application data, typically the class driver
+ *  interface structure as it was after a successful call to the class driver's \c ConfigurePipes() function. When
+ *  the cache is full, the oldest entry is replaced. Entries are only rewritten when their contents change, so that
+ *  repeated attachment of a known device does not wear the underlying memory.
+ *
+ *  The cache is stored in application provided non-volatile memory, such as the AVR's internal EEPROM or an external
+ *  Dataflash, which is accessed via the \ref CALLBACK_USB_Host_ReadEnumCache() and
+ *  \ref CALLBACK_USB_Host_WriteEnumCache() functions. The application must reserve at least
+ *  \ref HOST_ENUM_CACHE_STORAGE_SIZE bytes of storage for the cache.
+ *
+ *  \note The enumeration cache is only available when the \c HOST_ENUM_CACHE compile time token is defined. The cached
+ *        data is stored in the native layout of the application's structures, and so the cache should be cleared via
+ *        \ref USB_Host_ClearEnumCache() if the layout of the cached structures changes in a new firmware version.
+ *
+ *  @{
+ */
+
+#ifndef __ENUMERATIONCACHE_H__
+#define __ENUMERATIONCACHE_H__
+
+	/* Includes: */
+		#include "../../../Common/Common.h"
+		#include "USBMode.h"
+		#include "StdDescriptors.h"
+		#include "HostStandardReq.h"
+
+	/* Enable C linkage for C++ Compilers: */
+		#if defined(__cplusplus)
+			extern "C" {
+		#endif
+
+	/* Preprocessor Checks: */
+		#if !defined(__INCLUDE_FROM_USB_DRIVER)
+			#error Do not include this file directly. Include LUFA/Drivers/USB/USB.h instead.
+		#endif
+
+	#if defined(HOST_ENUM_CACHE) || defined(__DOXYGEN__)
+	/* Public Interface - May be used in end-application: */
+		/* Macros: */
+			#if !defined(HOST_ENUM_CACHE_SLOTS) || defined(__DOXYGEN__)
+				/** Number of device entries which can be held in the enumeration cache at the one time. This value may be
+				 *  overridden in the user project makefile as the value of the \c HOST_ENUM_CACHE_SLOTS token, and passed
+				 *  to the compiler using the -D switch.
+				 */
+				#define HOST_ENUM_CACHE_SLOTS           4
+			#endif
+
+			#if !defined(HOST_ENUM_CACHE_DATA_SIZE) || defined(__DOXYGEN__)
+				/** Maximum size in bytes of the application data which can be stored in each enumeration cache entry. This
+				 *  value may be overridden in the user project makefile as the value of the \c HOST_ENUM_CACHE_DATA_SIZE token,
+				 *  and passed to the compiler using the -D switch.
+				 */
+				#define HOST_ENUM_CACHE_DATA_SIZE       48
+			#endif
+
+			/** Size in bytes of a single entry of the enumeration cache in non-volatile memory. */
+			#define HOST_ENUM_CACHE_SLOT_SIZE           (sizeof(USB_Host_EnumCacheHeader_t) + HOST_ENUM_CACHE_DATA_SIZE)
+
+			/** Total size in bytes of the non-volatile storage which must be reserved by the application for the
+			 *  enumeration cache.
+			 */
+			#define HOST_ENUM_CACHE_STORAGE_SIZE        (HOST_ENUM_CACHE_SLOT_SIZE * HOST_ENUM_CACHE_SLOTS)
+
+		/* Type Defines: */
+			/** \brief Enumeration Cache Key.
+			 *
+			 *  Type define for the identity of an attached device as used to locate its entry in the enumeration cache,
+			 *  retrieved from the device via \ref USB_Host_GetEnumCacheKey().
+			 */
+			typedef struct
+			{
+				uint16_t VendorID; /**< Vendor ID of the attached device. */
+				uint16_t ProductID; /**< Product ID of the attached device. */
+				uint16_t ReleaseNumber; /**< Product release (\c bcdDevice) number of the attached device. */
+				uint16_t ConfigHash; /**< Hash of the configuration descriptor header of the selected device configuration. */
+			} ATTR_PACKED USB_Host_EnumCacheKey_t;
+
+		/* Function Prototypes: */
+			/** Retrieves the device descriptor and the header of the given configuration descriptor from the attached
+			 *  device, and constructs the enumeration cache key which identifies the device and configuration. This is a
+			 *  much shorter transfer than the retrieval of the complete configuration descriptor.
+			 *
+			 *  \note The control pipe is selected on exit of this function.
+			 *
+			 *  \param[in]  ConfigNumber  Device configuration descriptor number to verify, indexed from 1.
+			 *  \param[out] Key           Location where the constructed cache key is to be stored.
+			 *
+			 *  \return A value from the \ref USB_Host_GetConfigDescriptor_ErrorCodes_t enum.
+			 */
+			uint8_t USB_Host_GetEnumCacheKey(const uint8_t ConfigNumber,
+			                                 USB_Host_EnumCacheKey_t* const Key) ATTR_NON_NULL_PTR_ARG(2);
+
+			/** Searches the enumeration cache for an entry matching the given key, and if found, copies the entry's
+			 *  application data into the given buffer. The buffer is left untouched if no valid matching entry exists.
+			 *
+			 *  \param[in]  Key       Pointer to the cache key of the attached device.
+			 *  \param[out] Data      Buffer where the cached application data is to be stored.
+			 *  \param[in]  DataSize  Size of the application data in bytes, which must match the size it was stored with.
+			 *
+			 *  \return Boolean \c true if a matching entry was found and loaded, \c false otherwise.
+			 */
+			bool USB_Host_LoadEnumCache(const USB_Host_EnumCacheKey_t* const Key,
+			                            void* const Data,
+			                            const uint8_t DataSize) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+
+			/** Stores the given application data into the enumeration cache entry for the given key. If no entry for
+			 *  the key exists, a free entry is used, or the oldest entry is replaced if the cache is full. An existing
+			 *  entry which already holds identical data is not rewritten.
+			 *
+			 *  \param[in] Key       Pointer to the cache key of the attached device.
+			 *  \param[in] Data      Buffer containing the application data to store.
+			 *  \param[in] DataSize  Size of the application data in bytes, no larger than \ref HOST_ENUM_CACHE_DATA_SIZE.
+			 *
+			 *  \return Boolean \c true if the data is held in the cache, \c false if it is too large to be cached.
+			 */
+			bool USB_Host_SaveEnumCache(const USB_Host_EnumCacheKey_t* const Key,
+			                            const void* const Data,
+			                            const uint8_t DataSize) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+
+			/** Removes the enumeration cache entry for the given key, if one exists. This should be called if a device
+			 *  could not be brought up from its cached configuration, before falling back to a full enumeration.
+			 *
+			 *  \param[in] Key  Pointer to the cache key of the device whose entry is to be removed.
+			 */
+			void USB_Host_InvalidateEnumCache(const USB_Host_EnumCacheKey_t* const Key) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Removes all entries from the enumeration cache. */
+			void USB_Host_ClearEnumCache(void);
+
+			/** Enumeration cache storage read callback. This function MUST be overridden in the user application (added
+			 *  with full, identical prototype and name) so that the library can read from the non-volatile memory used to
+			 *  hold the enumeration cache.
+			 *
+			 *  \param[in]  Offset  Offset in bytes from the start of the cache storage to read from.
+			 *  \param[out] Buffer  Buffer where the read data is to be stored.
+			 *  \param[in]  Length  Number of bytes to read.
+			 */
+			void CALLBACK_USB_Host_ReadEnumCache(const uint16_t Offset,
+			                                     void* const Buffer,
+			                                     const uint16_t Length) ATTR_NON_NULL_PTR_ARG(2);
+
+			/** Enumeration cache storage write callback. This function MUST be overridden in the user application (added
+			 *  with full, identical prototype and name) so that the library can write to the non-volatile memory used to
+			 *  hold the enumeration cache.
+			 *
+			 *  \param[in] Offset  Offset in bytes from the start of the cache storage to write to.
+			 *  \param[in] Buffer  Buffer containing the data to write.
+			 *  \param[in] Length  Number of bytes to write.
+			 */
+			void CALLBACK_USB_Host_WriteEnumCache(const uint16_t Offset,
+			                                      const void* const Buffer,
+			                                      const uint16_t Length) ATTR_NON_NULL_PTR_ARG(2);
+
+	/* Private Interface - For use in library only: */
+	#if !defined(__DOXYGEN__)
+		/* Type Defines: */
+			typedef struct
+			{
+				USB_Host_EnumCacheKey_t Key;
+				uint16_t                Sequence;
+				uint8_t                 DataSize;
+				uint16_t                Checksum;
+			} ATTR_PACKED USB_Host_EnumCacheHeader_t;
+	#endif
+	#endif
+
+	/* Disable C linkage for C++ Compilers: */
+		#if defined(__cplusplus)
+			}
+		#endif
+
+#endif
+
+/** @} */
+
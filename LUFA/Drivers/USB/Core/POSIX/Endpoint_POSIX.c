@@ -0,0 +1,267 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2018.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2018  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+#include "../../../../Common/Common.h"
+#if (ARCH == ARCH_POSIX)
+
+#define  __INCLUDE_FROM_USB_DRIVER
+#include "../USBMode.h"
+
+#if defined(USB_CAN_BE_DEVICE)
+
+#include "../Endpoint.h"
+
+#if !defined(FIXED_CONTROL_ENDPOINT_SIZE)
+uint8_t USB_Device_ControlEndpointSize = ENDPOINT_CONTROLEP_DEFAULT_SIZE;
+#endif
+
+Endpoint_FIFOPair_t USB_Endpoint_FIFOs[ENDPOINT_TOTAL_ENDPOINTS];
+
+uint8_t             USB_Endpoint_SelectedEndpoint;
+Endpoint_FIFO_t*    USB_Endpoint_SelectedFIFO = &USB_Endpoint_FIFOs[0].OUT;
+
+bool Endpoint_IsINReady(void)
+{
+	USB_VirtualHost_Poll();
+
+	Endpoint_SelectEndpoint(USB_Endpoint_SelectedEndpoint | ENDPOINT_DIR_IN);
+
+	return ((USB_Endpoint_SelectedFIFO->Flags & ENDPOINT_FIFO_FLAG_PACKET) ? false : true);
+}
+
+bool Endpoint_IsOUTReceived(void)
+{
+	USB_VirtualHost_Poll();
+
+	Endpoint_SelectEndpoint(USB_Endpoint_SelectedEndpoint & ~ENDPOINT_DIR_IN);
+
+	return ((USB_Endpoint_SelectedFIFO->Flags & ENDPOINT_FIFO_FLAG_PACKET) ? true : false);
+}
+
+bool Endpoint_IsStalled(void)
+{
+	USB_VirtualHost_Poll();
+
+	Endpoint_SelectEndpoint(USB_Endpoint_SelectedEndpoint);
+
+	return ((USB_Endpoint_SelectedFIFO->Flags & ENDPOINT_FIFO_FLAG_STALLED) ? true : false);
+}
+
+uint16_t Endpoint_GetEndpointInterrupts(void)
+{
+	uint16_t EndpointInterrupts = 0;
+
+	for (uint8_t EPNum = 0; EPNum < ENDPOINT_TOTAL_ENDPOINTS; EPNum++)
+	{
+		uint8_t INFlags  = USB_Endpoint_FIFOs[EPNum].IN.Flags;
+		uint8_t OUTFlags = USB_Endpoint_FIFOs[EPNum].OUT.Flags;
+
+		if (((INFlags & ENDPOINT_FIFO_FLAG_INTERRUPT) && !(INFlags & ENDPOINT_FIFO_FLAG_PACKET)) ||
+		    ((OUTFlags & ENDPOINT_FIFO_FLAG_INTERRUPT) && (OUTFlags & ENDPOINT_FIFO_FLAG_PACKET)))
+		{
+			EndpointInterrupts |= (1 << EPNum);
+		}
+	}
+
+	return EndpointInterrupts;
+}
+
+bool Endpoint_IsSETUPReceived(void)
+{
+	Endpoint_SelectEndpoint(USB_Endpoint_SelectedEndpoint & ~ENDPOINT_DIR_IN);
+
+	return ((USB_Endpoint_SelectedFIFO->Flags & ENDPOINT_FIFO_FLAG_SETUP) ? true : false);
+}
+
+void Endpoint_ClearSETUP(void)
+{
+	Endpoint_SelectEndpoint(USB_Endpoint_SelectedEndpoint & ~ENDPOINT_DIR_IN);
+	USB_Endpoint_SelectedFIFO->Flags   &= ~(ENDPOINT_FIFO_FLAG_SETUP | ENDPOINT_FIFO_FLAG_PACKET);
+	USB_Endpoint_SelectedFIFO->Length   = 0;
+	USB_Endpoint_SelectedFIFO->Position = 0;
+
+	Endpoint_SelectEndpoint(USB_Endpoint_SelectedEndpoint | ENDPOINT_DIR_IN);
+	USB_Endpoint_SelectedFIFO->Flags   &= ~ENDPOINT_FIFO_FLAG_PACKET;
+	USB_Endpoint_SelectedFIFO->Position = 0;
+
+	USB_INT_Clear(USB_INT_RXSTPI);
+}
+
+void Endpoint_ClearIN(void)
+{
+	USB_Endpoint_SelectedFIFO->Length   = USB_Endpoint_SelectedFIFO->Position;
+	USB_Endpoint_SelectedFIFO->Flags   |= ENDPOINT_FIFO_FLAG_PACKET;
+	USB_Endpoint_SelectedFIFO->Position = 0;
+}
+
+void Endpoint_ClearOUT(void)
+{
+	USB_Endpoint_SelectedFIFO->Flags   &= ~ENDPOINT_FIFO_FLAG_PACKET;
+	USB_Endpoint_SelectedFIFO->Length   = 0;
+	USB_Endpoint_SelectedFIFO->Position = 0;
+}
+
+void Endpoint_StallTransaction(void)
+{
+	USB_Endpoint_SelectedFIFO->Flags |= ENDPOINT_FIFO_FLAG_STALLED;
+
+	if (USB_Endpoint_SelectedFIFO->Type == EP_TYPE_CONTROL)
+	{
+		Endpoint_SelectEndpoint(USB_Endpoint_SelectedEndpoint ^ ENDPOINT_DIR_IN);
+		USB_Endpoint_SelectedFIFO->Flags |= ENDPOINT_FIFO_FLAG_STALLED;
+	}
+}
+
+void Endpoint_SelectEndpoint(const uint8_t Address)
+{
+	Endpoint_FIFOPair_t* EndpointFIFOPair = &USB_Endpoint_FIFOs[Address & ENDPOINT_EPNUM_MASK];
+
+	USB_Endpoint_SelectedEndpoint = Address;
+	USB_Endpoint_SelectedFIFO     = (Address & ENDPOINT_DIR_IN) ? &EndpointFIFOPair->IN : &EndpointFIFOPair->OUT;
+}
+
+bool Endpoint_ConfigureEndpointTable(const USB_Endpoint_Table_t* const Table,
+                                     const uint8_t Entries)
+{
+	for (uint8_t i = 0; i < Entries; i++)
+	{
+		if (!(Table[i].Address))
+		  continue;
+
+		if (!(Endpoint_ConfigureEndpoint(Table[i].Address, Table[i].Type, Table[i].Size, Table[i].Banks)))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool Endpoint_ConfigureEndpoint_PRV(const uint8_t Address,
+                                    const uint8_t Type,
+                                    const uint16_t Size)
+{
+	Endpoint_SelectEndpoint(Address);
+
+	USB_Endpoint_SelectedFIFO->Type     = Type;
+	USB_Endpoint_SelectedFIFO->Size     = Size;
+	USB_Endpoint_SelectedFIFO->Length   = 0;
+	USB_Endpoint_SelectedFIFO->Position = 0;
+	USB_Endpoint_SelectedFIFO->Flags    = ENDPOINT_FIFO_FLAG_CONFIGURED;
+
+	return true;
+}
+
+void Endpoint_ClearEndpoints(void)
+{
+	#if defined(ASYNC_ENDPOINT_TRANSFERS) && !defined(CONTROL_ONLY_DEVICE)
+	Endpoint_CancelTransfers();
+	#endif
+
+	for (uint8_t EPNum = 0; EPNum < ENDPOINT_TOTAL_ENDPOINTS; EPNum++)
+	{
+		USB_Endpoint_FIFOs[EPNum].IN.Flags  = 0;
+		USB_Endpoint_FIFOs[EPNum].OUT.Flags = 0;
+	}
+}
+
+void Endpoint_ClearStatusStage(void)
+{
+	if (USB_ControlRequest.bmRequestType & REQDIR_DEVICETOHOST)
+	{
+		while (!(Endpoint_IsOUTReceived()))
+		{
+			if (USB_DeviceState == DEVICE_STATE_Unattached)
+			  return;
+		}
+
+		Endpoint_ClearOUT();
+	}
+	else
+	{
+		while (!(Endpoint_IsINReady()))
+		{
+			if (USB_DeviceState == DEVICE_STATE_Unattached)
+			  return;
+		}
+
+		Endpoint_ClearIN();
+	}
+}
+
+#if !defined(CONTROL_ONLY_DEVICE)
+uint8_t Endpoint_WaitUntilReady(void)
+{
+	#if (USB_STREAM_TIMEOUT_MS < 0xFF)
+	uint8_t  TimeoutMSRem = USB_STREAM_TIMEOUT_MS;
+	#else
+	uint16_t TimeoutMSRem = USB_STREAM_TIMEOUT_MS;
+	#endif
+
+	uint16_t PreviousFrameNumber = USB_Device_GetFrameNumber();
+
+	for (;;)
+	{
+		if (Endpoint_GetEndpointDirection() == ENDPOINT_DIR_IN)
+		{
+			if (Endpoint_IsINReady())
+			  return ENDPOINT_READYWAIT_NoError;
+		}
+		else
+		{
+			if (Endpoint_IsOUTReceived())
+			  return ENDPOINT_READYWAIT_NoError;
+		}
+
+		uint8_t USB_DeviceState_LCL = USB_DeviceState;
+
+		if (USB_DeviceState_LCL == DEVICE_STATE_Unattached)
+		  return ENDPOINT_READYWAIT_DeviceDisconnected;
+		else if (USB_DeviceState_LCL == DEVICE_STATE_Suspended)
+		  return ENDPOINT_READYWAIT_BusSuspended;
+		else if (Endpoint_IsStalled())
+		  return ENDPOINT_READYWAIT_EndpointStalled;
+
+		uint16_t CurrentFrameNumber = USB_Device_GetFrameNumber();
+
+		if (CurrentFrameNumber != PreviousFrameNumber)
+		{
+			PreviousFrameNumber = CurrentFrameNumber;
+
+			if (!(TimeoutMSRem--))
+			  return ENDPOINT_READYWAIT_Timeout;
+		}
+	}
+}
+#endif
+
+#endif
+
+#endif
@@ -0,0 +1,179 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2018.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2018  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+#include "../../../../Common/Common.h"
+#if (ARCH == ARCH_POSIX)
+
+#define  __INCLUDE_FROM_USB_DRIVER
+#include "../USBInterrupt.h"
+
+volatile uint8_t USB_INT_Flags;
+volatile uint8_t USB_INT_EnableMask;
+
+static void USB_GEN_vect(void);
+static void USB_COM_vect(void);
+
+void USB_INT_DisableAllInterrupts(void)
+{
+	USB_INT_EnableMask = 0;
+}
+
+void USB_INT_ClearAllInterrupts(void)
+{
+	USB_INT_Flags      = 0;
+}
+
+void USB_INT_ServicePending(void)
+{
+	static bool InGeneralISR;
+	static bool InControlISR;
+
+	if (!(InGeneralISR) && (USB_INT_Flags & USB_INT_EnableMask & ~(1 << USB_INT_RXSTPI)))
+	{
+		InGeneralISR = true;
+		USB_GEN_vect();
+		InGeneralISR = false;
+	}
+
+	#if defined(ASYNC_ENDPOINT_TRANSFERS) && !defined(CONTROL_ONLY_DEVICE)
+	bool EndpointInterrupted = (Endpoint_GetEndpointInterrupts() & ~(1 << ENDPOINT_CONTROLEP));
+	#else
+	bool EndpointInterrupted = false;
+	#endif
+
+	if (!(InControlISR) && ((USB_INT_Flags & USB_INT_EnableMask & (1 << USB_INT_RXSTPI)) || EndpointInterrupted))
+	{
+		InControlISR = true;
+		USB_COM_vect();
+		InControlISR = false;
+	}
+}
+
+ISR(USB_GEN_vect)
+{
+	#if !defined(NO_SOF_EVENTS)
+	if (USB_INT_HasOccurred(USB_INT_SOFI) && USB_INT_IsEnabled(USB_INT_SOFI))
+	{
+		USB_INT_Clear(USB_INT_SOFI);
+
+		EVENT_USB_Device_StartOfFrame();
+	}
+	#endif
+
+	if (USB_INT_HasOccurred(USB_INT_VBUSTI) && USB_INT_IsEnabled(USB_INT_VBUSTI))
+	{
+		USB_INT_Clear(USB_INT_VBUSTI);
+
+		if (USB_VBUS_GetStatus())
+		{
+			USB_DeviceState = DEVICE_STATE_Powered;
+			EVENT_USB_Device_Connect();
+		}
+		else
+		{
+			USB_DeviceState = DEVICE_STATE_Unattached;
+			EVENT_USB_Device_Disconnect();
+		}
+	}
+
+	if (USB_INT_HasOccurred(USB_INT_SUSPI) && USB_INT_IsEnabled(USB_INT_SUSPI))
+	{
+		USB_INT_Clear(USB_INT_SUSPI);
+
+		USB_INT_Disable(USB_INT_SUSPI);
+		USB_INT_Enable(USB_INT_WAKEUPI);
+
+		USB_DeviceState = DEVICE_STATE_Suspended;
+		EVENT_USB_Device_Suspend();
+	}
+
+	if (USB_INT_HasOccurred(USB_INT_WAKEUPI) && USB_INT_IsEnabled(USB_INT_WAKEUPI))
+	{
+		USB_INT_Clear(USB_INT_WAKEUPI);
+
+		USB_INT_Disable(USB_INT_WAKEUPI);
+		USB_INT_Enable(USB_INT_SUSPI);
+
+		if (USB_Device_ConfigurationNumber)
+		  USB_DeviceState = DEVICE_STATE_Configured;
+		else
+		  USB_DeviceState = (USB_Device_IsAddressSet()) ? DEVICE_STATE_Addressed : DEVICE_STATE_Powered;
+
+		EVENT_USB_Device_WakeUp();
+	}
+
+	if (USB_INT_HasOccurred(USB_INT_EORSTI) && USB_INT_IsEnabled(USB_INT_EORSTI))
+	{
+		USB_INT_Clear(USB_INT_EORSTI);
+
+		USB_DeviceState                = DEVICE_STATE_Default;
+		USB_Device_ConfigurationNumber = 0;
+
+		USB_INT_Clear(USB_INT_SUSPI);
+		USB_INT_Enable(USB_INT_SUSPI);
+		USB_INT_Disable(USB_INT_WAKEUPI);
+
+		USB_Device_EnableDeviceAddress(0);
+
+		Endpoint_ClearEndpoints();
+		Endpoint_ConfigureEndpoint(ENDPOINT_CONTROLEP, EP_TYPE_CONTROL,
+		                           USB_Device_ControlEndpointSize, 1);
+
+		#if defined(INTERRUPT_CONTROL_ENDPOINT)
+		USB_INT_Enable(USB_INT_RXSTPI);
+		#endif
+
+		EVENT_USB_Device_Reset();
+	}
+}
+
+ISR(USB_COM_vect)
+{
+	uint8_t PrevSelectedEndpoint = Endpoint_GetCurrentEndpoint();
+
+	#if defined(ASYNC_ENDPOINT_TRANSFERS) && !defined(CONTROL_ONLY_DEVICE)
+	Endpoint_ServiceTransfers();
+	#endif
+
+	if (USB_INT_HasOccurred(USB_INT_RXSTPI) && USB_INT_IsEnabled(USB_INT_RXSTPI))
+	{
+		Endpoint_SelectEndpoint(ENDPOINT_CONTROLEP);
+		USB_INT_Disable(USB_INT_RXSTPI);
+
+		USB_Device_ProcessControlRequest();
+
+		Endpoint_SelectEndpoint(ENDPOINT_CONTROLEP);
+		USB_INT_Enable(USB_INT_RXSTPI);
+	}
+
+	Endpoint_SelectEndpoint(PrevSelectedEndpoint);
+}
+
+#endif
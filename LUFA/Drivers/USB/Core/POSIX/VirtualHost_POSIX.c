@@ -0,0 +1,805 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2018.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2018  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+#include "../../../../Common/Common.h"
+#if (ARCH == ARCH_POSIX)
+
+#define  __INCLUDE_FROM_USB_DRIVER
+#include "../USBController.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+
+#define VHOST_MAX_LINE_LENGTH      4096
+#define VHOST_MAX_ARGUMENTS        (ENDPOINT_POSIX_MAX_BANK_SIZE + 8)
+#define VHOST_MAX_CONTROL_LENGTH   4096
+
+enum VirtualHost_Commands_t
+{
+	VHOST_CMD_None,
+	VHOST_CMD_Connect,
+	VHOST_CMD_Disconnect,
+	VHOST_CMD_Reset,
+	VHOST_CMD_Suspend,
+	VHOST_CMD_Resume,
+	VHOST_CMD_Wait,
+	VHOST_CMD_Enumerate,
+	VHOST_CMD_Control,
+	VHOST_CMD_Out,
+	VHOST_CMD_OutFill,
+	VHOST_CMD_In,
+	VHOST_CMD_InDrain,
+	VHOST_CMD_Stats,
+	VHOST_CMD_Exit,
+};
+
+enum VirtualHost_ControlStates_t
+{
+	VHOST_CONTROL_Setup,
+	VHOST_CONTROL_DataIN,
+	VHOST_CONTROL_DataOUT,
+	VHOST_CONTROL_StatusIN,
+	VHOST_CONTROL_StatusOUT,
+	VHOST_CONTROL_Complete,
+};
+
+typedef struct
+{
+	const char* Name;
+	uint8_t     Command;
+	uint8_t     MinArguments;
+} VirtualHost_CommandInfo_t;
+
+static const VirtualHost_CommandInfo_t VirtualHost_CommandTable[] =
+	{
+		{.Name = "CONNECT",    .Command = VHOST_CMD_Connect,    .MinArguments = 0},
+		{.Name = "DISCONNECT", .Command = VHOST_CMD_Disconnect, .MinArguments = 0},
+		{.Name = "RESET",      .Command = VHOST_CMD_Reset,      .MinArguments = 0},
+		{.Name = "SUSPEND",    .Command = VHOST_CMD_Suspend,    .MinArguments = 0},
+		{.Name = "RESUME",     .Command = VHOST_CMD_Resume,     .MinArguments = 0},
+		{.Name = "WAIT",       .Command = VHOST_CMD_Wait,       .MinArguments = 1},
+		{.Name = "ENUMERATE",  .Command = VHOST_CMD_Enumerate,  .MinArguments = 0},
+		{.Name = "CONTROL",    .Command = VHOST_CMD_Control,    .MinArguments = 5},
+		{.Name = "OUT",        .Command = VHOST_CMD_Out,        .MinArguments = 1},
+		{.Name = "OUTFILL",    .Command = VHOST_CMD_OutFill,    .MinArguments = 3},
+		{.Name = "IN",         .Command = VHOST_CMD_In,         .MinArguments = 1},
+		{.Name = "INDRAIN",    .Command = VHOST_CMD_InDrain,    .MinArguments = 2},
+		{.Name = "STATS",      .Command = VHOST_CMD_Stats,      .MinArguments = 0},
+		{.Name = "EXIT",       .Command = VHOST_CMD_Exit,       .MinArguments = 0},
+	};
+
+static const char* const VirtualHost_DefaultScript[] =
+	{
+		"CONNECT",
+		"RESET",
+		"ENUMERATE",
+		NULL
+	};
+
+static bool     VirtualHost_Initialized;
+static FILE*    VirtualHost_Script;
+static FILE*    VirtualHost_Output;
+static uint8_t  VirtualHost_DefaultScriptLine;
+static uint32_t VirtualHost_ScriptLine;
+
+static bool     VirtualHost_VBUS;
+static bool     VirtualHost_BusActive;
+static bool     VirtualHost_Suspended;
+
+static uint64_t VirtualHost_StartTimeUS;
+static uint32_t VirtualHost_Frame;
+
+static struct
+{
+	uint8_t  Command;
+	bool     Started;
+	uint32_t Arguments[VHOST_MAX_ARGUMENTS];
+	uint16_t TotalArguments;
+	uint32_t Remaining;
+	uint32_t ProgressFrame;
+} VirtualHost_CurrentCommand;
+
+static struct
+{
+	USB_Request_Header_t Request;
+	uint8_t              State;
+	uint16_t             Transferred;
+	uint8_t              Data[VHOST_MAX_CONTROL_LENGTH];
+} VirtualHost_Control;
+
+static struct
+{
+	uint64_t Bytes;
+	uint32_t Packets;
+	uint32_t StartFrame;
+	uint64_t StartTimeUS;
+} VirtualHost_Stats;
+
+static uint64_t VirtualHost_GetTimeUS(void)
+{
+	struct timespec Now;
+	clock_gettime(CLOCK_MONOTONIC, &Now);
+
+	return ((uint64_t)Now.tv_sec * 1000000ULL) + ((uint64_t)Now.tv_nsec / 1000);
+}
+
+static void VirtualHost_Fail(const char* const Format, ...) ATTR_NO_RETURN;
+static void VirtualHost_Fail(const char* const Format, ...)
+{
+	va_list Arguments;
+
+	fflush(VirtualHost_Output);
+
+	fprintf(stderr, "vhost: line %lu: ", (unsigned long)VirtualHost_ScriptLine);
+	va_start(Arguments, Format);
+	vfprintf(stderr, Format, Arguments);
+	va_end(Arguments);
+	fputc('\n', stderr);
+
+	exit(EXIT_FAILURE);
+}
+
+static bool VirtualHost_DeviceReady(void)
+{
+	return (VirtualHost_VBUS && VirtualHost_BusActive && !(VirtualHost_Suspended) &&
+	        USB_Controller_Enabled && USB_Controller_Attached);
+}
+
+static Endpoint_FIFO_t* VirtualHost_GetFIFO(const uint8_t EPNum,
+                                            const bool IsIN)
+{
+	uint8_t EPIndex = (EPNum & ENDPOINT_EPNUM_MASK);
+
+	if (!(VirtualHost_DeviceReady()) || (EPIndex >= ENDPOINT_TOTAL_ENDPOINTS))
+	  return NULL;
+
+	Endpoint_FIFO_t* FIFO = (IsIN) ? &USB_Endpoint_FIFOs[EPIndex].IN : &USB_Endpoint_FIFOs[EPIndex].OUT;
+
+	if (!(FIFO->Flags & ENDPOINT_FIFO_FLAG_CONFIGURED))
+	  return NULL;
+
+	return FIFO;
+}
+
+uint16_t USB_VirtualHost_GetFrameNumber(void)
+{
+	return (VirtualHost_Frame & 0x07FF);
+}
+
+bool USB_VirtualHost_IsConnected(void)
+{
+	return VirtualHost_VBUS;
+}
+
+void USB_VirtualHost_Connect(void)
+{
+	VirtualHost_VBUS = true;
+	USB_INT_Raise(USB_INT_VBUSTI);
+}
+
+void USB_VirtualHost_Disconnect(void)
+{
+	VirtualHost_VBUS      = false;
+	VirtualHost_BusActive = false;
+	VirtualHost_Suspended = false;
+	USB_INT_Raise(USB_INT_VBUSTI);
+}
+
+void USB_VirtualHost_BusReset(void)
+{
+	VirtualHost_BusActive = true;
+	VirtualHost_Suspended = false;
+	USB_INT_Raise(USB_INT_EORSTI);
+}
+
+void USB_VirtualHost_Suspend(void)
+{
+	VirtualHost_Suspended = true;
+	USB_INT_Raise(USB_INT_SUSPI);
+}
+
+void USB_VirtualHost_Resume(void)
+{
+	VirtualHost_Suspended = false;
+	USB_INT_Raise(USB_INT_WAKEUPI);
+}
+
+void USB_VirtualHost_RemoteWakeup(void)
+{
+	if (!(VirtualHost_Suspended))
+	  return;
+
+	fprintf(VirtualHost_Output, "WAKEUP\n");
+	USB_VirtualHost_Resume();
+}
+
+uint8_t USB_VirtualHost_SendSETUP(const USB_Request_Header_t* const Request)
+{
+	Endpoint_FIFO_t* OUTFIFO = VirtualHost_GetFIFO(ENDPOINT_CONTROLEP, false);
+	Endpoint_FIFO_t* INFIFO  = VirtualHost_GetFIFO(ENDPOINT_CONTROLEP, true);
+
+	if (!(OUTFIFO) || !(INFIFO))
+	  return VHOST_TRANSACTION_Error;
+
+	/* Hold off until the device has consumed the previous transfer's status stage */
+	if (OUTFIFO->Flags & (ENDPOINT_FIFO_FLAG_SETUP | ENDPOINT_FIFO_FLAG_PACKET))
+	  return VHOST_TRANSACTION_NAK;
+
+	OUTFIFO->Flags &= ~ENDPOINT_FIFO_FLAG_STALLED;
+	INFIFO->Flags  &= ~(ENDPOINT_FIFO_FLAG_STALLED | ENDPOINT_FIFO_FLAG_PACKET);
+
+	memcpy(OUTFIFO->Data, Request, sizeof(USB_Request_Header_t));
+	OUTFIFO->Length   = sizeof(USB_Request_Header_t);
+	OUTFIFO->Position = 0;
+	OUTFIFO->Flags   |= ENDPOINT_FIFO_FLAG_SETUP;
+
+	USB_INT_Raise(USB_INT_RXSTPI);
+	return VHOST_TRANSACTION_ACK;
+}
+
+uint8_t USB_VirtualHost_SendOUT(const uint8_t EPNum,
+                                const void* const Buffer,
+                                const uint16_t Length)
+{
+	Endpoint_FIFO_t* FIFO = VirtualHost_GetFIFO(EPNum, false);
+
+	if (!(FIFO) || (Length > FIFO->Size))
+	  return VHOST_TRANSACTION_Error;
+
+	if (FIFO->Flags & ENDPOINT_FIFO_FLAG_STALLED)
+	  return VHOST_TRANSACTION_STALL;
+
+	if (FIFO->Flags & (ENDPOINT_FIFO_FLAG_SETUP | ENDPOINT_FIFO_FLAG_PACKET))
+	  return VHOST_TRANSACTION_NAK;
+
+	if (Length)
+	  memcpy(FIFO->Data, Buffer, Length);
+
+	FIFO->Length   = Length;
+	FIFO->Position = 0;
+	FIFO->Flags   |= ENDPOINT_FIFO_FLAG_PACKET;
+
+	return VHOST_TRANSACTION_ACK;
+}
+
+uint8_t USB_VirtualHost_ReceiveIN(const uint8_t EPNum,
+                                  void* const Buffer,
+                                  const uint16_t BufferSize,
+                                  uint16_t* const Length)
+{
+	Endpoint_FIFO_t* FIFO = VirtualHost_GetFIFO(EPNum, true);
+
+	if (!(FIFO))
+	  return VHOST_TRANSACTION_Error;
+
+	if (FIFO->Flags & ENDPOINT_FIFO_FLAG_STALLED)
+	  return VHOST_TRANSACTION_STALL;
+
+	if (!(FIFO->Flags & ENDPOINT_FIFO_FLAG_PACKET))
+	  return VHOST_TRANSACTION_NAK;
+
+	uint16_t BytesToCopy = MIN(FIFO->Length, BufferSize);
+
+	if (BytesToCopy)
+	  memcpy(Buffer, FIFO->Data, BytesToCopy);
+
+	*Length = FIFO->Length;
+
+	FIFO->Length = 0;
+	FIFO->Flags &= ~ENDPOINT_FIFO_FLAG_PACKET;
+
+	return VHOST_TRANSACTION_ACK;
+}
+
+static void VirtualHost_StartControl(const uint8_t bmRequestType,
+                                     const uint8_t bRequest,
+                                     const uint16_t wValue,
+                                     const uint16_t wIndex,
+                                     const uint16_t wLength)
+{
+	if (wLength > VHOST_MAX_CONTROL_LENGTH)
+	  VirtualHost_Fail("control request length %u exceeds %u bytes", wLength, VHOST_MAX_CONTROL_LENGTH);
+
+	VirtualHost_Control.Request = (USB_Request_Header_t)
+		{
+			.bmRequestType = bmRequestType,
+			.bRequest      = bRequest,
+			.wValue        = cpu_to_le16(wValue),
+			.wIndex        = cpu_to_le16(wIndex),
+			.wLength       = cpu_to_le16(wLength),
+		};
+
+	VirtualHost_Control.State       = VHOST_CONTROL_Setup;
+	VirtualHost_Control.Transferred = 0;
+}
+
+static uint8_t VirtualHost_ControlStep(void)
+{
+	uint16_t wLength     = le16_to_cpu(VirtualHost_Control.Request.wLength);
+	uint16_t ControlSize = USB_Endpoint_FIFOs[ENDPOINT_CONTROLEP].IN.Size;
+	uint16_t Remaining   = (wLength - VirtualHost_Control.Transferred);
+	uint16_t PacketLength;
+	uint8_t  ErrorCode;
+
+	switch (VirtualHost_Control.State)
+	{
+		case VHOST_CONTROL_Setup:
+			if ((ErrorCode = USB_VirtualHost_SendSETUP(&VirtualHost_Control.Request)) != VHOST_TRANSACTION_ACK)
+			  break;
+
+			if (!(wLength))
+			  VirtualHost_Control.State = VHOST_CONTROL_StatusIN;
+			else if (VirtualHost_Control.Request.bmRequestType & REQDIR_DEVICETOHOST)
+			  VirtualHost_Control.State = VHOST_CONTROL_DataIN;
+			else
+			  VirtualHost_Control.State = VHOST_CONTROL_DataOUT;
+
+			break;
+		case VHOST_CONTROL_DataIN:
+			ErrorCode = USB_VirtualHost_ReceiveIN(ENDPOINT_CONTROLEP, &VirtualHost_Control.Data[VirtualHost_Control.Transferred],
+			                                      Remaining, &PacketLength);
+			if (ErrorCode != VHOST_TRANSACTION_ACK)
+			  break;
+
+			VirtualHost_Control.Transferred += MIN(PacketLength, Remaining);
+
+			if ((PacketLength < ControlSize) || (VirtualHost_Control.Transferred == wLength))
+			  VirtualHost_Control.State = VHOST_CONTROL_StatusOUT;
+
+			break;
+		case VHOST_CONTROL_DataOUT:
+			PacketLength = MIN(Remaining, ControlSize);
+
+			ErrorCode = USB_VirtualHost_SendOUT(ENDPOINT_CONTROLEP, &VirtualHost_Control.Data[VirtualHost_Control.Transferred],
+			                                    PacketLength);
+			if (ErrorCode != VHOST_TRANSACTION_ACK)
+			  break;
+
+			VirtualHost_Control.Transferred += PacketLength;
+
+			if (VirtualHost_Control.Transferred == wLength)
+			  VirtualHost_Control.State = VHOST_CONTROL_StatusIN;
+
+			break;
+		case VHOST_CONTROL_StatusIN:
+			if ((ErrorCode = USB_VirtualHost_ReceiveIN(ENDPOINT_CONTROLEP, NULL, 0, &PacketLength)) == VHOST_TRANSACTION_ACK)
+			  VirtualHost_Control.State = VHOST_CONTROL_Complete;
+
+			break;
+		case VHOST_CONTROL_StatusOUT:
+			if ((ErrorCode = USB_VirtualHost_SendOUT(ENDPOINT_CONTROLEP, NULL, 0)) == VHOST_TRANSACTION_ACK)
+			  VirtualHost_Control.State = VHOST_CONTROL_Complete;
+
+			break;
+		default:
+			ErrorCode = VHOST_TRANSACTION_ACK;
+			break;
+	}
+
+	return ErrorCode;
+}
+
+static void VirtualHost_PrintData(const char* const Prefix,
+                                  const uint8_t* const Data,
+                                  const uint16_t Length)
+{
+	fprintf(VirtualHost_Output, "%s", Prefix);
+
+	for (uint16_t i = 0; i < Length; i++)
+	  fprintf(VirtualHost_Output, " %02X", Data[i]);
+
+	fprintf(VirtualHost_Output, "\n");
+}
+
+static bool VirtualHost_ReadCommand(void)
+{
+	static char Line[VHOST_MAX_LINE_LENGTH];
+
+	for (;;)
+	{
+		if (VirtualHost_Script)
+		{
+			if (!(fgets(Line, sizeof(Line), VirtualHost_Script)))
+			  return false;
+		}
+		else
+		{
+			const char* DefaultLine = VirtualHost_DefaultScript[VirtualHost_DefaultScriptLine];
+
+			if (!(DefaultLine))
+			  return false;
+
+			VirtualHost_DefaultScriptLine++;
+			snprintf(Line, sizeof(Line), "%s", DefaultLine);
+		}
+
+		VirtualHost_ScriptLine++;
+
+		char* CommentStart = strchr(Line, '#');
+		if (CommentStart)
+		  *CommentStart = '\0';
+
+		char* Token = strtok(Line, " \t\r\n");
+		if (!(Token))
+		  continue;
+
+		const VirtualHost_CommandInfo_t* CommandInfo = NULL;
+
+		for (uint8_t i = 0; i < (sizeof(VirtualHost_CommandTable) / sizeof(VirtualHost_CommandTable[0])); i++)
+		{
+			if (!(strcasecmp(Token, VirtualHost_CommandTable[i].Name)))
+			  CommandInfo = &VirtualHost_CommandTable[i];
+		}
+
+		if (!(CommandInfo))
+		  VirtualHost_Fail("unknown command \"%s\"", Token);
+
+		VirtualHost_CurrentCommand.TotalArguments = 0;
+
+		while ((Token = strtok(NULL, " \t\r\n")) != NULL)
+		{
+			char* TokenEnd;
+
+			if (VirtualHost_CurrentCommand.TotalArguments == VHOST_MAX_ARGUMENTS)
+			  VirtualHost_Fail("too many arguments");
+
+			VirtualHost_CurrentCommand.Arguments[VirtualHost_CurrentCommand.TotalArguments++] = strtoul(Token, &TokenEnd, 16);
+
+			if (*TokenEnd != '\0')
+			  VirtualHost_Fail("invalid hexadecimal argument \"%s\"", Token);
+		}
+
+		if (VirtualHost_CurrentCommand.TotalArguments < CommandInfo->MinArguments)
+		  VirtualHost_Fail("%s requires at least %u argument(s)", CommandInfo->Name, CommandInfo->MinArguments);
+
+		VirtualHost_CurrentCommand.Command       = CommandInfo->Command;
+		VirtualHost_CurrentCommand.Started       = false;
+		VirtualHost_CurrentCommand.Remaining     = 0;
+		VirtualHost_CurrentCommand.ProgressFrame = VirtualHost_Frame;
+		return true;
+	}
+}
+
+static void VirtualHost_CheckTransaction(const uint8_t ErrorCode)
+{
+	switch (ErrorCode)
+	{
+		case VHOST_TRANSACTION_ACK:
+			VirtualHost_CurrentCommand.ProgressFrame = VirtualHost_Frame;
+			break;
+		case VHOST_TRANSACTION_STALL:
+			VirtualHost_Fail("endpoint stalled");
+		default:
+			if ((VirtualHost_Frame - VirtualHost_CurrentCommand.ProgressFrame) > VHOST_COMMAND_TIMEOUT_FRAMES)
+			  VirtualHost_Fail("timed out waiting for the device");
+
+			break;
+	}
+}
+
+static uint8_t VirtualHost_SendDataOUT(const uint8_t EPNum,
+                                       const uint8_t* const Buffer,
+                                       const uint16_t Length)
+{
+	Endpoint_FIFO_t* FIFO = VirtualHost_GetFIFO(EPNum, false);
+
+	if (FIFO && (Length > FIFO->Size))
+	  VirtualHost_Fail("%u byte packet exceeds the %u byte endpoint size", Length, FIFO->Size);
+
+	uint8_t ErrorCode = USB_VirtualHost_SendOUT(EPNum, Buffer, Length);
+	VirtualHost_CheckTransaction(ErrorCode);
+
+	if (ErrorCode == VHOST_TRANSACTION_ACK)
+	{
+		VirtualHost_Stats.Bytes += Length;
+		VirtualHost_Stats.Packets++;
+	}
+
+	return ErrorCode;
+}
+
+static bool VirtualHost_EnumerateStep(void)
+{
+	uint32_t* Phase = &VirtualHost_CurrentCommand.Remaining;
+
+	if (VirtualHost_Control.State != VHOST_CONTROL_Complete)
+	{
+		VirtualHost_CheckTransaction(VirtualHost_ControlStep());
+		return false;
+	}
+
+	switch ((*Phase)++)
+	{
+		case 0:
+			VirtualHost_StartControl((REQDIR_DEVICETOHOST | REQTYPE_STANDARD | REQREC_DEVICE), REQ_GetDescriptor,
+			                         (DTYPE_Device << 8), 0, sizeof(USB_StdDescriptor_Device_t));
+			break;
+		case 1:
+		{
+			USB_StdDescriptor_Device_t* DeviceDescriptor = (void*)VirtualHost_Control.Data;
+
+			fprintf(VirtualHost_Output, "ENUMERATE device %04X:%04X\n", le16_to_cpu(DeviceDescriptor->idVendor),
+			        le16_to_cpu(DeviceDescriptor->idProduct));
+
+			VirtualHost_StartControl((REQDIR_HOSTTODEVICE | REQTYPE_STANDARD | REQREC_DEVICE), REQ_SetAddress,
+			                         1, 0, 0);
+			break;
+		}
+		case 2:
+			VirtualHost_StartControl((REQDIR_DEVICETOHOST | REQTYPE_STANDARD | REQREC_DEVICE), REQ_GetDescriptor,
+			                         (DTYPE_Configuration << 8), 0, sizeof(USB_StdDescriptor_Configuration_Header_t));
+			break;
+		case 3:
+		{
+			USB_StdDescriptor_Configuration_Header_t* ConfigHeader = (void*)VirtualHost_Control.Data;
+
+			VirtualHost_StartControl((REQDIR_DEVICETOHOST | REQTYPE_STANDARD | REQREC_DEVICE), REQ_GetDescriptor,
+			                         (DTYPE_Configuration << 8), 0, le16_to_cpu(ConfigHeader->wTotalLength));
+			break;
+		}
+		case 4:
+			fprintf(VirtualHost_Output, "ENUMERATE configuration %u bytes\n", VirtualHost_Control.Transferred);
+
+			VirtualHost_StartControl((REQDIR_HOSTTODEVICE | REQTYPE_STANDARD | REQREC_DEVICE), REQ_SetConfiguration,
+			                         1, 0, 0);
+			break;
+		default:
+			return true;
+	}
+
+	return false;
+}
+
+static bool VirtualHost_StartCommand(void)
+{
+	if (VirtualHost_CurrentCommand.Started)
+	  return false;
+
+	VirtualHost_CurrentCommand.Started = true;
+	return true;
+}
+
+static bool VirtualHost_CommandStep(void)
+{
+	static uint8_t PacketBuffer[ENDPOINT_POSIX_MAX_BANK_SIZE];
+
+	uint32_t* Arguments = VirtualHost_CurrentCommand.Arguments;
+	uint16_t  PacketLength;
+	uint8_t   ErrorCode;
+	char      Prefix[16];
+
+	switch (VirtualHost_CurrentCommand.Command)
+	{
+		case VHOST_CMD_Connect:
+			USB_VirtualHost_Connect();
+			return true;
+		case VHOST_CMD_Disconnect:
+			USB_VirtualHost_Disconnect();
+			return true;
+		case VHOST_CMD_Reset:
+			if (!(VirtualHost_VBUS && USB_Controller_Enabled && USB_Controller_Attached))
+			{
+				VirtualHost_CheckTransaction(VHOST_TRANSACTION_NAK);
+				return false;
+			}
+
+			USB_VirtualHost_BusReset();
+			return true;
+		case VHOST_CMD_Suspend:
+			USB_VirtualHost_Suspend();
+			return true;
+		case VHOST_CMD_Resume:
+			USB_VirtualHost_Resume();
+			return true;
+		case VHOST_CMD_Wait:
+			return ((VirtualHost_Frame - VirtualHost_CurrentCommand.ProgressFrame) >= Arguments[0]);
+		case VHOST_CMD_Enumerate:
+			if (VirtualHost_StartCommand())
+			{
+				VirtualHost_Control.State = VHOST_CONTROL_Complete;
+				VirtualHost_CurrentCommand.Remaining = 0;
+			}
+
+			return VirtualHost_EnumerateStep();
+		case VHOST_CMD_Control:
+			if (VirtualHost_StartCommand())
+			{
+				VirtualHost_StartControl(Arguments[0], Arguments[1], Arguments[2], Arguments[3], Arguments[4]);
+
+				for (uint16_t i = 5; i < VirtualHost_CurrentCommand.TotalArguments; i++)
+				{
+					if ((i - 5) < VHOST_MAX_CONTROL_LENGTH)
+					  VirtualHost_Control.Data[i - 5] = Arguments[i];
+				}
+			}
+
+			ErrorCode = VirtualHost_ControlStep();
+
+			if (ErrorCode == VHOST_TRANSACTION_STALL)
+			{
+				fprintf(VirtualHost_Output, "CONTROL STALL\n");
+				return true;
+			}
+
+			VirtualHost_CheckTransaction(ErrorCode);
+
+			if (VirtualHost_Control.State != VHOST_CONTROL_Complete)
+			  return false;
+
+			if (VirtualHost_Control.Request.bmRequestType & REQDIR_DEVICETOHOST)
+			  VirtualHost_PrintData("CONTROL", VirtualHost_Control.Data, VirtualHost_Control.Transferred);
+			else
+			  fprintf(VirtualHost_Output, "CONTROL ACK\n");
+
+			return true;
+		case VHOST_CMD_Out:
+			for (uint16_t i = 1; i < VirtualHost_CurrentCommand.TotalArguments; i++)
+			  PacketBuffer[i - 1] = Arguments[i];
+
+			PacketLength = (VirtualHost_CurrentCommand.TotalArguments - 1);
+			return (VirtualHost_SendDataOUT(Arguments[0], PacketBuffer, PacketLength) == VHOST_TRANSACTION_ACK);
+		case VHOST_CMD_OutFill:
+			if (VirtualHost_StartCommand())
+			  VirtualHost_CurrentCommand.Remaining = Arguments[2];
+
+			if (!(VirtualHost_CurrentCommand.Remaining))
+			  return true;
+
+			PacketLength = MIN(Arguments[1], sizeof(PacketBuffer));
+			for (uint16_t i = 0; i < PacketLength; i++)
+			  PacketBuffer[i] = (uint8_t)(VirtualHost_Stats.Bytes + i);
+
+			if (VirtualHost_SendDataOUT(Arguments[0], PacketBuffer, PacketLength) == VHOST_TRANSACTION_ACK)
+			  VirtualHost_CurrentCommand.Remaining--;
+
+			return !(VirtualHost_CurrentCommand.Remaining);
+		case VHOST_CMD_In:
+			if (VirtualHost_StartCommand())
+			  VirtualHost_CurrentCommand.Remaining = (VirtualHost_CurrentCommand.TotalArguments > 1) ? Arguments[1] : 1;
+
+			if (!(VirtualHost_CurrentCommand.Remaining))
+			  return true;
+
+			ErrorCode = USB_VirtualHost_ReceiveIN(Arguments[0], PacketBuffer, sizeof(PacketBuffer), &PacketLength);
+			VirtualHost_CheckTransaction(ErrorCode);
+
+			if (ErrorCode == VHOST_TRANSACTION_ACK)
+			{
+				snprintf(Prefix, sizeof(Prefix), "IN %02X:", (unsigned)(Arguments[0] & ENDPOINT_EPNUM_MASK));
+				VirtualHost_PrintData(Prefix, PacketBuffer, PacketLength);
+
+				VirtualHost_Stats.Bytes += PacketLength;
+				VirtualHost_Stats.Packets++;
+				VirtualHost_CurrentCommand.Remaining--;
+			}
+
+			return !(VirtualHost_CurrentCommand.Remaining);
+		case VHOST_CMD_InDrain:
+			if (VirtualHost_StartCommand())
+			  VirtualHost_CurrentCommand.Remaining = Arguments[1];
+
+			if (!(VirtualHost_CurrentCommand.Remaining))
+			  return true;
+
+			ErrorCode = USB_VirtualHost_ReceiveIN(Arguments[0], PacketBuffer, sizeof(PacketBuffer), &PacketLength);
+			VirtualHost_CheckTransaction(ErrorCode);
+
+			if (ErrorCode == VHOST_TRANSACTION_ACK)
+			{
+				VirtualHost_Stats.Bytes += PacketLength;
+				VirtualHost_Stats.Packets++;
+				VirtualHost_CurrentCommand.Remaining -= MIN(PacketLength, VirtualHost_CurrentCommand.Remaining);
+			}
+
+			return !(VirtualHost_CurrentCommand.Remaining);
+		case VHOST_CMD_Stats:
+		{
+			uint64_t Now       = VirtualHost_GetTimeUS();
+			uint64_t ElapsedUS = (Now - VirtualHost_Stats.StartTimeUS);
+
+			fprintf(VirtualHost_Output, "STATS bytes=%llu packets=%lu frames=%lu time=%.3fms throughput=%.1fKB/s\n",
+			        (unsigned long long)VirtualHost_Stats.Bytes, (unsigned long)VirtualHost_Stats.Packets,
+			        (unsigned long)(VirtualHost_Frame - VirtualHost_Stats.StartFrame), (ElapsedUS / 1000.0),
+			        (ElapsedUS ? ((VirtualHost_Stats.Bytes * 1000000.0) / (ElapsedUS * 1024.0)) : 0));
+
+			VirtualHost_Stats.Bytes       = 0;
+			VirtualHost_Stats.Packets     = 0;
+			VirtualHost_Stats.StartFrame  = VirtualHost_Frame;
+			VirtualHost_Stats.StartTimeUS = Now;
+			return true;
+		}
+		case VHOST_CMD_Exit:
+			fflush(VirtualHost_Output);
+			exit((VirtualHost_CurrentCommand.TotalArguments) ? (int)Arguments[0] : EXIT_SUCCESS);
+		default:
+			return true;
+	}
+}
+
+static void VirtualHost_Init(void)
+{
+	const char* ScriptPath = getenv("LUFA_VHOST_SCRIPT");
+
+	if (ScriptPath && (*ScriptPath != '\0'))
+	{
+		if (!(VirtualHost_Script = fopen(ScriptPath, "r")))
+		  VirtualHost_Fail("unable to open script \"%s\"", ScriptPath);
+	}
+
+	/* The transcript is written to a private duplicate of the standard output, so that it is unaffected by the
+	 * application redirecting stdout to its own console (such as the Serial driver's stream) */
+	if (!(VirtualHost_Output = fdopen(dup(STDOUT_FILENO), "w")))
+	  VirtualHost_Output = stdout;
+
+	setvbuf(VirtualHost_Output, NULL, _IOLBF, 0);
+
+	VirtualHost_StartTimeUS       = VirtualHost_GetTimeUS();
+	VirtualHost_Stats.StartTimeUS = VirtualHost_StartTimeUS;
+	VirtualHost_Initialized       = true;
+}
+
+static void VirtualHost_UpdateFrame(void)
+{
+	uint32_t CurrentFrame = ((VirtualHost_GetTimeUS() - VirtualHost_StartTimeUS) / 1000);
+
+	if (CurrentFrame == VirtualHost_Frame)
+	  return;
+
+	VirtualHost_Frame = CurrentFrame;
+
+	if (VirtualHost_DeviceReady())
+	  USB_INT_Raise(USB_INT_SOFI);
+}
+
+void USB_VirtualHost_Poll(void)
+{
+	if (!(VirtualHost_Initialized))
+	  VirtualHost_Init();
+
+	VirtualHost_UpdateFrame();
+
+	if (VirtualHost_CurrentCommand.Command == VHOST_CMD_None)
+	  VirtualHost_ReadCommand();
+
+	if (VirtualHost_CurrentCommand.Command != VHOST_CMD_None)
+	{
+		if (VirtualHost_CommandStep())
+		  VirtualHost_CurrentCommand.Command = VHOST_CMD_None;
+	}
+
+	USB_INT_ServicePending();
+}
+
+#endif
+
@@ -0,0 +1,198 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2018.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2018  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *  \brief Scripted virtual USB host for the host-native POSIX architecture.
+ *  \copydetails Group_VirtualHost_POSIX
+ *
+ *  \note This file should not be included directly. It is automatically included as needed by the USB driver
+ *        dispatch header located in LUFA/Drivers/USB/USB.h.
+ */
+
+/** \ingroup Group_USBManagement_POSIX
+ *  \defgroup Group_VirtualHost_POSIX Virtual USB Host (POSIX)
+ *  \brief Scripted virtual USB host for the host-native POSIX architecture.
+ *
+ *  The virtual host drives the simulated USB controller of the POSIX architecture. It runs co-operatively inside
+ *  the device application; each time the device polls the bus (from \ref USB_USBTask(), the endpoint status
+ *  functions or \ref USB_Device_GetFrameNumber()) the host advances by at most one bus transaction, the frame
+ *  counter is updated from the system monotonic clock (one frame per millisecond) and any pending controller
+ *  interrupts are serviced.
+ *
+ *  The host is controlled by a plain text script, whose path is read from the \c LUFA_VHOST_SCRIPT environment
+ *  variable. Each line holds a single command followed by its arguments in hexadecimal; blank lines and text
+ *  following a \c # character are ignored. When no script is given, the host connects, resets and enumerates
+ *  the device and then leaves the bus idle. The supported commands are:
+ *
+ *  <table>
+ *   <tr><th>Command</th><th>Description</th></tr>
+ *   <tr><td>CONNECT</td><td>Applies VBUS to the device.</td></tr>
+ *   <tr><td>DISCONNECT</td><td>Removes VBUS from the device.</td></tr>
+ *   <tr><td>RESET</td><td>Waits until the device has attached to the bus, then issues a bus reset.</td></tr>
+ *   <tr><td>SUSPEND</td><td>Suspends the bus, stopping Start of Frame packets.</td></tr>
+ *   <tr><td>RESUME</td><td>Resumes the bus from suspension.</td></tr>
+ *   <tr><td>WAIT \c frames</td><td>Leaves the bus idle for the given number of frames.</td></tr>
+ *   <tr><td>ENUMERATE</td><td>Reads the device and configuration descriptors, then addresses and configures the device.</td></tr>
+ *   <tr><td>CONTROL \c bmRequestType \c bRequest \c wValue \c wIndex \c wLength [\c data...]</td><td>Issues a control
+ *       request; data read from the device is printed to standard output.</td></tr>
+ *   <tr><td>OUT \c endpoint \c data...</td><td>Sends a single OUT packet to the given endpoint.</td></tr>
+ *   <tr><td>OUTFILL \c endpoint \c size \c count</td><td>Sends \c count OUT packets of \c size bytes to the given endpoint.</td></tr>
+ *   <tr><td>IN \c endpoint [\c count]</td><td>Reads \c count IN packets (one by default) and prints them to standard output.</td></tr>
+ *   <tr><td>INDRAIN \c endpoint \c bytes</td><td>Reads and discards IN packets until at least \c bytes bytes have been received.</td></tr>
+ *   <tr><td>STATS</td><td>Prints and resets the data transfer statistics gathered since the last STATS command.</td></tr>
+ *   <tr><td>EXIT [\c code]</td><td>Terminates the application with the given exit code (zero by default).</td></tr>
+ *  </table>
+ *
+ *  A command which makes no progress for \ref VHOST_COMMAND_TIMEOUT_FRAMES frames, or which is unexpectedly
+ *  stalled by the device, aborts the application with a non-zero exit code. Stalled \c CONTROL requests are
+ *  reported on standard output instead, so that scripts may check for rejected requests.
+ *
+ *  @{
+ */
+
+#ifndef __VIRTUALHOST_POSIX_H__
+#define __VIRTUALHOST_POSIX_H__
+
+	/* Includes: */
+		#include "../../../../Common/Common.h"
+		#include "../StdRequestType.h"
+
+	/* Enable C linkage for C++ Compilers: */
+		#if defined(__cplusplus)
+			extern "C" {
+		#endif
+
+	/* Preprocessor Checks: */
+		#if !defined(__INCLUDE_FROM_USB_DRIVER)
+			#error Do not include this file directly. Include LUFA/Drivers/USB/USB.h instead.
+		#endif
+
+	/* Public Interface - May be used in end-application: */
+		/* Macros: */
+			#if !defined(VHOST_COMMAND_TIMEOUT_FRAMES) || defined(__DOXYGEN__)
+				/** Number of frames a virtual host script command may go without completing a transaction before it is
+				 *  considered to have failed.
+				 *
+				 *  This value may be overridden in the user project makefile as the value of the
+				 *  \ref VHOST_COMMAND_TIMEOUT_FRAMES token, and passed to the compiler using the -D switch.
+				 */
+				#define VHOST_COMMAND_TIMEOUT_FRAMES    5000
+			#endif
+
+		/* Enums: */
+			/** Enum for the possible outcomes of a single virtual host bus transaction. */
+			enum VHOST_Transaction_ErrorCodes_t
+			{
+				VHOST_TRANSACTION_ACK   = 0, /**< Transaction was accepted by the device. */
+				VHOST_TRANSACTION_NAK   = 1, /**< Device was not ready, the transaction should be retried. */
+				VHOST_TRANSACTION_STALL = 2, /**< Device stalled the addressed endpoint. */
+				VHOST_TRANSACTION_Error = 3, /**< Device is not attached, or the endpoint is not configured. */
+			};
+
+		/* Function Prototypes: */
+			/** Services the virtual host, advancing the host by at most one bus transaction and servicing any pending
+			 *  simulated controller interrupts. This is called automatically by the library whenever the device polls
+			 *  the bus, and need not be called by the user application.
+			 */
+			void USB_VirtualHost_Poll(void);
+
+			/** Retrieves the current virtual bus frame number.
+			 *
+			 *  \return Current 11-bit USB frame number.
+			 */
+			uint16_t USB_VirtualHost_GetFrameNumber(void) ATTR_WARN_UNUSED_RESULT;
+
+			/** Determines if the virtual host is currently supplying VBUS to the device.
+			 *
+			 *  \return Boolean \c true if the device is connected to the virtual host, \c false otherwise.
+			 */
+			bool USB_VirtualHost_IsConnected(void) ATTR_WARN_UNUSED_RESULT;
+
+			/** Applies VBUS to the device, simulating connection to the virtual host. */
+			void USB_VirtualHost_Connect(void);
+
+			/** Removes VBUS from the device, simulating disconnection from the virtual host. */
+			void USB_VirtualHost_Disconnect(void);
+
+			/** Issues a bus reset to the attached device. */
+			void USB_VirtualHost_BusReset(void);
+
+			/** Suspends the virtual bus, halting Start of Frame packets to the device. */
+			void USB_VirtualHost_Suspend(void);
+
+			/** Resumes the virtual bus from suspension. */
+			void USB_VirtualHost_Resume(void);
+
+			/** Signals a remote wakeup from the device to the virtual host, which resumes the bus if suspended. */
+			void USB_VirtualHost_RemoteWakeup(void);
+
+			/** Sends a SETUP packet to the device's default control endpoint.
+			 *
+			 *  \param[in] Request  Control request to send to the device.
+			 *
+			 *  \return A value from the \ref VHOST_Transaction_ErrorCodes_t enum.
+			 */
+			uint8_t USB_VirtualHost_SendSETUP(const USB_Request_Header_t* const Request) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Sends an OUT packet to the given device endpoint.
+			 *
+			 *  \param[in] EPNum   Endpoint number the packet is addressed to.
+			 *  \param[in] Buffer  Packet data to send.
+			 *  \param[in] Length  Length of the packet data, in bytes.
+			 *
+			 *  \return A value from the \ref VHOST_Transaction_ErrorCodes_t enum.
+			 */
+			uint8_t USB_VirtualHost_SendOUT(const uint8_t EPNum,
+			                                const void* const Buffer,
+			                                const uint16_t Length);
+
+			/** Requests an IN packet from the given device endpoint.
+			 *
+			 *  \param[in]  EPNum       Endpoint number the packet is requested from.
+			 *  \param[out] Buffer      Buffer to store the received packet data into.
+			 *  \param[in]  BufferSize  Size of the destination buffer, in bytes; longer packets are truncated.
+			 *  \param[out] Length      Length of the received packet, in bytes.
+			 *
+			 *  \return A value from the \ref VHOST_Transaction_ErrorCodes_t enum.
+			 */
+			uint8_t USB_VirtualHost_ReceiveIN(const uint8_t EPNum,
+			                                  void* const Buffer,
+			                                  const uint16_t BufferSize,
+			                                  uint16_t* const Length) ATTR_NON_NULL_PTR_ARG(4);
+
+	/* Disable C linkage for C++ Compilers: */
+		#if defined(__cplusplus)
+			}
+		#endif
+
+#endif
+
+/** @} */
+
@@ -0,0 +1,282 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2018.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2018  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+
+#define  __INCLUDE_FROM_USB_DRIVER
+#include "USBMode.h"
+
+#if defined(USB_CAN_BE_HOST) && defined(PERIODIC_PIPE_SCHEDULER)
+
+#define  __INCLUDE_FROM_PIPESCHEDULER_C
+#include "PipeScheduler.h"
+
+static Pipe_PeriodicPipe_t* Pipe_PeriodicPipes;
+
+#if !defined(NO_SOF_EVENTS)
+volatile bool USB_Host_SOFEventsEnabled;
+#endif
+
+static void Pipe_QueuePeriodicPacket(Pipe_PeriodicPipe_t* const PeriodicPipe)
+{
+	PeriodicPipe->State.Statistics.PacketsReceived++;
+
+	if (PeriodicPipe->State.QueueCount < PeriodicPipe->State.QueueDepth)
+	{
+		uint8_t  SlotIndex    = (PeriodicPipe->State.QueueHead + PeriodicPipe->State.QueueCount);
+		uint16_t PacketLength = MIN(Pipe_BytesInPipe(), PeriodicPipe->Config.PacketSize);
+
+		if (SlotIndex >= PeriodicPipe->State.QueueDepth)
+		  SlotIndex -= PeriodicPipe->State.QueueDepth;
+
+		uint8_t* SlotPtr = &PeriodicPipe->Config.QueueBuffer[SlotIndex * (sizeof(uint16_t) + PeriodicPipe->Config.PacketSize)];
+
+		*(SlotPtr++) = (PacketLength & 0xFF);
+		*(SlotPtr++) = (PacketLength >> 8);
+
+		while (PacketLength--)
+		  *(SlotPtr++) = Pipe_Read_8();
+
+		PeriodicPipe->State.QueueCount++;
+	}
+	else
+	{
+		PeriodicPipe->State.Statistics.QueueOverflows++;
+	}
+
+	Pipe_ClearIN();
+	PeriodicPipe->State.RequestPending = false;
+}
+
+static void Pipe_PollPeriodicPipe(Pipe_PeriodicPipe_t* const PeriodicPipe,
+                                  const uint16_t CurrentFrame)
+{
+	if (Pipe_IsStalled() || Pipe_IsError())
+	{
+		Pipe_ClearStall();
+		Pipe_ClearError();
+
+		PeriodicPipe->State.Statistics.Errors++;
+		PeriodicPipe->State.RequestPending = false;
+	}
+	else if (PeriodicPipe->State.RequestPending && Pipe_IsINReceived())
+	{
+		Pipe_QueuePeriodicPacket(PeriodicPipe);
+	}
+
+	uint16_t FramesLate = ((CurrentFrame - PeriodicPipe->State.NextFrame) & PIPE_FRAME_NUMBER_MASK);
+
+	if (FramesLate > (PIPE_FRAME_NUMBER_MASK >> 1))
+	  return;
+
+	uint16_t MissedIntervals = (FramesLate / PeriodicPipe->Config.Interval);
+
+	PeriodicPipe->State.NextFrame = ((PeriodicPipe->State.NextFrame +
+	                                  ((MissedIntervals + 1) * PeriodicPipe->Config.Interval)) & PIPE_FRAME_NUMBER_MASK);
+
+	PeriodicPipe->State.Statistics.MissedIntervals += MissedIntervals;
+
+	if (FramesLate > PeriodicPipe->State.Statistics.MaxLateFrames)
+	  PeriodicPipe->State.Statistics.MaxLateFrames = MIN(FramesLate, UINT8_MAX);
+
+	if (PeriodicPipe->State.RequestPending)
+	{
+		PeriodicPipe->State.Statistics.EmptyPolls++;
+		return;
+	}
+
+	Pipe_SetFiniteINRequests(1);
+	Pipe_Unfreeze();
+
+	PeriodicPipe->State.RequestPending = true;
+}
+
+uint8_t Pipe_GetPeriodicInterval(const uint8_t Type,
+                                 const uint8_t PollingInterval)
+{
+	if (Type == EP_TYPE_ISOCHRONOUS)
+	  return (1 << (MIN(MAX(PollingInterval, 1), 8) - 1));
+
+	return MAX(PollingInterval, 1);
+}
+
+bool Pipe_SchedulePeriodicPipe(Pipe_PeriodicPipe_t* const PeriodicPipe)
+{
+	uint16_t SlotSize = (sizeof(uint16_t) + PeriodicPipe->Config.PacketSize);
+
+	if (!(PeriodicPipe->Config.PipeAddress & PIPE_DIR_IN) || !(PeriodicPipe->Config.Interval) ||
+	    !(PeriodicPipe->Config.QueueBuffer) || (PeriodicPipe->Config.QueueSize < SlotSize))
+	{
+		return false;
+	}
+
+	for (Pipe_PeriodicPipe_t* CurrPipe = Pipe_PeriodicPipes; CurrPipe != NULL; CurrPipe = CurrPipe->State.NextPipe)
+	{
+		if (CurrPipe == PeriodicPipe)
+		  return false;
+	}
+
+	memset(&PeriodicPipe->State, 0x00, sizeof(PeriodicPipe->State));
+	PeriodicPipe->State.QueueDepth = MIN(PeriodicPipe->Config.QueueSize / SlotSize, UINT8_MAX);
+
+	uint8_t PrevSelectedPipe = Pipe_GetCurrentPipe();
+
+	Pipe_SelectPipe(PeriodicPipe->Config.PipeAddress);
+	Pipe_Freeze();
+	Pipe_SetPipeToken(PIPE_TOKEN_IN);
+	Pipe_SetInterruptPeriod(PeriodicPipe->Config.Interval);
+	Pipe_SelectPipe(PrevSelectedPipe);
+
+	uint_reg_t CurrentGlobalInt = GetGlobalInterruptMask();
+	GlobalInterruptDisable();
+
+	PeriodicPipe->State.NextFrame = ((USB_Host_GetFrameNumber() + 1) & PIPE_FRAME_NUMBER_MASK);
+	PeriodicPipe->State.NextPipe  = Pipe_PeriodicPipes;
+	Pipe_PeriodicPipes            = PeriodicPipe;
+
+	Pipe_UpdateFrameInterrupt();
+
+	SetGlobalInterruptMask(CurrentGlobalInt);
+	return true;
+}
+
+void Pipe_UnschedulePeriodicPipe(Pipe_PeriodicPipe_t* const PeriodicPipe)
+{
+	uint_reg_t CurrentGlobalInt = GetGlobalInterruptMask();
+	GlobalInterruptDisable();
+
+	Pipe_PeriodicPipe_t** LinkPtr = &Pipe_PeriodicPipes;
+
+	while (*LinkPtr != NULL)
+	{
+		if (*LinkPtr == PeriodicPipe)
+		{
+			*LinkPtr = PeriodicPipe->State.NextPipe;
+
+			uint8_t PrevSelectedPipe = Pipe_GetCurrentPipe();
+
+			Pipe_SelectPipe(PeriodicPipe->Config.PipeAddress);
+			Pipe_Freeze();
+			Pipe_SetInfiniteINRequests();
+			Pipe_SelectPipe(PrevSelectedPipe);
+
+			break;
+		}
+
+		LinkPtr = (Pipe_PeriodicPipe_t**)&(*LinkPtr)->State.NextPipe;
+	}
+
+	PeriodicPipe->State.NextPipe   = NULL;
+	PeriodicPipe->State.QueueCount = 0;
+
+	Pipe_UpdateFrameInterrupt();
+
+	SetGlobalInterruptMask(CurrentGlobalInt);
+}
+
+uint16_t Pipe_ReadPeriodicPacket(Pipe_PeriodicPipe_t* const PeriodicPipe,
+                                 void* const Buffer)
+{
+	if (!(PeriodicPipe->State.QueueCount))
+	  return 0;
+
+	uint8_t* SlotPtr      = &PeriodicPipe->Config.QueueBuffer[PeriodicPipe->State.QueueHead *
+	                                                          (sizeof(uint16_t) + PeriodicPipe->Config.PacketSize)];
+	uint16_t PacketLength = (SlotPtr[0] | (SlotPtr[1] << 8));
+
+	memcpy(Buffer, &SlotPtr[sizeof(uint16_t)], PacketLength);
+
+	uint_reg_t CurrentGlobalInt = GetGlobalInterruptMask();
+	GlobalInterruptDisable();
+
+	if (++PeriodicPipe->State.QueueHead == PeriodicPipe->State.QueueDepth)
+	  PeriodicPipe->State.QueueHead = 0;
+
+	PeriodicPipe->State.QueueCount--;
+
+	SetGlobalInterruptMask(CurrentGlobalInt);
+	return PacketLength;
+}
+
+void Pipe_GetPeriodicStatistics(Pipe_PeriodicPipe_t* const PeriodicPipe,
+                                Pipe_PeriodicStatistics_t* const Statistics,
+                                const bool Reset)
+{
+	uint_reg_t CurrentGlobalInt = GetGlobalInterruptMask();
+	GlobalInterruptDisable();
+
+	*Statistics = PeriodicPipe->State.Statistics;
+
+	if (Reset)
+	  memset(&PeriodicPipe->State.Statistics, 0x00, sizeof(PeriodicPipe->State.Statistics));
+
+	SetGlobalInterruptMask(CurrentGlobalInt);
+}
+
+void Pipe_ServicePeriodicPipes(void)
+{
+	uint16_t CurrentFrame     = USB_Host_GetFrameNumber();
+	uint8_t  PrevSelectedPipe = Pipe_GetCurrentPipe();
+
+	for (Pipe_PeriodicPipe_t* PeriodicPipe = Pipe_PeriodicPipes; PeriodicPipe != NULL; PeriodicPipe = PeriodicPipe->State.NextPipe)
+	{
+		Pipe_SelectPipe(PeriodicPipe->Config.PipeAddress);
+		Pipe_PollPeriodicPipe(PeriodicPipe, CurrentFrame);
+	}
+
+	Pipe_SelectPipe(PrevSelectedPipe);
+}
+
+void Pipe_UpdateFrameInterrupt(void)
+{
+	bool FrameInterruptNeeded = (Pipe_PeriodicPipes != NULL);
+
+	#if !defined(NO_SOF_EVENTS)
+	FrameInterruptNeeded |= USB_Host_SOFEventsEnabled;
+	#endif
+
+	if (FrameInterruptNeeded)
+	  USB_INT_Enable(USB_INT_HSOFI);
+	else
+	  USB_INT_Disable(USB_INT_HSOFI);
+}
+
+void Pipe_ClearPeriodicPipes(void)
+{
+	while (Pipe_PeriodicPipes != NULL)
+	{
+		Pipe_PeriodicPipe_t* PeriodicPipe = Pipe_PeriodicPipes;
+
+		Pipe_PeriodicPipes           = PeriodicPipe->State.NextPipe;
+		PeriodicPipe->State.NextPipe = NULL;
+	}
+}
+
+#endif
+
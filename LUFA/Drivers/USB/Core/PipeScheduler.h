@@ -0,0 +1,239 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2018.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2018  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+
+/** \file
+ *  \brief USB host periodic pipe scheduler.
+ *
+ *  This file contains structures, function prototypes and macros related to the scheduled polling of
+ *  periodic (interrupt and isochronous) IN pipes when the library is in USB host mode.
+ *
+ *  \note This file should not be included directly. It is automatically included as needed by the USB driver
+ *        dispatch header located in LUFA/Drivers/USB/USB.h.
+ */
+
+/** \ingroup Group_PipeManagement
+ *  \defgroup Group_PipeScheduler Periodic Pipe Scheduler
+ *  \brief Frame scheduled polling of periodic IN pipes.
+ *
+ *  Functions, macros, variables, enums and types related to the scheduled polling of interrupt and isochronous IN
+ *  pipes while in USB host mode. Rather than the application polling each pipe from its main loop, the scheduler
+ *  issues a single IN request on each registered pipe once per polling interval, timed from the USB Start Of Frame
+ *  interrupt, and places the received packets into a per-pipe queue for later retrieval by the application. This
+ *  gives each pipe a deterministic polling latency bound by its descriptor interval regardless of the main loop
+ *  load, and avoids the bus and CPU overhead of continually re-polling a device which has no new data.
+ *
+ *  Each scheduled pipe also maintains a set of statistics, which can be used to verify that the requested polling
+ *  intervals are being met when several periodic devices are attached at the same time.
+ *
+ *  The scheduler manages the host Start Of Frame interrupt itself, enabling it only while at least one pipe is
+ *  scheduled; the \ref EVENT_USB_Host_StartOfFrame() event continues to fire only while enabled by the application
+ *  via \ref USB_Host_EnableSOFEvents(). Scheduled pipes continue to be serviced while the library waits for frames
+ *  within blocking control transfers and enumeration delays.
+ *
+ *  \note The scheduler is only available when the \c PERIODIC_PIPE_SCHEDULER compile time token is defined. Frames
+ *        are not generated while the bus is being reset or is suspended, and any polling intervals which elapse during
+ *        this time are recorded as missed.
+ *
+ *  @{
+ */
+
+#ifndef __PIPESCHEDULER_H__
+#define __PIPESCHEDULER_H__
+
+	/* Includes: */
+		#include "../../../Common/Common.h"
+		#include "USBMode.h"
+		#include "USBController.h"
+		#include "Pipe.h"
+
+	/* Enable C linkage for C++ Compilers: */
+		#if defined(__cplusplus)
+			extern "C" {
+		#endif
+
+	/* Preprocessor Checks: */
+		#if !defined(__INCLUDE_FROM_USB_DRIVER)
+			#error Do not include this file directly. Include LUFA/Drivers/USB/USB.h instead.
+		#endif
+
+		#if defined(PERIODIC_PIPE_SCHEDULER) && !(ARCH == ARCH_AVR8 || ARCH == ARCH_UC3)
+			#error The PERIODIC_PIPE_SCHEDULER token is only supported on the AVR8 and UC3 architectures.
+		#endif
+
+	#if defined(PERIODIC_PIPE_SCHEDULER) || defined(__DOXYGEN__)
+	/* Public Interface - May be used in end-application: */
+		/* Macros: */
+			/** Computes the size in bytes of a periodic pipe queue buffer which can hold the given number of packets of up
+			 *  to the given size, for use as the \c QueueBuffer and \c QueueSize members of a \ref Pipe_PeriodicPipe_t.
+			 *
+			 *  \param[in] PacketSize  Maximum packet size of the periodic pipe, in bytes.
+			 *  \param[in] Packets     Number of packets the queue should be able to hold.
+			 */
+			#define PIPE_PERIODIC_QUEUE_SIZE(PacketSize, Packets)   ((sizeof(uint16_t) + (PacketSize)) * (Packets))
+
+		/* Type Defines: */
+			/** \brief Periodic Pipe Statistics.
+			 *
+			 *  Type define for the polling statistics of a pipe registered with the periodic pipe scheduler, retrieved via
+			 *  \ref Pipe_GetPeriodicStatistics().
+			 */
+			typedef struct
+			{
+				uint32_t PacketsReceived; /**< Number of IN packets received on the pipe, including any discarded due to a full queue. */
+				uint32_t EmptyPolls; /**< Number of polling intervals which elapsed without the device returning new data. */
+				uint16_t MissedIntervals; /**< Number of polling intervals which elapsed without the scheduler servicing the pipe. */
+				uint16_t QueueOverflows; /**< Number of received packets which were discarded as the pipe's queue was full. */
+				uint16_t Errors; /**< Number of pipe stalls or transaction errors which were cleared by the scheduler. */
+				uint8_t  MaxLateFrames; /**< Largest number of frames the scheduler serviced the pipe after its scheduled frame. */
+			} Pipe_PeriodicStatistics_t;
+
+			/** \brief Periodic Pipe Scheduler Entry.
+			 *
+			 *  Type define for a pipe entry registered with the periodic pipe scheduler via \ref Pipe_SchedulePeriodicPipe().
+			 *  The entry, and the queue buffer it references, must remain valid for as long as the pipe is scheduled.
+			 */
+			typedef struct
+			{
+				struct
+				{
+					uint8_t  PipeAddress; /**< Address of the configured interrupt or isochronous IN pipe to poll. */
+					uint8_t  Interval; /**< Polling interval of the pipe in frames, see \ref Pipe_GetPeriodicInterval(). */
+					uint16_t PacketSize; /**< Maximum size of a packet received on the pipe, in bytes. Any bytes beyond this
+					                      *   size in a received packet are discarded.
+					                      */
+					uint8_t* QueueBuffer; /**< Buffer used to queue received packets until they are read by the application. */
+					uint16_t QueueSize; /**< Size of the queue buffer in bytes, see \ref PIPE_PERIODIC_QUEUE_SIZE(). */
+				} Config; /**< Config data for the scheduled pipe. All elements in this section <b>must</b> be set before
+				           *   the pipe is scheduled.
+				           */
+				struct
+				{
+					void*             NextPipe; /**< Next scheduled pipe entry. */
+					uint16_t          NextFrame; /**< Frame number the pipe is next due to be polled in. */
+					uint8_t           QueueDepth; /**< Number of packets the queue buffer can hold. */
+					uint8_t           QueueHead; /**< Index of the oldest packet in the queue. */
+					volatile uint8_t  QueueCount; /**< Number of packets currently held in the queue. */
+					bool              RequestPending; /**< Indicates if an IN request has been issued but not yet answered. */
+					Pipe_PeriodicStatistics_t Statistics; /**< Polling statistics of the scheduled pipe. */
+				} State; /**< State data for the scheduled pipe. All elements in this section are managed by the scheduler
+				          *   and should not be modified by the user application.
+				          */
+			} Pipe_PeriodicPipe_t;
+
+		/* Function Prototypes: */
+			/** Converts the \c PollingIntervalMS value of an endpoint descriptor into a polling interval in full speed frames,
+			 *  suitable for use as the \c Interval member of a \ref Pipe_PeriodicPipe_t. Interrupt endpoint intervals are
+			 *  given directly in frames, while isochronous endpoint intervals are given as a power of two exponent.
+			 *
+			 *  \param[in] Type             Type of the endpoint, an \c EP_TYPE_* mask.
+			 *  \param[in] PollingInterval  Polling interval value from the endpoint descriptor.
+			 *
+			 *  \return Polling interval of the endpoint in frames, between 1 and 255.
+			 */
+			uint8_t Pipe_GetPeriodicInterval(const uint8_t Type,
+			                                 const uint8_t PollingInterval) ATTR_CONST;
+
+			/** Registers a configured interrupt or isochronous IN pipe with the periodic pipe scheduler. Once scheduled, the
+			 *  pipe is polled once every \c Interval frames from within the Start Of Frame interrupt, and any packets received
+			 *  are queued for retrieval via \ref Pipe_ReadPeriodicPacket(). The host Start Of Frame interrupt is enabled by
+			 *  this function if required.
+			 *
+			 *  \note Scheduled pipes are owned by the scheduler and must not be read directly by the application. All pipes
+			 *        are automatically removed from the scheduler when the pipes are reset due to a device disconnection.
+			 *
+			 *  \param[in,out] PeriodicPipe  Pointer to the pipe entry to schedule, with its \c Config section set.
+			 *
+			 *  \return Boolean \c true if the pipe was scheduled, \c false if the entry is invalid or already scheduled.
+			 */
+			bool Pipe_SchedulePeriodicPipe(Pipe_PeriodicPipe_t* const PeriodicPipe) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Removes a pipe from the periodic pipe scheduler, freezing the pipe. Any packets still held in the pipe's
+			 *  queue are discarded.
+			 *
+			 *  \param[in,out] PeriodicPipe  Pointer to the scheduled pipe entry to remove.
+			 */
+			void Pipe_UnschedulePeriodicPipe(Pipe_PeriodicPipe_t* const PeriodicPipe) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Reads the oldest queued packet received on a scheduled pipe into the given buffer, removing it from the
+			 *  pipe's queue.
+			 *
+			 *  \param[in,out] PeriodicPipe  Pointer to the scheduled pipe entry to read from.
+			 *  \param[out]    Buffer        Buffer to store the packet into, at least \c PacketSize bytes in length.
+			 *
+			 *  \return Length of the packet read in bytes, or zero if the queue was empty.
+			 */
+			uint16_t Pipe_ReadPeriodicPacket(Pipe_PeriodicPipe_t* const PeriodicPipe,
+			                                 void* const Buffer) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+
+			/** Retrieves a consistent snapshot of the polling statistics of a scheduled pipe, optionally resetting them.
+			 *
+			 *  \param[in,out] PeriodicPipe  Pointer to the scheduled pipe entry whose statistics are to be retrieved.
+			 *  \param[out]    Statistics    Location where the statistics are to be stored.
+			 *  \param[in]     Reset         If \c true, the pipe's statistics are cleared once they have been retrieved.
+			 */
+			void Pipe_GetPeriodicStatistics(Pipe_PeriodicPipe_t* const PeriodicPipe,
+			                                Pipe_PeriodicStatistics_t* const Statistics,
+			                                const bool Reset) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+
+		/* Inline Functions: */
+			/** Determines if one or more packets received on a scheduled pipe are waiting in its queue.
+			 *
+			 *  \param[in] PeriodicPipe  Pointer to the scheduled pipe entry to check.
+			 *
+			 *  \return Boolean \c true if a packet is waiting to be read, \c false otherwise.
+			 */
+			static inline bool Pipe_IsPeriodicPacketReceived(const Pipe_PeriodicPipe_t* const PeriodicPipe) ATTR_WARN_UNUSED_RESULT ATTR_NON_NULL_PTR_ARG(1) ATTR_ALWAYS_INLINE;
+			static inline bool Pipe_IsPeriodicPacketReceived(const Pipe_PeriodicPipe_t* const PeriodicPipe)
+			{
+				return (PeriodicPipe->State.QueueCount != 0);
+			}
+
+	/* Private Interface - For use in library only: */
+	#if !defined(__DOXYGEN__)
+		/* Macros: */
+			#define PIPE_FRAME_NUMBER_MASK      0x07FF
+
+		/* Function Prototypes: */
+			void Pipe_ServicePeriodicPipes(void);
+			void Pipe_UpdateFrameInterrupt(void);
+			void Pipe_ClearPeriodicPipes(void);
+	#endif
+	#endif
+
+	/* Disable C linkage for C++ Compilers: */
+		#if defined(__cplusplus)
+			}
+		#endif
+
+#endif
+
+/** @} */
+
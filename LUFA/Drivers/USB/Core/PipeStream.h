@@ -82,6 +82,31 @@
 				                                       */
 			};
 
+			/** Enum for the possible source memory spaces of a \ref Pipe_StreamSegment_t segment. */
+			enum Pipe_StreamSegment_MemorySpaces_t
+			{
+				PIPE_SEGMENT_RAM    = 0, /**< Segment data is located in RAM. */
+				#if defined(ARCH_HAS_FLASH_ADDRESS_SPACE) || defined(__DOXYGEN__)
+				PIPE_SEGMENT_FLASH  = 1, /**< Segment data is located in FLASH memory. */
+				#endif
+				#if defined(ARCH_HAS_EEPROM_ADDRESS_SPACE) || defined(__DOXYGEN__)
+				PIPE_SEGMENT_EEPROM = 2, /**< Segment data is located in EEPROM memory. */
+				#endif
+			};
+
+		/* Type Defines: */
+			/** Type define for a single source data segment of a scatter-gather stream write, for use with the
+			 *  \c Pipe_Write_StreamV() function. Zero initialized fields default to a RAM segment.
+			 */
+			typedef struct
+			{
+				const void* Buffer; /**< Pointer to the start of the segment data. */
+				uint16_t    Length; /**< Length of the segment data, in bytes. */
+				uint8_t     MemorySpace; /**< Memory space of the segment data, a value from the
+				                          *   \ref Pipe_StreamSegment_MemorySpaces_t enum.
+				                          */
+			} Pipe_StreamSegment_t;
+
 	/* Architecture Includes: */
 		#if (ARCH == ARCH_AVR8)
 			#include "AVR8/PipeStream_AVR8.h"
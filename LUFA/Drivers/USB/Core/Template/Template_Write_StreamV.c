@@ -0,0 +1,106 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2018.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2018  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+#if defined(TEMPLATE_FUNC_NAME)
+
+uint8_t TEMPLATE_FUNC_NAME (const TEMPLATE_SEGMENT_TYPE* const Segments,
+                            const uint8_t TotalSegments,
+                            uint16_t* const BytesProcessed)
+{
+	uint16_t BytesToSkip     = 0;
+	uint16_t BytesInTransfer = 0;
+	uint8_t  ErrorCode;
+
+	if (BytesProcessed != NULL)
+	  BytesToSkip = *BytesProcessed;
+
+	for (uint8_t SegmentIndex = 0; SegmentIndex < TotalSegments; SegmentIndex++)
+	{
+		const TEMPLATE_SEGMENT_TYPE* Segment = &Segments[SegmentIndex];
+
+		const uint8_t* DataStream = (const uint8_t*)Segment->Buffer;
+		uint16_t       Length     = Segment->Length;
+
+		if (BytesToSkip)
+		{
+			uint16_t SkippedBytes = MIN(BytesToSkip, Length);
+
+			DataStream  += SkippedBytes;
+			Length      -= SkippedBytes;
+			BytesToSkip -= SkippedBytes;
+		}
+
+		if (!(Length))
+		  continue;
+
+		uint16_t  SegmentBytesProcessed = 0;
+		uint16_t* SegmentProgress       = (BytesProcessed != NULL) ? &SegmentBytesProcessed : NULL;
+
+		switch (Segment->MemorySpace)
+		{
+			#if defined(ARCH_HAS_FLASH_ADDRESS_SPACE)
+			case TEMPLATE_SEGMENT_FLASH:
+				ErrorCode = TEMPLATE_WRITE_PSTREAM(DataStream, Length, SegmentProgress);
+				break;
+			#endif
+			#if defined(ARCH_HAS_EEPROM_ADDRESS_SPACE)
+			case TEMPLATE_SEGMENT_EEPROM:
+				ErrorCode = TEMPLATE_WRITE_ESTREAM(DataStream, Length, SegmentProgress);
+				break;
+			#endif
+			default:
+				ErrorCode = TEMPLATE_WRITE_STREAM(DataStream, Length, SegmentProgress);
+				break;
+		}
+
+		if (ErrorCode)
+		{
+			if (BytesProcessed != NULL)
+			  *BytesProcessed += (BytesInTransfer + SegmentBytesProcessed);
+
+			return ErrorCode;
+		}
+
+		BytesInTransfer += Length;
+	}
+
+	return TEMPLATE_NO_ERROR;
+}
+
+#undef TEMPLATE_FUNC_NAME
+#undef TEMPLATE_SEGMENT_TYPE
+#undef TEMPLATE_NO_ERROR
+#undef TEMPLATE_SEGMENT_FLASH
+#undef TEMPLATE_SEGMENT_EEPROM
+#undef TEMPLATE_WRITE_STREAM
+#undef TEMPLATE_WRITE_PSTREAM
+#undef TEMPLATE_WRITE_ESTREAM
+
+#endif
@@ -117,6 +117,28 @@ uint8_t Endpoint_Null_Stream(uint16_t Length,
 	return ENDPOINT_RWSTREAM_NoError;
 }
 
+static inline void Endpoint_Write_FIFOWord(const uint8_t* const Data) ATTR_ALWAYS_INLINE;
+static inline void Endpoint_Write_FIFOWord(const uint8_t* const Data)
+{
+	*((volatile uint32_t*)USB_Endpoint_FIFOPos[USB_Endpoint_SelectedEndpoint]) =
+	    (((uint32_t)Data[0] << 24) | ((uint32_t)Data[1] << 16) | ((uint32_t)Data[2] << 8) | Data[3]);
+
+	USB_Endpoint_FIFOPos[USB_Endpoint_SelectedEndpoint] += 4;
+}
+
+static inline void Endpoint_Read_FIFOWord(uint8_t* const Data) ATTR_ALWAYS_INLINE;
+static inline void Endpoint_Read_FIFOWord(uint8_t* const Data)
+{
+	uint32_t Word = *((volatile uint32_t*)USB_Endpoint_FIFOPos[USB_Endpoint_SelectedEndpoint]);
+
+	Data[0] = (Word >> 24);
+	Data[1] = (Word >> 16);
+	Data[2] = (Word >> 8);
+	Data[3] = Word;
+
+	USB_Endpoint_FIFOPos[USB_Endpoint_SelectedEndpoint] += 4;
+}
+
 /* The following abuses the C preprocessor in order to copy-paste common code with slight alterations,
  * so that the code needs to be written once. It is a crude form of templating to reduce code maintenance. */
 
@@ -126,6 +148,7 @@ uint8_t Endpoint_Null_Stream(uint16_t Length,
 #define  TEMPLATE_BUFFER_OFFSET(Length)            0
 #define  TEMPLATE_BUFFER_MOVE(BufferPtr, Amount)   BufferPtr += Amount
 #define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         Endpoint_Write_8(*BufferPtr)
+#define  TEMPLATE_TRANSFER_WORD(BufferPtr)         Endpoint_Write_FIFOWord(BufferPtr)
 #include "Template/Template_Endpoint_RW.c"
 
 #define  TEMPLATE_FUNC_NAME                        Endpoint_Write_Stream_BE
@@ -142,6 +165,7 @@ uint8_t Endpoint_Null_Stream(uint16_t Length,
 #define  TEMPLATE_BUFFER_OFFSET(Length)            0
 #define  TEMPLATE_BUFFER_MOVE(BufferPtr, Amount)   BufferPtr += Amount
 #define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         *BufferPtr = Endpoint_Read_8()
+#define  TEMPLATE_TRANSFER_WORD(BufferPtr)         Endpoint_Read_FIFOWord(BufferPtr)
 #include "Template/Template_Endpoint_RW.c"
 
 #define  TEMPLATE_FUNC_NAME                        Endpoint_Read_Stream_BE
@@ -204,6 +228,16 @@ uint8_t Endpoint_Null_Stream(uint16_t Length,
 	#include "Template/Template_Endpoint_RW.c"
 #endif
 
+#define  TEMPLATE_FUNC_NAME                        Endpoint_Write_StreamV
+#define  TEMPLATE_SEGMENT_TYPE                     Endpoint_StreamSegment_t
+#define  TEMPLATE_SEGMENT_FLASH                    ENDPOINT_SEGMENT_FLASH
+#define  TEMPLATE_SEGMENT_EEPROM                   ENDPOINT_SEGMENT_EEPROM
+#define  TEMPLATE_NO_ERROR                         ENDPOINT_RWSTREAM_NoError
+#define  TEMPLATE_WRITE_STREAM                     Endpoint_Write_Stream_LE
+#define  TEMPLATE_WRITE_PSTREAM                    Endpoint_Write_PStream_LE
+#define  TEMPLATE_WRITE_ESTREAM                    Endpoint_Write_EStream_LE
+#include "../Template/Template_Write_StreamV.c"
+
 #endif
 
 #define  TEMPLATE_FUNC_NAME                        Endpoint_Write_Control_Stream_LE
@@ -427,6 +427,50 @@
 			                                        uint16_t Length) ATTR_NON_NULL_PTR_ARG(1);
 			//@}
 
+			/** \name Scatter-gather stream functions */
+			//@{
+
+			/** Writes the given list of source data segments to the currently selected endpoint as a single continuous
+			 *  stream, in little endian byte order. The segments are packed back to back into the endpoint banks without
+			 *  an intermediate copy and without waiting for the endpoint to become ready between segments, so that a
+			 *  header and payload held in separate buffers are sent in as few packets as possible. Each segment may
+			 *  reside in any of the memory spaces supported by the architecture, as indicated by its \c MemorySpace field.
+			 *
+			 *  If the BytesProcessed parameter is \c NULL, the entire stream transfer is attempted at once, failing or
+			 *  succeeding as a single unit. Otherwise the transfer is performed as a series of chunks in the same manner
+			 *  as \ref Endpoint_Write_Stream_LE(), with BytesProcessed tracking the total number of bytes written across
+			 *  all segments.
+			 *
+			 *  As with the other stream functions, the last packet is not automatically sent once the final segment has
+			 *  been written; the user is responsible for manually sending the last written packet to the host via the
+			 *  \ref Endpoint_ClearIN() macro.
+			 *
+			 *  <b>Example Usage:</b>
+			 *  \code
+			 *  Endpoint_StreamSegment_t Segments[] =
+			 *      {
+			 *          {.Buffer = &Header, .Length = sizeof(Header)},
+			 *          {.Buffer = Payload, .Length = PayloadLength},
+			 *      };
+			 *
+			 *  if (Endpoint_Write_StreamV(Segments, 2, NULL) == ENDPOINT_RWSTREAM_NoError)
+			 *    Endpoint_ClearIN();
+			 *  \endcode
+			 *
+			 *  \note This routine should not be used on CONTROL type endpoints.
+			 *
+			 *  \param[in] Segments        Pointer to an array of source data segments to write.
+			 *  \param[in] TotalSegments   Number of segments in the array.
+			 *  \param[in] BytesProcessed  Pointer to a location where the total number of bytes processed in the current
+			 *                             transaction should be updated, \c NULL if the entire stream should be written at once.
+			 *
+			 *  \return A value from the \ref Endpoint_Stream_RW_ErrorCodes_t enum.
+			 */
+			uint8_t Endpoint_Write_StreamV(const Endpoint_StreamSegment_t* const Segments,
+			                               const uint8_t TotalSegments,
+			                               uint16_t* const BytesProcessed) ATTR_NON_NULL_PTR_ARG(1);
+			//@}
+
 	/* Disable C linkage for C++ Compilers: */
 		#if defined(__cplusplus)
 			}
@@ -242,6 +242,26 @@
 				return ((&AVR32_USBB.UECFG0)[USB_Endpoint_SelectedEndpoint].epdir ? ENDPOINT_DIR_IN : ENDPOINT_DIR_OUT);
 			}
 
+			/** Determines the number of bytes which may be written to (IN endpoints) or read from (OUT endpoints) the
+			 *  currently selected endpoint's bank before it becomes full or empty, and must be cleared. This allows
+			 *  stream transfers to move a complete bank of data without checking \ref Endpoint_IsReadWriteAllowed()
+			 *  after each byte.
+			 *
+			 *  \ingroup Group_EndpointRW_UC3
+			 *
+			 *  \note This function is not valid on CONTROL type endpoints.
+			 *
+			 *  \return Number of bytes which may be transferred before the current bank must be cleared.
+			 */
+			static inline uint16_t Endpoint_BytesRemainingInBank(void) ATTR_WARN_UNUSED_RESULT ATTR_ALWAYS_INLINE;
+			static inline uint16_t Endpoint_BytesRemainingInBank(void)
+			{
+				if (Endpoint_GetEndpointDirection() == ENDPOINT_DIR_IN)
+				  return ((8 << (&AVR32_USBB.UECFG0)[USB_Endpoint_SelectedEndpoint].epsize) - Endpoint_BytesInEndpoint());
+				else
+				  return Endpoint_BytesInEndpoint();
+			}
+
 			/** Get the endpoint address of the currently selected endpoint. This is typically used to save
 			 *  the currently selected endpoint so that it can be restored after another endpoint has been
 			 *  manipulated.
@@ -214,6 +214,11 @@ uint8_t USB_Host_WaitMS(uint8_t MS)
 		{
 			USB_INT_Clear(USB_INT_HSOFI);
 			MS--;
+
+			#if defined(PERIODIC_PIPE_SCHEDULER)
+			if (HSOFIEnabled)
+			  Pipe_ServicePeriodicPipes();
+			#endif
 		}
 
 		if ((USB_HostState == HOST_STATE_Unattached) || (USB_CurrentMode != USB_MODE_Host))
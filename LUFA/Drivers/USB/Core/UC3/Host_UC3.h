@@ -139,6 +139,12 @@
 			}
 
 			#if !defined(NO_SOF_EVENTS)
+				#if defined(PERIODIC_PIPE_SCHEDULER) && !defined(__DOXYGEN__)
+					extern volatile bool USB_Host_SOFEventsEnabled;
+
+					void Pipe_UpdateFrameInterrupt(void);
+				#endif
+
 				/** Enables the host mode Start Of Frame events. When enabled, this causes the
 				 *  \ref EVENT_USB_Host_StartOfFrame() event to fire once per millisecond, synchronized to the USB bus,
 				 *  at the start of each USB frame when a device is enumerated while in host mode.
@@ -148,7 +154,12 @@
 				static inline void USB_Host_EnableSOFEvents(void) ATTR_ALWAYS_INLINE;
 				static inline void USB_Host_EnableSOFEvents(void)
 				{
+					#if defined(PERIODIC_PIPE_SCHEDULER)
+					USB_Host_SOFEventsEnabled = true;
+					Pipe_UpdateFrameInterrupt();
+					#else
 					USB_INT_Enable(USB_INT_HSOFI);
+					#endif
 				}
 
 				/** Disables the host mode Start Of Frame events. When disabled, this stops the firing of the
@@ -159,7 +170,12 @@
 				static inline void USB_Host_DisableSOFEvents(void) ATTR_ALWAYS_INLINE;
 				static inline void USB_Host_DisableSOFEvents(void)
 				{
+					#if defined(PERIODIC_PIPE_SCHEDULER)
+					USB_Host_SOFEventsEnabled = false;
+					Pipe_UpdateFrameInterrupt();
+					#else
 					USB_INT_Disable(USB_INT_HSOFI);
+					#endif
 				}
 			#endif
 
@@ -161,6 +161,16 @@ uint8_t Pipe_Null_Stream(uint16_t Length,
 #define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         *BufferPtr = Pipe_Read_8()
 #include "Template/Template_Pipe_RW.c"
 
+#define  TEMPLATE_FUNC_NAME                        Pipe_Write_StreamV
+#define  TEMPLATE_SEGMENT_TYPE                     Pipe_StreamSegment_t
+#define  TEMPLATE_SEGMENT_FLASH                    PIPE_SEGMENT_FLASH
+#define  TEMPLATE_SEGMENT_EEPROM                   PIPE_SEGMENT_EEPROM
+#define  TEMPLATE_NO_ERROR                         PIPE_RWSTREAM_NoError
+#define  TEMPLATE_WRITE_STREAM                     Pipe_Write_Stream_LE
+#define  TEMPLATE_WRITE_PSTREAM                    Pipe_Write_PStream_LE
+#define  TEMPLATE_WRITE_ESTREAM                    Pipe_Write_EStream_LE
+#include "../Template/Template_Write_StreamV.c"
+
 #endif
 
 #endif
@@ -341,6 +341,39 @@
 			                            uint16_t* const BytesProcessed) ATTR_NON_NULL_PTR_ARG(1);
 			//@}
 
+			/** \name Scatter-gather stream functions */
+			//@{
+
+			/** Writes the given list of source data segments to the currently selected pipe as a single continuous
+			 *  stream, in little endian byte order. The segments are packed back to back into the pipe banks without an
+			 *  intermediate copy and without waiting for the pipe to become ready between segments, so that a header
+			 *  and payload held in separate buffers are sent in as few packets as possible. Each segment may reside in
+			 *  any of the memory spaces supported by the architecture, as indicated by its \c MemorySpace field.
+			 *
+			 *  If the BytesProcessed parameter is \c NULL, the entire stream transfer is attempted at once, failing or
+			 *  succeeding as a single unit. Otherwise the transfer is performed as a series of chunks in the same manner
+			 *  as \ref Pipe_Write_Stream_LE(), with BytesProcessed tracking the total number of bytes written across
+			 *  all segments.
+			 *
+			 *  As with the other stream functions, the last packet is not automatically sent once the final segment has
+			 *  been written; the user is responsible for manually sending the last written packet to the device via the
+			 *  \ref Pipe_ClearOUT() macro.
+			 *
+			 *  \note The pipe token is set automatically, thus this can be used on bi-directional pipes directly without
+			 *        having to explicitly change the data direction with a call to \ref Pipe_SetPipeToken().
+			 *
+			 *  \param[in] Segments        Pointer to an array of source data segments to write.
+			 *  \param[in] TotalSegments   Number of segments in the array.
+			 *  \param[in] BytesProcessed  Pointer to a location where the total number of bytes processed in the current
+			 *                             transaction should be updated, \c NULL if the entire stream should be written at once.
+			 *
+			 *  \return A value from the \ref Pipe_Stream_RW_ErrorCodes_t enum.
+			 */
+			uint8_t Pipe_Write_StreamV(const Pipe_StreamSegment_t* const Segments,
+			                           const uint8_t TotalSegments,
+			                           uint16_t* const BytesProcessed) ATTR_NON_NULL_PTR_ARG(1);
+			//@}
+
 	/* Disable C linkage for C++ Compilers: */
 		#if defined(__cplusplus)
 			}
@@ -135,6 +135,10 @@ bool Pipe_ConfigurePipe(const uint8_t Address,
 
 void Pipe_ClearPipes(void)
 {
+	#if defined(PERIODIC_PIPE_SCHEDULER)
+	Pipe_ClearPeriodicPipes();
+	#endif
+
 	for (uint8_t PNum = 0; PNum < PIPE_TOTAL_PIPES; PNum++)
 	{
 		Pipe_SelectPipe(PNum);
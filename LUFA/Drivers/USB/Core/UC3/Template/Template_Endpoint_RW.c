@@ -68,10 +68,59 @@ uint8_t TEMPLATE_FUNC_NAME (TEMPLATE_BUFFER_TYPE const Buffer,
 		}
 		else
 		{
-			TEMPLATE_TRANSFER_BYTE(DataStream);
-			TEMPLATE_BUFFER_MOVE(DataStream, 1);
-			Length--;
-			BytesInTransfer++;
+			uint16_t BytesInBank = MIN(Endpoint_BytesRemainingInBank(), Length);
+
+			if (!(BytesInBank))
+			  BytesInBank = 1;
+
+			Length          -= BytesInBank;
+			BytesInTransfer += BytesInBank;
+
+			#if defined(TEMPLATE_TRANSFER_WORD)
+			/* Copy the remainder of the current bank as whole 32-bit FIFO words once the FIFO position is word aligned */
+			while (BytesInBank && ((uintptr_t)USB_Endpoint_FIFOPos[USB_Endpoint_SelectedEndpoint] & 0x03))
+			{
+				TEMPLATE_TRANSFER_BYTE(DataStream);
+				TEMPLATE_BUFFER_MOVE(DataStream, 1);
+				BytesInBank--;
+			}
+
+			while (BytesInBank >= 4)
+			{
+				TEMPLATE_TRANSFER_WORD(DataStream);
+				TEMPLATE_BUFFER_MOVE(DataStream, 4);
+				BytesInBank -= 4;
+			}
+			#else
+			/* Copy the remainder of the current bank in one burst, only re-checking the bank state once it is exhausted */
+			while (BytesInBank >= 8)
+			{
+				TEMPLATE_TRANSFER_BYTE(DataStream);
+				TEMPLATE_BUFFER_MOVE(DataStream, 1);
+				TEMPLATE_TRANSFER_BYTE(DataStream);
+				TEMPLATE_BUFFER_MOVE(DataStream, 1);
+				TEMPLATE_TRANSFER_BYTE(DataStream);
+				TEMPLATE_BUFFER_MOVE(DataStream, 1);
+				TEMPLATE_TRANSFER_BYTE(DataStream);
+				TEMPLATE_BUFFER_MOVE(DataStream, 1);
+				TEMPLATE_TRANSFER_BYTE(DataStream);
+				TEMPLATE_BUFFER_MOVE(DataStream, 1);
+				TEMPLATE_TRANSFER_BYTE(DataStream);
+				TEMPLATE_BUFFER_MOVE(DataStream, 1);
+				TEMPLATE_TRANSFER_BYTE(DataStream);
+				TEMPLATE_BUFFER_MOVE(DataStream, 1);
+				TEMPLATE_TRANSFER_BYTE(DataStream);
+				TEMPLATE_BUFFER_MOVE(DataStream, 1);
+
+				BytesInBank -= 8;
+			}
+			#endif
+
+			while (BytesInBank--)
+			{
+				TEMPLATE_TRANSFER_BYTE(DataStream);
+				TEMPLATE_BUFFER_MOVE(DataStream, 1);
+			}
 		}
 	}
 
@@ -81,6 +130,7 @@ uint8_t TEMPLATE_FUNC_NAME (TEMPLATE_BUFFER_TYPE const Buffer,
 #undef TEMPLATE_FUNC_NAME
 #undef TEMPLATE_BUFFER_TYPE
 #undef TEMPLATE_TRANSFER_BYTE
+#undef TEMPLATE_TRANSFER_WORD
 #undef TEMPLATE_CLEAR_ENDPOINT
 #undef TEMPLATE_BUFFER_OFFSET
 #undef TEMPLATE_BUFFER_MOVE
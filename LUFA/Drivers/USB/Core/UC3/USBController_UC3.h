@@ -61,6 +61,7 @@
 			#include "../Pipe.h"
 			#include "../HostStandardReq.h"
 			#include "../PipeStream.h"
+			#include "../PipeScheduler.h"
 		#endif
 
 		#if defined(USB_CAN_BE_DEVICE) || defined(__DOXYGEN__)
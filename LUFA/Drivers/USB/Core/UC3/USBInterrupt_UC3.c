@@ -132,12 +132,21 @@ ISR(USB_GEN_vect)
 	#endif
 
 	#if defined(USB_CAN_BE_HOST)
-	#if !defined(NO_SOF_EVENTS)
+	#if !defined(NO_SOF_EVENTS) || defined(PERIODIC_PIPE_SCHEDULER)
 	if (USB_INT_HasOccurred(USB_INT_HSOFI) && USB_INT_IsEnabled(USB_INT_HSOFI))
 	{
 		USB_INT_Clear(USB_INT_HSOFI);
 
+		#if defined(PERIODIC_PIPE_SCHEDULER)
+		Pipe_ServicePeriodicPipes();
+		#endif
+
+		#if !defined(NO_SOF_EVENTS) && defined(PERIODIC_PIPE_SCHEDULER)
+		if (USB_Host_SOFEventsEnabled)
+		  EVENT_USB_Host_StartOfFrame();
+		#elif !defined(NO_SOF_EVENTS)
 		EVENT_USB_Host_StartOfFrame();
+		#endif
 	}
 	#endif
 
@@ -155,6 +155,11 @@
 		 */
 		#define USB_SERIES_C4_XMEGA
 
+		/** Indicates that the target is the host-native POSIX architecture, using a simulated USB device controller
+		 *  which is driven by a software virtual host, when defined.
+		 */
+		#define USB_SERIES_POSIX
+
 		/** Indicates that the target microcontroller and compilation settings allow for the
 		 *  target to be configured in USB Device mode when defined.
 		 */
@@ -245,6 +250,9 @@
 			#elif (defined(__AVR_ATxmega16C4__) || defined(__AVR_ATxmega32C4__))
 				#define USB_SERIES_C4_XMEGA
 				#define USB_CAN_BE_DEVICE
+			#elif (ARCH == ARCH_POSIX)
+				#define USB_SERIES_POSIX
+				#define USB_CAN_BE_DEVICE
 			#endif
 
 			#if (defined(USB_HOST_ONLY) && defined(USB_DEVICE_ONLY))
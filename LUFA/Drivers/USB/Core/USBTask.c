@@ -45,6 +45,10 @@ volatile uint8_t     USB_DeviceState;
 
 void USB_USBTask(void)
 {
+	#if (ARCH == ARCH_POSIX)
+		USB_VirtualHost_Poll();
+	#endif
+
 	#if defined(USB_CAN_BE_BOTH)
 		if (USB_CurrentMode == USB_MODE_Device)
 		  USB_DeviceTask();
@@ -204,6 +204,16 @@ uint8_t Endpoint_Null_Stream(uint16_t Length,
 	#include "Template/Template_Endpoint_RW.c"
 #endif
 
+#define  TEMPLATE_FUNC_NAME                        Endpoint_Write_StreamV
+#define  TEMPLATE_SEGMENT_TYPE                     Endpoint_StreamSegment_t
+#define  TEMPLATE_SEGMENT_FLASH                    ENDPOINT_SEGMENT_FLASH
+#define  TEMPLATE_SEGMENT_EEPROM                   ENDPOINT_SEGMENT_EEPROM
+#define  TEMPLATE_NO_ERROR                         ENDPOINT_RWSTREAM_NoError
+#define  TEMPLATE_WRITE_STREAM                     Endpoint_Write_Stream_LE
+#define  TEMPLATE_WRITE_PSTREAM                    Endpoint_Write_PStream_LE
+#define  TEMPLATE_WRITE_ESTREAM                    Endpoint_Write_EStream_LE
+#include "../Template/Template_Write_StreamV.c"
+
 #endif
 
 #define  TEMPLATE_FUNC_NAME                        Endpoint_Write_Control_Stream_LE
@@ -160,6 +160,11 @@
 				#define ENDPOINT_CONTROLEP_DEFAULT_SIZE     8
 			#endif
 
+			/** Indicates that the endpoint banks of the selected architecture are directly addressable, and may be
+			 *  accessed in place via \ref Endpoint_AcquireBank() and \ref Endpoint_CommitBank().
+			 */
+			#define ENDPOINT_HAS_BANK_ACCESS
+
 		/* Enums: */
 			/** Enum for the possible error return codes of the \ref Endpoint_WaitUntilReady() function.
 			 *
@@ -270,6 +275,60 @@
 				  return (USB_Endpoint_SelectedFIFO->Length - USB_Endpoint_SelectedFIFO->Position);
 			}
 
+			/** Determines the number of bytes which may be written to (IN endpoints) or read from (OUT endpoints) the
+			 *  currently selected endpoint's bank before it becomes full or empty, and must be cleared. This allows
+			 *  stream transfers to move a complete bank of data without checking \ref Endpoint_IsReadWriteAllowed()
+			 *  after each byte.
+			 *
+			 *  \ingroup Group_EndpointRW_XMEGA
+			 *
+			 *  \note This function is not valid on CONTROL type endpoints.
+			 *
+			 *  \return Number of bytes which may be transferred before the current bank must be cleared.
+			 */
+			static inline uint16_t Endpoint_BytesRemainingInBank(void) ATTR_WARN_UNUSED_RESULT ATTR_ALWAYS_INLINE;
+			static inline uint16_t Endpoint_BytesRemainingInBank(void)
+			{
+				return (USB_Endpoint_SelectedFIFO->Length - USB_Endpoint_SelectedFIFO->Position);
+			}
+
+			/** Obtains direct access to the unprocessed portion of the currently selected endpoint's bank, so that
+			 *  packet data may be parsed (OUT endpoints) or built (IN endpoints) in place rather than being copied
+			 *  through the \c Endpoint_Read_* and \c Endpoint_Write_* functions. Once processed, the bytes must be
+			 *  released with \ref Endpoint_CommitBank() before the bank is cleared or further accessed through the
+			 *  regular endpoint functions.
+			 *
+			 *  \ingroup Group_EndpointRW_XMEGA
+			 *
+			 *  \note This function is not valid on CONTROL type endpoints.
+			 *
+			 *  \param[out] Length  Number of bytes available at the returned location, as returned by
+			 *                      \ref Endpoint_BytesRemainingInBank().
+			 *
+			 *  \return Pointer to the next unprocessed byte of the currently selected endpoint's bank.
+			 */
+			static inline void* Endpoint_AcquireBank(uint16_t* const Length) ATTR_WARN_UNUSED_RESULT ATTR_NON_NULL_PTR_ARG(1) ATTR_ALWAYS_INLINE;
+			static inline void* Endpoint_AcquireBank(uint16_t* const Length)
+			{
+				*Length = Endpoint_BytesRemainingInBank();
+				return (void*)&USB_Endpoint_SelectedFIFO->Data[USB_Endpoint_SelectedFIFO->Position];
+			}
+
+			/** Releases bytes obtained through \ref Endpoint_AcquireBank(), marking them as read from (OUT endpoints)
+			 *  or written to (IN endpoints) the currently selected endpoint's bank. The bank must still be cleared
+			 *  via \ref Endpoint_ClearOUT() or \ref Endpoint_ClearIN() as usual once complete.
+			 *
+			 *  \ingroup Group_EndpointRW_XMEGA
+			 *
+			 *  \param[in] Length  Number of bytes processed, which must not exceed the length given by
+			 *                     \ref Endpoint_AcquireBank().
+			 */
+			static inline void Endpoint_CommitBank(const uint16_t Length) ATTR_ALWAYS_INLINE;
+			static inline void Endpoint_CommitBank(const uint16_t Length)
+			{
+				USB_Endpoint_SelectedFIFO->Position += Length;
+			}
+
 			/** Get the endpoint address of the currently selected endpoint. This is typically used to save
 			 *  the currently selected endpoint so that it can be restored after another endpoint has been
 			 *  manipulated.
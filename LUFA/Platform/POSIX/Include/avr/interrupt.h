@@ -0,0 +1,45 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2018.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2018  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *  \brief Host-native substitute for the AVR-LibC \c <avr/interrupt.h> header.
+ *
+ *  This header allows applications written against AVR-LibC to be built for the host-native POSIX
+ *  architecture. The relevant definitions are provided by the POSIX section of LUFA/Common/Common.h.
+ */
+
+#ifndef __POSIX_AVR_INTERRUPT_H__
+#define __POSIX_AVR_INTERRUPT_H__
+
+	/* Includes: */
+		#include "../../../../Common/Common.h"
+
+#endif
+
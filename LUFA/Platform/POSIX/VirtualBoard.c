@@ -0,0 +1,367 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2018.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2018  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+#include "../../Common/Common.h"
+#if (ARCH == ARCH_POSIX)
+
+#define  __INCLUDE_FROM_VIRTUALBOARD_C
+#include "VirtualBoard.h"
+#include "../../Drivers/Misc/AT45DB642D.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define VBOARD_DATAFLASH_RAW_PAGE    (VIRTUAL_BOARD_DATAFLASH_PAGE_SIZE + VIRTUAL_BOARD_DATAFLASH_SPARE_SIZE)
+#define VBOARD_DATAFLASH_CHIP_SIZE   ((size_t)VIRTUAL_BOARD_DATAFLASH_PAGES * VIRTUAL_BOARD_DATAFLASH_PAGE_SIZE)
+#define VBOARD_DATAFLASH_CHIP_SPARE  ((size_t)VIRTUAL_BOARD_DATAFLASH_PAGES * VIRTUAL_BOARD_DATAFLASH_SPARE_SIZE)
+#define VBOARD_DATAFLASH_DATA_SIZE   (VBOARD_DATAFLASH_CHIP_SIZE * VIRTUAL_BOARD_DATAFLASH_CHIPS)
+#define VBOARD_DATAFLASH_TOTAL_SIZE  (VBOARD_DATAFLASH_DATA_SIZE + (VBOARD_DATAFLASH_CHIP_SPARE * VIRTUAL_BOARD_DATAFLASH_CHIPS))
+#define VBOARD_DATAFLASH_MAX_HEADER  8
+#define VBOARD_DATAFLASH_DENSITY     (0x0F << 2)
+
+typedef struct
+{
+	uint8_t  Buffers[2][VBOARD_DATAFLASH_RAW_PAGE];
+	uint8_t  Status;
+} VirtualBoard_DataflashChip_t;
+
+volatile uint8_t VirtualBoard_LEDs;
+volatile uint8_t VirtualBoard_Buttons;
+volatile uint8_t VirtualBoard_Joystick;
+
+static uint8_t*                     VirtualBoard_DataflashMemory;
+static VirtualBoard_DataflashChip_t VirtualBoard_DataflashChips[VIRTUAL_BOARD_DATAFLASH_CHIPS];
+static uint8_t                      VirtualBoard_DataflashSelected;
+static uint8_t                      VirtualBoard_DataflashShiftRegister;
+
+static struct
+{
+	uint8_t  Header[VBOARD_DATAFLASH_MAX_HEADER];
+	uint8_t  HeaderLength;
+	uint8_t  BytesReceived;
+	uint16_t Page;
+	uint16_t Offset;
+} VirtualBoard_DataflashCommand;
+
+static void VirtualBoard_Dataflash_Init(void)
+{
+	const char* ImagePath = getenv("LUFA_VBOARD_DATAFLASH");
+	void*       Memory;
+
+	if (ImagePath && (*ImagePath != '\0'))
+	{
+		struct stat ImageInfo;
+		int         ImageFD = open(ImagePath, (O_RDWR | O_CREAT), 0644);
+
+		if ((ImageFD < 0) || fstat(ImageFD, &ImageInfo) ||
+		    (((size_t)ImageInfo.st_size < VBOARD_DATAFLASH_TOTAL_SIZE) && ftruncate(ImageFD, VBOARD_DATAFLASH_TOTAL_SIZE)))
+		{
+			perror(ImagePath);
+			exit(EXIT_FAILURE);
+		}
+
+		Memory = mmap(NULL, VBOARD_DATAFLASH_TOTAL_SIZE, (PROT_READ | PROT_WRITE), MAP_SHARED, ImageFD, 0);
+		close(ImageFD);
+
+		/* Newly created regions of the image are zero filled, but must read back as erased memory */
+		if ((Memory != MAP_FAILED) && ((size_t)ImageInfo.st_size < VBOARD_DATAFLASH_TOTAL_SIZE))
+		  memset((uint8_t*)Memory + ImageInfo.st_size, 0xFF, (VBOARD_DATAFLASH_TOTAL_SIZE - ImageInfo.st_size));
+	}
+	else
+	{
+		Memory = mmap(NULL, VBOARD_DATAFLASH_TOTAL_SIZE, (PROT_READ | PROT_WRITE), (MAP_PRIVATE | MAP_ANONYMOUS), -1, 0);
+
+		if (Memory != MAP_FAILED)
+		  memset(Memory, 0xFF, VBOARD_DATAFLASH_TOTAL_SIZE);
+	}
+
+	if (Memory == MAP_FAILED)
+	{
+		perror("VirtualBoard");
+		exit(EXIT_FAILURE);
+	}
+
+	for (uint8_t Chip = 0; Chip < VIRTUAL_BOARD_DATAFLASH_CHIPS; Chip++)
+	{
+		VirtualBoard_DataflashChips[Chip].Status = (DF_STATUS_READY | VBOARD_DATAFLASH_DENSITY |
+		                                            DF_STATUS_SECTORPROTECTION_ON);
+	}
+
+	VirtualBoard_DataflashMemory = Memory;
+}
+
+static uint8_t VirtualBoard_Dataflash_GetChipIndex(void)
+{
+	uint8_t Chip = 0;
+
+	while (!(VirtualBoard_DataflashSelected & (1 << Chip)))
+	  Chip++;
+
+	return Chip;
+}
+
+static uint8_t* VirtualBoard_Dataflash_GetPageByte(const uint8_t Chip,
+                                                   const uint16_t Page,
+                                                   const uint16_t Offset)
+{
+	size_t PageIndex = ((size_t)Chip * VIRTUAL_BOARD_DATAFLASH_PAGES) + (Page % VIRTUAL_BOARD_DATAFLASH_PAGES);
+
+	/* Page data is stored ahead of the spare bytes of all pages, so that the image starts with the plain page data */
+	if (Offset < VIRTUAL_BOARD_DATAFLASH_PAGE_SIZE)
+	  return &VirtualBoard_DataflashMemory[(PageIndex * VIRTUAL_BOARD_DATAFLASH_PAGE_SIZE) + Offset];
+	else
+	  return &VirtualBoard_DataflashMemory[VBOARD_DATAFLASH_DATA_SIZE + (PageIndex * VIRTUAL_BOARD_DATAFLASH_SPARE_SIZE) +
+	                                       (Offset - VIRTUAL_BOARD_DATAFLASH_PAGE_SIZE)];
+}
+
+static void VirtualBoard_Dataflash_ErasePages(const uint8_t Chip,
+                                              const uint16_t StartPage,
+                                              const uint16_t TotalPages)
+{
+	for (uint16_t Page = StartPage; Page < (StartPage + TotalPages); Page++)
+	{
+		memset(VirtualBoard_Dataflash_GetPageByte(Chip, Page, 0), 0xFF, VIRTUAL_BOARD_DATAFLASH_PAGE_SIZE);
+		memset(VirtualBoard_Dataflash_GetPageByte(Chip, Page, VIRTUAL_BOARD_DATAFLASH_PAGE_SIZE), 0xFF,
+		       VIRTUAL_BOARD_DATAFLASH_SPARE_SIZE);
+	}
+}
+
+static void VirtualBoard_Dataflash_ProgramPage(const uint8_t Chip,
+                                               const uint16_t Page,
+                                               const uint8_t* Buffer)
+{
+	/* Programming can only clear bits, as with a real flash array */
+	for (uint16_t i = 0; i < VBOARD_DATAFLASH_RAW_PAGE; i++)
+	  *VirtualBoard_Dataflash_GetPageByte(Chip, Page, i) &= Buffer[i];
+}
+
+static void VirtualBoard_Dataflash_ReadPage(const uint8_t Chip,
+                                            const uint16_t Page,
+                                            uint8_t* Buffer)
+{
+	for (uint16_t i = 0; i < VBOARD_DATAFLASH_RAW_PAGE; i++)
+	  Buffer[i] = *VirtualBoard_Dataflash_GetPageByte(Chip, Page, i);
+}
+
+static uint8_t VirtualBoard_Dataflash_GetHeaderLength(const uint8_t Opcode)
+{
+	switch (Opcode)
+	{
+		case DF_CMD_GETSTATUS:
+		case DF_CMD_POWERDOWN:
+		case DF_CMD_WAKEUP:
+		case DF_CMD_READMANUFACTURERDEVICEINFO:
+			return 1;
+		case DF_CMD_MAINMEMPAGEREAD:
+			return 8;
+		default:
+			return 4;
+	}
+}
+
+static void VirtualBoard_Dataflash_CompleteCommand(void)
+{
+	uint8_t  Chip   = VirtualBoard_Dataflash_GetChipIndex();
+	uint8_t* Header = VirtualBoard_DataflashCommand.Header;
+	uint16_t Page   = VirtualBoard_DataflashCommand.Page;
+
+	VirtualBoard_DataflashChip_t* ChipState = &VirtualBoard_DataflashChips[Chip];
+
+	if (VirtualBoard_DataflashCommand.BytesReceived < VirtualBoard_DataflashCommand.HeaderLength)
+	  return;
+
+	switch (Header[0])
+	{
+		case DF_CMD_MAINMEMTOBUFF1:
+		case DF_CMD_MAINMEMTOBUFF2:
+			VirtualBoard_Dataflash_ReadPage(Chip, Page, ChipState->Buffers[Header[0] == DF_CMD_MAINMEMTOBUFF2]);
+			break;
+		case DF_CMD_MAINMEMTOBUFF1COMP:
+		case DF_CMD_MAINMEMTOBUFF2COMP:
+		{
+			uint8_t PageContents[VBOARD_DATAFLASH_RAW_PAGE];
+
+			VirtualBoard_Dataflash_ReadPage(Chip, Page, PageContents);
+
+			if (memcmp(ChipState->Buffers[Header[0] == DF_CMD_MAINMEMTOBUFF2COMP], PageContents, sizeof(PageContents)))
+			{
+				ChipState->Status |= DF_STATUS_COMPMISMATCH;
+			}
+			else
+			{
+				ChipState->Status &= ~DF_STATUS_COMPMISMATCH;
+			}
+
+			break;
+		}
+		case DF_CMD_BUFF1TOMAINMEMWITHERASE:
+		case DF_CMD_BUFF2TOMAINMEMWITHERASE:
+		case DF_CMD_MAINMEMPAGETHROUGHBUFF1:
+		case DF_CMD_MAINMEMPAGETHROUGHBUFF2:
+			VirtualBoard_Dataflash_ErasePages(Chip, Page, 1);
+			/* Fall through */
+		case DF_CMD_BUFF1TOMAINMEM:
+		case DF_CMD_BUFF2TOMAINMEM:
+			VirtualBoard_Dataflash_ProgramPage(Chip, Page,
+			                                   ChipState->Buffers[(Header[0] == DF_CMD_BUFF2TOMAINMEMWITHERASE) ||
+			                                                      (Header[0] == DF_CMD_MAINMEMPAGETHROUGHBUFF2) ||
+			                                                      (Header[0] == DF_CMD_BUFF2TOMAINMEM)]);
+			break;
+		case DF_CMD_PAGEERASE:
+			VirtualBoard_Dataflash_ErasePages(Chip, Page, 1);
+			break;
+		case DF_CMD_BLOCKERASE:
+			VirtualBoard_Dataflash_ErasePages(Chip, (Page & ~7), 8);
+			break;
+		case DF_CMD_SECTORERASE:
+			if (Page < 8)
+			  VirtualBoard_Dataflash_ErasePages(Chip, 0, 8);
+			else if (Page < 256)
+			  VirtualBoard_Dataflash_ErasePages(Chip, 8, (256 - 8));
+			else
+			  VirtualBoard_Dataflash_ErasePages(Chip, (Page & ~255), 256);
+
+			break;
+		case DF_CMD_CHIPERASE_BYTE1:
+			if (!(memcmp(Header, DF_CMD_CHIPERASE, 4)))
+			  VirtualBoard_Dataflash_ErasePages(Chip, 0, VIRTUAL_BOARD_DATAFLASH_PAGES);
+
+			break;
+		case DF_CMD_SECTORPROTECTIONOFF_BYTE1:
+			if (!(memcmp(Header, DF_CMD_SECTORPROTECTIONOFF, 4)))
+			  ChipState->Status &= ~DF_STATUS_SECTORPROTECTION_ON;
+
+			break;
+	}
+}
+
+void VirtualBoard_Dataflash_SelectChip(const uint8_t ChipMask)
+{
+	if (!(VirtualBoard_DataflashMemory))
+	  VirtualBoard_Dataflash_Init();
+
+	if (VirtualBoard_DataflashSelected)
+	  VirtualBoard_Dataflash_CompleteCommand();
+
+	VirtualBoard_DataflashSelected = (ChipMask & ((1 << VIRTUAL_BOARD_DATAFLASH_CHIPS) - 1));
+	memset(&VirtualBoard_DataflashCommand, 0x00, sizeof(VirtualBoard_DataflashCommand));
+}
+
+uint8_t VirtualBoard_Dataflash_GetSelectedChip(void)
+{
+	return VirtualBoard_DataflashSelected;
+}
+
+uint8_t VirtualBoard_Dataflash_TransferByte(const uint8_t Byte)
+{
+	if (!(VirtualBoard_DataflashSelected))
+	  return 0xFF;
+
+	VirtualBoard_DataflashChip_t* ChipState = &VirtualBoard_DataflashChips[VirtualBoard_Dataflash_GetChipIndex()];
+	uint8_t* Header = VirtualBoard_DataflashCommand.Header;
+
+	if (!(VirtualBoard_DataflashCommand.HeaderLength) ||
+	    (VirtualBoard_DataflashCommand.BytesReceived < VirtualBoard_DataflashCommand.HeaderLength))
+	{
+		if (!(VirtualBoard_DataflashCommand.HeaderLength))
+		  VirtualBoard_DataflashCommand.HeaderLength = VirtualBoard_Dataflash_GetHeaderLength(Byte);
+
+		Header[VirtualBoard_DataflashCommand.BytesReceived++] = Byte;
+
+		/* Commands are addressed as by the LUFA board drivers, with the page number above an 11-bit byte offset */
+		if (VirtualBoard_DataflashCommand.BytesReceived == 4)
+		{
+			uint32_t Address = (((uint32_t)Header[1] << 16) | ((uint16_t)Header[2] << 8) | Header[3]);
+
+			VirtualBoard_DataflashCommand.Page   = ((Address >> 11) % VIRTUAL_BOARD_DATAFLASH_PAGES);
+			VirtualBoard_DataflashCommand.Offset = ((Address & 0x7FF) % VBOARD_DATAFLASH_RAW_PAGE);
+		}
+
+		if (Header[0] == DF_CMD_GETSTATUS)
+		  return ChipState->Status;
+
+		return 0xFF;
+	}
+
+	uint16_t Offset     = VirtualBoard_DataflashCommand.Offset;
+	uint16_t Page       = VirtualBoard_DataflashCommand.Page;
+	uint8_t  ReturnByte = 0xFF;
+
+	VirtualBoard_DataflashCommand.Offset = ((Offset + 1) % VBOARD_DATAFLASH_RAW_PAGE);
+
+	switch (Header[0])
+	{
+		case DF_CMD_GETSTATUS:
+			return ChipState->Status;
+		case DF_CMD_READMANUFACTURERDEVICEINFO:
+		{
+			static const uint8_t DeviceInfo[] = {DF_MANUFACTURER_ATMEL, 0x28, 0x00, 0x01, 0x00};
+
+			return (Offset < sizeof(DeviceInfo)) ? DeviceInfo[Offset] : 0x00;
+		}
+		case DF_CMD_MAINMEMPAGEREAD:
+			return *VirtualBoard_Dataflash_GetPageByte(VirtualBoard_Dataflash_GetChipIndex(), Page, Offset);
+		case DF_CMD_CONTARRAYREAD_LF:
+			ReturnByte = *VirtualBoard_Dataflash_GetPageByte(VirtualBoard_Dataflash_GetChipIndex(), Page, Offset);
+
+			if (!(VirtualBoard_DataflashCommand.Offset))
+			  VirtualBoard_DataflashCommand.Page = ((Page + 1) % VIRTUAL_BOARD_DATAFLASH_PAGES);
+
+			return ReturnByte;
+		case DF_CMD_BUFF1READ_LF:
+		case DF_CMD_BUFF2READ_LF:
+			return ChipState->Buffers[Header[0] == DF_CMD_BUFF2READ_LF][Offset];
+		case DF_CMD_BUFF1WRITE:
+		case DF_CMD_BUFF2WRITE:
+		case DF_CMD_MAINMEMPAGETHROUGHBUFF1:
+		case DF_CMD_MAINMEMPAGETHROUGHBUFF2:
+			ChipState->Buffers[(Header[0] == DF_CMD_BUFF2WRITE) || (Header[0] == DF_CMD_MAINMEMPAGETHROUGHBUFF2)][Offset] = Byte;
+			break;
+	}
+
+	return ReturnByte;
+}
+
+void VirtualBoard_Dataflash_BeginTransferByte(const uint8_t Byte)
+{
+	VirtualBoard_DataflashShiftRegister = VirtualBoard_Dataflash_TransferByte(Byte);
+}
+
+uint8_t VirtualBoard_Dataflash_EndTransferByte(void)
+{
+	return VirtualBoard_DataflashShiftRegister;
+}
+
+#endif
+
@@ -0,0 +1,186 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2018.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2018  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *  \brief Simulated board hardware for the host-native POSIX architecture.
+ *
+ *  Simulated board hardware for the host-native POSIX architecture, backing the \c BOARD_VIRTUAL board drivers.
+ */
+
+/** \ingroup Group_PlatformDrivers_POSIX
+ *  \defgroup Group_PlatformDrivers_POSIXVirtualBoard Virtual Board - LUFA/Platform/POSIX/VirtualBoard.h
+ *  \brief Simulated board hardware for the host-native POSIX architecture.
+ *
+ *  \section Sec_PlatformDrivers_POSIXVirtualBoard_Dependencies Module Source Dependencies
+ *  The following files must be built with any user project that uses this module:
+ *    - LUFA/Platform/POSIX/VirtualBoard.c <i>(Makefile source module name: LUFA_SRC_PLATFORM)</i>
+ *    - LUFA/Platform/POSIX/VirtualSDCard.c <i>(Makefile source module name: LUFA_SRC_PLATFORM)</i>
+ *
+ *  \section Sec_PlatformDrivers_POSIXVirtualBoard_ModDescription Module Description
+ *  Simulated board hardware for the host-native POSIX architecture, which backs the board drivers selected by
+ *  \c BOARD_VIRTUAL. The virtual board carries four LEDs, a single button, a five-way joystick, two serial
+ *  Dataflash ICs and a SPI mode SD card, which together allow the unmodified demo applications to be run and profiled
+ *  on the build machine.
+ *
+ *  The simulated Dataflash ICs implement the AT45DB642D command set (see \ref Group_AT45DB642D) in the standard page
+ *  size mode, with all commands completing instantly. Each page holds \ref VIRTUAL_BOARD_DATAFLASH_PAGE_SIZE bytes of
+ *  data followed by \ref VIRTUAL_BOARD_DATAFLASH_SPARE_SIZE spare bytes, which are addressed as the bytes following the
+ *  page data. The memory contents are held in an erased anonymous memory map by default; if the
+ *  \c LUFA_VBOARD_DATAFLASH environment variable names a file, that file is mapped instead (and created or extended as
+ *  required) so that the Dataflash contents persist between runs. The file holds the page data of each IC in turn,
+ *  followed by the spare bytes of all pages, so that its start remains a plain image of the Dataflash page data.
+ *
+ *  A simulated SDHC memory card is attached to the virtual board's SPI bus (see \ref Group_SPI_POSIX), selected via
+ *  \ref VirtualBoard_SDCard_SelectCard(). The card implements the SPI mode initialization, register read, single and
+ *  multiple block read and write commands of the SD Physical Layer specification, with block addressing as for cards
+ *  over 2GB. Its contents are held in a zero filled anonymous memory map of \ref VIRTUAL_BOARD_SDCARD_BLOCKS blocks by
+ *  default; if the \c LUFA_VBOARD_SDCARD environment variable names a file, that file is mapped instead. Files are
+ *  extended to at least the default size, while the capacity of larger (possibly sparse) files is rounded down to a
+ *  whole number of 512KB units, so that large cards may be simulated.
+ *
+ *  The button and joystick state variables may be freely altered by the application or a test harness to simulate
+ *  user input.
+ *
+ *  @{
+ */
+
+#ifndef __POSIX_VIRTUAL_BOARD_H__
+#define __POSIX_VIRTUAL_BOARD_H__
+
+	/* Includes: */
+		#include "../../Common/Common.h"
+
+	/* Enable C linkage for C++ Compilers: */
+		#if defined(__cplusplus)
+			extern "C" {
+		#endif
+
+	/* Public Interface - May be used in end-application: */
+		/* Macros: */
+			/** Total number of simulated Dataflash ICs mounted on the virtual board. */
+			#define VIRTUAL_BOARD_DATAFLASH_CHIPS        2
+
+			/** Page size of each simulated Dataflash IC, in bytes. */
+			#define VIRTUAL_BOARD_DATAFLASH_PAGE_SIZE    1024
+
+			/** Number of spare bytes following the data of each page of the simulated Dataflash ICs. */
+			#define VIRTUAL_BOARD_DATAFLASH_SPARE_SIZE   32
+
+			/** Total number of pages inside each simulated Dataflash IC. */
+			#define VIRTUAL_BOARD_DATAFLASH_PAGES        8192
+
+			/** Block size of the simulated SD card, in bytes. */
+			#define VIRTUAL_BOARD_SDCARD_BLOCK_SIZE      512
+
+			/** Default total number of blocks of the simulated SD card, when no backing file is given or the file is smaller. */
+			#define VIRTUAL_BOARD_SDCARD_BLOCKS          131072UL
+
+		/* Global Variables: */
+			/** Current state of the virtual board's LEDs, as a mask of \c LEDS_LED* values. */
+			extern volatile uint8_t VirtualBoard_LEDs;
+
+			/** Current state of the virtual board's buttons, as a mask of pressed \c BUTTONS_BUTTON* values. */
+			extern volatile uint8_t VirtualBoard_Buttons;
+
+			/** Current state of the virtual board's joystick, as a mask of active \c JOY_* values. */
+			extern volatile uint8_t VirtualBoard_Joystick;
+
+		/* Function Prototypes: */
+			/** Selects the given simulated Dataflash IC, or deselects all ICs. Deselecting an IC completes any
+			 *  pending command sent to it, such as a buffer to main memory page program.
+			 *
+			 *  \param[in] ChipMask  Mask of the Dataflash IC to select, where bit n selects IC n, or zero for none.
+			 */
+			void VirtualBoard_Dataflash_SelectChip(const uint8_t ChipMask);
+
+			/** Retrieves the currently selected simulated Dataflash IC.
+			 *
+			 *  \return Mask of the currently selected Dataflash IC, or zero if no IC is selected.
+			 */
+			uint8_t VirtualBoard_Dataflash_GetSelectedChip(void) ATTR_WARN_UNUSED_RESULT;
+
+			/** Exchanges a byte with the currently selected simulated Dataflash IC over the virtual SPI bus.
+			 *
+			 *  \param[in] Byte  Byte to send to the Dataflash IC.
+			 *
+			 *  \return Byte received from the Dataflash IC, or 0xFF if no IC is selected.
+			 */
+			uint8_t VirtualBoard_Dataflash_TransferByte(const uint8_t Byte);
+
+			/** Starts exchanging a byte with the currently selected simulated Dataflash IC, modelling a SPI transfer which
+			 *  completes in the background. The received byte is retrieved via \ref VirtualBoard_Dataflash_EndTransferByte().
+			 *
+			 *  \param[in] Byte  Byte to send to the Dataflash IC.
+			 */
+			void VirtualBoard_Dataflash_BeginTransferByte(const uint8_t Byte);
+
+			/** Completes a byte exchange started by \ref VirtualBoard_Dataflash_BeginTransferByte().
+			 *
+			 *  \return Byte received from the Dataflash IC, or 0xFF if no IC was selected.
+			 */
+			uint8_t VirtualBoard_Dataflash_EndTransferByte(void) ATTR_WARN_UNUSED_RESULT;
+
+			/** Asserts or releases the chip select line of the simulated SD card. Releasing the card abandons any partially
+			 *  received command, and any data transfer which is still in progress.
+			 *
+			 *  \param[in] Selected  Boolean \c true to select the SD card, \c false to deselect it.
+			 */
+			void VirtualBoard_SDCard_SelectCard(const bool Selected);
+
+			/** Exchanges a byte with the device currently selected on the virtual board's SPI bus.
+			 *
+			 *  \param[in] Byte  Byte to send over the SPI bus.
+			 *
+			 *  \return Byte received from the selected SPI device, or 0xFF if no device is selected.
+			 */
+			uint8_t VirtualBoard_SPI_TransferByte(const uint8_t Byte);
+
+			/** Starts exchanging a byte over the virtual board's SPI bus, modelling a transfer which completes in the
+			 *  background. The received byte is retrieved via \ref VirtualBoard_SPI_EndTransferByte().
+			 *
+			 *  \param[in] Byte  Byte to send over the SPI bus.
+			 */
+			void VirtualBoard_SPI_BeginTransferByte(const uint8_t Byte);
+
+			/** Completes a byte exchange started by \ref VirtualBoard_SPI_BeginTransferByte().
+			 *
+			 *  \return Byte received from the selected SPI device, or 0xFF if no device was selected.
+			 */
+			uint8_t VirtualBoard_SPI_EndTransferByte(void) ATTR_WARN_UNUSED_RESULT;
+
+	/* Disable C linkage for C++ Compilers: */
+		#if defined(__cplusplus)
+			}
+		#endif
+
+#endif
+
+/** @} */
+
@@ -0,0 +1,446 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2018.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2018  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaims all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+#include "../../Common/Common.h"
+#if (ARCH == ARCH_POSIX)
+
+#define  __INCLUDE_FROM_VIRTUALBOARD_C
+#include "VirtualBoard.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define VSDCARD_UNIT_BLOCKS          (((uint32_t)512 * 1024) / VIRTUAL_BOARD_SDCARD_BLOCK_SIZE)
+#define VSDCARD_MAX_UNITS            ((uint32_t)0x3FFFFF + 1)
+#define VSDCARD_INIT_POLLS           2
+#define VSDCARD_BUSY_BYTES           2
+#define VSDCARD_MAX_RESPONSE         (VIRTUAL_BOARD_SDCARD_BLOCK_SIZE + 8)
+
+#define VSDCARD_R1_IDLE              (1 << 0)
+#define VSDCARD_R1_ILLEGAL_COMMAND   (1 << 2)
+#define VSDCARD_R1_ADDRESS_ERROR     (1 << 5)
+#define VSDCARD_R1_PARAMETER_ERROR   (1 << 6)
+
+#define VSDCARD_OCR_POWER_UP         (1UL << 31)
+#define VSDCARD_OCR_CCS              (1UL << 30)
+#define VSDCARD_OCR_VOLTAGE_WINDOW   0x00FF8000UL
+
+#define VSDCARD_ACMD41_HCS           (1UL << 30)
+
+#define VSDCARD_TOKEN_START_BLOCK    0xFE
+#define VSDCARD_TOKEN_START_MULTI    0xFC
+#define VSDCARD_TOKEN_STOP_TRAN      0xFD
+
+#define VSDCARD_DATA_ACCEPTED        0x05
+#define VSDCARD_DATA_WRITE_ERROR     0x0D
+
+enum VirtualBoard_SDCard_States_t
+{
+	VSDCARD_STATE_COMMAND,
+	VSDCARD_STATE_READ,
+	VSDCARD_STATE_WRITE_TOKEN,
+	VSDCARD_STATE_WRITE_DATA,
+};
+
+static uint8_t* VirtualBoard_SDCardMemory;
+static uint32_t VirtualBoard_SDCardUnits;
+static uint32_t VirtualBoard_SDCardBlocks;
+static bool     VirtualBoard_SDCardSelected;
+static uint8_t  VirtualBoard_SPIShiftRegister;
+
+uint8_t SPI_POSIX_Options;
+
+static struct
+{
+	uint8_t  State;
+	bool     Idle;
+	bool     AppCommand;
+	uint8_t  InitPolls;
+	bool     MultiBlock;
+	uint32_t Block;
+	uint8_t  Command[6];
+	uint8_t  CommandBytes;
+	uint8_t  Response[VSDCARD_MAX_RESPONSE];
+	uint16_t ResponseLength;
+	uint16_t ResponsePos;
+	uint8_t  BusyBytes;
+	uint8_t  WriteData[VIRTUAL_BOARD_SDCARD_BLOCK_SIZE + 2];
+	uint16_t WriteBytes;
+} VirtualBoard_SDCard = {.Idle = true};
+
+static void VirtualBoard_SDCard_Init(void)
+{
+	const char* ImagePath = getenv("LUFA_VBOARD_SDCARD");
+	uint64_t    ImageUnits = (VIRTUAL_BOARD_SDCARD_BLOCKS / VSDCARD_UNIT_BLOCKS);
+	void*       Memory;
+
+	if (ImagePath && (*ImagePath != '\0'))
+	{
+		struct stat ImageInfo;
+		int         ImageFD = open(ImagePath, (O_RDWR | O_CREAT), 0644);
+		uint64_t    MinimumSize = ((uint64_t)VIRTUAL_BOARD_SDCARD_BLOCKS * VIRTUAL_BOARD_SDCARD_BLOCK_SIZE);
+
+		if ((ImageFD < 0) || fstat(ImageFD, &ImageInfo) ||
+		    (((uint64_t)ImageInfo.st_size < MinimumSize) && ftruncate(ImageFD, MinimumSize)))
+		{
+			perror(ImagePath);
+			exit(EXIT_FAILURE);
+		}
+
+		/* Larger images set the card capacity, in the 512KB units of the version 2.0 CSD register */
+		if ((uint64_t)ImageInfo.st_size > MinimumSize)
+		  ImageUnits = MIN(((uint64_t)ImageInfo.st_size / (VSDCARD_UNIT_BLOCKS * VIRTUAL_BOARD_SDCARD_BLOCK_SIZE)), VSDCARD_MAX_UNITS);
+
+		Memory = mmap(NULL, (ImageUnits * VSDCARD_UNIT_BLOCKS * VIRTUAL_BOARD_SDCARD_BLOCK_SIZE), (PROT_READ | PROT_WRITE),
+		              MAP_SHARED, ImageFD, 0);
+		close(ImageFD);
+	}
+	else
+	{
+		Memory = mmap(NULL, (ImageUnits * VSDCARD_UNIT_BLOCKS * VIRTUAL_BOARD_SDCARD_BLOCK_SIZE), (PROT_READ | PROT_WRITE),
+		              (MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE), -1, 0);
+	}
+
+	if (Memory == MAP_FAILED)
+	{
+		perror("VirtualBoard");
+		exit(EXIT_FAILURE);
+	}
+
+	VirtualBoard_SDCardMemory = Memory;
+	VirtualBoard_SDCardUnits  = ImageUnits;
+
+	/* Block addresses are 32 bits wide, so the last block of a full 2TB card cannot be addressed */
+	VirtualBoard_SDCardBlocks = (uint32_t)MIN((ImageUnits * VSDCARD_UNIT_BLOCKS), UINT32_MAX);
+}
+
+static void VirtualBoard_SDCard_QueueByte(const uint8_t Byte)
+{
+	VirtualBoard_SDCard.Response[VirtualBoard_SDCard.ResponseLength++] = Byte;
+}
+
+static void VirtualBoard_SDCard_QueueDataBlock(const uint8_t* const Data,
+                                               const uint16_t Length)
+{
+	/* Data blocks follow a single byte access time gap and start token, and end with an (unchecked) CRC16 */
+	VirtualBoard_SDCard_QueueByte(0xFF);
+	VirtualBoard_SDCard_QueueByte(VSDCARD_TOKEN_START_BLOCK);
+
+	memcpy(&VirtualBoard_SDCard.Response[VirtualBoard_SDCard.ResponseLength], Data, Length);
+	VirtualBoard_SDCard.ResponseLength += Length;
+
+	VirtualBoard_SDCard_QueueByte(0x00);
+	VirtualBoard_SDCard_QueueByte(0x00);
+}
+
+static void VirtualBoard_SDCard_QueueReadBlock(void)
+{
+	VirtualBoard_SDCard.ResponseLength = 0;
+	VirtualBoard_SDCard.ResponsePos    = 0;
+
+	VirtualBoard_SDCard_QueueDataBlock(&VirtualBoard_SDCardMemory[(size_t)VirtualBoard_SDCard.Block++ *
+	                                                              VIRTUAL_BOARD_SDCARD_BLOCK_SIZE],
+	                                   VIRTUAL_BOARD_SDCARD_BLOCK_SIZE);
+}
+
+static void VirtualBoard_SDCard_QueueCSD(void)
+{
+	uint32_t CSize = (VirtualBoard_SDCardUnits - 1);
+	uint8_t  CSD[16] =
+		{
+			0x40, 0x0E, 0x00, 0x32, 0x5B, 0x59, 0x00,
+			((CSize >> 16) & 0x3F), (CSize >> 8), CSize,
+			0x7F, 0x80, 0x0A, 0x40, 0x00, 0x01,
+		};
+
+	VirtualBoard_SDCard_QueueDataBlock(CSD, sizeof(CSD));
+}
+
+static void VirtualBoard_SDCard_QueueCID(void)
+{
+	static const uint8_t CID[16] =
+		{
+			0x00, 'L', 'U', 'V', 'S', 'D', 'H', 'C', 0x10, 0x00, 0x00, 0x00, 0x01, 0x01, 0x2A, 0x01,
+		};
+
+	VirtualBoard_SDCard_QueueDataBlock(CID, sizeof(CID));
+}
+
+static void VirtualBoard_SDCard_ExecuteCommand(void)
+{
+	uint8_t  Command    = (VirtualBoard_SDCard.Command[0] & 0x3F);
+	uint32_t Argument   = (((uint32_t)VirtualBoard_SDCard.Command[1] << 24) | ((uint32_t)VirtualBoard_SDCard.Command[2] << 16) |
+	                       ((uint32_t)VirtualBoard_SDCard.Command[3] << 8)  | VirtualBoard_SDCard.Command[4]);
+	bool     AppCommand = VirtualBoard_SDCard.AppCommand;
+	uint8_t  R1         = (VirtualBoard_SDCard.Idle ? VSDCARD_R1_IDLE : 0);
+
+	VirtualBoard_SDCard.AppCommand     = false;
+	VirtualBoard_SDCard.CommandBytes   = 0;
+	VirtualBoard_SDCard.ResponseLength = 0;
+	VirtualBoard_SDCard.ResponsePos    = 0;
+
+	/* Responses follow the command after a single byte gap */
+	VirtualBoard_SDCard_QueueByte(0xFF);
+
+	/* Only the initialization commands are accepted until the card has left the idle state */
+	if (VirtualBoard_SDCard.Idle && (Command != 0) && (Command != 8) && (Command != 55) && (Command != 58) &&
+	    (Command != 59) && !(AppCommand && (Command == 41)))
+	{
+		VirtualBoard_SDCard_QueueByte(R1 | VSDCARD_R1_ILLEGAL_COMMAND);
+		return;
+	}
+
+	switch (Command)
+	{
+		case 0:
+			VirtualBoard_SDCard.Idle      = true;
+			VirtualBoard_SDCard.InitPolls = 0;
+			VirtualBoard_SDCard.State     = VSDCARD_STATE_COMMAND;
+
+			VirtualBoard_SDCard_QueueByte(VSDCARD_R1_IDLE);
+			break;
+		case 8:
+			VirtualBoard_SDCard_QueueByte(R1);
+			VirtualBoard_SDCard_QueueByte(0x00);
+			VirtualBoard_SDCard_QueueByte(0x00);
+			VirtualBoard_SDCard_QueueByte(VirtualBoard_SDCard.Command[3] & 0x0F);
+			VirtualBoard_SDCard_QueueByte(VirtualBoard_SDCard.Command[4]);
+			break;
+		case 9:
+			VirtualBoard_SDCard_QueueByte(R1);
+			VirtualBoard_SDCard_QueueCSD();
+			break;
+		case 10:
+			VirtualBoard_SDCard_QueueByte(R1);
+			VirtualBoard_SDCard_QueueCID();
+			break;
+		case 12:
+			VirtualBoard_SDCard.State     = VSDCARD_STATE_COMMAND;
+			VirtualBoard_SDCard.BusyBytes = VSDCARD_BUSY_BYTES;
+
+			/* The byte following a stop command is undefined, as the card may still be sending data */
+			VirtualBoard_SDCard_QueueByte(0xFF);
+			VirtualBoard_SDCard_QueueByte(R1);
+			break;
+		case 13:
+			VirtualBoard_SDCard_QueueByte(R1);
+			VirtualBoard_SDCard_QueueByte(0x00);
+			break;
+		case 16:
+			VirtualBoard_SDCard_QueueByte(R1 | ((Argument != VIRTUAL_BOARD_SDCARD_BLOCK_SIZE) ? VSDCARD_R1_PARAMETER_ERROR : 0));
+			break;
+		case 17:
+		case 18:
+		case 24:
+		case 25:
+			if (Argument >= VirtualBoard_SDCardBlocks)
+			{
+				VirtualBoard_SDCard_QueueByte(R1 | VSDCARD_R1_ADDRESS_ERROR);
+				break;
+			}
+
+			VirtualBoard_SDCard_QueueByte(R1);
+
+			VirtualBoard_SDCard.Block      = Argument;
+			VirtualBoard_SDCard.MultiBlock = ((Command == 18) || (Command == 25));
+
+			if ((Command == 17) || (Command == 18))
+			{
+				VirtualBoard_SDCard.State = VSDCARD_STATE_READ;
+
+				if (Command == 17)
+				{
+					VirtualBoard_SDCard_QueueDataBlock(&VirtualBoard_SDCardMemory[(size_t)Argument * VIRTUAL_BOARD_SDCARD_BLOCK_SIZE],
+					                                   VIRTUAL_BOARD_SDCARD_BLOCK_SIZE);
+				}
+			}
+			else
+			{
+				VirtualBoard_SDCard.State = VSDCARD_STATE_WRITE_TOKEN;
+			}
+
+			break;
+		case 23:
+			VirtualBoard_SDCard_QueueByte(R1 | (AppCommand ? 0 : VSDCARD_R1_ILLEGAL_COMMAND));
+			break;
+		case 41:
+			/* High capacity cards remain busy initializing if the host does not indicate support for them */
+			if ((Argument & VSDCARD_ACMD41_HCS) && (++VirtualBoard_SDCard.InitPolls > VSDCARD_INIT_POLLS))
+			  VirtualBoard_SDCard.Idle = false;
+
+			VirtualBoard_SDCard_QueueByte(VirtualBoard_SDCard.Idle ? VSDCARD_R1_IDLE : 0);
+			break;
+		case 55:
+			VirtualBoard_SDCard.AppCommand = true;
+			VirtualBoard_SDCard_QueueByte(R1);
+			break;
+		case 58:
+		{
+			uint32_t OCR = (VirtualBoard_SDCard.Idle ? VSDCARD_OCR_VOLTAGE_WINDOW :
+			                (VSDCARD_OCR_POWER_UP | VSDCARD_OCR_CCS | VSDCARD_OCR_VOLTAGE_WINDOW));
+
+			VirtualBoard_SDCard_QueueByte(R1);
+			VirtualBoard_SDCard_QueueByte(OCR >> 24);
+			VirtualBoard_SDCard_QueueByte(OCR >> 16);
+			VirtualBoard_SDCard_QueueByte(OCR >> 8);
+			VirtualBoard_SDCard_QueueByte(OCR);
+			break;
+		}
+		case 59:
+			VirtualBoard_SDCard_QueueByte(R1);
+			break;
+		default:
+			VirtualBoard_SDCard_QueueByte(R1 | VSDCARD_R1_ILLEGAL_COMMAND);
+			break;
+	}
+}
+
+static uint8_t VirtualBoard_SDCard_TransferByte(const uint8_t Byte)
+{
+	uint8_t ReturnByte = 0xFF;
+
+	/* Multiple block reads continue with the next block once the previous one has been clocked out */
+	if ((VirtualBoard_SDCard.State == VSDCARD_STATE_READ) &&
+	    (VirtualBoard_SDCard.ResponsePos == VirtualBoard_SDCard.ResponseLength))
+	{
+		if (VirtualBoard_SDCard.MultiBlock && (VirtualBoard_SDCard.Block < VirtualBoard_SDCardBlocks))
+		  VirtualBoard_SDCard_QueueReadBlock();
+		else if (!(VirtualBoard_SDCard.MultiBlock))
+		  VirtualBoard_SDCard.State = VSDCARD_STATE_COMMAND;
+	}
+
+	if (VirtualBoard_SDCard.ResponsePos < VirtualBoard_SDCard.ResponseLength)
+	{
+		ReturnByte = VirtualBoard_SDCard.Response[VirtualBoard_SDCard.ResponsePos++];
+	}
+	else if (VirtualBoard_SDCard.BusyBytes)
+	{
+		VirtualBoard_SDCard.BusyBytes--;
+		ReturnByte = 0x00;
+	}
+
+	switch (VirtualBoard_SDCard.State)
+	{
+		case VSDCARD_STATE_COMMAND:
+		case VSDCARD_STATE_READ:
+			/* Commands start with a zero start bit followed by a one transmission bit */
+			if (!(VirtualBoard_SDCard.CommandBytes) && ((Byte & 0xC0) != 0x40))
+			  break;
+
+			VirtualBoard_SDCard.Command[VirtualBoard_SDCard.CommandBytes++] = Byte;
+
+			if (VirtualBoard_SDCard.CommandBytes == sizeof(VirtualBoard_SDCard.Command))
+			  VirtualBoard_SDCard_ExecuteCommand();
+
+			break;
+		case VSDCARD_STATE_WRITE_TOKEN:
+			if ((Byte == VSDCARD_TOKEN_STOP_TRAN) && VirtualBoard_SDCard.MultiBlock)
+			{
+				VirtualBoard_SDCard.State     = VSDCARD_STATE_COMMAND;
+				VirtualBoard_SDCard.BusyBytes = VSDCARD_BUSY_BYTES;
+			}
+			else if (Byte == (VirtualBoard_SDCard.MultiBlock ? VSDCARD_TOKEN_START_MULTI : VSDCARD_TOKEN_START_BLOCK))
+			{
+				VirtualBoard_SDCard.State      = VSDCARD_STATE_WRITE_DATA;
+				VirtualBoard_SDCard.WriteBytes = 0;
+			}
+
+			break;
+		case VSDCARD_STATE_WRITE_DATA:
+			VirtualBoard_SDCard.WriteData[VirtualBoard_SDCard.WriteBytes++] = Byte;
+
+			if (VirtualBoard_SDCard.WriteBytes < sizeof(VirtualBoard_SDCard.WriteData))
+			  break;
+
+			VirtualBoard_SDCard.ResponseLength = 0;
+			VirtualBoard_SDCard.ResponsePos    = 0;
+			VirtualBoard_SDCard.BusyBytes      = VSDCARD_BUSY_BYTES;
+
+			if (VirtualBoard_SDCard.Block < VirtualBoard_SDCardBlocks)
+			{
+				memcpy(&VirtualBoard_SDCardMemory[(size_t)VirtualBoard_SDCard.Block++ * VIRTUAL_BOARD_SDCARD_BLOCK_SIZE],
+				       VirtualBoard_SDCard.WriteData, VIRTUAL_BOARD_SDCARD_BLOCK_SIZE);
+
+				VirtualBoard_SDCard_QueueByte(VSDCARD_DATA_ACCEPTED);
+			}
+			else
+			{
+				VirtualBoard_SDCard_QueueByte(VSDCARD_DATA_WRITE_ERROR);
+			}
+
+			VirtualBoard_SDCard.State = (VirtualBoard_SDCard.MultiBlock ? VSDCARD_STATE_WRITE_TOKEN : VSDCARD_STATE_COMMAND);
+			break;
+	}
+
+	return ReturnByte;
+}
+
+void VirtualBoard_SDCard_SelectCard(const bool Selected)
+{
+	if (!(VirtualBoard_SDCardMemory))
+	  VirtualBoard_SDCard_Init();
+
+	/* Releasing the card abandons any incomplete command or transfer */
+	if (!(Selected))
+	{
+		VirtualBoard_SDCard.State          = VSDCARD_STATE_COMMAND;
+		VirtualBoard_SDCard.CommandBytes   = 0;
+		VirtualBoard_SDCard.ResponseLength = 0;
+		VirtualBoard_SDCard.ResponsePos    = 0;
+		VirtualBoard_SDCard.BusyBytes      = 0;
+	}
+
+	VirtualBoard_SDCardSelected = Selected;
+}
+
+uint8_t VirtualBoard_SPI_TransferByte(const uint8_t Byte)
+{
+	if (!(VirtualBoard_SDCardSelected))
+	  return 0xFF;
+
+	return VirtualBoard_SDCard_TransferByte(Byte);
+}
+
+void VirtualBoard_SPI_BeginTransferByte(const uint8_t Byte)
+{
+	VirtualBoard_SPIShiftRegister = VirtualBoard_SPI_TransferByte(Byte);
+}
+
+uint8_t VirtualBoard_SPI_EndTransferByte(void)
+{
+	return VirtualBoard_SPIShiftRegister;
+}
+
+#endif
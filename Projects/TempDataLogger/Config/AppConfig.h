@@ -45,4 +45,6 @@
 
 	#define DUMMY_RTC
 
+	#define DATAFLASH_FTL              false
+
 #endif
@@ -0,0 +1,74 @@
+"""
+             LUFA Library
+     Copyright (C) Dean Camera, 2018.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+"""
+
+"""
+    LUFA Temperature Data Logger project sequential read throughput test
+    script. Reads the raw block device of an attached Temperature Data Logger
+    from start to end a number of times, dropping the OS page cache before
+    each pass, and reports the achieved read throughput. The device is only
+    ever read, never written.
+
+    Usage: test_mass_storage_read_speed.py <block device> [passes] [chunk size]
+
+    Example: test_mass_storage_read_speed.py /dev/sdb 3 65536
+
+    Reading the raw block device normally requires root privileges.
+"""
+
+import os
+import sys
+from time import time
+
+
+def read_pass(device_name, chunk_size):
+    fd = os.open(device_name, os.O_RDONLY)
+
+    # Drop any cached blocks so that the data is read from the device itself
+    if hasattr(os, "posix_fadvise"):
+        os.posix_fadvise(fd, 0, 0, os.POSIX_FADV_DONTNEED)
+
+    total_read = 0
+    start_time = time()
+
+    try:
+        while True:
+            data = os.read(fd, chunk_size)
+            if not data:
+                break
+
+            total_read += len(data)
+    finally:
+        os.close(fd)
+
+    return total_read, time() - start_time
+
+
+def main():
+    if len(sys.argv) < 2:
+        print("Usage: {0} <block device> [passes] [chunk size]".format(sys.argv[0]))
+        sys.exit(1)
+
+    device_name = sys.argv[1]
+    passes      = int(sys.argv[2]) if len(sys.argv) > 2 else 3
+    chunk_size  = int(sys.argv[3]) if len(sys.argv) > 3 else 65536
+
+    best_rate = 0
+
+    for current_pass in range(passes):
+        total_read, elapsed = read_pass(device_name, chunk_size)
+        rate = total_read / elapsed / 1024
+
+        print("Pass {0}: read {1} bytes in {2:.2f}s - {3:.1f} KB/s".format(
+              current_pass + 1, total_read, elapsed, rate))
+
+        best_rate = max(best_rate, rate)
+
+    print("Best sequential read throughput: {0:.1f} KB/s".format(best_rate))
+
+if __name__ == '__main__':
+    main()
@@ -47,14 +47,23 @@
 		#include <LUFA/Drivers/USB/USB.h>
 		#include <LUFA/Drivers/Board/Dataflash.h>
 
+		#if DATAFLASH_FTL
+			#include <LUFA/Drivers/Misc/DataflashFTL.h>
+		#endif
+
 	/* Preprocessor Checks: */
 		#if (DATAFLASH_PAGE_SIZE % 16)
 			#error Dataflash page size must be a multiple of 16 bytes.
 		#endif
 
 	/* Defines: */
-		/** Total number of bytes of the storage medium, comprised of one or more Dataflash ICs. */
-		#define VIRTUAL_MEMORY_BYTES                ((uint32_t)DATAFLASH_PAGES * DATAFLASH_PAGE_SIZE * DATAFLASH_TOTALCHIPS)
+		#if DATAFLASH_FTL
+			/** Total number of bytes of the storage medium, comprised of the logical pages of the Dataflash translation layer. */
+			#define VIRTUAL_MEMORY_BYTES            ((uint32_t)DATAFLASH_FTL_LOGICAL_PAGES * DATAFLASH_PAGE_SIZE)
+		#else
+			/** Total number of bytes of the storage medium, comprised of one or more Dataflash ICs. */
+			#define VIRTUAL_MEMORY_BYTES            ((uint32_t)DATAFLASH_PAGES * DATAFLASH_PAGE_SIZE * DATAFLASH_TOTALCHIPS)
+		#endif
 
 		/** Block size of the device. This is kept at 512 to remain compatible with the OS despite the underlying
 		 *  storage media (Dataflash) using a different native block size. Do not change this value.
@@ -82,5 +91,15 @@
 		void DataflashManager_ResetDataflashProtections(void);
 		bool DataflashManager_CheckDataflashOperation(void);
 
+		#if defined(INCLUDE_FROM_DATAFLASHMANAGER_C)
+			static inline uint16_t DataflashManager_GetPhysicalPage(const uint16_t PageAddress) ATTR_ALWAYS_INLINE;
+			static void DataflashManager_LoadPageIntoBuffer(const uint16_t PageAddress,
+			                                                const bool UseSecondBuffer);
+			static void DataflashManager_ProgramBuffer(const uint16_t PageAddress,
+			                                           const bool UseSecondBuffer);
+			static void DataflashManager_SendPageReadCommand(const uint16_t PageAddress,
+			                                                 const uint16_t PageByte);
+		#endif
+
 #endif
 
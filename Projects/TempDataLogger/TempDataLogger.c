@@ -162,6 +162,16 @@ int main(void)
 		MS_Device_USBTask(&Disk_MS_Interface);
 		HID_Device_USBTask(&Generic_HID_Interface);
 		USB_USBTask();
+
+		#if DATAFLASH_FTL
+		/* Erase unused Dataflash pages ahead of time, with the logging interrupt that also writes to the Dataflash blocked */
+		uint_reg_t CurrentGlobalInt = GetGlobalInterruptMask();
+		GlobalInterruptDisable();
+
+		DataflashFTL_Task();
+
+		SetGlobalInterruptMask(CurrentGlobalInt);
+		#endif
 	}
 }
 
@@ -206,14 +216,6 @@ void SetupHardware(void)
 	ADC_Init(ADC_FREE_RUNNING | ADC_PRESCALE_128);
 	Temperature_Init();
 	Dataflash_Init();
-	USB_Init();
-	TWI_Init(TWI_BIT_PRESCALE_4, TWI_BITLENGTH_FROM_FREQ(4, 50000));
-	RTC_Init();
-
-	/* 500ms logging interval timer configuration */
-	OCR1A   = (((F_CPU / 256) / 2) - 1);
-	TCCR1B  = (1 << WGM12) | (1 << CS12);
-	TIMSK1  = (1 << OCIE1A);
 
 	/* Check if the Dataflash is working, abort if not */
 	if (!(DataflashManager_CheckDataflashOperation()))
@@ -224,6 +226,24 @@ void SetupHardware(void)
 
 	/* Clear Dataflash sector protections, if enabled */
 	DataflashManager_ResetDataflashProtections();
+
+	#if DATAFLASH_FTL
+	/* Rebuild the Dataflash translation layer's page map from the Dataflash contents, abort if it cannot be recovered */
+	if (!(DataflashFTL_Init()))
+	{
+		LEDs_SetAllLEDs(LEDMASK_USB_ERROR);
+		for(;;);
+	}
+	#endif
+
+	USB_Init();
+	TWI_Init(TWI_BIT_PRESCALE_4, TWI_BITLENGTH_FROM_FREQ(4, 50000));
+	RTC_Init();
+
+	/* 500ms logging interval timer configuration */
+	OCR1A   = (((F_CPU / 256) / 2) - 1);
+	TCCR1B  = (1 << WGM12) | (1 << CS12);
+	TIMSK1  = (1 << OCIE1A);
 }
 
 /** Event handler for the library USB Connection event. */
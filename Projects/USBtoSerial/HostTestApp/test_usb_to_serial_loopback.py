@@ -0,0 +1,85 @@
+"""
+             LUFA Library
+     Copyright (C) Dean Camera, 2018.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+"""
+
+"""
+    LUFA USB to Serial project loopback throughput test script. With the
+    AVR's USART TX and RX lines connected together, this script streams a
+    pseudo-random byte pattern through the bridge in both directions at the
+    same time for a few seconds, verifies that every byte is echoed back
+    intact and in order, and reports the achieved full-duplex throughput.
+
+    Usage: test_usb_to_serial_loopback.py <port> [baud rate] [duration]
+
+    Requires pySerial >= 3.0 (https://github.com/pyserial/pyserial).
+"""
+
+import sys
+import threading
+from time import time
+import serial
+
+
+def pattern(offset, length):
+    return bytearray(((x * 73) + (x >> 8)) & 0xFF for x in range(offset, offset + length))
+
+
+def writer(port, duration, block_size, state):
+    start_time = time()
+    while (time() - start_time) < duration:
+        port.write(pattern(state["sent"], block_size))
+        state["sent"] += block_size
+    port.flush()
+
+
+def main():
+    if len(sys.argv) < 2:
+        print("Usage: {0} <port> [baud rate] [duration]".format(sys.argv[0]))
+        sys.exit(1)
+
+    port_name = sys.argv[1]
+    baud_rate = int(sys.argv[2]) if len(sys.argv) > 2 else 1000000
+    duration  = float(sys.argv[3]) if len(sys.argv) > 3 else 5
+    block_size = 1024
+
+    port = serial.Serial(port_name, baud_rate, timeout=1)
+    port.reset_input_buffer()
+
+    state = {"sent": 0}
+    write_thread = threading.Thread(target=writer, args=(port, duration, block_size, state))
+
+    received = 0
+    errors   = 0
+
+    start_time = time()
+    write_thread.start()
+
+    while write_thread.is_alive() or (received < state["sent"]):
+        data = port.read(4096)
+        if not data:
+            break
+
+        if data != pattern(received, len(data)):
+            errors += 1
+
+        received += len(data)
+
+    elapsed = time() - start_time
+    write_thread.join()
+    port.close()
+
+    print("Sent {0} bytes, received {1} bytes in {2:.2f}s - {3:.1f} KB/s each way".format(
+          state["sent"], received, elapsed, received / elapsed / 1024))
+
+    if (received != state["sent"]) or errors:
+        print("FAILED: {0} bytes lost, {1} corrupted reads".format(state["sent"] - received, errors))
+        sys.exit(1)
+
+    print("PASSED: all bytes echoed intact")
+
+if __name__ == '__main__':
+    main()
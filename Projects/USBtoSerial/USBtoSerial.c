@@ -36,17 +36,10 @@
 
 #include "USBtoSerial.h"
 
-/** Circular buffer to hold data from the host before it is sent to the device via the serial port. */
-static RingBuffer_t USBtoUSART_Buffer;
-
-/** Underlying data buffer for \ref USBtoUSART_Buffer, where the stored bytes are located. */
-static uint8_t      USBtoUSART_Buffer_Data[128];
-
-/** Circular buffer to hold data from the serial port before it is sent to the host. */
-static RingBuffer_t USARTtoUSB_Buffer;
-
-/** Underlying data buffer for \ref USARTtoUSB_Buffer, where the stored bytes are located. */
-static uint8_t      USARTtoUSB_Buffer_Data[128];
+/** Indicates if the last packet sent to the host was a full packet, so that the transfer must still be terminated
+ *  by a short or Zero Length Packet (ZLP) before the host will return the received data to the application.
+ */
+static bool USARTtoUSB_TransferOpen;
 
 /** LUFA CDC Class driver interface configuration and state information. This structure is
  *  passed to all CDC Class driver functions, so that multiple instances of the same class
@@ -86,60 +79,72 @@ int main(void)
 {
 	SetupHardware();
 
-	RingBuffer_InitBuffer(&USBtoUSART_Buffer, USBtoUSART_Buffer_Data, sizeof(USBtoUSART_Buffer_Data));
-	RingBuffer_InitBuffer(&USARTtoUSB_Buffer, USARTtoUSB_Buffer_Data, sizeof(USARTtoUSB_Buffer_Data));
-
 	LEDs_SetAllLEDs(LEDMASK_USB_NOTREADY);
 	GlobalInterruptEnable();
 
 	for (;;)
 	{
-		/* Only try to read in bytes from the CDC interface if the transmit buffer is not full */
-		if (!(RingBuffer_IsFull(&USBtoUSART_Buffer)))
+		/* The tasks access the CDC data endpoints directly, so they must only run once the endpoints are configured */
+		if (USB_DeviceState == DEVICE_STATE_Configured)
 		{
-			int16_t ReceivedByte = CDC_Device_ReceiveByte(&VirtualSerial_CDC_Interface);
-
-			/* Store received byte into the USART transmit buffer */
-			if (!(ReceivedByte < 0))
-			  RingBuffer_Insert(&USBtoUSART_Buffer, ReceivedByte);
+			USBtoUSART_Task();
+			USARTtoUSB_Task();
 		}
 
-		uint16_t BufferCount = RingBuffer_GetCount(&USARTtoUSB_Buffer);
-		if (BufferCount)
-		{
-			Endpoint_SelectEndpoint(VirtualSerial_CDC_Interface.Config.DataINEndpoint.Address);
+		CDC_Device_USBTask(&VirtualSerial_CDC_Interface);
+		USB_USBTask();
+	}
+}
 
-			/* Check if a packet is already enqueued to the host - if so, we shouldn't try to send more data
-			 * until it completes as there is a chance nothing is listening and a lengthy timeout could occur */
-			if (Endpoint_IsINReady())
-			{
-				/* Never send more than one bank size less one byte to the host at a time, so that we don't block
-				 * while a Zero Length Packet (ZLP) to terminate the transfer is sent if the host isn't listening */
-				uint8_t BytesToSend = MIN(BufferCount, (CDC_TXRX_EPSIZE - 1));
-
-				/* Read bytes from the USART receive buffer into the USB IN endpoint */
-				while (BytesToSend--)
-				{
-					/* Try to send the next byte of data to the host, abort if there is an error without dequeuing */
-					if (CDC_Device_SendByte(&VirtualSerial_CDC_Interface,
-											RingBuffer_Peek(&USARTtoUSB_Buffer)) != ENDPOINT_READYWAIT_NoError)
-					{
-						break;
-					}
+/** Moves each packet received from the host on the CDC data OUT endpoint into the transmit buffer of the serial
+ *  driver, which sends the queued data through the USART from its interrupts.
+ */
+void USBtoUSART_Task(void)
+{
+	Endpoint_SelectEndpoint(VirtualSerial_CDC_Interface.Config.DataOUTEndpoint.Address);
 
-					/* Dequeue the already sent byte from the buffer now we have confirmed that no transmission error occurred */
-					RingBuffer_Remove(&USARTtoUSB_Buffer);
-				}
-			}
-		}
+	if (!(Endpoint_IsOUTReceived()))
+	  return;
 
-		/* Load the next byte from the USART transmit buffer into the USART if transmit buffer space is available */
-		if (Serial_IsSendReady() && !(RingBuffer_IsEmpty(&USBtoUSART_Buffer)))
-		  Serial_SendByte(RingBuffer_Remove(&USBtoUSART_Buffer));
+	uint16_t BytesInPacket = Endpoint_BytesInEndpoint();
 
-		CDC_Device_USBTask(&VirtualSerial_CDC_Interface);
-		USB_USBTask();
-	}
+	/* Leave the packet in the endpoint bank until it fits into the transmit buffer in its entirety */
+	if (BytesInPacket > Serial_BufferedSendFreeCount())
+	  return;
+
+	uint8_t PacketData[CDC_TXRX_EPSIZE];
+
+	Endpoint_Read_Stream_LE(PacketData, BytesInPacket, NULL);
+	Endpoint_ClearOUT();
+
+	Serial_BufferedSendData(PacketData, BytesInPacket);
+}
+
+/** Sends the data received from the serial port to the host, as packets of up to a full endpoint bank read from the
+ *  receive buffer of the serial driver. Transfers ending on a full packet are terminated with a Zero Length Packet once no
+ *  further data is waiting, so that the host does not hold back the received data.
+ */
+void USARTtoUSB_Task(void)
+{
+	uint16_t BufferCount = Serial_BufferedBytesReceived();
+
+	if (!(BufferCount) && !(USARTtoUSB_TransferOpen))
+	  return;
+
+	Endpoint_SelectEndpoint(VirtualSerial_CDC_Interface.Config.DataINEndpoint.Address);
+
+	/* Only write to the endpoint once the previous packet has been taken by the host, so that the bridge can never
+	 * block waiting for a host which is not listening */
+	if (!(Endpoint_IsINReady()))
+	  return;
+
+	uint8_t  PacketData[CDC_TXRX_EPSIZE];
+	uint16_t BytesToSend = Serial_BufferedReceiveData(PacketData, MIN(BufferCount, CDC_TXRX_EPSIZE));
+
+	Endpoint_Write_Stream_LE(PacketData, BytesToSend, NULL);
+	Endpoint_ClearIN();
+
+	USARTtoUSB_TransferOpen = (BytesToSend == CDC_TXRX_EPSIZE);
 }
 
 /** Configures the board hardware and chip peripherals for the demo's functionality. */
@@ -156,6 +161,7 @@ void SetupHardware(void)
 
 	/* Hardware Initialization */
 	LEDs_Init();
+	Serial_BufferedInit(9600, false);
 	USB_Init();
 }
 
@@ -178,6 +184,8 @@ void EVENT_USB_Device_ConfigurationChanged(void)
 
 	ConfigSuccess &= CDC_Device_ConfigureEndpoints(&VirtualSerial_CDC_Interface);
 
+	USARTtoUSB_TransferOpen = false;
+
 	LEDs_SetAllLEDs(ConfigSuccess ? LEDMASK_USB_READY : LEDMASK_USB_ERROR);
 }
 
@@ -187,17 +195,6 @@ void EVENT_USB_Device_ControlRequest(void)
 	CDC_Device_ProcessControlRequest(&VirtualSerial_CDC_Interface);
 }
 
-/** ISR to manage the reception of data from the serial port, placing received bytes into a circular buffer
- *  for later transmission to the host.
- */
-ISR(USART1_RX_vect, ISR_BLOCK)
-{
-	uint8_t ReceivedByte = UDR1;
-
-	if ((USB_DeviceState == DEVICE_STATE_Configured) && !(RingBuffer_IsFull(&USARTtoUSB_Buffer)))
-	  RingBuffer_Insert(&USARTtoUSB_Buffer, ReceivedByte);
-}
-
 /** Event handler for the CDC Class driver Line Encoding Changed event.
  *
  *  \param[in] CDCInterfaceInfo  Pointer to the CDC class interface configuration structure being referenced
@@ -246,7 +243,7 @@ void EVENT_CDC_Device_LineEncodingChanged(USB_ClassInfo_CDC_Device_t* const CDCI
 	/* Reconfigure the USART in double speed mode for a wider baud rate range at the expense of accuracy */
 	UCSR1C = ConfigMask;
 	UCSR1A = (1 << U2X1);
-	UCSR1B = ((1 << RXCIE1) | (1 << TXEN1) | (1 << RXEN1));
+	UCSR1B = ((1 << RXCIE1) | (1 << UDRIE1) | (1 << TXEN1) | (1 << RXEN1));
 
 	/* Release the TX line after the USART has been reconfigured */
 	PORTD &= ~(1 << 3);
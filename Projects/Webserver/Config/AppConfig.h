@@ -48,6 +48,8 @@
 	#define ENABLE_TELNET_SERVER
 	#define MAX_URI_LENGTH                50
 
+	#define DATAFLASH_FTL                 false
+
 	#define DEVICE_IP_ADDRESS             (uint8_t[]){ 10,   0,   0,   2}
 	#define DEVICE_NETMASK                (uint8_t[]){255, 255, 255,   0}
 	#define DEVICE_GATEWAY                (uint8_t[]){ 10,   0,   0,   1}
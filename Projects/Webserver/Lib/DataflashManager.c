@@ -56,14 +56,12 @@ void DataflashManager_WriteBlocks(USB_ClassInfo_MS_Device_t* const MSInterfaceIn
 	uint8_t  CurrDFPageByteDiv16 = (CurrDFPageByte >> 4);
 	bool     UsingSecondBuffer   = false;
 
+#if (DATAFLASH_PAGE_SIZE > VIRTUAL_MEMORY_BLOCK_SIZE)
+	/* Select the correct starting Dataflash IC and copy the page's current contents to the Dataflash buffer */
+	DataflashManager_LoadPageIntoBuffer(CurrDFPage, false);
+#else
 	/* Select the correct starting Dataflash IC for the block requested */
 	Dataflash_SelectChipFromPage(CurrDFPage);
-
-#if (DATAFLASH_PAGE_SIZE > VIRTUAL_MEMORY_BLOCK_SIZE)
-	/* Copy selected dataflash's current page contents to the Dataflash buffer */
-	Dataflash_SendByte(DF_CMD_MAINMEMTOBUFF1);
-	Dataflash_SendAddressBytes(CurrDFPage, 0);
-	Dataflash_WaitWhileBusy();
 #endif
 
 	/* Send the Dataflash buffer write command */
@@ -97,8 +95,7 @@ void DataflashManager_WriteBlocks(USB_ClassInfo_MS_Device_t* const MSInterfaceIn
 			{
 				/* Write the Dataflash buffer contents back to the Dataflash page */
 				Dataflash_WaitWhileBusy();
-				Dataflash_SendByte(UsingSecondBuffer ? DF_CMD_BUFF2TOMAINMEMWITHERASE : DF_CMD_BUFF1TOMAINMEMWITHERASE);
-				Dataflash_SendAddressBytes(CurrDFPage, 0);
+				DataflashManager_ProgramBuffer(CurrDFPage, UsingSecondBuffer);
 
 				/* Reset the Dataflash buffer counter, increment the page counter */
 				CurrDFPageByteDiv16 = 0;
@@ -115,11 +112,8 @@ void DataflashManager_WriteBlocks(USB_ClassInfo_MS_Device_t* const MSInterfaceIn
 				/* If less than one Dataflash page remaining, copy over the existing page to preserve trailing data */
 				if ((TotalBlocks * (VIRTUAL_MEMORY_BLOCK_SIZE >> 4)) < (DATAFLASH_PAGE_SIZE >> 4))
 				{
-					/* Copy selected dataflash's current page contents to the Dataflash buffer */
-					Dataflash_WaitWhileBusy();
-					Dataflash_SendByte(UsingSecondBuffer ? DF_CMD_MAINMEMTOBUFF2 : DF_CMD_MAINMEMTOBUFF1);
-					Dataflash_SendAddressBytes(CurrDFPage, 0);
-					Dataflash_WaitWhileBusy();
+					/* Copy the page's current contents to the Dataflash buffer */
+					DataflashManager_LoadPageIntoBuffer(CurrDFPage, UsingSecondBuffer);
 				}
 #endif
 
@@ -163,8 +157,7 @@ void DataflashManager_WriteBlocks(USB_ClassInfo_MS_Device_t* const MSInterfaceIn
 
 	/* Write the Dataflash buffer contents back to the Dataflash page */
 	Dataflash_WaitWhileBusy();
-	Dataflash_SendByte(UsingSecondBuffer ? DF_CMD_BUFF2TOMAINMEMWITHERASE : DF_CMD_BUFF1TOMAINMEMWITHERASE);
-	Dataflash_SendAddressBytes(CurrDFPage, 0x00);
+	DataflashManager_ProgramBuffer(CurrDFPage, UsingSecondBuffer);
 	Dataflash_WaitWhileBusy();
 
 	/* If the endpoint is empty, clear it ready for the next packet from the host */
@@ -191,16 +184,8 @@ void DataflashManager_ReadBlocks(USB_ClassInfo_MS_Device_t* const MSInterfaceInf
 	uint16_t CurrDFPageByte      = ((BlockAddress * VIRTUAL_MEMORY_BLOCK_SIZE) % DATAFLASH_PAGE_SIZE);
 	uint8_t  CurrDFPageByteDiv16 = (CurrDFPageByte >> 4);
 
-	/* Select the correct starting Dataflash IC for the block requested */
-	Dataflash_SelectChipFromPage(CurrDFPage);
-
-	/* Send the Dataflash main memory page read command */
-	Dataflash_SendByte(DF_CMD_MAINMEMPAGEREAD);
-	Dataflash_SendAddressBytes(CurrDFPage, CurrDFPageByte);
-	Dataflash_SendByte(0x00);
-	Dataflash_SendByte(0x00);
-	Dataflash_SendByte(0x00);
-	Dataflash_SendByte(0x00);
+	/* Select the correct starting Dataflash IC and send the Dataflash main memory page read command */
+	DataflashManager_SendPageReadCommand(CurrDFPage, CurrDFPageByte);
 
 	/* Wait until endpoint is ready before continuing */
 	if (Endpoint_WaitUntilReady())
@@ -231,35 +216,22 @@ void DataflashManager_ReadBlocks(USB_ClassInfo_MS_Device_t* const MSInterfaceInf
 				CurrDFPageByteDiv16 = 0;
 				CurrDFPage++;
 
-				/* Select the next Dataflash chip based on the new Dataflash page index */
-				Dataflash_SelectChipFromPage(CurrDFPage);
+				/* Select the next Dataflash chip and send the Dataflash main memory page read command */
+				DataflashManager_SendPageReadCommand(CurrDFPage, 0);
+			}
 
-				/* Send the Dataflash main memory page read command */
-				Dataflash_SendByte(DF_CMD_MAINMEMPAGEREAD);
-				Dataflash_SendAddressBytes(CurrDFPage, 0);
-				Dataflash_SendByte(0x00);
-				Dataflash_SendByte(0x00);
-				Dataflash_SendByte(0x00);
-				Dataflash_SendByte(0x00);
+			/* Read one 16-byte chunk of data from the Dataflash, clocking in each byte while the previous one is
+			 * loaded into the endpoint bank so that the SPI transfers overlap the USB controller accesses */
+			Dataflash_BeginReceiveByte();
+
+			for (uint8_t ByteInChunk = 0; ByteInChunk < 15; ByteInChunk++)
+			{
+				uint8_t DataByte = Dataflash_EndReceiveByte();
+				Dataflash_BeginReceiveByte();
+				Endpoint_Write_8(DataByte);
 			}
 
-			/* Read one 16-byte chunk of data from the Dataflash */
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
-			Endpoint_Write_8(Dataflash_ReceiveByte());
+			Endpoint_Write_8(Dataflash_EndReceiveByte());
 
 			/* Increment the Dataflash page 16 byte block counter */
 			CurrDFPageByteDiv16++;
@@ -302,14 +274,12 @@ void DataflashManager_WriteBlocks_RAM(const uint32_t BlockAddress,
 	uint8_t  CurrDFPageByteDiv16 = (CurrDFPageByte >> 4);
 	bool     UsingSecondBuffer   = false;
 
+#if (DATAFLASH_PAGE_SIZE > VIRTUAL_MEMORY_BLOCK_SIZE)
+	/* Select the correct starting Dataflash IC and copy the page's current contents to the Dataflash buffer */
+	DataflashManager_LoadPageIntoBuffer(CurrDFPage, false);
+#else
 	/* Select the correct starting Dataflash IC for the block requested */
 	Dataflash_SelectChipFromPage(CurrDFPage);
-
-#if (DATAFLASH_PAGE_SIZE > VIRTUAL_MEMORY_BLOCK_SIZE)
-	/* Copy selected dataflash's current page contents to the Dataflash buffer */
-	Dataflash_SendByte(DF_CMD_MAINMEMTOBUFF1);
-	Dataflash_SendAddressBytes(CurrDFPage, 0);
-	Dataflash_WaitWhileBusy();
 #endif
 
 	/* Send the Dataflash buffer write command */
@@ -328,8 +298,7 @@ void DataflashManager_WriteBlocks_RAM(const uint32_t BlockAddress,
 			{
 				/* Write the Dataflash buffer contents back to the Dataflash page */
 				Dataflash_WaitWhileBusy();
-				Dataflash_SendByte(UsingSecondBuffer ? DF_CMD_BUFF2TOMAINMEMWITHERASE : DF_CMD_BUFF1TOMAINMEMWITHERASE);
-				Dataflash_SendAddressBytes(CurrDFPage, 0);
+				DataflashManager_ProgramBuffer(CurrDFPage, UsingSecondBuffer);
 
 				/* Reset the Dataflash buffer counter, increment the page counter */
 				CurrDFPageByteDiv16 = 0;
@@ -346,11 +315,8 @@ void DataflashManager_WriteBlocks_RAM(const uint32_t BlockAddress,
 				/* If less than one Dataflash page remaining, copy over the existing page to preserve trailing data */
 				if ((TotalBlocks * (VIRTUAL_MEMORY_BLOCK_SIZE >> 4)) < (DATAFLASH_PAGE_SIZE >> 4))
 				{
-					/* Copy selected dataflash's current page contents to the Dataflash buffer */
-					Dataflash_WaitWhileBusy();
-					Dataflash_SendByte(UsingSecondBuffer ? DF_CMD_MAINMEMTOBUFF2 : DF_CMD_MAINMEMTOBUFF1);
-					Dataflash_SendAddressBytes(CurrDFPage, 0);
-					Dataflash_WaitWhileBusy();
+					/* Copy the page's current contents to the Dataflash buffer */
+					DataflashManager_LoadPageIntoBuffer(CurrDFPage, UsingSecondBuffer);
 				}
 #endif
 
@@ -377,8 +343,7 @@ void DataflashManager_WriteBlocks_RAM(const uint32_t BlockAddress,
 
 	/* Write the Dataflash buffer contents back to the Dataflash page */
 	Dataflash_WaitWhileBusy();
-	Dataflash_SendByte(UsingSecondBuffer ? DF_CMD_BUFF2TOMAINMEMWITHERASE : DF_CMD_BUFF1TOMAINMEMWITHERASE);
-	Dataflash_SendAddressBytes(CurrDFPage, 0x00);
+	DataflashManager_ProgramBuffer(CurrDFPage, UsingSecondBuffer);
 	Dataflash_WaitWhileBusy();
 
 	/* Deselect all Dataflash chips */
@@ -402,16 +367,8 @@ void DataflashManager_ReadBlocks_RAM(const uint32_t BlockAddress,
 	uint16_t CurrDFPageByte      = ((BlockAddress * VIRTUAL_MEMORY_BLOCK_SIZE) % DATAFLASH_PAGE_SIZE);
 	uint8_t  CurrDFPageByteDiv16 = (CurrDFPageByte >> 4);
 
-	/* Select the correct starting Dataflash IC for the block requested */
-	Dataflash_SelectChipFromPage(CurrDFPage);
-
-	/* Send the Dataflash main memory page read command */
-	Dataflash_SendByte(DF_CMD_MAINMEMPAGEREAD);
-	Dataflash_SendAddressBytes(CurrDFPage, CurrDFPageByte);
-	Dataflash_SendByte(0x00);
-	Dataflash_SendByte(0x00);
-	Dataflash_SendByte(0x00);
-	Dataflash_SendByte(0x00);
+	/* Select the correct starting Dataflash IC and send the Dataflash main memory page read command */
+	DataflashManager_SendPageReadCommand(CurrDFPage, CurrDFPageByte);
 
 	while (TotalBlocks)
 	{
@@ -427,16 +384,8 @@ void DataflashManager_ReadBlocks_RAM(const uint32_t BlockAddress,
 				CurrDFPageByteDiv16 = 0;
 				CurrDFPage++;
 
-				/* Select the next Dataflash chip based on the new Dataflash page index */
-				Dataflash_SelectChipFromPage(CurrDFPage);
-
-				/* Send the Dataflash main memory page read command */
-				Dataflash_SendByte(DF_CMD_MAINMEMPAGEREAD);
-				Dataflash_SendAddressBytes(CurrDFPage, 0);
-				Dataflash_SendByte(0x00);
-				Dataflash_SendByte(0x00);
-				Dataflash_SendByte(0x00);
-				Dataflash_SendByte(0x00);
+				/* Select the next Dataflash chip and send the Dataflash main memory page read command */
+				DataflashManager_SendPageReadCommand(CurrDFPage, 0);
 			}
 
 			/* Read one 16-byte chunk of data from the Dataflash */
@@ -532,3 +481,87 @@ bool DataflashManager_CheckDataflashOperation(void)
 	return true;
 }
 
+/** Retrieves the physical Dataflash page holding the given page of the storage medium. With the Dataflash translation
+ *  layer enabled the pages are moved on each write, otherwise each page of the medium is held in the Dataflash page of
+ *  the same address.
+ *
+ *  \param[in] PageAddress  Page of the storage medium to locate
+ *
+ *  \return Physical Dataflash page holding the page
+ */
+static inline uint16_t DataflashManager_GetPhysicalPage(const uint16_t PageAddress)
+{
+#if DATAFLASH_FTL
+	return DataflashFTL_GetPhysicalPage(PageAddress);
+#else
+	return PageAddress;
+#endif
+}
+
+/** Selects the Dataflash IC holding the given page and copies the page's current contents into one of its Dataflash
+ *  buffers, so that part of the page can be rewritten. The Dataflash IC remains selected.
+ *
+ *  \param[in] PageAddress      Dataflash page to copy
+ *  \param[in] UseSecondBuffer  Indicates if the page is to be copied into the second Dataflash buffer rather than the first
+ */
+static void DataflashManager_LoadPageIntoBuffer(const uint16_t PageAddress,
+                                                const bool UseSecondBuffer)
+{
+	uint16_t PhysicalPage = DataflashManager_GetPhysicalPage(PageAddress);
+
+	/* Select the correct Dataflash IC for the page requested, wait until it is idle */
+	Dataflash_SelectChipFromPage(PhysicalPage);
+	Dataflash_WaitWhileBusy();
+
+	Dataflash_SendByte(UseSecondBuffer ? DF_CMD_MAINMEMTOBUFF2 : DF_CMD_MAINMEMTOBUFF1);
+	Dataflash_SendAddressBytes(PhysicalPage, 0);
+	Dataflash_WaitWhileBusy();
+}
+
+/** Programs the contents of one of the Dataflash buffers of the selected Dataflash IC into the given page. With the
+ *  Dataflash translation layer enabled the contents are written to a fresh physical page, otherwise the page is erased
+ *  and reprogrammed in place. The programming is started but not waited for, and the Dataflash IC remains selected.
+ *
+ *  \param[in] PageAddress      Dataflash page to write
+ *  \param[in] UseSecondBuffer  Indicates if the contents are held in the second Dataflash buffer rather than the first
+ */
+static void DataflashManager_ProgramBuffer(const uint16_t PageAddress,
+                                           const bool UseSecondBuffer)
+{
+#if DATAFLASH_FTL
+	DataflashFTL_ProgramBuffer(PageAddress, UseSecondBuffer);
+#else
+	Dataflash_ToggleSelectedChipCS();
+	Dataflash_SendByte(UseSecondBuffer ? DF_CMD_BUFF2TOMAINMEMWITHERASE : DF_CMD_BUFF1TOMAINMEMWITHERASE);
+	Dataflash_SendAddressBytes(PageAddress, 0);
+	Dataflash_ToggleSelectedChipCS();
+#endif
+}
+
+/** Selects the Dataflash IC holding the given page and sends the main memory page read command, so that the page contents
+ *  can be read out starting from the given byte within the page.
+ *
+ *  \param[in] PageAddress  Dataflash page to read
+ *  \param[in] PageByte     Byte within the page to start reading from
+ */
+static void DataflashManager_SendPageReadCommand(const uint16_t PageAddress,
+                                                 const uint16_t PageByte)
+{
+	uint16_t PhysicalPage = DataflashManager_GetPhysicalPage(PageAddress);
+
+	/* Select the correct Dataflash IC for the page requested */
+	Dataflash_SelectChipFromPage(PhysicalPage);
+
+#if DATAFLASH_FTL
+	/* Unused pages are erased in the background, wait until the Dataflash IC is idle */
+	Dataflash_WaitWhileBusy();
+#endif
+
+	/* Send the Dataflash main memory page read command */
+	Dataflash_SendByte(DF_CMD_MAINMEMPAGEREAD);
+	Dataflash_SendAddressBytes(PhysicalPage, PageByte);
+	Dataflash_SendByte(0x00);
+	Dataflash_SendByte(0x00);
+	Dataflash_SendByte(0x00);
+	Dataflash_SendByte(0x00);
+}
@@ -54,6 +54,11 @@ int main(void)
 		  USBDeviceMode_USBTask();
 
 		USB_USBTask();
+
+		#if DATAFLASH_FTL
+		/* Erase unused Dataflash pages ahead of time and level the Dataflash wear */
+		DataflashFTL_Task();
+		#endif
 	}
 }
 
@@ -72,6 +77,16 @@ void SetupHardware(void)
 	/* Hardware Initialization */
 	Dataflash_Init();
 	LEDs_Init();
+
+	#if DATAFLASH_FTL
+	/* Rebuild the Dataflash translation layer's page map from the Dataflash contents, abort if it cannot be recovered */
+	if (!(DataflashFTL_Init()))
+	{
+		LEDs_SetAllLEDs(LEDMASK_USB_ERROR);
+		for(;;);
+	}
+	#endif
+
 	USB_Init(USB_MODE_UID);
 }
 